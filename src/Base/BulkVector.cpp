@@ -0,0 +1,661 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <vector>
+#include <QThreadPool>
+#include <QtConcurrentMap>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define FC_BULKVECTOR_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#include "BulkVector.h"
+
+// GCC and Clang only allow intrinsics in functions compiled for the matching instruction set
+#if defined(__GNUC__) || defined(__clang__)
+#define FC_TARGET(set) __attribute__((target(set)))
+#else
+#define FC_TARGET(set)
+#endif
+
+
+using namespace Base;
+using Set = BulkVector::InstructionSet;
+
+namespace
+{
+// the number of points a thread gets at least
+constexpr std::size_t MinPointsPerThread = 65536;
+
+// the upper 3x4 part of the matrix in row-major order
+struct Coefficients
+{
+    double m[12];
+};
+
+Coefficients coefficients(const Matrix4D& mat)
+{
+    Coefficients c {};
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 4; j++) {
+            c.m[4 * i + j] = mat[i][j];
+        }
+    }
+    return c;
+}
+
+inline float* pointAt(void* data, std::size_t index, std::size_t stride)
+{
+    return reinterpret_cast<float*>(static_cast<char*>(data) + index * stride);  // NOLINT
+}
+
+inline const float* pointAt(const void* data, std::size_t index, std::size_t stride)
+{
+    return reinterpret_cast<const float*>(static_cast<const char*>(data)  // NOLINT
+                                          + index * stride);
+}
+
+// the number of threads of the global thread pool
+std::size_t countThreads()
+{
+    return std::max<std::size_t>(1, QThreadPool::globalInstance()->maxThreadCount());
+}
+
+struct Chunk
+{
+    std::size_t begin;
+    std::size_t end;
+    std::size_t index;
+};
+
+// Splits [0, count) into at most \a threads ranges and calls func(begin, end, chunk) for each of
+// them on the global thread pool. Returns the number of ranges.
+template<typename Func>
+std::size_t forEachChunk(std::size_t count, std::size_t threads, Func&& func)
+{
+    threads = std::max<std::size_t>(1, std::min(threads, count / MinPointsPerThread));
+    if (threads == 1) {
+        func(std::size_t(0), count, std::size_t(0));
+        return 1;
+    }
+
+    std::size_t size = (count + threads - 1) / threads;
+    std::vector<Chunk> chunks;
+    for (std::size_t begin = 0; begin < count; begin += size) {
+        chunks.push_back({begin, std::min(begin + size, count), chunks.size()});
+    }
+    QtConcurrent::blockingMap(chunks, [&func](const Chunk& chunk) {
+        func(chunk.begin, chunk.end, chunk.index);
+    });
+    return chunks.size();
+}
+
+// ----------------------------------------------------------------------------
+
+void transformScalar(const Coefficients& c,
+                     void* data,
+                     std::size_t begin,
+                     std::size_t end,
+                     std::size_t stride)
+{
+    const double* m = c.m;
+    for (std::size_t i = begin; i < end; i++) {
+        float* p = pointAt(data, i, stride);
+        double x = p[0];
+        double y = p[1];
+        double z = p[2];
+        p[0] = static_cast<float>(m[0] * x + m[1] * y + m[2] * z + m[3]);
+        p[1] = static_cast<float>(m[4] * x + m[5] * y + m[6] * z + m[7]);
+        p[2] = static_cast<float>(m[8] * x + m[9] * y + m[10] * z + m[11]);
+    }
+}
+
+void boundBoxScalar(const void* data,
+                    std::size_t begin,
+                    std::size_t end,
+                    std::size_t stride,
+                    BoundBox3f& box)
+{
+    for (std::size_t i = begin; i < end; i++) {
+        const float* p = pointAt(data, i, stride);
+        box.Add(Vector3f(p[0], p[1], p[2]));
+    }
+}
+
+void boundBoxScalar(const Coefficients& c,
+                    const void* data,
+                    std::size_t begin,
+                    std::size_t end,
+                    std::size_t stride,
+                    BoundBox3d& box)
+{
+    const double* m = c.m;
+    for (std::size_t i = begin; i < end; i++) {
+        const float* p = pointAt(data, i, stride);
+        double x = p[0];
+        double y = p[1];
+        double z = p[2];
+        box.Add(Vector3d(m[0] * x + m[1] * y + m[2] * z + m[3],
+                         m[4] * x + m[5] * y + m[6] * z + m[7],
+                         m[8] * x + m[9] * y + m[10] * z + m[11]));
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+#ifdef FC_BULKVECTOR_X86
+// MINPS and MAXPS return the second operand if one of them is NaN, so the new values are always
+// passed first to skip NaN coordinates like BoundBox3::Add() does. The accumulators start
+// with +/-MAX, and lanes that only got NaN keep these values and don't change the box.
+template<class Precision, std::size_t N>
+void addLanes(const Precision (&lo)[3][N], const Precision (&hi)[3][N], BoundBox3<Precision>& box)
+{
+    for (std::size_t k = 0; k < N; k++) {
+        box.MinX = std::min<Precision>(box.MinX, lo[0][k]);
+        box.MinY = std::min<Precision>(box.MinY, lo[1][k]);
+        box.MinZ = std::min<Precision>(box.MinZ, lo[2][k]);
+        box.MaxX = std::max<Precision>(box.MaxX, hi[0][k]);
+        box.MaxY = std::max<Precision>(box.MaxY, hi[1][k]);
+        box.MaxZ = std::max<Precision>(box.MaxZ, hi[2][k]);
+    }
+}
+
+// With a stride only the 12 bytes of a point are accessed and the data in between is left untouched
+FC_TARGET("sse2") inline __m128 load3(const float* p)
+{
+    __m128 xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(p)));  // NOLINT
+    return _mm_movelh_ps(xy, _mm_load_ss(p + 2));
+}
+
+FC_TARGET("sse2") inline void store3(float* p, __m128 v)
+{
+    _mm_store_sd(reinterpret_cast<double*>(p), _mm_castps_pd(v));  // NOLINT
+    _mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+}
+
+// Loads four points and returns their x, y and z coordinates
+FC_TARGET("sse2")
+inline void
+load4(const void* data, std::size_t i, std::size_t stride, __m128& x, __m128& y, __m128& z)
+{
+    if (stride == 3 * sizeof(float)) {
+        // deinterleave x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+        const float* p = pointAt(data, i, stride);
+        __m128 a = _mm_loadu_ps(p);
+        __m128 b = _mm_loadu_ps(p + 4);
+        __m128 c = _mm_loadu_ps(p + 8);
+        x = _mm_shuffle_ps(a,
+                           _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)),
+                           _MM_SHUFFLE(2, 0, 3, 0));
+        y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+                           _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)),
+                           _MM_SHUFFLE(2, 0, 2, 0));
+        z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+                           c,
+                           _MM_SHUFFLE(3, 0, 2, 0));
+        return;
+    }
+
+    __m128 p0 = load3(pointAt(data, i, stride));
+    __m128 p1 = load3(pointAt(data, i + 1, stride));
+    __m128 p2 = load3(pointAt(data, i + 2, stride));
+    __m128 p3 = load3(pointAt(data, i + 3, stride));
+    _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+    x = p0;
+    y = p1;
+    z = p2;
+}
+
+FC_TARGET("sse2")
+inline void store4(void* data, std::size_t i, std::size_t stride, __m128 x, __m128 y, __m128 z)
+{
+    if (stride == 3 * sizeof(float)) {
+        float* p = pointAt(data, i, stride);
+        _mm_storeu_ps(p,
+                      _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)),
+                                     _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)),
+                                     _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(p + 4,
+                      _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)),
+                                     _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)),
+                                     _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(p + 8,
+                      _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),
+                                     _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)),
+                                     _MM_SHUFFLE(2, 0, 2, 0)));
+        return;
+    }
+
+    __m128 w = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+    store3(pointAt(data, i, stride), x);
+    store3(pointAt(data, i + 1, stride), y);
+    store3(pointAt(data, i + 2, stride), z);
+    store3(pointAt(data, i + 3, stride), w);
+}
+
+// The rows of the matrix are evaluated in the same order as by Matrix4D::multVec()
+FC_TARGET("sse2") inline __m128d row2(const double* r, __m128d x, __m128d y, __m128d z)
+{
+    __m128d v = _mm_mul_pd(_mm_set1_pd(r[0]), x);
+    v = _mm_add_pd(v, _mm_mul_pd(_mm_set1_pd(r[1]), y));
+    v = _mm_add_pd(v, _mm_mul_pd(_mm_set1_pd(r[2]), z));
+    return _mm_add_pd(v, _mm_set1_pd(r[3]));
+}
+
+FC_TARGET("avx") inline __m256d row4(const double* r, __m256d x, __m256d y, __m256d z)
+{
+    __m256d v = _mm256_mul_pd(_mm256_set1_pd(r[0]), x);
+    v = _mm256_add_pd(v, _mm256_mul_pd(_mm256_set1_pd(r[1]), y));
+    v = _mm256_add_pd(v, _mm256_mul_pd(_mm256_set1_pd(r[2]), z));
+    return _mm256_add_pd(v, _mm256_set1_pd(r[3]));
+}
+
+FC_TARGET("avx512f") inline __m512d row8(const double* r, __m512d x, __m512d y, __m512d z)
+{
+    __m512d v = _mm512_mul_pd(_mm512_set1_pd(r[0]), x);
+    v = _mm512_add_pd(v, _mm512_mul_pd(_mm512_set1_pd(r[1]), y));
+    v = _mm512_add_pd(v, _mm512_mul_pd(_mm512_set1_pd(r[2]), z));
+    return _mm512_add_pd(v, _mm512_set1_pd(r[3]));
+}
+
+FC_TARGET("sse2") inline __m128 rowSSE2(const double* r, __m128 x, __m128 y, __m128 z)
+{
+    __m128d lo = row2(r, _mm_cvtps_pd(x), _mm_cvtps_pd(y), _mm_cvtps_pd(z));
+    __m128d hi = row2(r,
+                      _mm_cvtps_pd(_mm_movehl_ps(x, x)),
+                      _mm_cvtps_pd(_mm_movehl_ps(y, y)),
+                      _mm_cvtps_pd(_mm_movehl_ps(z, z)));
+    return _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi));
+}
+
+FC_TARGET("sse2")
+void transformSSE2(const Coefficients& c,
+                   void* data,
+                   std::size_t begin,
+                   std::size_t end,
+                   std::size_t stride)
+{
+    std::size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 x, y, z;  // NOLINT
+        load4(data, i, stride, x, y, z);
+        __m128 tx = rowSSE2(c.m, x, y, z);
+        __m128 ty = rowSSE2(c.m + 4, x, y, z);
+        __m128 tz = rowSSE2(c.m + 8, x, y, z);
+        store4(data, i, stride, tx, ty, tz);
+    }
+    transformScalar(c, data, i, end, stride);
+}
+
+FC_TARGET("avx")
+void transformAVX(const Coefficients& c,
+                  void* data,
+                  std::size_t begin,
+                  std::size_t end,
+                  std::size_t stride)
+{
+    std::size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 x, y, z;  // NOLINT
+        load4(data, i, stride, x, y, z);
+        __m256d dx = _mm256_cvtps_pd(x);
+        __m256d dy = _mm256_cvtps_pd(y);
+        __m256d dz = _mm256_cvtps_pd(z);
+        __m128 tx = _mm256_cvtpd_ps(row4(c.m, dx, dy, dz));
+        __m128 ty = _mm256_cvtpd_ps(row4(c.m + 4, dx, dy, dz));
+        __m128 tz = _mm256_cvtpd_ps(row4(c.m + 8, dx, dy, dz));
+        store4(data, i, stride, tx, ty, tz);
+    }
+    transformScalar(c, data, i, end, stride);
+}
+
+FC_TARGET("avx512f")
+void transformAVX512(const Coefficients& c,
+                     void* data,
+                     std::size_t begin,
+                     std::size_t end,
+                     std::size_t stride)
+{
+    std::size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m128 x0, y0, z0, x1, y1, z1;  // NOLINT
+        load4(data, i, stride, x0, y0, z0);
+        load4(data, i + 4, stride, x1, y1, z1);
+        __m512d dx = _mm512_cvtps_pd(_mm256_insertf128_ps(_mm256_castps128_ps256(x0), x1, 1));
+        __m512d dy = _mm512_cvtps_pd(_mm256_insertf128_ps(_mm256_castps128_ps256(y0), y1, 1));
+        __m512d dz = _mm512_cvtps_pd(_mm256_insertf128_ps(_mm256_castps128_ps256(z0), z1, 1));
+        __m256 tx = _mm512_cvtpd_ps(row8(c.m, dx, dy, dz));
+        __m256 ty = _mm512_cvtpd_ps(row8(c.m + 4, dx, dy, dz));
+        __m256 tz = _mm512_cvtpd_ps(row8(c.m + 8, dx, dy, dz));
+        store4(data,
+               i,
+               stride,
+               _mm256_castps256_ps128(tx),
+               _mm256_castps256_ps128(ty),
+               _mm256_castps256_ps128(tz));
+        store4(data,
+               i + 4,
+               stride,
+               _mm256_extractf128_ps(tx, 1),
+               _mm256_extractf128_ps(ty, 1),
+               _mm256_extractf128_ps(tz, 1));
+    }
+    transformAVX(c, data, i, end, stride);
+}
+
+FC_TARGET("sse2")
+void boundBoxSSE2(const void* data,
+                  std::size_t begin,
+                  std::size_t end,
+                  std::size_t stride,
+                  BoundBox3f& box)
+{
+    std::size_t i = begin;
+    if (i + 4 <= end) {
+        __m128 minX = _mm_set1_ps(FLT_MAX), minY = minX, minZ = minX;  // NOLINT
+        __m128 maxX = _mm_set1_ps(-FLT_MAX), maxY = maxX, maxZ = maxX;  // NOLINT
+        for (; i + 4 <= end; i += 4) {
+            __m128 x, y, z;  // NOLINT
+            load4(data, i, stride, x, y, z);
+            minX = _mm_min_ps(x, minX);
+            minY = _mm_min_ps(y, minY);
+            minZ = _mm_min_ps(z, minZ);
+            maxX = _mm_max_ps(x, maxX);
+            maxY = _mm_max_ps(y, maxY);
+            maxZ = _mm_max_ps(z, maxZ);
+        }
+
+        float lo[3][4];  // NOLINT
+        float hi[3][4];  // NOLINT
+        _mm_storeu_ps(lo[0], minX);
+        _mm_storeu_ps(lo[1], minY);
+        _mm_storeu_ps(lo[2], minZ);
+        _mm_storeu_ps(hi[0], maxX);
+        _mm_storeu_ps(hi[1], maxY);
+        _mm_storeu_ps(hi[2], maxZ);
+        addLanes(lo, hi, box);
+    }
+    boundBoxScalar(data, i, end, stride, box);
+}
+
+FC_TARGET("sse2")
+void boundBoxSSE2(const Coefficients& c,
+                  const void* data,
+                  std::size_t begin,
+                  std::size_t end,
+                  std::size_t stride,
+                  BoundBox3d& box)
+{
+    std::size_t i = begin;
+    __m128d lo[3];  // NOLINT
+    __m128d hi[3];  // NOLINT
+    for (int k = 0; k < 3; k++) {
+        lo[k] = _mm_set1_pd(DBL_MAX);
+        hi[k] = _mm_set1_pd(-DBL_MAX);
+    }
+
+    for (; i + 4 <= end; i += 4) {
+        __m128 x, y, z;  // NOLINT
+        load4(data, i, stride, x, y, z);
+        __m128d dx[2] = {_mm_cvtps_pd(x), _mm_cvtps_pd(_mm_movehl_ps(x, x))};
+        __m128d dy[2] = {_mm_cvtps_pd(y), _mm_cvtps_pd(_mm_movehl_ps(y, y))};
+        __m128d dz[2] = {_mm_cvtps_pd(z), _mm_cvtps_pd(_mm_movehl_ps(z, z))};
+        for (int h = 0; h < 2; h++) {
+            for (int k = 0; k < 3; k++) {
+                __m128d v = row2(c.m + 4 * k, dx[h], dy[h], dz[h]);
+                lo[k] = _mm_min_pd(v, lo[k]);
+                hi[k] = _mm_max_pd(v, hi[k]);
+            }
+        }
+    }
+
+    if (i > begin) {
+        double l[3][2];  // NOLINT
+        double h[3][2];  // NOLINT
+        for (int k = 0; k < 3; k++) {
+            _mm_storeu_pd(l[k], lo[k]);
+            _mm_storeu_pd(h[k], hi[k]);
+        }
+        addLanes(l, h, box);
+    }
+    boundBoxScalar(c, data, i, end, stride, box);
+}
+
+FC_TARGET("avx")
+void boundBoxAVX(const Coefficients& c,
+                 const void* data,
+                 std::size_t begin,
+                 std::size_t end,
+                 std::size_t stride,
+                 BoundBox3d& box)
+{
+    std::size_t i = begin;
+    __m256d lo[3];  // NOLINT
+    __m256d hi[3];  // NOLINT
+    for (int k = 0; k < 3; k++) {
+        lo[k] = _mm256_set1_pd(DBL_MAX);
+        hi[k] = _mm256_set1_pd(-DBL_MAX);
+    }
+
+    for (; i + 4 <= end; i += 4) {
+        __m128 x, y, z;  // NOLINT
+        load4(data, i, stride, x, y, z);
+        __m256d dx = _mm256_cvtps_pd(x);
+        __m256d dy = _mm256_cvtps_pd(y);
+        __m256d dz = _mm256_cvtps_pd(z);
+        for (int k = 0; k < 3; k++) {
+            __m256d v = row4(c.m + 4 * k, dx, dy, dz);
+            lo[k] = _mm256_min_pd(v, lo[k]);
+            hi[k] = _mm256_max_pd(v, hi[k]);
+        }
+    }
+
+    if (i > begin) {
+        double l[3][4];  // NOLINT
+        double h[3][4];  // NOLINT
+        for (int k = 0; k < 3; k++) {
+            _mm256_storeu_pd(l[k], lo[k]);
+            _mm256_storeu_pd(h[k], hi[k]);
+        }
+        addLanes(l, h, box);
+    }
+    boundBoxScalar(c, data, i, end, stride, box);
+}
+#endif
+
+Set detect()
+{
+#if defined(FC_BULKVECTOR_X86) && defined(_MSC_VER)
+    int info[4];  // NOLINT
+    __cpuid(info, 0);
+    int maxId = info[0];
+    __cpuid(info, 1);
+    bool sse2 = (info[3] & (1 << 26)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    bool avx512 = false;
+    if (maxId >= 7) {
+        __cpuidex(info, 7, 0);
+        avx512 = (info[1] & (1 << 16)) != 0;
+    }
+
+    // the operating system must save the registers, too
+    unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+    if (avx512 && (xcr0 & 0xe6) == 0xe6) {
+        return Set::AVX512;
+    }
+    if (avx && (xcr0 & 0x6) == 0x6) {
+        return Set::AVX;
+    }
+    if (sse2) {
+        return Set::SSE2;
+    }
+#elif defined(FC_BULKVECTOR_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return Set::AVX512;
+    }
+    if (__builtin_cpu_supports("avx")) {
+        return Set::AVX;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return Set::SSE2;
+    }
+#endif
+    return Set::Scalar;
+}
+
+std::atomic<Set>& activeSet()
+{
+    static std::atomic<Set> set {BulkVector::supported()};
+    return set;
+}
+}  // namespace
+
+BulkVector::InstructionSet BulkVector::supported()
+{
+    static const Set set = detect();
+    return set;
+}
+
+BulkVector::InstructionSet BulkVector::active()
+{
+    return activeSet();
+}
+
+void BulkVector::setActive(InstructionSet set)
+{
+    activeSet() = std::min(set, supported());
+}
+
+const char* BulkVector::name(InstructionSet set)
+{
+    switch (set) {
+        case Set::SSE2:
+            return "SSE2";
+        case Set::AVX:
+            return "AVX";
+        case Set::AVX512:
+            return "AVX-512";
+        default:
+            return "Scalar";
+    }
+}
+
+void BulkVector::transform(const Matrix4D& mat,
+                           Vector3f* points,
+                           std::size_t count,
+                           std::size_t stride)
+{
+    Coefficients c = coefficients(mat);
+    Set set = active();
+    forEachChunk(count, countThreads(), [&](std::size_t begin, std::size_t end, std::size_t) {
+        switch (set) {
+#ifdef FC_BULKVECTOR_X86
+            case Set::AVX512:
+                transformAVX512(c, points, begin, end, stride);
+                break;
+            case Set::AVX:
+                transformAVX(c, points, begin, end, stride);
+                break;
+            case Set::SSE2:
+                transformSSE2(c, points, begin, end, stride);
+                break;
+#endif
+            default:
+                transformScalar(c, points, begin, end, stride);
+                break;
+        }
+    });
+}
+
+BoundBox3f BulkVector::boundBox(const Vector3f* points, std::size_t count, std::size_t stride)
+{
+    Set set = active();
+    std::size_t threads = countThreads();
+    std::vector<BoundBox3f> boxes(threads);
+    auto func = [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+#ifdef FC_BULKVECTOR_X86
+        if (set != Set::Scalar) {
+            boundBoxSSE2(points, begin, end, stride, boxes[chunk]);
+            return;
+        }
+#endif
+        boundBoxScalar(points, begin, end, stride, boxes[chunk]);
+    };
+
+    std::size_t chunks = forEachChunk(count, threads, func);
+
+    BoundBox3f box;
+    for (std::size_t i = 0; i < chunks; i++) {
+        box.Add(boxes[i]);
+    }
+    return box;
+}
+
+BoundBox3d BulkVector::boundBox(const Matrix4D& mat,
+                                const Vector3f* points,
+                                std::size_t count,
+                                std::size_t stride)
+{
+    Coefficients c = coefficients(mat);
+    Set set = active();
+    std::size_t threads = countThreads();
+    std::vector<BoundBox3d> boxes(threads);
+    auto func = [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+        switch (set) {
+#ifdef FC_BULKVECTOR_X86
+            case Set::AVX512:
+            case Set::AVX:
+                boundBoxAVX(c, points, begin, end, stride, boxes[chunk]);
+                break;
+            case Set::SSE2:
+                boundBoxSSE2(c, points, begin, end, stride, boxes[chunk]);
+                break;
+#endif
+            default:
+                boundBoxScalar(c, points, begin, end, stride, boxes[chunk]);
+                break;
+        }
+    };
+
+    std::size_t chunks = forEachChunk(count, threads, func);
+
+    BoundBox3d box;
+    for (std::size_t i = 0; i < chunks; i++) {
+        box.Add(boxes[i]);
+    }
+    return box;
+}
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+
+#ifndef BASE_BULKVECTOR_H
+#define BASE_BULKVECTOR_H
+
+#include <cstddef>
+
+#include "BoundBox.h"
+#include "Matrix.h"
+#include "Vector3D.h"
+#ifndef FC_GLOBAL_H
+#include <FCGlobal.h>
+#endif
+
+
+namespace Base
+{
+
+/**
+ * The BulkVector class provides operations on large arrays of float vectors.
+ * The points are processed in blocks with the widest SIMD instruction set that the CPU supports,
+ * which is detected at runtime, and large arrays are split among several threads. Coordinates
+ * are transformed in double precision in the same order as Matrix4D::multVec() does, so all code
+ * paths give identical results.
+ *
+ * The vectors don't need to be contiguous: \a stride is the distance in bytes between two of them
+ * so that e.g. arrays of classes derived from Vector3f can be passed, too.
+ */
+class BaseExport BulkVector
+{
+public:
+    enum class InstructionSet
+    {
+        Scalar,
+        SSE2,
+        AVX,
+        AVX512
+    };
+
+    /// The widest instruction set of this CPU
+    static InstructionSet supported();
+    /// The instruction set used by the operations
+    static InstructionSet active();
+    /// Limits the used instruction set. It's clamped to the supported one.
+    static void setActive(InstructionSet set);
+    static const char* name(InstructionSet set);
+
+    /// Transforms \a count points with \a mat
+    static void transform(const Matrix4D& mat,
+                          Vector3f* points,
+                          std::size_t count,
+                          std::size_t stride = sizeof(Vector3f));
+    /// Computes the bounding box of \a count points
+    static BoundBox3f
+    boundBox(const Vector3f* points, std::size_t count, std::size_t stride = sizeof(Vector3f));
+    /// Computes the bounding box of \a count points transformed with \a mat
+    static BoundBox3d boundBox(const Matrix4D& mat,
+                               const Vector3f* points,
+                               std::size_t count,
+                               std::size_t stride = sizeof(Vector3f));
+};
+
+}  // namespace Base
+
+
+#endif  // BASE_BULKVECTOR_H
@@ -78,6 +78,9 @@
 #include <mutex>
 #include <bitset>
 #include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
 
 // streams
 #include <iostream>
@@ -134,8 +137,10 @@
 #include <QWriteLocker>
 #include <QReadLocker>
 #include <QReadWriteLock>
+#include <QThreadPool>
 #include <QTime>
 #include <QUuid>
+#include <QtConcurrentMap>
 
 
 #endif  //_PreComp_
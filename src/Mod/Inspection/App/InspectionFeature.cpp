@@ -23,15 +23,24 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
-#include <boost/core/ignore_unused.hpp>
-#include <numeric>
+#include <climits>
+#include <functional>
+#include <set>
+#include <unordered_map>
 
+#include <BRepBuilderAPI_Copy.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
 #include <BRepClass3d_SolidClassifier.hxx>
 #include <BRepExtrema_DistShapeShape.hxx>
 #include <BRepGProp_Face.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRep_Builder.hxx>
+#include <Precision.hxx>
+#include <Standard_Version.hxx>
 #include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
 #include <gp_Pnt.hxx>
 
 #include <QEventLoop>
@@ -45,9 +54,7 @@
 #include <Base/Sequencer.h>
 #include <Base/Stream.h>
 
-#include <Mod/Mesh/App/Core/Algorithm.h>
-#include <Mod/Mesh/App/Core/Grid.h>
-#include <Mod/Mesh/App/Core/Iterator.h>
+#include <Mod/Mesh/App/Core/BVH.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
 #include <Mod/Mesh/App/MeshFeature.h>
 #include <Mod/Part/App/PartFeature.h>
@@ -144,141 +151,33 @@ Base::Vector3f InspectActualShape::getPoint(unsigned long index) const
 
 // ----------------------------------------------------------------
 
-namespace Inspection
+namespace
 {
-class MeshInspectGrid: public MeshCore::MeshGrid
+/// Returns the distance of \a point to the nearest facet within \a maxDist. The distance is
+/// negative if the point is below the facet.
+float signedDistance(const MeshCore::MeshFacetBVH& bvh,
+                     const MeshCore::MeshKernel& mesh,
+                     bool apply,
+                     const Base::Matrix4D& trf,
+                     const Base::Vector3f& point,
+                     float maxDist)
 {
-public:
-    MeshInspectGrid(const MeshCore::MeshKernel& mesh, float fGridLen, const Base::Matrix4D& mat)
-        : MeshCore::MeshGrid(mesh)
-        , _transform(mat)
-    {
-        Base::BoundBox3f clBBMesh = _pclMesh->GetBoundBox().Transformed(mat);
-        Rebuild(std::max<unsigned long>((unsigned long)(clBBMesh.LengthX() / fGridLen), 1),
-                std::max<unsigned long>((unsigned long)(clBBMesh.LengthY() / fGridLen), 1),
-                std::max<unsigned long>((unsigned long)(clBBMesh.LengthZ() / fGridLen), 1));
-    }
-
-    void Validate(const MeshCore::MeshKernel& kernel) override
-    {
-        // do nothing
-        boost::ignore_unused(kernel);
-    }
-
-    void Validate()
-    {
-        // do nothing
-    }
-
-    bool Verify() const override
-    {
-        // do nothing
-        return true;
-    }
-
-protected:
-    void CalculateGridLength(int /*iCtGridPerAxis*/) override
-    {
-        // do nothing
+    Base::Vector3f res;
+    MeshCore::FacetIndex index {};
+    if (!bvh.NearestFacetToPoint(point, res, index, maxDist)) {
+        return FLT_MAX;
     }
 
-    unsigned long HasElements() const override
-    {
-        return _pclMesh->CountFacets();
-    }
-
-    void Pos(const Base::Vector3f& rclPoint,
-             unsigned long& rulX,
-             unsigned long& rulY,
-             unsigned long& rulZ) const
-    {
-        rulX = (unsigned long)((rclPoint.x - _fMinX) / _fGridLenX);
-        rulY = (unsigned long)((rclPoint.y - _fMinY) / _fGridLenY);
-        rulZ = (unsigned long)((rclPoint.z - _fMinZ) / _fGridLenZ);
-
-        assert((rulX < _ulCtGridsX) && (rulY < _ulCtGridsY) && (rulZ < _ulCtGridsZ));
+    MeshCore::MeshGeomFacet geomFace = mesh.GetFacet(index);
+    if (apply) {
+        geomFace.Transform(trf);
     }
 
-    void AddFacet(const MeshCore::MeshGeomFacet& rclFacet, unsigned long ulFacetIndex)
-    {
-        unsigned long ulX1;
-        unsigned long ulY1;
-        unsigned long ulZ1;
-        unsigned long ulX2;
-        unsigned long ulY2;
-        unsigned long ulZ2;
-
-        Base::BoundBox3f clBB;
-        clBB.Add(rclFacet._aclPoints[0]);
-        clBB.Add(rclFacet._aclPoints[1]);
-        clBB.Add(rclFacet._aclPoints[2]);
-
-        Pos(Base::Vector3f(clBB.MinX, clBB.MinY, clBB.MinZ), ulX1, ulY1, ulZ1);
-        Pos(Base::Vector3f(clBB.MaxX, clBB.MaxY, clBB.MaxZ), ulX2, ulY2, ulZ2);
-
-
-        if ((ulX1 < ulX2) || (ulY1 < ulY2) || (ulZ1 < ulZ2)) {
-            for (unsigned long ulX = ulX1; ulX <= ulX2; ulX++) {
-                for (unsigned long ulY = ulY1; ulY <= ulY2; ulY++) {
-                    for (unsigned long ulZ = ulZ1; ulZ <= ulZ2; ulZ++) {
-                        if (rclFacet.IntersectBoundingBox(GetBoundBox(ulX, ulY, ulZ))) {
-                            _aulGrid[ulX][ulY][ulZ].insert(ulFacetIndex);
-                        }
-                    }
-                }
-            }
-        }
-        else {
-            _aulGrid[ulX1][ulY1][ulZ1].insert(ulFacetIndex);
-        }
-    }
-
-    void InitGrid() override
-    {
-        unsigned long i, j;
-
-        Base::BoundBox3f clBBMesh = _pclMesh->GetBoundBox().Transformed(_transform);
-
-        float fLengthX = clBBMesh.LengthX();
-        float fLengthY = clBBMesh.LengthY();
-        float fLengthZ = clBBMesh.LengthZ();
-
-        _fGridLenX = (1.0f + fLengthX) / float(_ulCtGridsX);
-        _fMinX = clBBMesh.MinX - 0.5f;
-
-        _fGridLenY = (1.0f + fLengthY) / float(_ulCtGridsY);
-        _fMinY = clBBMesh.MinY - 0.5f;
-
-        _fGridLenZ = (1.0f + fLengthZ) / float(_ulCtGridsZ);
-        _fMinZ = clBBMesh.MinZ - 0.5f;
-
-        _aulGrid.clear();
-        _aulGrid.resize(_ulCtGridsX);
-        for (i = 0; i < _ulCtGridsX; i++) {
-            _aulGrid[i].resize(_ulCtGridsY);
-            for (j = 0; j < _ulCtGridsY; j++) {
-                _aulGrid[i][j].resize(_ulCtGridsZ);
-            }
-        }
-    }
-
-    void RebuildGrid() override
-    {
-        _ulCtElements = _pclMesh->CountFacets();
-        InitGrid();
-
-        unsigned long i = 0;
-        MeshCore::MeshFacetIterator clFIter(*_pclMesh);
-        clFIter.Transform(_transform);
-        for (clFIter.Init(); clFIter.More(); clFIter.Next()) {
-            AddFacet(*clFIter, i++);
-        }
-    }
-
-private:
-    Base::Matrix4D _transform;
-};
-}  // namespace Inspection
+    float fDist = Base::Distance(point, res);
+    bool positive = point.DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) > 0;
+    return positive ? fDist : -fDist;
+}
+}  // namespace
 
 InspectNominalMesh::InspectNominalMesh(const Mesh::MeshObject& rMesh, float offset)
     : _mesh(rMesh.getKernel())
@@ -287,30 +186,16 @@ InspectNominalMesh::InspectNominalMesh(const Mesh::MeshObject& rMesh, float offs
     _clTrf = rMesh.getTransform();
     _bApply = _clTrf != tmp;
 
-    // Max. limit of grid elements
-    float fMaxGridElements = 8000000.0f;
-    Base::BoundBox3f box = _mesh.GetBoundBox().Transformed(rMesh.getTransform());
-
-    // estimate the minimum allowed grid length
-    float fMinGridLen =
-        (float)pow((box.LengthX() * box.LengthY() * box.LengthZ() / fMaxGridElements), 0.3333f);
-    float fGridLen = 5.0f * MeshCore::MeshAlgorithm(_mesh).GetAverageEdgeLength();
-
-    // We want to avoid to get too small grid elements otherwise building up the grid structure
-    // would take too much time and memory. Having quite a dense grid speeds up more the following
-    // algorithms extremely. Due to the issue above it's always a compromise between speed and
-    // memory usage.
-    fGridLen = std::max<float>(fMinGridLen, fGridLen);
-
-    // build up grid structure to speed up algorithms
-    _pGrid = new MeshInspectGrid(_mesh, fGridLen, rMesh.getTransform());
-    _box = box;
+    // build up the hierarchy on the transformed facets to speed up the distance queries
+    _pBVH = new MeshCore::MeshFacetBVH();
+    _pBVH->Attach(_mesh, _clTrf);
+    _box = _pBVH->GetBoundBox();
     _box.Enlarge(offset);
 }
 
 InspectNominalMesh::~InspectNominalMesh()
 {
-    delete this->_pGrid;
+    delete this->_pBVH;
 }
 
 float InspectNominalMesh::getDistance(const Base::Vector3f& point) const
@@ -319,76 +204,34 @@ float InspectNominalMesh::getDistance(const Base::Vector3f& point) const
         return FLT_MAX;  // must be inside bbox
     }
 
-    std::vector<unsigned long> indices;
-    //_pGrid->GetElements(point, indices);
-    if (indices.empty()) {
-        std::set<unsigned long> inds;
-        _pGrid->MeshGrid::SearchNearestFromPoint(point, inds);
-        indices.insert(indices.begin(), inds.begin(), inds.end());
-    }
-
-    float fMinDist = FLT_MAX;
-    bool positive = true;
-    for (unsigned long it : indices) {
-        MeshCore::MeshGeomFacet geomFace = _mesh.GetFacet(it);
-        if (_bApply) {
-            geomFace.Transform(_clTrf);
-        }
-
-        float fDist = geomFace.DistanceToPoint(point);
-        if (fabs(fDist) < fabs(fMinDist)) {
-            fMinDist = fDist;
-            positive = point.DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) > 0;
-        }
-    }
-
-    if (!positive) {
-        fMinDist = -fMinDist;
-    }
-    return fMinDist;
+    return signedDistance(*_pBVH, _mesh, _bApply, _clTrf, point, FLT_MAX);
 }
 
 // ----------------------------------------------------------------
 
 InspectNominalFastMesh::InspectNominalFastMesh(const Mesh::MeshObject& rMesh, float offset)
     : _mesh(rMesh.getKernel())
+    , _offset(offset)
 {
-    const MeshCore::MeshKernel& kernel = rMesh.getKernel();
-
     Base::Matrix4D tmp;
     _clTrf = rMesh.getTransform();
     _bApply = _clTrf != tmp;
 
-    // Max. limit of grid elements
-    float fMaxGridElements = 8000000.0f;
-    Base::BoundBox3f box = kernel.GetBoundBox().Transformed(rMesh.getTransform());
-
-    // estimate the minimum allowed grid length
-    float fMinGridLen =
-        (float)pow((box.LengthX() * box.LengthY() * box.LengthZ() / fMaxGridElements), 0.3333f);
-    float fGridLen = 5.0f * MeshCore::MeshAlgorithm(kernel).GetAverageEdgeLength();
-
-    // We want to avoid to get too small grid elements otherwise building up the grid structure
-    // would take too much time and memory. Having quite a dense grid speeds up more the following
-    // algorithms extremely. Due to the issue above it's always a compromise between speed and
-    // memory usage.
-    fGridLen = std::max<float>(fMinGridLen, fGridLen);
-
-    // build up grid structure to speed up algorithms
-    _pGrid = new MeshInspectGrid(kernel, fGridLen, rMesh.getTransform());
-    _box = box;
+    // build up the hierarchy on the transformed facets to speed up the distance queries
+    _pBVH = new MeshCore::MeshFacetBVH();
+    _pBVH->Attach(_mesh, _clTrf);
+    _box = _pBVH->GetBoundBox();
     _box.Enlarge(offset);
-    max_level = (unsigned long)(offset / fGridLen);
 }
 
 InspectNominalFastMesh::~InspectNominalFastMesh()
 {
-    delete this->_pGrid;
+    delete this->_pBVH;
 }
 
 /**
- * This algorithm is not that exact as that from InspectNominalMesh but is by
- * factors faster and sufficient for many cases.
+ * In contrast to InspectNominalMesh only facets within the search radius are
+ * taken into account, so that points far away from the mesh are rejected early.
  */
 float InspectNominalFastMesh::getDistance(const Base::Vector3f& point) const
 {
@@ -396,42 +239,7 @@ float InspectNominalFastMesh::getDistance(const Base::Vector3f& point) const
         return FLT_MAX;  // must be inside bbox
     }
 
-    std::set<unsigned long> indices;
-#if 0  // a point in a neighbour grid can be nearer
-    std::vector<unsigned long> elements;
-    _pGrid->GetElements(point, elements);
-    indices.insert(elements.begin(), elements.end());
-#else
-    unsigned long ulX, ulY, ulZ;
-    _pGrid->Position(point, ulX, ulY, ulZ);
-    unsigned long ulLevel = 0;
-    while (indices.empty() && ulLevel <= max_level) {
-        _pGrid->GetHull(ulX, ulY, ulZ, ulLevel++, indices);
-    }
-    if (indices.empty() || ulLevel == 1) {
-        _pGrid->GetHull(ulX, ulY, ulZ, ulLevel, indices);
-    }
-#endif
-
-    float fMinDist = FLT_MAX;
-    bool positive = true;
-    for (unsigned long it : indices) {
-        MeshCore::MeshGeomFacet geomFace = _mesh.GetFacet(it);
-        if (_bApply) {
-            geomFace.Transform(_clTrf);
-        }
-
-        float fDist = geomFace.DistanceToPoint(point);
-        if (fabs(fDist) < fabs(fMinDist)) {
-            fMinDist = fDist;
-            positive = point.DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) > 0;
-        }
-    }
-
-    if (!positive) {
-        fMinDist = -fMinDist;
-    }
-    return fMinDist;
+    return signedDistance(*_pBVH, _mesh, _bApply, _clTrf, point, _offset);
 }
 
 // ----------------------------------------------------------------
@@ -471,39 +279,149 @@ float InspectNominalPoints::getDistance(const Base::Vector3f& point) const
 
 // ----------------------------------------------------------------
 
-InspectNominalShape::InspectNominalShape(const TopoDS_Shape& shape, float /*radius*/)
+InspectNominalShape::InspectNominalShape(const TopoDS_Shape& shape, float radius)
     : _rShape(shape)
+    , _radius(radius)
 {
-    distss = new BRepExtrema_DistShapeShape();
-    distss->LoadS1(_rShape);
-
-    // When having a solid then use its shell because otherwise the distance
-    // for inner points will always be zero
+    // When having a solid then only the distance to its faces is of interest because
+    // otherwise the distance for inner points will always be zero
     if (!_rShape.IsNull() && _rShape.ShapeType() == TopAbs_SOLID) {
         TopExp_Explorer xp;
         xp.Init(_rShape, TopAbs_SHELL);
         if (xp.More()) {
-            distss->LoadS1(xp.Current());
             isSolid = true;
         }
     }
-    // distss->SetDeflection(radius);
+
+    tessellate();
 }
 
 InspectNominalShape::~InspectNominalShape()
 {
-    delete distss;
+    delete _pBVH;
+    delete _pMesh;
+}
+
+void InspectNominalShape::tessellate()
+{
+    if (_rShape.IsNull()) {
+        return;
+    }
+
+    // Mesh a copy that shares the geometry, otherwise the triangulation that is shown for the
+    // nominal shape would be replaced
+    TopoDS_Shape shape = BRepBuilderAPI_Copy(_rShape, /*copyGeom*/ Standard_False).Shape();
+
+    // The tessellation deviates from the faces by at most the deflection. A finer one than the
+    // search radius is not needed because points near the faces are refined anyway.
+    Part::TopoShape topo(shape);
+    double deflection = std::min<double>(topo.getAccuracy(), _radius);
+    deflection = std::max<double>(deflection, Precision::Confusion());
+    BRepMesh_IncrementalMesh(shape,
+                             deflection,
+                             /*isRelative*/ Standard_False,
+                             /*theAngDeflection*/ 0.5,
+                             /*isInParallel*/ Standard_True);
+
+    std::vector<Data::ComplexGeoData::Domain> domains;
+    topo.getDomains(domains);
+
+    // the domains are in the order of the explored faces
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    TopExp_Explorer xp(shape, TopAbs_FACE);
+    for (const auto& domain : domains) {
+        auto offset = static_cast<MeshCore::PointIndex>(points.size());
+        for (const auto& pnt : domain.points) {
+            points.emplace_back(Base::toVector<float>(pnt));
+        }
+        for (const auto& facet : domain.facets) {
+            facets.emplace_back(offset + facet.I1, offset + facet.I2, offset + facet.I3);
+            _faceOfFacet.push_back(_faces.size());
+        }
+        _faces.push_back(xp.Current());
+        xp.Next();
+    }
+
+    if (facets.empty()) {
+        _faceOfFacet.clear();
+        _faces.clear();
+        return;
+    }
+
+    _pMesh = new MeshCore::MeshKernel();
+    _pMesh->Adopt(points, facets);
+    _pBVH = new MeshCore::MeshFacetBVH(*_pMesh);
+    _deflection = static_cast<float>(deflection);
 }
 
 float InspectNominalShape::getDistance(const Base::Vector3f& point) const
 {
     gp_Pnt pnt3d(point.x, point.y, point.z);
+    if (!_pBVH) {
+        // wires and vertexes
+        return getExactDistance(_rShape, pnt3d, true);
+    }
+
+    Base::Vector3f res;
+    MeshCore::FacetIndex index {};
+    if (!_pBVH->NearestFacetToPoint(point, res, index)) {
+        return FLT_MAX;
+    }
+
+    // The sign of the distance to the tessellation can only be trusted if the point is
+    // clearly off the surface and in front of or behind the nearest facet
+    float fDist = Base::Distance(point, res);
+    float fSide = (point - res) * _pMesh->GetFacet(index).GetNormal();
+    bool reliable = fDist > 2.0F * _deflection && std::fabs(fSide) >= 0.5F * fDist;
+    if (reliable && fDist > _radius + _deflection) {
+        return fSide < 0 ? -fDist : fDist;
+    }
+
+    // all faces that may contain the nearest point have a facet in this box
+    float range = fDist + 2.0F * _deflection;
+    Base::BoundBox3f box(point.x - range,
+                         point.y - range,
+                         point.z - range,
+                         point.x + range,
+                         point.y + range,
+                         point.z + range);
+    std::vector<MeshCore::FacetIndex> indices;
+    _pBVH->Inside(box, indices);
+
+    std::set<std::size_t> faces;
+    for (MeshCore::FacetIndex it : indices) {
+        faces.insert(_faceOfFacet[it]);
+    }
+
+    TopoDS_Compound comp;
+    BRep_Builder builder;
+    builder.MakeCompound(comp);
+    for (std::size_t it : faces) {
+        builder.Add(comp, _faces[it]);
+    }
+
+    // classifying the point is expensive, so avoid it if the sign is known already
+    float fMinDist = getExactDistance(comp, pnt3d, !reliable);
+    if (reliable && fSide < 0) {
+        fMinDist = -fMinDist;
+    }
+    return fMinDist;
+}
+
+float InspectNominalShape::getExactDistance(const TopoDS_Shape& shape,
+                                            const gp_Pnt& pnt3d,
+                                            bool withSign) const
+{
     BRepBuilderAPI_MakeVertex mkVert(pnt3d);
-    distss->LoadS2(mkVert.Vertex());
+    BRepExtrema_DistShapeShape distss(shape, mkVert.Vertex());
 
     float fMinDist = FLT_MAX;
-    if (distss->Perform() && distss->NbSolution() > 0) {
-        fMinDist = (float)distss->Value();
+    if (distss.IsDone() && distss.NbSolution() > 0) {
+        fMinDist = (float)distss.Value();
+        if (!withSign) {
+            return fMinDist;
+        }
         // the shape is a solid, check if the vertex is inside
         if (isSolid) {
             if (isInsideSolid(pnt3d)) {
@@ -512,7 +430,7 @@ float InspectNominalShape::getDistance(const Base::Vector3f& point) const
         }
         else if (fMinDist > 0) {
             // check if the distance was computed from a face
-            if (isBelowFace(pnt3d)) {
+            if (isBelowFace(distss, pnt3d)) {
                 fMinDist = -fMinDist;
             }
         }
@@ -528,15 +446,16 @@ bool InspectNominalShape::isInsideSolid(const gp_Pnt& pnt3d) const
     return (classifier.State() == TopAbs_IN);
 }
 
-bool InspectNominalShape::isBelowFace(const gp_Pnt& pnt3d) const
+bool InspectNominalShape::isBelowFace(const BRepExtrema_DistShapeShape& distss,
+                                      const gp_Pnt& pnt3d)
 {
     // check if the distance was computed from a face
-    for (Standard_Integer index = 1; index <= distss->NbSolution(); index++) {
-        if (distss->SupportTypeShape1(index) == BRepExtrema_IsInFace) {
-            TopoDS_Shape face = distss->SupportOnShape1(index);
+    for (Standard_Integer index = 1; index <= distss.NbSolution(); index++) {
+        if (distss.SupportTypeShape1(index) == BRepExtrema_IsInFace) {
+            TopoDS_Shape face = distss.SupportOnShape1(index);
             Standard_Real u, v;
-            distss->ParOnFaceS1(index, u, v);
-            // gp_Pnt pnt = distss->PointOnShape1(index);
+            distss.ParOnFaceS1(index, u, v);
+            // gp_Pnt pnt = distss.PointOnShape1(index);
             BRepGProp_Face props(TopoDS::Face(face));
             gp_Vec normal;
             gp_Pnt center;
@@ -758,11 +677,103 @@ public:
     int m_numv {0};
     double m_sumsq {0.0};
 };
+
+// Distances of the last run keyed by the inspected point. They stay valid as long as the
+// nominals and the search radius don't change.
+class DistanceCache
+{
+public:
+    struct PointHash
+    {
+        std::size_t operator()(const Base::Vector3f& pnt) const
+        {
+            // adding zero turns -0 into +0 so that equal points get equal hashes
+            std::size_t seed = std::hash<float> {}(pnt.x + 0.0F);
+            hashCombine(seed, pnt.y + 0.0F);
+            hashCombine(seed, pnt.z + 0.0F);
+            return seed;
+        }
+    };
+    struct PointEqual
+    {
+        bool operator()(const Base::Vector3f& pnt1, const Base::Vector3f& pnt2) const
+        {
+            // must be exact to be consistent with the hash
+            return pnt1.x == pnt2.x && pnt1.y == pnt2.y && pnt1.z == pnt2.z;
+        }
+    };
+    using Map = std::unordered_map<Base::Vector3f, float, PointHash, PointEqual>;
+
+    template<class T>
+    static void hashCombine(std::size_t& seed, const T& value)
+    {
+        // copied from boost::hash_combine
+        seed ^= std::hash<T> {}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+
+    /// Returns a value that changes whenever the geometry of one of the nominals changes
+    static std::size_t version(const std::vector<App::DocumentObject*>& nominals, double radius)
+    {
+        std::size_t seed = std::hash<double> {}(radius);
+        auto hashMatrix = [&seed](const Base::Matrix4D& mat) {
+            for (unsigned short i = 0; i < 4; i++) {
+                for (unsigned short j = 0; j < 4; j++) {
+                    hashCombine(seed, mat[i][j]);
+                }
+            }
+        };
+
+        for (auto it : nominals) {
+            hashCombine(seed, it);
+            if (it->isDerivedFrom<Mesh::Feature>()) {
+                const Mesh::MeshObject& mesh = static_cast<Mesh::Feature*>(it)->Mesh.getValue();
+                hashMatrix(mesh.getTransform());
+                for (const auto& pnt : mesh.getKernel().GetPoints()) {
+                    hashCombine(seed, pnt.x);
+                    hashCombine(seed, pnt.y);
+                    hashCombine(seed, pnt.z);
+                }
+                for (const auto& face : mesh.getKernel().GetFacets()) {
+                    hashCombine(seed, face._aulPoints[0]);
+                    hashCombine(seed, face._aulPoints[1]);
+                    hashCombine(seed, face._aulPoints[2]);
+                }
+            }
+            else if (it->isDerivedFrom<Points::Feature>()) {
+                const Points::PointKernel& kernel =
+                    static_cast<Points::Feature*>(it)->Points.getValue();
+                hashMatrix(kernel.getTransform());
+                for (const auto& pnt : kernel.getBasicPoints()) {
+                    hashCombine(seed, pnt.x);
+                    hashCombine(seed, pnt.y);
+                    hashCombine(seed, pnt.z);
+                }
+            }
+            else if (it->isDerivedFrom<Part::Feature>()) {
+                // a modified shape is always a new shape
+                const TopoDS_Shape& shape = static_cast<Part::Feature*>(it)->Shape.getValue();
+#if OCC_VERSION_HEX >= 0x070800
+                hashCombine(seed, std::hash<TopoDS_Shape> {}(shape));
+#else
+                hashCombine(seed, shape.HashCode(INT_MAX));
+#endif
+            }
+        }
+
+        return seed;
+    }
+
+    std::size_t nominalVersion {0};
+    Map distances;
+    /// the number of points that were not taken from the cache by the last run
+    unsigned long computed {0};
+};
 }  // namespace Inspection
 
 PROPERTY_SOURCE(Inspection::Feature, App::DocumentObject)
 
 Feature::Feature()
+    : cache(std::make_unique<DistanceCache>())
 {
     ADD_PROPERTY(SearchRadius, (0.05));
     ADD_PROPERTY(Thickness, (0.0));
@@ -792,8 +803,6 @@ short Feature::mustExecute() const
 
 App::DocumentObjectExecReturn* Feature::execute()
 {
-    bool useMultithreading = true;
-
     App::DocumentObject* pcActual = Actual.getValue();
     if (!pcActual) {
         throw Base::ValueError("No actual geometry to inspect specified");
@@ -809,7 +818,6 @@ App::DocumentObjectExecReturn* Feature::execute()
         actual = new InspectActualPoints(pts->Points.getValue());
     }
     else if (pcActual->isDerivedFrom<Part::Feature>()) {
-        useMultithreading = false;
         Part::Feature* part = static_cast<Part::Feature*>(pcActual);
         actual = new InspectActualShape(part->Shape.getShape());
     }
@@ -817,28 +825,51 @@ App::DocumentObjectExecReturn* Feature::execute()
         throw Base::TypeError("Unknown geometric type");
     }
 
-    // clang-format off
-    // get a list of nominals
-    std::vector<InspectNominalGeometry*> inspectNominal;
     const std::vector<App::DocumentObject*>& nominals = Nominals.getValues();
-    for (auto it : nominals) {
-        InspectNominalGeometry* nominal = nullptr;
-        if (it->isDerivedFrom<Mesh::Feature>()) {
-            Mesh::Feature* mesh = static_cast<Mesh::Feature*>(it);
-            nominal = new InspectNominalMesh(mesh->Mesh.getValue(), this->SearchRadius.getValue());
-        }
-        else if (it->isDerivedFrom<Points::Feature>()) {
-            Points::Feature* pts = static_cast<Points::Feature*>(it);
-            nominal = new InspectNominalPoints(pts->Points.getValue(), this->SearchRadius.getValue());
+    std::size_t version = DistanceCache::version(nominals, this->SearchRadius.getValue());
+    if (cache->nominalVersion != version) {
+        cache->nominalVersion = version;
+        cache->distances.clear();
+    }
+
+    // take the distances of the points that were inspected before from the cache
+    unsigned long count = actual->countPoints();
+    std::vector<Base::Vector3f> points(count);
+    std::vector<float> vals(count);
+    std::vector<unsigned long> indices;
+    for (unsigned long i = 0; i < count; i++) {
+        points[i] = actual->getPoint(i);
+        auto it = cache->distances.find(points[i]);
+        if (it != cache->distances.end()) {
+            vals[i] = it->second;
         }
-        else if (it->isDerivedFrom<Part::Feature>()) {
-            useMultithreading = false;
-            Part::Feature* part = static_cast<Part::Feature*>(it);
-            nominal = new InspectNominalShape(part->Shape.getValue(), this->SearchRadius.getValue());
+        else {
+            indices.push_back(i);
         }
+    }
 
-        if (nominal) {
-            inspectNominal.push_back(nominal);
+    // clang-format off
+    // get a list of nominals, it's not needed if all distances are known
+    std::vector<InspectNominalGeometry*> inspectNominal;
+    if (!indices.empty()) {
+        for (auto it : nominals) {
+            InspectNominalGeometry* nominal = nullptr;
+            if (it->isDerivedFrom<Mesh::Feature>()) {
+                Mesh::Feature* mesh = static_cast<Mesh::Feature*>(it);
+                nominal = new InspectNominalMesh(mesh->Mesh.getValue(), this->SearchRadius.getValue());
+            }
+            else if (it->isDerivedFrom<Points::Feature>()) {
+                Points::Feature* pts = static_cast<Points::Feature*>(it);
+                nominal = new InspectNominalPoints(pts->Points.getValue(), this->SearchRadius.getValue());
+            }
+            else if (it->isDerivedFrom<Part::Feature>()) {
+                Part::Feature* part = static_cast<Part::Feature*>(it);
+                nominal = new InspectNominalShape(part->Shape.getValue(), this->SearchRadius.getValue());
+            }
+
+            if (nominal) {
+                inspectNominal.push_back(nominal);
+            }
         }
     }
     // clang-format on
@@ -898,72 +929,60 @@ App::DocumentObjectExecReturn* Feature::execute()
     Base::Console().Message("RMS value for '%s' with search radius [%.4f,%.4f] is: %.4f\n",
         this->Label.getValue(), -this->SearchRadius.getValue(), this->SearchRadius.getValue(), fRMS);
 #else
-    unsigned long count = actual->countPoints();
-    std::vector<float> vals(count);
-    std::function<DistanceInspectionRMS(int)> fMap = [&](unsigned int index) {
-        DistanceInspectionRMS res;
-        Base::Vector3f pnt = actual->getPoint(index);
-
+    // compute the distances of the new or moved points only
+    std::function<void(unsigned long)> fMap = [&](unsigned long index) {
         float fMinDist = FLT_MAX;
         for (auto it : inspectNominal) {
-            float fDist = it->getDistance(pnt);
+            float fDist = it->getDistance(points[index]);
             if (fabs(fDist) < fabs(fMinDist)) {
                 fMinDist = fDist;
             }
         }
-
-        if (fMinDist > this->SearchRadius.getValue()) {
-            fMinDist = FLT_MAX;
-        }
-        else if (-fMinDist > this->SearchRadius.getValue()) {
-            fMinDist = -FLT_MAX;
-        }
-        else {
-            res.m_sumsq += fMinDist * fMinDist;
-            res.m_numv++;
-        }
-
         vals[index] = fMinDist;
-        return res;
     };
 
-    DistanceInspectionRMS res;
-
-    if (useMultithreading) {
-        // Build vector of increasing indices
-        std::vector<unsigned long> index(count);
-        std::iota(index.begin(), index.end(), 0);
-        // Perform map-reduce operation : compute distances and update sum of squares for RMS
-        // computation
-        QFuture<DistanceInspectionRMS> future =
-            QtConcurrent::mappedReduced(index, fMap, &DistanceInspectionRMS::operator+=);
+    if (!indices.empty()) {
+        // The nominals are thread-safe, so check the points in parallel
+        QFuture<void> future = QtConcurrent::map(indices, fMap);
         // Setup progress bar
-        Base::FutureWatcherProgress progress("Inspecting...", actual->countPoints());
-        QFutureWatcher<DistanceInspectionRMS> watcher;
+        Base::FutureWatcherProgress progress("Inspecting...",
+                                             static_cast<unsigned int>(indices.size()));
+        QFutureWatcher<void> watcher;
         QObject::connect(&watcher,
-                         &QFutureWatcher<DistanceInspectionRMS>::progressValueChanged,
+                         &QFutureWatcher<void>::progressValueChanged,
                          &progress,
                          &Base::FutureWatcherProgress::progressValueChanged);
         // Keep UI responsive during computation
         QEventLoop loop;
-        QObject::connect(&watcher,
-                         &QFutureWatcher<DistanceInspectionRMS>::finished,
-                         &loop,
-                         &QEventLoop::quit);
+        QObject::connect(&watcher, &QFutureWatcher<void>::finished, &loop, &QEventLoop::quit);
         watcher.setFuture(future);
         loop.exec();
-        res = future.result();
+        // the loop returns at once if there is no application object
+        future.waitForFinished();
     }
-    else {
-        // Single-threaded operation
-        std::stringstream str;
-        str << "Inspecting " << this->Label.getValue() << "...";
-        Base::SequencerLauncher seq(str.str().c_str(), count);
+    cache->computed = static_cast<unsigned long>(indices.size());
 
-        for (unsigned int i = 0; i < count; i++) {
-            res += fMap(i);
+    // Update the cache with the points of this run and clip the distances to the search radius.
+    // Points that are gone are dropped from the cache.
+    DistanceInspectionRMS res;
+    DistanceCache::Map distances;
+    distances.reserve(count);
+    for (unsigned long i = 0; i < count; i++) {
+        float fMinDist = vals[i];
+        distances.emplace(points[i], fMinDist);
+        if (fMinDist > this->SearchRadius.getValue()) {
+            fMinDist = FLT_MAX;
+        }
+        else if (-fMinDist > this->SearchRadius.getValue()) {
+            fMinDist = -FLT_MAX;
+        }
+        else {
+            res.m_sumsq += fMinDist * fMinDist;
+            res.m_numv++;
         }
+        vals[i] = fMinDist;
     }
+    cache->distances.swap(distances);
 
     Base::Console().Message("RMS value for '%s' with search radius [%.4f,%.4f] is: %.4f\n",
                             this->Label.getValue(),
@@ -981,6 +1000,11 @@ App::DocumentObjectExecReturn* Feature::execute()
     return nullptr;
 }
 
+unsigned long Feature::countComputedPoints() const
+{
+    return cache->computed;
+}
+
 // ----------------------------------------------------------------
 
 PROPERTY_SOURCE(Inspection::Group, App::DocumentObjectGroup)
@@ -23,6 +23,8 @@
 #ifndef INSPECTION_FEATURE_H
 #define INSPECTION_FEATURE_H
 
+#include <memory>
+
 #include <App/DocumentObject.h>
 #include <App/DocumentObjectGroup.h>
 
@@ -37,7 +39,7 @@ class gp_Pnt;
 namespace MeshCore
 {
 class MeshKernel;
-class MeshGrid;
+class MeshFacetBVH;
 }  // namespace MeshCore
 
 namespace Mesh
@@ -125,7 +127,7 @@ public:
 
 private:
     const MeshCore::MeshKernel& _mesh;
-    MeshCore::MeshGrid* _pGrid;
+    MeshCore::MeshFacetBVH* _pBVH;
     Base::BoundBox3f _box;
     bool _bApply;
     Base::Matrix4D _clTrf;
@@ -140,9 +142,9 @@ public:
 
 protected:
     const MeshCore::MeshKernel& _mesh;
-    MeshCore::MeshGrid* _pGrid;
+    MeshCore::MeshFacetBVH* _pBVH;
     Base::BoundBox3f _box;
-    unsigned long max_level;
+    float _offset;
     bool _bApply;
     Base::Matrix4D _clTrf;
 };
@@ -159,6 +161,10 @@ private:
     Points::PointsGrid* _pGrid;
 };
 
+/** Computes the distance to a shape in two passes. The faces are tessellated and the distance
+ * to the tessellation is used to skip points that are clearly outside the search radius. Only
+ * for the remaining points the exact distance is computed, and only to the faces next to them.
+ */
 class InspectionExport InspectNominalShape: public InspectNominalGeometry
 {
 public:
@@ -167,12 +173,20 @@ public:
     float getDistance(const Base::Vector3f&) const override;
 
 private:
+    void tessellate();
+    float getExactDistance(const TopoDS_Shape&, const gp_Pnt&, bool withSign) const;
     bool isInsideSolid(const gp_Pnt&) const;
-    bool isBelowFace(const gp_Pnt&) const;
+    static bool isBelowFace(const BRepExtrema_DistShapeShape&, const gp_Pnt&);
 
 private:
-    BRepExtrema_DistShapeShape* distss;
     const TopoDS_Shape& _rShape;
+    float _radius;
+    float _deflection {0.0F};
+    MeshCore::MeshKernel* _pMesh {nullptr};
+    MeshCore::MeshFacetBVH* _pBVH {nullptr};
+    /// the index into _faces for each facet of the tessellation
+    std::vector<std::size_t> _faceOfFacet;
+    std::vector<TopoDS_Shape> _faces;
     bool isSolid {false};
 };
 
@@ -236,7 +250,11 @@ private:
 
 // ----------------------------------------------------------------
 
+class DistanceCache;
+
 /** The inspection feature.
+ * The distances of a run are cached by point, so that re-running it after the actual geometry
+ * was only partly changed computes the distances for the new or moved points only.
  * \author Werner Mayer
  */
 class InspectionExport Feature: public App::DocumentObject
@@ -262,6 +280,8 @@ public:
     short mustExecute() const override;
     /// recalculate the Feature
     App::DocumentObjectExecReturn* execute() override;
+    /// returns the number of points whose distances were computed by the last recalculation
+    unsigned long countComputedPoints() const;
     //@}
 
     /// returns the type name of the ViewProvider
@@ -269,6 +289,9 @@ public:
     {
         return "InspectionGui::ViewProviderInspection";
     }
+
+private:
+    std::unique_ptr<DistanceCache> cache;
 };
 
 class InspectionExport Group: public App::DocumentObjectGroup
@@ -35,20 +35,27 @@
 #ifdef _PreComp_
 
 // STL
-#include <numeric>
+#include <climits>
+#include <functional>
+#include <set>
+#include <unordered_map>
 
 // OCC
+#include <BRepBuilderAPI_Copy.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
 #include <BRepClass3d_SolidClassifier.hxx>
 #include <BRepExtrema_DistShapeShape.hxx>
 #include <BRepGProp_Face.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRep_Builder.hxx>
+#include <Precision.hxx>
+#include <Standard_Version.hxx>
 #include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
 #include <gp_Pnt.hxx>
 
-// boost
-#include <boost/core/ignore_unused.hpp>
-
 // Qt
 #include <QEventLoop>
 #include <QFuture>
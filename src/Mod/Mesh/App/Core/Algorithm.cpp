@@ -24,6 +24,8 @@
 
 #ifndef _PreComp_
 #include <algorithm>
+#include <future>
+#include <thread>
 #endif
 
 #include <Base/Console.h>
@@ -31,6 +33,7 @@
 
 #include "Algorithm.h"
 #include "Approximation.h"
+#include "BVH.h"
 #include "Elements.h"
 #include "Grid.h"
 #include "Iterator.h"
@@ -206,6 +209,15 @@ bool MeshAlgorithm::NearestFacetOnRay(const Base::Vector3f& rclPt,
     return bSol;
 }
 
+bool MeshAlgorithm::NearestFacetOnRay(const Base::Vector3f& rclPt,
+                                      const Base::Vector3f& rclDir,
+                                      const MeshFacetBVH& rclBVH,
+                                      Base::Vector3f& rclRes,
+                                      FacetIndex& rulFacet) const
+{
+    return rclBVH.NearestFacetOnRay(rclPt, rclDir, rclRes, rulFacet);
+}
+
 bool MeshAlgorithm::RayNearestField(const Base::Vector3f& rclPt,
                                     const Base::Vector3f& rclDir,
                                     const std::vector<FacetIndex>& raulFacets,
@@ -1516,6 +1528,14 @@ bool MeshAlgorithm::NearestPointFromPoint(const Base::Vector3f& rclPt,
     return true;
 }
 
+bool MeshAlgorithm::NearestPointFromPoint(const Base::Vector3f& rclPt,
+                                          const MeshFacetBVH& rclBVH,
+                                          FacetIndex& rclResFacetIndex,
+                                          Base::Vector3f& rclResPoint) const
+{
+    return rclBVH.NearestFacetToPoint(rclPt, rclResPoint, rclResFacetIndex);
+}
+
 bool MeshAlgorithm::CutWithPlane(const Base::Vector3f& clBase,
                                  const Base::Vector3f& clNormal,
                                  const MeshFacetGrid& rclGrid,
@@ -1538,11 +1558,21 @@ bool MeshAlgorithm::CutWithPlane(const Base::Vector3f& clBase,
     std::sort(aulFacets.begin(), aulFacets.end());
     aulFacets.erase(std::unique(aulFacets.begin(), aulFacets.end()), aulFacets.end());
 
+    return CutWithPlane(clBase, clNormal, aulFacets, rclResult, fMinEps, bConnectPolygons);
+}
+
+bool MeshAlgorithm::CutWithPlane(const Base::Vector3f& clBase,
+                                 const Base::Vector3f& clNormal,
+                                 const std::vector<FacetIndex>& raulFacets,
+                                 std::list<std::vector<Base::Vector3f>>& rclResult,
+                                 float fMinEps,
+                                 bool bConnectPolygons) const
+{
     // intersect all facets with plane
     std::list<std::pair<Base::Vector3f, Base::Vector3f>>
         clTempPoly;  // Field with intersection lines (unsorted, not chained)
 
-    for (FacetIndex facetIndex : aulFacets) {
+    for (FacetIndex facetIndex : raulFacets) {
         Base::Vector3f clE1, clE2;
         const MeshGeomFacet clF(_rclMesh.GetFacet(facetIndex));
 
@@ -2166,3 +2196,146 @@ const Base::Vector3f& MeshRefNormalToPoints::operator[](PointIndex pos) const
 {
     return _norm[pos];
 }
+
+// ----------------------------------------------------------------------------
+
+MeshSlicer::MeshSlicer(const MeshKernel& rclM, const Base::Vector3f& rclNormal)
+    : _rclMesh(rclM)
+    , _normal(rclNormal)
+{
+    Rebuild();
+}
+
+void MeshSlicer::Rebuild()
+{
+    _extents.clear();
+    _slabs.clear();
+
+    const MeshPointArray& points = _rclMesh.GetPoints();
+    const MeshFacetArray& facets = _rclMesh.GetFacets();
+    if (facets.empty()) {
+        return;
+    }
+
+    // the extent of all facets along the normal
+    std::vector<float> dist(points.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        dist[i] = _normal * points[i];
+    }
+
+    _extents.reserve(facets.size());
+    float fMin = FLOAT_MAX;
+    float fMax = -FLOAT_MAX;
+    double fSumExtent = 0.0;
+    for (const auto& facet : facets) {
+        float d0 = dist[facet._aulPoints[0]];
+        float d1 = dist[facet._aulPoints[1]];
+        float d2 = dist[facet._aulPoints[2]];
+        float fFirst = std::min<float>({d0, d1, d2});
+        float fLast = std::max<float>({d0, d1, d2});
+        _extents.emplace_back(fFirst, fLast);
+        fMin = std::min<float>(fMin, fFirst);
+        fMax = std::max<float>(fMax, fLast);
+        fSumExtent += fLast - fFirst;
+    }
+
+    // make sure that no facet touching a plane gets lost by rounding errors
+    float fRange = fMax - fMin;
+    _fEps = 1.0e-4F * _normal.Length() + 1.0e-6F * fRange;
+    _fMin = fMin - _fEps;
+    fRange += 2.0F * _fEps;
+
+    // choose the slab width not smaller than the average extent of a facet so that
+    // a facet overlaps only few slabs
+    std::size_t numFacets = facets.size();
+    float fAvgExtent = static_cast<float>(fSumExtent / numFacets);
+    std::size_t numSlabs = 1;
+    if (fAvgExtent > 0.0F) {
+        numSlabs = std::min<std::size_t>(numFacets, std::size_t(fRange / fAvgExtent) + 1);
+    }
+    _fSlabWidth = std::max<float>(fRange / numSlabs, FLOAT_EPS);
+    _slabs.resize(numSlabs);
+
+    auto slabIndex = [this, numSlabs](float d) {
+        float index = (d - _fMin) / _fSlabWidth;
+        if (index <= 0.0F) {
+            return std::size_t(0);
+        }
+        return std::min<std::size_t>(numSlabs - 1, std::size_t(index));
+    };
+
+    for (std::size_t i = 0; i < numFacets; i++) {
+        std::size_t first = slabIndex(_extents[i].first - _fEps);
+        std::size_t last = slabIndex(_extents[i].second + _fEps);
+        for (std::size_t j = first; j <= last; j++) {
+            _slabs[j].push_back(i);
+        }
+    }
+}
+
+void MeshSlicer::GetFacetsFromPlane(const Base::Vector3f& rclBase,
+                                    std::vector<FacetIndex>& rclRes) const
+{
+    if (_slabs.empty()) {
+        return;
+    }
+
+    float fDist = _normal * rclBase;
+    float fIndex = (fDist - _fMin) / _fSlabWidth;
+    if (fIndex < 0.0F || fIndex >= float(_slabs.size())) {
+        return;
+    }
+
+    // the slabs are filled in ascending order of the facet indices
+    for (FacetIndex index : _slabs[std::size_t(fIndex)]) {
+        const auto& extent = _extents[index];
+        if (extent.first - _fEps <= fDist && fDist <= extent.second + _fEps) {
+            rclRes.push_back(index);
+        }
+    }
+}
+
+bool MeshSlicer::CutWithPlane(const Base::Vector3f& rclBase,
+                              TPolylines& rclResult,
+                              float fMinEps,
+                              bool bConnectPolygons) const
+{
+    std::vector<FacetIndex> facets;
+    GetFacetsFromPlane(rclBase, facets);
+
+    MeshAlgorithm algo(_rclMesh);
+    return algo.CutWithPlane(rclBase, _normal, facets, rclResult, fMinEps, bConnectPolygons);
+}
+
+std::vector<MeshSlicer::TPolylines> MeshSlicer::CutWithPlanes(
+    const std::vector<Base::Vector3f>& rclBases,
+    float fMinEps,
+    bool bConnectPolygons) const
+{
+    std::size_t numPlanes = rclBases.size();
+    std::vector<TPolylines> result(numPlanes);
+
+    std::size_t threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    threads = std::min<std::size_t>(threads, numPlanes);
+    if (threads <= 1) {
+        for (std::size_t i = 0; i < numPlanes; i++) {
+            CutWithPlane(rclBases[i], result[i], fMinEps, bConnectPolygons);
+        }
+        return result;
+    }
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(threads);
+    for (std::size_t t = 0; t < threads; t++) {
+        futures.push_back(std::async(std::launch::async, [&, t]() {
+            for (std::size_t i = t; i < numPlanes; i += threads) {
+                CutWithPlane(rclBases[i], result[i], fMinEps, bConnectPolygons);
+            }
+        }));
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    return result;
+}
@@ -46,6 +46,7 @@ class MeshGeomFacet;
 class MeshGeomEdge;
 class MeshKernel;
 class MeshFacetGrid;
+class MeshFacetBVH;
 class MeshFacetArray;
 class MeshRefPointToFacets;
 class AbstractPolygonTriangulator;
@@ -125,6 +126,18 @@ public:
                            const MeshFacetGrid& rclGrid,
                            Base::Vector3f& rclRes,
                            FacetIndex& rulFacet) const;
+    /**
+     * Searches for the nearest facet to the ray defined by (\a rclPt, \a rclDir).
+     * The point \a rclRes holds the intersection point with the ray and the
+     * nearest facet with index \a rulFacet.
+     * \note This method uses a bounding volume hierarchy that in contrast to a grid
+     * copes well with meshes of uneven facet density.
+     */
+    bool NearestFacetOnRay(const Base::Vector3f& rclPt,
+                           const Base::Vector3f& rclDir,
+                           const MeshFacetBVH& rclBVH,
+                           Base::Vector3f& rclRes,
+                           FacetIndex& rulFacet) const;
     /**
      * Searches for the first facet of the grid element (\a rGrid) in that the point \a rPt lies
      * into which is a distance not higher than \a fMaxDistance. Of no such facet is found \a
@@ -356,6 +369,10 @@ public:
                                float fMaxSearchArea,
                                FacetIndex& rclResFacetIndex,
                                Base::Vector3f& rclResPoint) const;
+    bool NearestPointFromPoint(const Base::Vector3f& rclPt,
+                               const MeshFacetBVH& rclBVH,
+                               FacetIndex& rclResFacetIndex,
+                               Base::Vector3f& rclResPoint) const;
     /** Cuts the mesh with a plane. The result is a list of polylines. */
     bool CutWithPlane(const Base::Vector3f& clBase,
                       const Base::Vector3f& clNormal,
@@ -363,6 +380,15 @@ public:
                       std::list<std::vector<Base::Vector3f>>& rclResult,
                       float fMinEps = 1.0e-2F,
                       bool bConnectPolygons = false) const;
+    /** Cuts the facets \a raulFacets with a plane. The indices must be sorted and unique.
+     * The result is a list of polylines.
+     */
+    bool CutWithPlane(const Base::Vector3f& clBase,
+                      const Base::Vector3f& clNormal,
+                      const std::vector<FacetIndex>& raulFacets,
+                      std::list<std::vector<Base::Vector3f>>& rclResult,
+                      float fMinEps = 1.0e-2F,
+                      bool bConnectPolygons = false) const;
     /**
      * Gets all facets that cut the plane (N,d) and that lie between the two points left and right.
      * The plane is defined by it normalized normal and the signed distance to the origin.
@@ -610,6 +636,54 @@ private:
     std::map<MeshEdge, MeshFacetPair, EdgeOrder> _map;
 };
 
+/**
+ * The MeshSlicer class cuts a mesh with parallel planes. The extent of each facet
+ * along the plane normal is computed once and the facets are sorted into slabs
+ * along the normal, so that a plane only visits the facets it may cut instead of
+ * searching a grid. Several planes are cut in parallel.
+ * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
+ * be rebuilt.
+ */
+class MeshExport MeshSlicer
+{
+public:
+    using TPolylines = std::list<std::vector<Base::Vector3f>>;
+
+    /// Construction
+    MeshSlicer(const MeshKernel& rclM, const Base::Vector3f& rclNormal);
+
+    /// Rebuilds up data structure
+    void Rebuild();
+    const Base::Vector3f& GetNormal() const
+    {
+        return _normal;
+    }
+    /** Cuts the mesh with the plane through \a rclBase. */
+    bool CutWithPlane(const Base::Vector3f& rclBase,
+                      TPolylines& rclResult,
+                      float fMinEps = 1.0e-2F,
+                      bool bConnectPolygons = false) const;
+    /** Cuts the mesh with the planes through \a rclBases using several threads.
+     * The i-th entry of the result belongs to the i-th plane.
+     */
+    std::vector<TPolylines> CutWithPlanes(const std::vector<Base::Vector3f>& rclBases,
+                                          float fMinEps = 1.0e-2F,
+                                          bool bConnectPolygons = false) const;
+    /** Gets the sorted indices of all facets that may cut the plane through \a rclBase. */
+    void GetFacetsFromPlane(const Base::Vector3f& rclBase, std::vector<FacetIndex>& rclRes) const;
+
+private:
+    const MeshKernel& _rclMesh; /**< The mesh kernel. */
+    Base::Vector3f _normal;
+    float _fMin {0.0F};
+    float _fSlabWidth {1.0F};
+    float _fEps {0.0F};
+    /// Extent of each facet along the normal
+    std::vector<std::pair<float, float>> _extents;
+    /// Sorted indices of the facets overlapping each slab
+    std::vector<std::vector<FacetIndex>> _slabs;
+};
+
 /**
  * The MeshRefNormalToPoints builds up a structure to have access to the normal of a vertex.
  * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
@@ -146,29 +146,36 @@ float PlaneFit::Fit()
         return FLOAT_MAX;
     }
 
-    double sxx {0.0};
-    double sxy {0.0};
-    double sxz {0.0};
-    double syy {0.0};
-    double syz {0.0};
-    double szz {0.0};
-    double mx {0.0};
-    double my {0.0};
-    double mz {0.0};
-
-    for (const auto& vPoint : _vPoints) {
-        sxx += double(vPoint.x * vPoint.x);
-        sxy += double(vPoint.x * vPoint.y);
-        sxz += double(vPoint.x * vPoint.z);
-        syy += double(vPoint.y * vPoint.y);
-        syz += double(vPoint.y * vPoint.z);
-        szz += double(vPoint.z * vPoint.z);
-        mx += double(vPoint.x);
-        my += double(vPoint.y);
-        mz += double(vPoint.z);
-    }
-
+    // When growing a region point by point only the new points must be added to the sums
     size_t nSize = _vPoints.size();
+    if (_moments.count > nSize) {
+        _moments = Moments();
+    }
+    auto it = std::prev(_vPoints.end(), std::ptrdiff_t(nSize - _moments.count));
+    for (; it != _vPoints.end(); ++it) {
+        const Base::Vector3f& vPoint = *it;
+        _moments.sxx += double(vPoint.x * vPoint.x);
+        _moments.sxy += double(vPoint.x * vPoint.y);
+        _moments.sxz += double(vPoint.x * vPoint.z);
+        _moments.syy += double(vPoint.y * vPoint.y);
+        _moments.syz += double(vPoint.y * vPoint.z);
+        _moments.szz += double(vPoint.z * vPoint.z);
+        _moments.mx += double(vPoint.x);
+        _moments.my += double(vPoint.y);
+        _moments.mz += double(vPoint.z);
+    }
+    _moments.count = nSize;
+
+    double sxx = _moments.sxx;
+    double sxy = _moments.sxy;
+    double sxz = _moments.sxz;
+    double syy = _moments.syy;
+    double syz = _moments.syz;
+    double szz = _moments.szz;
+    double mx = _moments.mx;
+    double my = _moments.my;
+    double mz = _moments.mz;
+
     sxx = sxx - mx * mx / (double(nSize));
     sxy = sxy - mx * my / (double(nSize));
     sxz = sxz - mx * mz / (double(nSize));
@@ -394,6 +401,12 @@ float PlaneFit::GetSignedStdDeviation() const
     return fFactor * sqrt((ulPtCt / (ulPtCt - 3.0F)) * ((1.0F / ulPtCt) * fSumXi2 - fMean * fMean));
 }
 
+void PlaneFit::Clear()
+{
+    Approximation::Clear();
+    _moments = Moments();
+}
+
 void PlaneFit::ProjectToPlane()
 {
     Base::Vector3f cGravity(GetGravity());
@@ -403,6 +416,7 @@ void PlaneFit::ProjectToPlane()
         float fD = (cPnt - cGravity) * cNormal;
         cPnt = cPnt - fD * cNormal;
     }
+    _moments = Moments();
 }
 
 void PlaneFit::Dimension(float& length, float& width) const
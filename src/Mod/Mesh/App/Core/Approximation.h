@@ -170,7 +170,7 @@ public:
     /**
      * Deletes the inserted points and frees any allocated resources.
      */
-    void Clear();
+    virtual void Clear();
     /**
      * Returns the result of the last fit.
      * @return float Quality of the last fit.
@@ -227,6 +227,10 @@ public:
      * to succeed. If the fit fails FLOAT_MAX is returned.
      */
     float Fit() override;
+    /**
+     * Deletes the inserted points and the sums of the last fit.
+     */
+    void Clear() override;
     /**
      * Returns the distance from the point \a rcPoint to the fitted plane. If Fit() has not been
      * called FLOAT_MAX is returned.
@@ -270,6 +274,20 @@ protected:
     Base::Vector3f _vDirV;
     Base::Vector3f _vDirW; /**< Normal of the plane. */
     // NOLINTEND
+
+private:
+    /**
+     * Sums of the coordinates and their products of the first \a count points. Fit() only adds
+     * the points that have been added since the last fit.
+     */
+    struct Moments
+    {
+        double sxx {0.0}, sxy {0.0}, sxz {0.0};
+        double syy {0.0}, syz {0.0}, szz {0.0};
+        double mx {0.0}, my {0.0}, mz {0.0};
+        std::size_t count {0};
+    };
+    Moments _moments;
 };
 
 // -------------------------------------------------------------------------------
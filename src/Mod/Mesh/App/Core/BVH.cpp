@@ -0,0 +1,728 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <cmath>
+#include <future>
+#endif
+
+#include "BVH.h"
+#include "Functional.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+constexpr std::uint32_t MaxLeafSize = 8;
+constexpr int NumBins = 16;
+constexpr std::uint32_t ParallelBuildSize = 50000;
+constexpr int MaxStackSize = 64;
+/// the traversal stacks hold at most one entry more than the depth of the tree
+constexpr int MaxDepth = MaxStackSize - 1;
+
+/// the number of levels needed to split \a count triangles at the median into leaves
+int medianDepth(std::uint32_t count)
+{
+    int levels = 0;
+    while (count > MaxLeafSize) {
+        count = (count + 1) / 2;
+        levels++;
+    }
+    return levels;
+}
+
+float surfaceArea(const Base::BoundBox3f& box)
+{
+    float dx = box.LengthX();
+    float dy = box.LengthY();
+    float dz = box.LengthZ();
+    return 2.0F * (dx * dy + dy * dz + dz * dx);
+}
+
+float distanceToBox2(const Base::Vector3f& pnt,
+                     const std::array<float, 3>& min,
+                     const std::array<float, 3>& max)
+{
+    float dx = std::max({min[0] - pnt.x, 0.0F, pnt.x - max[0]});
+    float dy = std::max({min[1] - pnt.y, 0.0F, pnt.y - max[1]});
+    float dz = std::max({min[2] - pnt.z, 0.0F, pnt.z - max[2]});
+    return dx * dx + dy * dy + dz * dz;
+}
+
+/**
+ * Returns the entry distance of the ray into the box or FLOAT_MAX if the box isn't hit
+ * before \a maxDist.
+ */
+float intersectBox(const Base::Vector3f& org,
+                   const Base::Vector3f& inv,
+                   const std::array<float, 3>& min,
+                   const std::array<float, 3>& max,
+                   float maxDist)
+{
+    // if the ray lies in a face of the box the slab distances are 0 * inf = NaN, keep
+    // them as second argument of std::max and std::min so that they are ignored
+    float tmin = -FLOAT_MAX;
+    float tmax = FLOAT_MAX;
+    float t1 = (min[0] - org.x) * inv.x;
+    float t2 = (max[0] - org.x) * inv.x;
+    tmin = std::max(tmin, std::min(t1, t2));
+    tmax = std::min(tmax, std::max(t1, t2));
+    t1 = (min[1] - org.y) * inv.y;
+    t2 = (max[1] - org.y) * inv.y;
+    tmin = std::max(tmin, std::min(t1, t2));
+    tmax = std::min(tmax, std::max(t1, t2));
+    t1 = (min[2] - org.z) * inv.z;
+    t2 = (max[2] - org.z) * inv.z;
+    tmin = std::max(tmin, std::min(t1, t2));
+    tmax = std::min(tmax, std::max(t1, t2));
+    if (tmax >= std::max(tmin, 0.0F) && tmin < maxDist) {
+        return tmin;
+    }
+    return FLOAT_MAX;
+}
+
+/**
+ * Returns the point of the triangle (a, a + ab, a + ac) nearest to \a p.
+ * See Ericson, Real-Time Collision Detection, 5.1.5
+ */
+Base::Vector3f closestPointOnTriangle(const Base::Vector3f& p,
+                                      const Base::Vector3f& a,
+                                      const Base::Vector3f& ab,
+                                      const Base::Vector3f& ac)
+{
+    Base::Vector3f ap = p - a;
+    float d1 = ab * ap;
+    float d2 = ac * ap;
+    if (d1 <= 0.0F && d2 <= 0.0F) {
+        return a;
+    }
+
+    Base::Vector3f bp = ap - ab;
+    float d3 = ab * bp;
+    float d4 = ac * bp;
+    if (d3 >= 0.0F && d4 <= d3) {
+        return a + ab;
+    }
+
+    float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0F && d1 >= 0.0F && d3 <= 0.0F) {
+        float v = d1 / (d1 - d3);
+        return a + v * ab;
+    }
+
+    Base::Vector3f cp = ap - ac;
+    float d5 = ab * cp;
+    float d6 = ac * cp;
+    if (d6 >= 0.0F && d5 <= d6) {
+        return a + ac;
+    }
+
+    float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0F && d2 >= 0.0F && d6 <= 0.0F) {
+        float w = d2 / (d2 - d6);
+        return a + w * ac;
+    }
+
+    float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0F && (d4 - d3) >= 0.0F && (d5 - d6) >= 0.0F) {
+        float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+        return a + ab + w * (ac - ab);
+    }
+
+    float denom = 1.0F / (va + vb + vc);
+    float v = vb * denom;
+    float w = vc * denom;
+    return a + v * ab + w * ac;
+}
+}  // namespace
+
+struct MeshFacetBVH::Builder
+{
+    std::vector<Base::BoundBox3f> boxes;
+    std::vector<Base::Vector3f> centers;
+    std::vector<std::uint32_t> order;
+};
+
+MeshFacetBVH::MeshFacetBVH(const MeshKernel& rclM)
+{
+    Attach(rclM);
+}
+
+void MeshFacetBVH::Clear()
+{
+    _nodes.clear();
+    _facets.clear();
+    for (int i = 0; i < 3; i++) {
+        _base[i].clear();
+        _edge1[i].clear();
+        _edge2[i].clear();
+    }
+}
+
+void MeshFacetBVH::Attach(const MeshKernel& rclM)
+{
+    Build(rclM.GetFacets(), rclM.GetPoints());
+}
+
+void MeshFacetBVH::Attach(const MeshKernel& rclM, const Base::Matrix4D& rclMat)
+{
+    if (rclMat == Base::Matrix4D()) {
+        Build(rclM.GetFacets(), rclM.GetPoints());
+        return;
+    }
+
+    MeshPointArray points(rclM.GetPoints());
+    points.Transform(rclMat);
+    Build(rclM.GetFacets(), points);
+}
+
+void MeshFacetBVH::Build(const MeshFacetArray& facets, const MeshPointArray& points)
+{
+    Clear();
+
+    auto numFacets = static_cast<std::uint32_t>(facets.size());
+    if (numFacets == 0) {
+        return;
+    }
+
+    Builder builder;
+    builder.boxes.resize(numFacets);
+    builder.centers.resize(numFacets);
+    builder.order.resize(numFacets);
+    parallel_chunks(numFacets, 10000, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const MeshFacet& face = facets[i];
+            Base::BoundBox3f box;
+            box.Add(points[face._aulPoints[0]]);
+            box.Add(points[face._aulPoints[1]]);
+            box.Add(points[face._aulPoints[2]]);
+            builder.boxes[i] = box;
+            builder.centers[i] = box.GetCenter();
+            builder.order[i] = static_cast<std::uint32_t>(i);
+        }
+    });
+
+    int parallelDepth = 0;
+    for (unsigned int threads = std::thread::hardware_concurrency(); threads > 1; threads /= 2) {
+        parallelDepth++;
+    }
+
+    _nodes.reserve(2 * (numFacets / MaxLeafSize + 1));
+    BuildNode(builder, 0, numFacets, _nodes, 0, parallelDepth);
+
+    // copy the triangles in the order of the leaves
+    _facets.resize(numFacets);
+    for (int i = 0; i < 3; i++) {
+        _base[i].resize(numFacets);
+        _edge1[i].resize(numFacets);
+        _edge2[i].resize(numFacets);
+    }
+    parallel_chunks(numFacets, 10000, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            FacetIndex index = builder.order[i];
+            const MeshFacet& face = facets[index];
+            const Base::Vector3f& p0 = points[face._aulPoints[0]];
+            Base::Vector3f e1 = points[face._aulPoints[1]] - p0;
+            Base::Vector3f e2 = points[face._aulPoints[2]] - p0;
+            _facets[i] = index;
+            for (int j = 0; j < 3; j++) {
+                _base[j][i] = p0[j];
+                _edge1[j][i] = e1[j];
+                _edge2[j][i] = e2[j];
+            }
+        }
+    });
+}
+
+void MeshFacetBVH::BuildNode(Builder& builder,
+                             std::uint32_t first,
+                             std::uint32_t last,
+                             std::vector<Node>& nodes,
+                             int depth,
+                             int parallelDepth) const
+{
+    Base::BoundBox3f box;
+    Base::BoundBox3f centerBox;
+    for (std::uint32_t i = first; i < last; i++) {
+        std::uint32_t tria = builder.order[i];
+        box.Add(builder.boxes[tria]);
+        centerBox.Add(builder.centers[tria]);
+    }
+
+    auto nodeIndex = static_cast<std::uint32_t>(nodes.size());
+    Node node {};
+    node.min = {box.MinX, box.MinY, box.MinZ};
+    node.max = {box.MaxX, box.MaxY, box.MaxZ};
+    node.index = first;
+    node.count = last - first;
+    nodes.push_back(node);
+
+    std::uint32_t count = last - first;
+    if (count <= 2) {
+        return;
+    }
+
+    // the heuristic may only split off a few triangles per level, so it's only used as long as
+    // median splits of the larger child still end within the maximum depth
+    bool useSAH = depth + 1 + medianDepth(count) <= MaxDepth;
+    if (!useSAH && count <= MaxLeafSize) {
+        return;
+    }
+
+    // split along the longest axis of the centers
+    int axis = 0;
+    float extent = centerBox.LengthX();
+    if (centerBox.LengthY() > extent) {
+        axis = 1;
+        extent = centerBox.LengthY();
+    }
+    if (centerBox.LengthZ() > extent) {
+        axis = 2;
+        extent = centerBox.LengthZ();
+    }
+
+    std::uint32_t mid = first;
+    if (extent > 0.0F && useSAH) {
+        // binned surface area heuristic
+        float minCenter = axis == 0 ? centerBox.MinX : axis == 1 ? centerBox.MinY : centerBox.MinZ;
+        float scale = float(NumBins) / extent;
+        auto binOf = [&](std::uint32_t tria) {
+            int bin = static_cast<int>((builder.centers[tria][axis] - minCenter) * scale);
+            return std::min(bin, NumBins - 1);
+        };
+
+        std::array<Base::BoundBox3f, NumBins> binBoxes;
+        std::array<std::uint32_t, NumBins> binCounts {};
+        for (std::uint32_t i = first; i < last; i++) {
+            std::uint32_t tria = builder.order[i];
+            int bin = binOf(tria);
+            binBoxes[bin].Add(builder.boxes[tria]);
+            binCounts[bin]++;
+        }
+
+        // the costs of the right side for each split position
+        std::array<float, NumBins> rightCosts {};
+        Base::BoundBox3f rightBox;
+        std::uint32_t rightCount = 0;
+        for (int i = NumBins - 1; i > 0; i--) {
+            rightCount += binCounts[i];
+            if (binCounts[i] > 0) {
+                rightBox.Add(binBoxes[i]);
+            }
+            rightCosts[i] = rightCount > 0 ? surfaceArea(rightBox) * float(rightCount) : 0.0F;
+        }
+
+        float bestCost = FLOAT_MAX;
+        int bestSplit = -1;
+        Base::BoundBox3f leftBox;
+        std::uint32_t leftCount = 0;
+        for (int i = 0; i < NumBins - 1; i++) {
+            leftCount += binCounts[i];
+            if (binCounts[i] > 0) {
+                leftBox.Add(binBoxes[i]);
+            }
+            if (leftCount == 0 || leftCount == count) {
+                continue;
+            }
+            float cost = surfaceArea(leftBox) * float(leftCount) + rightCosts[i + 1];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestSplit = i;
+            }
+        }
+
+        // the costs are relative to testing all triangles of the node
+        float area = surfaceArea(box);
+        if (count <= MaxLeafSize
+            && (bestSplit < 0 || area <= 0.0F || 1.0F + bestCost / area >= float(count))) {
+            return;
+        }
+
+        if (bestSplit >= 0) {
+            auto it = std::partition(builder.order.begin() + first,
+                                     builder.order.begin() + last,
+                                     [&](std::uint32_t tria) {
+                                         return binOf(tria) <= bestSplit;
+                                     });
+            mid = static_cast<std::uint32_t>(it - builder.order.begin());
+        }
+    }
+    else if (count <= MaxLeafSize) {
+        return;
+    }
+
+    // all centers coincide or the heuristic didn't separate them
+    if (mid == first || mid == last) {
+        mid = first + count / 2;
+        std::nth_element(builder.order.begin() + first,
+                         builder.order.begin() + mid,
+                         builder.order.begin() + last,
+                         [&](std::uint32_t a, std::uint32_t b) {
+                             return builder.centers[a][axis] < builder.centers[b][axis];
+                         });
+    }
+
+    nodes[nodeIndex].count = 0;
+    if (parallelDepth > 0 && count > ParallelBuildSize) {
+        // the second child is built on another thread into its own array and appended
+        std::vector<Node> right;
+        auto future = std::async(std::launch::async, [&]() {
+            BuildNode(builder, mid, last, right, depth + 1, parallelDepth - 1);
+        });
+        BuildNode(builder, first, mid, nodes, depth + 1, parallelDepth - 1);
+        future.get();
+
+        auto offset = static_cast<std::uint32_t>(nodes.size());
+        for (Node& child : right) {
+            if (child.count == 0) {
+                child.index += offset;
+            }
+        }
+        nodes[nodeIndex].index = offset;
+        nodes.insert(nodes.end(), right.begin(), right.end());
+    }
+    else {
+        BuildNode(builder, first, mid, nodes, depth + 1, parallelDepth);
+        nodes[nodeIndex].index = static_cast<std::uint32_t>(nodes.size());
+        BuildNode(builder, mid, last, nodes, depth + 1, parallelDepth);
+    }
+}
+
+Base::BoundBox3f MeshFacetBVH::NodeBox(const Node& node)
+{
+    return Base::BoundBox3f(node.min[0],
+                            node.min[1],
+                            node.min[2],
+                            node.max[0],
+                            node.max[1],
+                            node.max[2]);
+}
+
+Base::BoundBox3f MeshFacetBVH::TriangleBox(std::uint32_t tria) const
+{
+    Base::Vector3f p0(_base[0][tria], _base[1][tria], _base[2][tria]);
+    Base::Vector3f e1(_edge1[0][tria], _edge1[1][tria], _edge1[2][tria]);
+    Base::Vector3f e2(_edge2[0][tria], _edge2[1][tria], _edge2[2][tria]);
+    Base::BoundBox3f box;
+    box.Add(p0);
+    box.Add(p0 + e1);
+    box.Add(p0 + e2);
+    return box;
+}
+
+Base::BoundBox3f MeshFacetBVH::GetBoundBox() const
+{
+    if (_nodes.empty()) {
+        return {};
+    }
+    return NodeBox(_nodes.front());
+}
+
+int MeshFacetBVH::GetDepth() const
+{
+    if (_nodes.empty()) {
+        return 0;
+    }
+
+    int depth = 0;
+    std::vector<std::pair<std::uint32_t, int>> stack;
+    stack.emplace_back(0, 0);
+    while (!stack.empty()) {
+        auto [index, level] = stack.back();
+        stack.pop_back();
+        depth = std::max(depth, level);
+        const Node& node = _nodes[index];
+        if (node.count == 0) {
+            stack.emplace_back(node.index, level + 1);
+            stack.emplace_back(index + 1, level + 1);
+        }
+    }
+    return depth;
+}
+
+bool MeshFacetBVH::IntersectRay(std::uint32_t first,
+                                std::uint32_t count,
+                                const Base::Vector3f& rclPt,
+                                const Base::Vector3f& rclDir,
+                                float fMaxAngle,
+                                float& rfDist,
+                                std::uint32_t& ruTria) const
+{
+    // Moeller-Trumbore for all triangles of the leaf, the loop has no branches so that it
+    // can be vectorized
+    const float eps = 1e-06F;
+    const float* bx = _base[0].data() + first;
+    const float* by = _base[1].data() + first;
+    const float* bz = _base[2].data() + first;
+    const float* ux = _edge1[0].data() + first;
+    const float* uy = _edge1[1].data() + first;
+    const float* uz = _edge1[2].data() + first;
+    const float* vx = _edge2[0].data() + first;
+    const float* vy = _edge2[1].data() + first;
+    const float* vz = _edge2[2].data() + first;
+    float dd = rclDir * rclDir;
+
+    std::array<float, MaxLeafSize> dist {};
+    for (std::uint32_t i = 0; i < count; i++) {
+        float px = rclDir.y * vz[i] - rclDir.z * vy[i];
+        float py = rclDir.z * vx[i] - rclDir.x * vz[i];
+        float pz = rclDir.x * vy[i] - rclDir.y * vx[i];
+        float det = ux[i] * px + uy[i] * py + uz[i] * pz;
+
+        float nx = uy[i] * vz[i] - uz[i] * vy[i];
+        float ny = uz[i] * vx[i] - ux[i] * vz[i];
+        float nz = ux[i] * vy[i] - uy[i] * vx[i];
+        float nn = nx * nx + ny * ny + nz * nz;
+
+        float tx = rclPt.x - bx[i];
+        float ty = rclPt.y - by[i];
+        float tz = rclPt.z - bz[i];
+        float qx = ty * uz[i] - tz * uy[i];
+        float qy = tz * ux[i] - tx * uz[i];
+        float qz = tx * uy[i] - ty * ux[i];
+
+        // the ray mustn't be parallel to the triangle, see MeshGeomFacet::Foraminate
+        bool valid = (det * det) > (eps * dd * nn);
+        float inv = valid ? 1.0F / det : 0.0F;
+        float s = (tx * px + ty * py + tz * pz) * inv;
+        float t = (rclDir.x * qx + rclDir.y * qy + rclDir.z * qz) * inv;
+        float r = (vx[i] * qx + vy[i] * qy + vz[i] * qz) * inv;
+        bool hit = valid && s >= 0.0F && t >= 0.0F && (s + t) <= 1.0F && r >= 0.0F;
+        dist[i] = hit ? r : FLOAT_MAX;
+    }
+
+    bool found = false;
+    for (std::uint32_t i = 0; i < count; i++) {
+        if (dist[i] >= rfDist) {
+            continue;
+        }
+        if (fMaxAngle < Mathf::PI) {
+            Base::Vector3f e1(ux[i], uy[i], uz[i]);
+            Base::Vector3f e2(vx[i], vy[i], vz[i]);
+            if (rclDir.GetAngle(e1 % e2) > fMaxAngle) {
+                continue;
+            }
+        }
+        rfDist = dist[i];
+        ruTria = first + i;
+        found = true;
+    }
+
+    return found;
+}
+
+bool MeshFacetBVH::NearestFacetOnRay(const Base::Vector3f& rclPt,
+                                     const Base::Vector3f& rclDir,
+                                     Base::Vector3f& rclRes,
+                                     FacetIndex& rulFacet,
+                                     float fMaxAngle) const
+{
+    if (_nodes.empty()) {
+        return false;
+    }
+
+    Base::Vector3f inv(1.0F / rclDir.x, 1.0F / rclDir.y, 1.0F / rclDir.z);
+    float fDist = FLOAT_MAX;
+    std::uint32_t hit = 0;
+    bool found = false;
+
+    std::array<std::uint32_t, MaxStackSize> stack {};
+    int top = 0;
+    if (intersectBox(rclPt, inv, _nodes[0].min, _nodes[0].max, fDist) < FLOAT_MAX) {
+        stack[top++] = 0;
+    }
+    while (top > 0) {
+        const Node& node = _nodes[stack[--top]];
+        if (node.count > 0) {
+            found |= IntersectRay(node.index, node.count, rclPt, rclDir, fMaxAngle, fDist, hit);
+            continue;
+        }
+
+        // visit the nearer child first
+        std::uint32_t left = static_cast<std::uint32_t>(&node - _nodes.data()) + 1;
+        std::uint32_t right = node.index;
+        float dl = intersectBox(rclPt, inv, _nodes[left].min, _nodes[left].max, fDist);
+        float dr = intersectBox(rclPt, inv, _nodes[right].min, _nodes[right].max, fDist);
+        if (dl > dr) {
+            std::swap(left, right);
+            std::swap(dl, dr);
+        }
+        if (dr < FLOAT_MAX) {
+            stack[top++] = right;
+        }
+        if (dl < FLOAT_MAX) {
+            stack[top++] = left;
+        }
+    }
+
+    if (found) {
+        rclRes = rclPt + fDist * rclDir;
+        rulFacet = _facets[hit];
+    }
+    return found;
+}
+
+bool MeshFacetBVH::NearestFacetToPoint(const Base::Vector3f& rclPt,
+                                       Base::Vector3f& rclRes,
+                                       FacetIndex& rulFacet,
+                                       float fMaxDist) const
+{
+    if (_nodes.empty()) {
+        return false;
+    }
+
+    float fMinDist2 = fMaxDist < FLOAT_MAX ? fMaxDist * fMaxDist : FLOAT_MAX;
+    bool found = false;
+
+    std::array<std::uint32_t, MaxStackSize> stack {};
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Node& node = _nodes[stack[--top]];
+        if (distanceToBox2(rclPt, node.min, node.max) >= fMinDist2) {
+            continue;
+        }
+        if (node.count > 0) {
+            for (std::uint32_t i = node.index; i < node.index + node.count; i++) {
+                Base::Vector3f p0(_base[0][i], _base[1][i], _base[2][i]);
+                Base::Vector3f e1(_edge1[0][i], _edge1[1][i], _edge1[2][i]);
+                Base::Vector3f e2(_edge2[0][i], _edge2[1][i], _edge2[2][i]);
+                Base::Vector3f pnt = closestPointOnTriangle(rclPt, p0, e1, e2);
+                float dist2 = Base::DistanceP2(pnt, rclPt);
+                if (dist2 < fMinDist2) {
+                    fMinDist2 = dist2;
+                    rclRes = pnt;
+                    rulFacet = _facets[i];
+                    found = true;
+                }
+            }
+            continue;
+        }
+
+        // visit the nearer child first
+        std::uint32_t left = static_cast<std::uint32_t>(&node - _nodes.data()) + 1;
+        std::uint32_t right = node.index;
+        float dl = distanceToBox2(rclPt, _nodes[left].min, _nodes[left].max);
+        float dr = distanceToBox2(rclPt, _nodes[right].min, _nodes[right].max);
+        if (dl > dr) {
+            std::swap(left, right);
+        }
+        stack[top++] = right;
+        stack[top++] = left;
+    }
+
+    return found;
+}
+
+void MeshFacetBVH::Inside(const Base::BoundBox3f& rclBB, std::vector<FacetIndex>& raulFacets) const
+{
+    raulFacets.clear();
+    if (_nodes.empty()) {
+        return;
+    }
+
+    std::array<std::uint32_t, MaxStackSize> stack {};
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        std::uint32_t index = stack[--top];
+        const Node& node = _nodes[index];
+        if (!(NodeBox(node) && rclBB)) {
+            continue;
+        }
+        if (node.count > 0) {
+            for (std::uint32_t i = node.index; i < node.index + node.count; i++) {
+                if (TriangleBox(i) && rclBB) {
+                    raulFacets.push_back(_facets[i]);
+                }
+            }
+        }
+        else {
+            stack[top++] = node.index;
+            stack[top++] = index + 1;
+        }
+    }
+}
+
+void MeshFacetBVH::Inside(const std::function<bool(const Base::BoundBox3f&)>& test,
+                          std::vector<FacetIndex>& raulFacets) const
+{
+    raulFacets.clear();
+    if (_nodes.empty()) {
+        return;
+    }
+
+    std::array<std::uint32_t, MaxStackSize> stack {};
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        std::uint32_t index = stack[--top];
+        const Node& node = _nodes[index];
+        if (!test(NodeBox(node))) {
+            continue;
+        }
+        if (node.count > 0) {
+            raulFacets.insert(raulFacets.end(),
+                              _facets.begin() + node.index,
+                              _facets.begin() + node.index + node.count);
+        }
+        else {
+            stack[top++] = node.index;
+            stack[top++] = index + 1;
+        }
+    }
+}
+
+void MeshFacetBVH::NearestFacetsOnRays(const std::vector<Base::Vector3f>& rclPts,
+                                       const std::vector<Base::Vector3f>& rclDirs,
+                                       std::vector<FacetIndex>& raulFacets,
+                                       std::vector<Base::Vector3f>& rclRes,
+                                       float fMaxAngle) const
+{
+    std::size_t count = std::min(rclPts.size(), rclDirs.size());
+    raulFacets.assign(count, FACET_INDEX_MAX);
+    rclRes.resize(count);
+    parallel_chunks(count, 100, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            NearestFacetOnRay(rclPts[i], rclDirs[i], rclRes[i], raulFacets[i], fMaxAngle);
+        }
+    });
+}
+
+void MeshFacetBVH::NearestFacetsToPoints(const std::vector<Base::Vector3f>& rclPts,
+                                         std::vector<FacetIndex>& raulFacets,
+                                         std::vector<Base::Vector3f>& rclRes,
+                                         float fMaxDist) const
+{
+    raulFacets.assign(rclPts.size(), FACET_INDEX_MAX);
+    rclRes.resize(rclPts.size());
+    parallel_chunks(rclPts.size(), 100, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            NearestFacetToPoint(rclPts[i], rclRes[i], raulFacets[i], fMaxDist);
+        }
+    });
+}
@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef MESH_BVH_H
+#define MESH_BVH_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <Base/BoundBox.h>
+
+#include "Definitions.h"
+
+
+namespace Base
+{
+class Matrix4D;
+}
+
+namespace MeshCore
+{
+
+class MeshKernel;
+class MeshFacetArray;
+class MeshPointArray;
+
+/**
+ * The MeshFacetBVH class is a bounding volume hierarchy over the facets of a mesh.
+ * It is built with the surface area heuristic (SAH) and in contrast to MeshFacetGrid its
+ * performance doesn't depend on how evenly the facets are distributed, which makes it
+ * the better choice for scans with very different triangle densities.
+ *
+ * The triangles are stored as structure of arrays in the order of the leaves, so the
+ * ray and point tests of a leaf run over contiguous memory and can be vectorized by the
+ * compiler. All queries are const and can be called from several threads at once.
+ * @note The BVH keeps a copy of the geometry, so it must be rebuilt whenever the mesh
+ * is modified.
+ */
+class MeshExport MeshFacetBVH
+{
+public:
+    /** @name Construction */
+    //@{
+    MeshFacetBVH() = default;
+    explicit MeshFacetBVH(const MeshKernel& rclM);
+    /** Builds the hierarchy for the given mesh. */
+    void Attach(const MeshKernel& rclM);
+    /** Builds the hierarchy for the given mesh transformed by \a rclMat. The mesh itself is
+     * not modified. */
+    void Attach(const MeshKernel& rclM, const Base::Matrix4D& rclMat);
+    void Clear();
+    //@}
+
+    /** @name Information */
+    //@{
+    bool IsEmpty() const
+    {
+        return _nodes.empty();
+    }
+    std::size_t CountFacets() const
+    {
+        return _facets.size();
+    }
+    std::size_t CountNodes() const
+    {
+        return _nodes.size();
+    }
+    Base::BoundBox3f GetBoundBox() const;
+    /** Returns the number of levels below the root node. */
+    int GetDepth() const;
+    //@}
+
+    /** @name Search */
+    //@{
+    /** Searches for the nearest facet hit by the ray (\a rclPt, \a rclDir). Only intersections
+     * in direction of \a rclDir are taken into account. The angle between the ray and the normal
+     * of the facet must not exceed \a fMaxAngle.
+     * The intersection point is \a rclRes and the facet \a rulFacet.
+     */
+    bool NearestFacetOnRay(const Base::Vector3f& rclPt,
+                           const Base::Vector3f& rclDir,
+                           Base::Vector3f& rclRes,
+                           FacetIndex& rulFacet,
+                           float fMaxAngle = Mathf::PI) const;
+    /** Searches for the facet nearest to \a rclPt within the distance \a fMaxDist.
+     * The nearest point on the facet is \a rclRes and the facet \a rulFacet.
+     */
+    bool NearestFacetToPoint(const Base::Vector3f& rclPt,
+                             Base::Vector3f& rclRes,
+                             FacetIndex& rulFacet,
+                             float fMaxDist = FLOAT_MAX) const;
+    /** Collects all facets whose bounding box intersects with \a rclBB. */
+    void Inside(const Base::BoundBox3f& rclBB, std::vector<FacetIndex>& raulFacets) const;
+    /** Collects all facets of the leaves whose bounding box is accepted by \a test. The nodes
+     * that are rejected by \a test are not descended. */
+    void Inside(const std::function<bool(const Base::BoundBox3f&)>& test,
+                std::vector<FacetIndex>& raulFacets) const;
+    //@}
+
+    /** @name Batched search */
+    //@{
+    /** Does the same as NearestFacetOnRay() for each ray in parallel. For rays that don't hit
+     * the mesh FACET_INDEX_MAX is set. */
+    void NearestFacetsOnRays(const std::vector<Base::Vector3f>& rclPts,
+                             const std::vector<Base::Vector3f>& rclDirs,
+                             std::vector<FacetIndex>& raulFacets,
+                             std::vector<Base::Vector3f>& rclRes,
+                             float fMaxAngle = Mathf::PI) const;
+    /** Does the same as NearestFacetToPoint() for each point in parallel. For points that have
+     * no facet within \a fMaxDist FACET_INDEX_MAX is set. */
+    void NearestFacetsToPoints(const std::vector<Base::Vector3f>& rclPts,
+                               std::vector<FacetIndex>& raulFacets,
+                               std::vector<Base::Vector3f>& rclRes,
+                               float fMaxDist = FLOAT_MAX) const;
+    //@}
+
+private:
+    struct Node
+    {
+        std::array<float, 3> min;
+        std::array<float, 3> max;
+        /// first triangle of a leaf or the second child of an inner node
+        std::uint32_t index;
+        /// number of triangles of a leaf, zero for inner nodes
+        std::uint32_t count;
+    };
+    struct Builder;
+
+    void Build(const MeshFacetArray& facets, const MeshPointArray& points);
+    void BuildNode(Builder& builder,
+                   std::uint32_t first,
+                   std::uint32_t last,
+                   std::vector<Node>& nodes,
+                   int depth,
+                   int parallelDepth) const;
+    static Base::BoundBox3f NodeBox(const Node& node);
+    bool IntersectRay(std::uint32_t first,
+                      std::uint32_t count,
+                      const Base::Vector3f& rclPt,
+                      const Base::Vector3f& rclDir,
+                      float fMaxAngle,
+                      float& rfDist,
+                      std::uint32_t& ruTria) const;
+    Base::BoundBox3f TriangleBox(std::uint32_t tria) const;
+
+private:
+    std::vector<Node> _nodes;
+    /// the facet index of each triangle
+    std::vector<FacetIndex> _facets;
+    /// corner and edges of the triangles as structure of arrays
+    std::array<std::vector<float>, 3> _base;
+    std::array<std::vector<float>, 3> _edge1;
+    std::array<std::vector<float>, 3> _edge2;
+};
+
+}  // namespace MeshCore
+
+#endif  // MESH_BVH_H
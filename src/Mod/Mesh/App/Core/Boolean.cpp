@@ -0,0 +1,1094 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <tuple>
+#include <vector>
+#endif
+
+#include <Base/Tools.h>
+
+#include "BVH.h"
+#include "Boolean.h"
+#include "Functional.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+// the minimum number of elements handled by a thread
+constexpr std::size_t MinChunkSize = 256;
+// the number of tries with a perturbed second mesh if the input is degenerated
+constexpr int MaxPerturbations = 3;
+
+// ----------------------------------------------------------------------------
+// Orientation predicate with a floating-point filter and an exact fallback based on the
+// expansion arithmetic of J. R. Shewchuk, "Adaptive Precision Floating-Point Arithmetic and
+// Fast Robust Geometric Predicates"
+
+using Expansion = std::vector<double>;
+
+inline void twoSum(double a, double b, double& x, double& y)
+{
+    x = a + b;
+    double bv = x - a;
+    double av = x - bv;
+    y = (a - av) + (b - bv);
+}
+
+inline void fastTwoSum(double a, double b, double& x, double& y)
+{
+    x = a + b;
+    y = b - (x - a);
+}
+
+inline void twoProduct(double a, double b, double& x, double& y)
+{
+    x = a * b;
+    y = std::fma(a, b, -x);
+}
+
+Expansion difference(double a, double b)
+{
+    double x {}, y {};
+    twoSum(a, -b, x, y);
+    if (y != 0.0) {
+        return {y, x};
+    }
+    return {x};
+}
+
+Expansion growExpansion(const Expansion& e, double b)
+{
+    Expansion h;
+    h.reserve(e.size() + 1);
+    double q = b;
+    for (double ei : e) {
+        double sum {}, err {};
+        twoSum(q, ei, sum, err);
+        q = sum;
+        if (err != 0.0) {
+            h.push_back(err);
+        }
+    }
+    if (q != 0.0 || h.empty()) {
+        h.push_back(q);
+    }
+    return h;
+}
+
+Expansion sumExpansion(Expansion e, const Expansion& f)
+{
+    for (double fi : f) {
+        e = growExpansion(e, fi);
+    }
+    return e;
+}
+
+Expansion scaleExpansion(const Expansion& e, double b)
+{
+    Expansion h;
+    h.reserve(2 * e.size());
+    double q {}, hh {};
+    twoProduct(e[0], b, q, hh);
+    if (hh != 0.0) {
+        h.push_back(hh);
+    }
+    for (std::size_t i = 1; i < e.size(); i++) {
+        double product1 {}, product0 {}, sum {};
+        twoProduct(e[i], b, product1, product0);
+        twoSum(q, product0, sum, hh);
+        if (hh != 0.0) {
+            h.push_back(hh);
+        }
+        fastTwoSum(product1, sum, q, hh);
+        if (hh != 0.0) {
+            h.push_back(hh);
+        }
+    }
+    if (q != 0.0 || h.empty()) {
+        h.push_back(q);
+    }
+    return h;
+}
+
+Expansion multiplyExpansion(const Expansion& e, const Expansion& f)
+{
+    Expansion h {0.0};
+    for (double fi : f) {
+        h = sumExpansion(h, scaleExpansion(e, fi));
+    }
+    return h;
+}
+
+double orient3dExact(const Base::Vector3d& a,
+                  const Base::Vector3d& b,
+                  const Base::Vector3d& c,
+                  const Base::Vector3d& d)
+{
+    Expansion adx = difference(a.x, d.x), ady = difference(a.y, d.y), adz = difference(a.z, d.z);
+    Expansion bdx = difference(b.x, d.x), bdy = difference(b.y, d.y), bdz = difference(b.z, d.z);
+    Expansion cdx = difference(c.x, d.x), cdy = difference(c.y, d.y), cdz = difference(c.z, d.z);
+
+    auto minor = [](const Expansion& p1, const Expansion& p2, const Expansion& q1, const Expansion& q2) {
+        Expansion neg = multiplyExpansion(q1, q2);
+        for (double& v : neg) {
+            v = -v;
+        }
+        return sumExpansion(multiplyExpansion(p1, p2), neg);
+    };
+
+    Expansion det = multiplyExpansion(adx, minor(bdy, cdz, bdz, cdy));
+    det = sumExpansion(det, multiplyExpansion(bdx, minor(cdy, adz, cdz, ady)));
+    det = sumExpansion(det, multiplyExpansion(cdx, minor(ady, bdz, adz, bdy)));
+
+    // the components don't overlap, so their sum has the sign of the largest one
+    return std::accumulate(det.begin(), det.end(), 0.0);
+}
+
+/// Returns a positive value if \a d lies below the plane through \a a, \a b and \a c, i.e.
+/// they appear in counterclockwise order seen from \a d. The value is six times the volume of
+/// the tetrahedron. Its sign is exact and so is the value up to rounding if the floating-point
+/// filter fails.
+double orient3d(const Base::Vector3d& a,
+                const Base::Vector3d& b,
+                const Base::Vector3d& c,
+                const Base::Vector3d& d)
+{
+    double adx = a.x - d.x, ady = a.y - d.y, adz = a.z - d.z;
+    double bdx = b.x - d.x, bdy = b.y - d.y, bdz = b.z - d.z;
+    double cdx = c.x - d.x, cdy = c.y - d.y, cdz = c.z - d.z;
+
+    double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+    double cdxady = cdx * ady, adxcdy = adx * cdy;
+    double adxbdy = adx * bdy, bdxady = bdx * ady;
+
+    double det = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady);
+    double permanent = (std::fabs(bdxcdy) + std::fabs(cdxbdy)) * std::fabs(adz)
+        + (std::fabs(cdxady) + std::fabs(adxcdy)) * std::fabs(bdz)
+        + (std::fabs(adxbdy) + std::fabs(bdxady)) * std::fabs(cdz);
+    const double errBound = 7.771561172376103e-16;
+    if (std::fabs(det) > errBound * permanent) {
+        return det;
+    }
+
+    return orient3dExact(a, b, c, d);
+}
+
+inline int signOf(double value)
+{
+    return value > 0.0 ? 1 : (value < 0.0 ? -1 : 0);
+}
+
+struct Point2
+{
+    double x, y;
+};
+
+/// Returns a positive value if \a a, \a b and \a c appear in counterclockwise order, the sign
+/// is exact
+double orient2d(const Point2& a, const Point2& b, const Point2& c)
+{
+    double detleft = (b.x - a.x) * (c.y - a.y);
+    double detright = (b.y - a.y) * (c.x - a.x);
+    double det = detleft - detright;
+    const double errBound = 3.3306690738754716e-16;
+    if (std::fabs(det) > errBound * (std::fabs(detleft) + std::fabs(detright))) {
+        return det;
+    }
+
+    Expansion left = multiplyExpansion(difference(b.x, a.x), difference(c.y, a.y));
+    Expansion right = multiplyExpansion(difference(b.y, a.y), difference(c.x, a.x));
+    for (double& v : right) {
+        v = -v;
+    }
+    Expansion exact = sumExpansion(left, right);
+    return std::accumulate(exact.begin(), exact.end(), 0.0);
+}
+
+// ----------------------------------------------------------------------------
+
+/// An edge of one mesh that crosses a facet of the other mesh. It identifies an intersection
+/// point independent of the facet pair it has been computed for.
+struct Crossing
+{
+    int side;
+    PointIndex p0, p1;
+    FacetIndex facet;
+
+    bool operator<(const Crossing& other) const
+    {
+        return std::tie(side, p0, p1, facet)
+            < std::tie(other.side, other.p0, other.p1, other.facet);
+    }
+    bool operator==(const Crossing& other) const
+    {
+        return side == other.side && p0 == other.p0 && p1 == other.p1 && facet == other.facet;
+    }
+};
+
+/// The intersection of two facets
+struct Segment
+{
+    std::array<FacetIndex, 2> facets;
+    std::array<Crossing, 2> ends;
+    std::array<Base::Vector3d, 2> points;
+};
+
+/// A point to be inserted into a facet, \a edge is the index of the facet edge it lies on
+/// or -1 for interior points
+struct FacetPoint
+{
+    PointIndex id;
+    Base::Vector3d pnt;
+    int edge;
+};
+
+using Triangle = std::array<PointIndex, 3>;
+using Edge = std::array<PointIndex, 2>;
+
+enum class Result
+{
+    None,
+    Found,
+    Degenerated
+};
+
+/// Checks if the segment \a p, \a q crosses the triangle \a a, \a b, \a c
+Result crossEdge(const Base::Vector3d& p,
+                 const Base::Vector3d& q,
+                 const Base::Vector3d& a,
+                 const Base::Vector3d& b,
+                 const Base::Vector3d& c,
+                 Base::Vector3d& point)
+{
+    double s1 = orient3d(a, b, c, p);
+    double s2 = orient3d(a, b, c, q);
+    int g1 = signOf(s1);
+    int g2 = signOf(s2);
+    if (g1 == g2 && g1 != 0) {
+        return Result::None;
+    }
+
+    int h1 = signOf(orient3d(p, q, a, b));
+    int h2 = signOf(orient3d(p, q, b, c));
+    int h3 = signOf(orient3d(p, q, c, a));
+    bool pos = h1 >= 0 && h2 >= 0 && h3 >= 0;
+    bool neg = h1 <= 0 && h2 <= 0 && h3 <= 0;
+    if (!pos && !neg) {
+        return Result::None;
+    }
+    if (g1 == 0 || g2 == 0 || h1 == 0 || h2 == 0 || h3 == 0) {
+        return Result::Degenerated;
+    }
+
+    double t = std::clamp(s1 / (s1 - s2), 0.0, 1.0);
+    point = p + (q - p) * t;
+    return Result::Found;
+}
+
+/**
+ * Triangulates a facet with the given points and constrained edges. The points are inserted
+ * into the facet one after another and the constrained edges are recovered by edge flips, see
+ * S. W. Sloan, "A fast algorithm for generating constrained Delaunay triangulations".
+ */
+class FacetTriangulator
+{
+public:
+    FacetTriangulator(const Triangle& corners, const std::array<Base::Vector3d, 3>& coords)
+    {
+        // project onto the coordinate plane that keeps the orientation of the facet
+        Base::Vector3d normal = (coords[1] - coords[0]) % (coords[2] - coords[0]);
+        std::array<double, 3> length {std::fabs(normal.x), std::fabs(normal.y), std::fabs(normal.z)};
+        int axis = int(std::max_element(length.begin(), length.end()) - length.begin());
+        axisU = (axis + 1) % 3;
+        axisV = (axis + 2) % 3;
+        if (normal[axis] < 0.0) {
+            std::swap(axisU, axisV);
+        }
+
+        for (int i = 0; i < 3; i++) {
+            addVertex(corners[i], coords[i]);
+        }
+        triangles.push_back({0, 1, 2});
+        base = coords;
+    }
+
+    bool Perform(const std::vector<FacetPoint>& points, const std::vector<Edge>& constraints)
+    {
+        // the points on the facet edges in the order along the edge
+        for (int edge = 0; edge < 3; edge++) {
+            const Base::Vector3d& start = base[edge];
+            Base::Vector3d dir = base[(edge + 1) % 3] - start;
+            std::vector<std::pair<double, const FacetPoint*>> onEdge;
+            for (const auto& it : points) {
+                if (it.edge == edge) {
+                    onEdge.emplace_back((it.pnt - start) * dir, &it);
+                }
+            }
+            std::sort(onEdge.begin(), onEdge.end(), [](const auto& a, const auto& b) {
+                return a.first < b.first;
+            });
+
+            std::size_t prev = edge;
+            std::size_t next = (edge + 1) % 3;
+            // place the points exactly on the projected edge so that the chain doesn't fold
+            double len2 = dir.Sqr();
+            for (const auto& it : onEdge) {
+                std::size_t index = addVertex(it.second->id, it.second->pnt);
+                double t = len2 > 0.0 ? std::clamp(it.first / len2, 0.0, 1.0) : 0.0;
+                uv[index] = {uv[edge].x + (uv[next].x - uv[edge].x) * t,
+                             uv[edge].y + (uv[next].y - uv[edge].y) * t};
+                if (!splitEdge(prev, next, index)) {
+                    return false;
+                }
+                prev = index;
+            }
+        }
+
+        for (const auto& it : points) {
+            if (it.edge < 0) {
+                insertPoint(addVertex(it.id, it.pnt));
+            }
+        }
+
+        for (const auto& it : constraints) {
+            if (!recoverEdge(localIndex(it[0]), localIndex(it[1]))) {
+                return false;
+            }
+        }
+
+        // rounded crossing points may still fold the triangulation
+        return std::all_of(triangles.begin(), triangles.end(), [this](const Local& t) {
+            return orient(t[0], t[1], t[2]) > 0.0;
+        });
+    }
+
+    void GetTriangles(std::vector<Triangle>& result) const
+    {
+        for (const auto& it : triangles) {
+            result.push_back({ids[it[0]], ids[it[1]], ids[it[2]]});
+        }
+    }
+
+private:
+    using Local = std::array<std::size_t, 3>;
+
+    std::size_t addVertex(PointIndex id, const Base::Vector3d& pnt)
+    {
+        ids.push_back(id);
+        uv.push_back({pnt[axisU], pnt[axisV]});
+        return ids.size() - 1;
+    }
+
+    std::size_t localIndex(PointIndex id) const
+    {
+        return std::size_t(std::find(ids.begin(), ids.end(), id) - ids.begin());
+    }
+
+    double orient(std::size_t a, std::size_t b, std::size_t c) const
+    {
+        return orient2d(uv[a], uv[b], uv[c]);
+    }
+
+    /// Returns the triangle with the directed edge \a a, \a b and its position
+    bool findEdge(std::size_t a, std::size_t b, std::size_t& tria, int& pos) const
+    {
+        for (std::size_t i = 0; i < triangles.size(); i++) {
+            for (int j = 0; j < 3; j++) {
+                if (triangles[i][j] == a && triangles[i][(j + 1) % 3] == b) {
+                    tria = i;
+                    pos = j;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /// Inserts \a index on the edge \a a, \a b and splits the triangles on both sides
+    bool splitEdge(std::size_t a, std::size_t b, std::size_t index)
+    {
+        std::size_t tria {};
+        int pos {};
+        if (!findEdge(a, b, tria, pos)) {
+            return false;
+        }
+        std::size_t x = triangles[tria][(pos + 2) % 3];
+        triangles[tria] = {a, index, x};
+        triangles.push_back({index, b, x});
+
+        if (findEdge(b, a, tria, pos)) {
+            std::size_t y = triangles[tria][(pos + 2) % 3];
+            triangles[tria] = {b, index, y};
+            triangles.push_back({index, a, y});
+        }
+        return true;
+    }
+
+    void insertPoint(std::size_t index)
+    {
+        // the triangle where the point is farthest away from the edges
+        std::size_t best = 0;
+        double bestValue = -std::numeric_limits<double>::max();
+        std::array<double, 3> bestBary {};
+        for (std::size_t i = 0; i < triangles.size(); i++) {
+            const Local& t = triangles[i];
+            double area = orient(t[0], t[1], t[2]);
+            if (area <= 0.0) {
+                continue;
+            }
+            std::array<double, 3> bary {orient(index, t[1], t[2]) / area,
+                                        orient(t[0], index, t[2]) / area,
+                                        orient(t[0], t[1], index) / area};
+            double value = std::min({bary[0], bary[1], bary[2]});
+            if (value > bestValue) {
+                bestValue = value;
+                best = i;
+                bestBary = bary;
+            }
+        }
+
+        // orient() has an exact sign, so only points exactly on an edge split it
+        Local t = triangles[best];
+        if (bestValue > 0.0) {
+            triangles[best] = {t[0], t[1], index};
+            triangles.push_back({t[1], t[2], index});
+            triangles.push_back({t[2], t[0], index});
+        }
+        else {
+            // the point lies on the edge opposite to the smallest coordinate
+            int pos = int(std::min_element(bestBary.begin(), bestBary.end()) - bestBary.begin());
+            splitEdge(t[(pos + 1) % 3], t[(pos + 2) % 3], index);
+        }
+    }
+
+    bool crosses(std::size_t a, std::size_t b, std::size_t u, std::size_t v) const
+    {
+        if (u == a || u == b || v == a || v == b) {
+            return false;
+        }
+        return signOf(orient(a, b, u)) * signOf(orient(a, b, v)) < 0
+            && signOf(orient(u, v, a)) * signOf(orient(u, v, b)) < 0;
+    }
+
+    bool hasEdge(std::size_t a, std::size_t b) const
+    {
+        std::size_t tria {};
+        int pos {};
+        return findEdge(a, b, tria, pos) || findEdge(b, a, tria, pos);
+    }
+
+    bool recoverEdge(std::size_t a, std::size_t b)
+    {
+        if (a >= ids.size() || b >= ids.size()) {
+            return false;
+        }
+        if (hasEdge(a, b)) {
+            return true;
+        }
+
+        std::vector<std::array<std::size_t, 2>> queue;
+        for (const auto& t : triangles) {
+            for (int j = 0; j < 3; j++) {
+                std::size_t u = t[j];
+                std::size_t v = t[(j + 1) % 3];
+                if (u < v && crosses(a, b, u, v)) {
+                    queue.push_back({u, v});
+                }
+            }
+        }
+
+        std::size_t maxIter = 10 * (queue.size() + 1) * (queue.size() + 1);
+        std::size_t front = 0;
+        for (std::size_t iter = 0; front < queue.size(); iter++) {
+            if (iter > maxIter) {
+                return false;
+            }
+            auto edge = queue[front++];
+            std::size_t u = edge[0];
+            std::size_t v = edge[1];
+            std::size_t t1 {}, t2 {};
+            int p1 {}, p2 {};
+            if (!findEdge(u, v, t1, p1) || !findEdge(v, u, t2, p2)) {
+                return false;
+            }
+            std::size_t w = triangles[t1][(p1 + 2) % 3];
+            std::size_t x = triangles[t2][(p2 + 2) % 3];
+
+            // only the diagonal of a convex quadrilateral can be flipped
+            if (signOf(orient(w, x, u)) * signOf(orient(w, x, v)) >= 0) {
+                queue.push_back(edge);
+                continue;
+            }
+
+            triangles[t1] = {u, x, w};
+            triangles[t2] = {x, v, w};
+            if (crosses(a, b, w, x)) {
+                queue.push_back({w, x});
+            }
+        }
+
+        return hasEdge(a, b);
+    }
+
+private:
+    int axisU {0};
+    int axisV {1};
+    std::array<Base::Vector3d, 3> base;
+    std::vector<PointIndex> ids;
+    std::vector<Point2> uv;
+    std::vector<Local> triangles;
+};
+
+double windingAngle(const Base::Vector3d& pnt,
+                    const Base::Vector3d& p1,
+                    const Base::Vector3d& p2,
+                    const Base::Vector3d& p3)
+{
+    // solid angle of a triangle, see A. Van Oosterom and J. Strackee, "The Solid Angle of a
+    // Plane Triangle"
+    Base::Vector3d a = p1 - pnt;
+    Base::Vector3d b = p2 - pnt;
+    Base::Vector3d c = p3 - pnt;
+    double la = a.Length();
+    double lb = b.Length();
+    double lc = c.Length();
+    double num = a * (b % c);
+    double den = la * lb * lc + (a * b) * lc + (b * c) * la + (c * a) * lb;
+    return 2.0 * std::atan2(num, den);
+}
+
+// ----------------------------------------------------------------------------
+
+class Corefinement
+{
+public:
+    Corefinement(const MeshKernel& mesh1, const MeshKernel& mesh2)
+        : kernels {&mesh1, &mesh2}
+    {
+        bvh.Attach(mesh2);
+        for (int side = 0; side < 2; side++) {
+            const MeshPointArray& points = kernels[side]->GetPoints();
+            coords[side].resize(points.size());
+            for (std::size_t i = 0; i < points.size(); i++) {
+                coords[side][i] = Base::toVector<double>(points[i]);
+            }
+        }
+        offsets = {0, PointIndex(coords[0].size()), PointIndex(coords[0].size() + coords[1].size())};
+
+        Base::BoundBox3f box = mesh1.GetBoundBox();
+        box.Add(mesh2.GetBoundBox());
+        diagonal = box.IsValid() ? box.CalcDiagonalLength() : 0.0F;
+    }
+
+    /// Translates the second mesh by a tiny amount to resolve degenerate configurations,
+    /// each further attempt moves it by two orders of magnitude more. The largest shift is
+    /// 1e-8 of the diagonal and so stays below the float precision at the scale of the meshes.
+    void Perturb(int attempt)
+    {
+        static const std::array<Base::Vector3d, MaxPerturbations> directions {
+            Base::Vector3d(0.5503, 0.6129, 0.5671),
+            Base::Vector3d(-0.4877, 0.7411, 0.4615),
+            Base::Vector3d(0.6643, -0.3519, 0.6594)};
+        double scale = 1e-8 * std::pow(0.01, MaxPerturbations - attempt);
+        Base::Vector3d shift = directions[(attempt - 1) % MaxPerturbations] * (scale * diagonal);
+        shiftLength = float(shift.Length());
+        const MeshPointArray& points = kernels[1]->GetPoints();
+        for (std::size_t i = 0; i < points.size(); i++) {
+            coords[1][i] = Base::toVector<double>(points[i]) + shift;
+        }
+    }
+
+    /// Computes the intersection segments of all facet pairs
+    Result Intersect()
+    {
+        const MeshFacetArray& facets = kernels[0]->GetFacets();
+        // the hierarchy is built from the unperturbed second mesh
+        float tolerance = 1e-6F * diagonal + shiftLength;
+        std::atomic<bool> degenerated {false};
+        std::mutex mutex;
+
+        segments.clear();
+        parallel_chunks(facets.size(), MinChunkSize, [&](std::size_t begin, std::size_t end) {
+            std::vector<Segment> local;
+            std::vector<FacetIndex> candidates;
+            for (std::size_t f0 = begin; f0 < end && !degenerated; f0++) {
+                Base::BoundBox3f box = kernels[0]->GetFacet(f0).GetBoundBox();
+                box.Enlarge(tolerance);
+                bvh.Inside(box, candidates);
+                for (FacetIndex f1 : candidates) {
+                    Segment seg;
+                    Result res = IntersectFacets(f0, f1, seg);
+                    if (res == Result::Found) {
+                        local.push_back(seg);
+                    }
+                    else if (res == Result::Degenerated) {
+                        degenerated = true;
+                        break;
+                    }
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            segments.insert(segments.end(), local.begin(), local.end());
+        });
+
+        if (degenerated) {
+            return Result::Degenerated;
+        }
+
+        std::sort(segments.begin(), segments.end(), [](const Segment& a, const Segment& b) {
+            return a.facets < b.facets;
+        });
+
+        // every crossing becomes a new point that is shared by all facets it belongs to
+        crossings.clear();
+        for (const auto& seg : segments) {
+            crossings.push_back(seg.ends[0]);
+            crossings.push_back(seg.ends[1]);
+        }
+        std::sort(crossings.begin(), crossings.end());
+        crossings.erase(std::unique(crossings.begin(), crossings.end()), crossings.end());
+
+        crossingPoints.resize(crossings.size());
+        edges.resize(segments.size());
+        for (std::size_t i = 0; i < segments.size(); i++) {
+            const Segment& seg = segments[i];
+            for (int j = 0; j < 2; j++) {
+                std::size_t index = CrossingIndex(seg.ends[j]);
+                crossingPoints[index] = seg.points[j];
+                edges[i][j] = offsets[2] + PointIndex(index);
+            }
+        }
+
+        return segments.empty() ? Result::None : Result::Found;
+    }
+
+    /// Retriangulates all facets that are cut by the other mesh
+    bool Triangulate()
+    {
+        for (int side = 0; side < 2; side++) {
+            const MeshFacetArray& facets = kernels[side]->GetFacets();
+
+            // the segments grouped by the facet of this side
+            std::vector<std::size_t> order(segments.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+                return segments[a].facets[side] < segments[b].facets[side];
+            });
+            std::vector<std::size_t> groups;
+            for (std::size_t i = 0; i < order.size(); i++) {
+                if (i == 0
+                    || segments[order[i]].facets[side] != segments[order[i - 1]].facets[side]) {
+                    groups.push_back(i);
+                }
+            }
+            groups.push_back(order.size());
+
+            std::size_t numGroups = groups.size() - 1;
+            std::vector<std::vector<Triangle>> result(numGroups);
+            std::atomic<bool> failed {false};
+            parallel_chunks(numGroups, 16, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end && !failed; i++) {
+                    std::vector<std::size_t> group(order.begin() + std::ptrdiff_t(groups[i]),
+                                                   order.begin() + std::ptrdiff_t(groups[i + 1]));
+                    if (!TriangulateFacet(side, group, result[i])) {
+                        failed = true;
+                    }
+                }
+            });
+            if (failed) {
+                return false;
+            }
+
+            // the facets that are not cut are kept
+            std::vector<bool> cut(facets.size(), false);
+            for (const auto& seg : segments) {
+                cut[seg.facets[side]] = true;
+            }
+
+            triangles[side].clear();
+            for (std::size_t i = 0; i < facets.size(); i++) {
+                if (!cut[i]) {
+                    const MeshFacet& facet = facets[i];
+                    triangles[side].push_back({facet._aulPoints[0] + offsets[side],
+                                               facet._aulPoints[1] + offsets[side],
+                                               facet._aulPoints[2] + offsets[side]});
+                }
+            }
+            for (const auto& it : result) {
+                triangles[side].insert(triangles[side].end(), it.begin(), it.end());
+            }
+        }
+
+        return true;
+    }
+
+    /// Determines for each triangle whether it lies inside the other mesh
+    void Classify()
+    {
+        std::vector<Edge> blocked = edges;
+        for (auto& it : blocked) {
+            std::sort(it.begin(), it.end());
+        }
+        std::sort(blocked.begin(), blocked.end());
+
+        for (int side = 0; side < 2; side++) {
+            const std::vector<Triangle>& tria = triangles[side];
+
+            // the regions bounded by the intersection curves
+            std::vector<std::size_t> parent(tria.size());
+            std::iota(parent.begin(), parent.end(), 0);
+            auto find = [&parent](std::size_t i) {
+                while (parent[i] != i) {
+                    parent[i] = parent[parent[i]];
+                    i = parent[i];
+                }
+                return i;
+            };
+
+            std::vector<std::pair<Edge, std::size_t>> triaEdges;
+            triaEdges.reserve(3 * tria.size());
+            for (std::size_t i = 0; i < tria.size(); i++) {
+                for (int j = 0; j < 3; j++) {
+                    Edge edge {tria[i][j], tria[i][(j + 1) % 3]};
+                    std::sort(edge.begin(), edge.end());
+                    triaEdges.emplace_back(edge, i);
+                }
+            }
+            parallel_sort(triaEdges.begin(),
+                          triaEdges.end(),
+                          std::less<>(),
+                          int(std::thread::hardware_concurrency()));
+
+            for (std::size_t i = 1; i < triaEdges.size(); i++) {
+                const Edge& edge = triaEdges[i].first;
+                if (edge == triaEdges[i - 1].first
+                    && !std::binary_search(blocked.begin(), blocked.end(), edge)) {
+                    parent[find(triaEdges[i].second)] = find(triaEdges[i - 1].second);
+                }
+            }
+
+            // classify each region by its largest triangle
+            std::vector<std::size_t> largest(tria.size(), tria.size());
+            std::vector<double> area(tria.size(), 0.0);
+            for (std::size_t i = 0; i < tria.size(); i++) {
+                std::size_t root = find(i);
+                const Triangle& t = tria[i];
+                double value =
+                    ((Coord(t[1]) - Coord(t[0])) % (Coord(t[2]) - Coord(t[0]))).Length();
+                if (largest[root] == tria.size() || value > area[root]) {
+                    largest[root] = i;
+                    area[root] = value;
+                }
+            }
+
+            std::vector<std::size_t> regions;
+            for (std::size_t i = 0; i < tria.size(); i++) {
+                if (find(i) == i) {
+                    regions.push_back(i);
+                }
+            }
+
+            std::vector<char> regionInside(tria.size(), 0);
+            for (std::size_t root : regions) {
+                const Triangle& t = tria[largest[root]];
+                Base::Vector3d center = (Coord(t[0]) + Coord(t[1]) + Coord(t[2])) / 3.0;
+                regionInside[root] = std::fabs(WindingNumber(1 - side, center)) > 0.5 ? 1 : 0;
+            }
+
+            inside[side].resize(tria.size());
+            for (std::size_t i = 0; i < tria.size(); i++) {
+                inside[side][i] = regionInside[find(i)];
+            }
+        }
+    }
+
+    /// Creates the mesh from the triangles inside or outside the other mesh
+    void Assemble(MeshBoolean::Operation operation, MeshKernel& result) const
+    {
+        // 0: skip, 1: keep outside, 2: keep inside, 3: keep inside with flipped orientation
+        std::array<int, 2> keep {};
+        switch (operation) {
+            case MeshBoolean::Union:
+                keep = {1, 1};
+                break;
+            case MeshBoolean::Intersect:
+                keep = {2, 2};
+                break;
+            case MeshBoolean::Difference:
+                keep = {1, 3};
+                break;
+            case MeshBoolean::Inner:
+                keep = {2, 0};
+                break;
+            case MeshBoolean::Outer:
+                keep = {1, 0};
+                break;
+        }
+
+        std::vector<PointIndex> index(offsets[2] + crossings.size(), POINT_INDEX_MAX);
+        MeshPointArray points;
+        MeshFacetArray facets;
+        for (int side = 0; side < 2; side++) {
+            if (keep[side] == 0) {
+                continue;
+            }
+            bool wantInside = keep[side] >= 2;
+            for (std::size_t i = 0; i < triangles[side].size(); i++) {
+                if ((inside[side][i] != 0) != wantInside) {
+                    continue;
+                }
+
+                Triangle t = triangles[side][i];
+                if (keep[side] == 3) {
+                    std::swap(t[0], t[1]);
+                }
+                MeshFacet facet;
+                for (int j = 0; j < 3; j++) {
+                    PointIndex& pos = index[t[j]];
+                    if (pos == POINT_INDEX_MAX) {
+                        pos = PointIndex(points.size());
+                        points.push_back(Point(t[j]));
+                    }
+                    facet._aulPoints[j] = pos;
+                }
+                facets.push_back(facet);
+            }
+        }
+
+        result.Adopt(points, facets, true);
+    }
+
+    std::size_t CountSegments() const
+    {
+        return segments.size();
+    }
+
+private:
+    Result IntersectFacets(FacetIndex f0, FacetIndex f1, Segment& seg) const
+    {
+        std::array<FacetIndex, 2> index {f0, f1};
+        int count = 0;
+        for (int side = 0; side < 2; side++) {
+            const MeshFacet& edgeFacet = kernels[side]->GetFacets()[index[side]];
+            const MeshFacet& other = kernels[1 - side]->GetFacets()[index[1 - side]];
+            const std::vector<Base::Vector3d>& pts = coords[side];
+            const std::vector<Base::Vector3d>& otherPts = coords[1 - side];
+            for (int i = 0; i < 3; i++) {
+                PointIndex p0 = edgeFacet._aulPoints[i];
+                PointIndex p1 = edgeFacet._aulPoints[(i + 1) % 3];
+                if (p0 > p1) {
+                    std::swap(p0, p1);
+                }
+
+                Base::Vector3d pnt;
+                Result res = crossEdge(pts[p0],
+                                       pts[p1],
+                                       otherPts[other._aulPoints[0]],
+                                       otherPts[other._aulPoints[1]],
+                                       otherPts[other._aulPoints[2]],
+                                       pnt);
+                if (res == Result::None) {
+                    continue;
+                }
+                if (res == Result::Degenerated || count == 2) {
+                    return Result::Degenerated;
+                }
+                seg.ends[count] = {side, p0, p1, index[1 - side]};
+                seg.points[count] = pnt;
+                count++;
+            }
+        }
+
+        if (count == 0) {
+            return Result::None;
+        }
+        if (count == 1) {
+            return Result::Degenerated;
+        }
+        seg.facets = index;
+        return Result::Found;
+    }
+
+    bool TriangulateFacet(int side,
+                          const std::vector<std::size_t>& group,
+                          std::vector<Triangle>& result) const
+    {
+        FacetIndex index = segments[group.front()].facets[side];
+        const MeshFacet& facet = kernels[side]->GetFacets()[index];
+        Triangle corners {};
+        std::array<Base::Vector3d, 3> base;
+        for (int i = 0; i < 3; i++) {
+            corners[i] = facet._aulPoints[i] + offsets[side];
+            base[i] = coords[side][facet._aulPoints[i]];
+        }
+
+        std::vector<FacetPoint> points;
+        std::vector<Edge> constraints;
+        for (std::size_t i : group) {
+            const Segment& seg = segments[i];
+            constraints.push_back(edges[i]);
+            for (int j = 0; j < 2; j++) {
+                PointIndex id = edges[i][j];
+                bool known = std::any_of(points.begin(), points.end(), [id](const FacetPoint& p) {
+                    return p.id == id;
+                });
+                if (known) {
+                    continue;
+                }
+
+                int edge = -1;
+                const Crossing& end = seg.ends[j];
+                if (end.side == side) {
+                    for (int k = 0; k < 3; k++) {
+                        PointIndex p0 = facet._aulPoints[k];
+                        PointIndex p1 = facet._aulPoints[(k + 1) % 3];
+                        if (std::min(p0, p1) == end.p0 && std::max(p0, p1) == end.p1) {
+                            edge = k;
+                        }
+                    }
+                }
+                points.push_back({id, crossingPoints[id - offsets[2]], edge});
+            }
+        }
+
+        FacetTriangulator triangulator(corners, base);
+        if (!triangulator.Perform(points, constraints)) {
+            return false;
+        }
+        triangulator.GetTriangles(result);
+        return true;
+    }
+
+    std::size_t CrossingIndex(const Crossing& crossing) const
+    {
+        return std::size_t(std::lower_bound(crossings.begin(), crossings.end(), crossing)
+                           - crossings.begin());
+    }
+
+    Base::Vector3d Coord(PointIndex id) const
+    {
+        if (id < offsets[1]) {
+            return coords[0][id];
+        }
+        if (id < offsets[2]) {
+            return coords[1][id - offsets[1]];
+        }
+        return crossingPoints[id - offsets[2]];
+    }
+
+    /// the points of the perturbed second mesh are written as well so that they fit to the
+    /// crossings computed from them
+    Base::Vector3f Point(PointIndex id) const
+    {
+        return Base::toVector<float>(Coord(id));
+    }
+
+    double WindingNumber(int side, const Base::Vector3d& pnt) const
+    {
+        const MeshFacetArray& facets = kernels[side]->GetFacets();
+        const std::vector<Base::Vector3d>& pts = coords[side];
+        std::mutex mutex;
+        double total = 0.0;
+        parallel_chunks(facets.size(), 4096, [&](std::size_t begin, std::size_t end) {
+            double sum = 0.0;
+            for (std::size_t i = begin; i < end; i++) {
+                const MeshFacet& facet = facets[i];
+                sum += windingAngle(pnt,
+                                    pts[facet._aulPoints[0]],
+                                    pts[facet._aulPoints[1]],
+                                    pts[facet._aulPoints[2]]);
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            total += sum;
+        });
+        return total / (4.0 * Base::toRadians<double>(180.0));
+    }
+
+private:
+    std::array<const MeshKernel*, 2> kernels;
+    MeshFacetBVH bvh;
+    std::array<std::vector<Base::Vector3d>, 2> coords;
+    /// the global index of the first point of each mesh and of the crossings
+    std::array<PointIndex, 3> offsets {};
+    float diagonal {0.0F};
+    float shiftLength {0.0F};
+
+    std::vector<Segment> segments;
+    /// the points of each segment
+    std::vector<Edge> edges;
+    std::vector<Crossing> crossings;
+    std::vector<Base::Vector3d> crossingPoints;
+    std::array<std::vector<Triangle>, 2> triangles;
+    std::array<std::vector<char>, 2> inside;
+};
+
+}  // namespace
+
+MeshBoolean::MeshBoolean(const MeshKernel& mesh1, const MeshKernel& mesh2, Operation op)
+    : mesh1(mesh1)
+    , mesh2(mesh2)
+    , operation(op)
+{}
+
+bool MeshBoolean::Perform(MeshKernel& result)
+{
+    numIntersections = 0;
+    if (mesh1.HasOpenEdges() || mesh2.HasOpenEdges()) {
+        return false;
+    }
+
+    Corefinement core(mesh1, mesh2);
+    for (int attempt = 0; attempt <= MaxPerturbations; attempt++) {
+        if (attempt > 0) {
+            core.Perturb(attempt);
+        }
+        if (core.Intersect() == Result::Degenerated) {
+            continue;
+        }
+        if (!core.Triangulate()) {
+            continue;
+        }
+
+        core.Classify();
+        core.Assemble(operation, result);
+        numIntersections = core.CountSegments();
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef MESH_BOOLEAN_H
+#define MESH_BOOLEAN_H
+
+#include <cstddef>
+
+#include "Definitions.h"
+
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshBoolean class computes the union, intersection or difference of two closed meshes.
+ *
+ * Both meshes are cut along their intersection curves (corefinement): the candidate facet pairs
+ * are found with a bounding volume hierarchy and each pair is intersected on its own thread. All
+ * topological decisions are made with an exact orientation predicate, so that near-coplanar
+ * input gives consistent results. The intersection points are identified by the edge and the
+ * facet they are computed from which makes the cut meshes fit together without any tolerance.
+ * Every facet is retriangulated with its intersection segments as constrained edges. Afterwards
+ * the cut meshes are split into regions bounded by the intersection curves, and each region is
+ * classified as inside or outside of the other mesh by the generalized winding number of one of
+ * its points.
+ *
+ * Degenerate configurations, e.g. a vertex of one mesh lying on a facet of the other one or
+ * coplanar facets, are resolved by translating the second mesh by a tiny amount. The shift is at
+ * most 1e-8 of the diagonal of both meshes, which is below the float precision of points at the
+ * scale of the meshes, but points close to the origin may still be moved by a few ULPs.
+ */
+class MeshExport MeshBoolean
+{
+public:
+    enum Operation
+    {
+        Union,
+        Intersect,
+        Difference,
+        Inner,  ///< The part of the first mesh inside the second mesh
+        Outer   ///< The part of the first mesh outside the second mesh
+    };
+
+    MeshBoolean(const MeshKernel& mesh1, const MeshKernel& mesh2, Operation op);
+
+    /** Computes the result. Returns false if the meshes are not closed or the computation
+     * failed, the result is not modified in this case.
+     */
+    bool Perform(MeshKernel& result);
+    /** Returns the number of segments of the intersection curves found by Perform(). */
+    std::size_t CountIntersections() const
+    {
+        return numIntersections;
+    }
+
+private:
+    const MeshKernel& mesh1;
+    const MeshKernel& mesh2;
+    Operation operation;
+    std::size_t numIntersections {0};
+};
+
+}  // namespace MeshCore
+
+#endif  // MESH_BOOLEAN_H
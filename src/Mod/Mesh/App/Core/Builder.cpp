@@ -24,6 +24,10 @@
 
 #ifndef _PreComp_
 #include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <numeric>
 #endif
 
 #include <Base/Exception.h>
@@ -32,7 +36,6 @@
 #include "Builder.h"
 #include "Functional.h"
 #include "MeshKernel.h"
-#include <QVector>
 
 
 using namespace MeshCore;
@@ -279,46 +282,37 @@ void MeshBuilder::Finish(bool freeMemory)
 
 struct MeshFastBuilder::Private
 {
-    struct Vertex
+    // x, y and z of each added vertex, three vertexes per facet
+    std::vector<float> coords;
+
+    void addPoint(const Base::Vector3f& pnt)
     {
-        Vertex()
-            : x(0)
-            , y(0)
-            , z(0)
-            , i(0)
-        {}
-        Vertex(float x, float y, float z)
-            : x(x)
-            , y(y)
-            , z(z)
-            , i(0)
-        {}
-
-        float x, y, z;
-        size_type i;
-
-        bool operator!=(const Vertex& rhs) const
-        {
-            return x != rhs.x || y != rhs.y || z != rhs.z;
-        }
-        bool operator<(const Vertex& rhs) const
-        {
-            if (x != rhs.x) {
-                return x < rhs.x;
-            }
-            if (y != rhs.y) {
-                return y < rhs.y;
-            }
-            if (z != rhs.z) {
-                return z < rhs.z;
-            }
+        // adding 0 turns -0 into +0 so that both are equal bitwise
+        coords.push_back(pnt.x + 0.0F);
+        coords.push_back(pnt.y + 0.0F);
+        coords.push_back(pnt.z + 0.0F);
+    }
 
-            return false;
-        }
-    };
+    std::uint32_t hashOf(std::size_t index) const
+    {
+        std::array<std::uint32_t, 3> bits {};
+        std::memcpy(bits.data(), &coords[3 * index], sizeof(bits));
+        std::uint32_t hash = bits[0] * 0x9E3779B1U;
+        hash = (hash ^ (hash >> 15)) + bits[1] * 0x85EBCA77U;
+        hash = (hash ^ (hash >> 13)) + bits[2] * 0xC2B2AE3DU;
+        // final mix of murmur3 so that the top bits are well distributed
+        hash ^= hash >> 16;
+        hash *= 0x85EBCA6BU;
+        hash ^= hash >> 13;
+        hash *= 0xC2B2AE35U;
+        hash ^= hash >> 16;
+        return hash;
+    }
 
-    // Hint: Using a QVector instead of std::vector is a bit faster
-    QVector<Vertex> verts;
+    bool isEqual(std::size_t index1, std::size_t index2) const
+    {
+        return std::memcmp(&coords[3 * index1], &coords[3 * index2], 3 * sizeof(float)) == 0;
+    }
 };
 
 MeshFastBuilder::MeshFastBuilder(MeshKernel& rclM)
@@ -333,70 +327,155 @@ MeshFastBuilder::~MeshFastBuilder()
 
 void MeshFastBuilder::Initialize(size_type ctFacets)
 {
-    p->verts.reserve(ctFacets * 3);
+    p->coords.reserve(static_cast<std::size_t>(ctFacets) * 9);
 }
 
 void MeshFastBuilder::AddFacet(const Base::Vector3f* facetPoints)
 {
-    Private::Vertex v;
     for (int i = 0; i < 3; i++) {
-        v.x = facetPoints[i].x;
-        v.y = facetPoints[i].y;
-        v.z = facetPoints[i].z;
-        p->verts.push_back(v);
+        p->addPoint(facetPoints[i]);
     }
 }
 
 void MeshFastBuilder::AddFacet(const MeshGeomFacet& facetPoints)
 {
-    Private::Vertex v;
     for (const auto& pnt : facetPoints._aclPoints) {
-        v.x = pnt.x;
-        v.y = pnt.y;
-        v.z = pnt.z;
-        p->verts.push_back(v);
+        p->addPoint(pnt);
     }
 }
 
 void MeshFastBuilder::Finish()
 {
-    using size_type = QVector<Private::Vertex>::size_type;
-    QVector<Private::Vertex>& verts = p->verts;
-    size_type ulCtPts = verts.size();
-    for (size_type i = 0; i < ulCtPts; ++i) {
-        verts[i].i = i;
+    // Duplicated vertexes are merged with a hash table. To do this in parallel the vertexes are
+    // distributed over several shards by the top bits of their hash values and each shard gets
+    // its own table. Inside a shard the vertexes keep their order so that each vertex is mapped
+    // onto its first occurrence and the points of the mesh are in the order they were added.
+    constexpr std::uint32_t shardBits = 8;
+    constexpr std::size_t numShards = std::size_t(1) << shardBits;
+    constexpr std::size_t blockSize = 65536;
+    constexpr std::uint32_t invalid = std::numeric_limits<std::uint32_t>::max();
+
+    std::vector<float>& coords = p->coords;
+    std::size_t ulCtPts = coords.size() / 3;
+    if (ulCtPts >= invalid) {
+        throw Base::MemoryException();
     }
 
-    // std::sort(verts.begin(), verts.end());
-    int threads = int(std::thread::hardware_concurrency());
-    MeshCore::parallel_sort(verts.begin(), verts.end(), std::less<>(), threads);
-
-    QVector<FacetIndex> indices(ulCtPts);
-
-    size_type vertex_count = 0;
-    for (QVector<Private::Vertex>::iterator v = verts.begin(); v != verts.end(); ++v) {
-        if (!vertex_count || *v != verts[vertex_count - 1]) {
-            verts[vertex_count++] = *v;
+    // the hash values are replaced by the index of the first occurrence later on
+    std::vector<std::uint32_t> hashes(ulCtPts);
+    MeshCore::parallel_chunks(ulCtPts, blockSize, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            hashes[i] = p->hashOf(i);
         }
+    });
+
+    // sort the vertex indices by shards, keeping the order inside a shard
+    std::size_t numBlocks = (ulCtPts + blockSize - 1) / blockSize;
+    std::vector<std::size_t> offsets(numBlocks * numShards + 1);
+    MeshCore::parallel_chunks(numBlocks, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t block = begin; block < end; block++) {
+            std::size_t last = std::min(ulCtPts, (block + 1) * blockSize);
+            for (std::size_t i = block * blockSize; i < last; i++) {
+                offsets[(hashes[i] >> (32 - shardBits)) * numBlocks + block + 1]++;
+            }
+        }
+    });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    std::vector<std::uint32_t> order(ulCtPts);
+    MeshCore::parallel_chunks(numBlocks, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t block = begin; block < end; block++) {
+            std::vector<std::size_t> pos(numShards);
+            for (std::size_t shard = 0; shard < numShards; shard++) {
+                pos[shard] = offsets[shard * numBlocks + block];
+            }
+            std::size_t last = std::min(ulCtPts, (block + 1) * blockSize);
+            for (std::size_t i = block * blockSize; i < last; i++) {
+                order[pos[hashes[i] >> (32 - shardBits)]++] = static_cast<std::uint32_t>(i);
+            }
+        }
+    });
+
+    // look up each vertex in the table of its shard
+    MeshCore::parallel_chunks(numShards, 1, [&](std::size_t begin, std::size_t end) {
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> table;
+        for (std::size_t shard = begin; shard < end; shard++) {
+            std::size_t first = offsets[shard * numBlocks];
+            std::size_t last = offsets[(shard + 1) * numBlocks];
+            std::size_t size = 16;
+            while (size < 2 * (last - first)) {
+                size *= 2;
+            }
+            std::size_t mask = size - 1;
+            table.assign(size, std::make_pair(invalid, 0));
+
+            for (std::size_t i = first; i < last; i++) {
+                std::uint32_t index = order[i];
+                std::uint32_t hash = hashes[index];
+                std::size_t slot = hash & mask;
+                while (true) {
+                    auto& entry = table[slot];
+                    if (entry.first == invalid) {
+                        entry = std::make_pair(index, hash);
+                        hashes[index] = index;
+                        break;
+                    }
+                    if (entry.second == hash && p->isEqual(entry.first, index)) {
+                        hashes[index] = entry.first;
+                        break;
+                    }
+                    slot = (slot + 1) & mask;
+                }
+            }
+        }
+    });
+
+    std::vector<std::uint32_t>& firstIndex = hashes;
+
+    // number the unique vertexes in order of their occurrence
+    std::vector<std::size_t> counts(numBlocks + 1);
+    MeshCore::parallel_chunks(numBlocks, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t block = begin; block < end; block++) {
+            std::size_t last = std::min(ulCtPts, (block + 1) * blockSize);
+            for (std::size_t i = block * blockSize; i < last; i++) {
+                if (firstIndex[i] == i) {
+                    counts[block + 1]++;
+                }
+            }
+        }
+    });
+    std::partial_sum(counts.begin(), counts.end(), counts.begin());
+
+    MeshPointArray rPoints(counts.back());
+    std::vector<std::uint32_t>& pointIndex = order;
+    MeshCore::parallel_chunks(numBlocks, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t block = begin; block < end; block++) {
+            std::size_t pos = counts[block];
+            std::size_t last = std::min(ulCtPts, (block + 1) * blockSize);
+            for (std::size_t i = block * blockSize; i < last; i++) {
+                if (firstIndex[i] == i) {
+                    rPoints[pos].Set(coords[3 * i], coords[3 * i + 1], coords[3 * i + 2]);
+                    pointIndex[i] = static_cast<std::uint32_t>(pos++);
+                }
+            }
+        }
+    });
 
-        indices[v->i] = static_cast<FacetIndex>(vertex_count - 1);
-    }
-
-    size_type ulCt = verts.size() / 3;
-    MeshFacetArray rFacets(static_cast<FacetIndex>(ulCt));
-    for (size_type i = 0; i < ulCt; ++i) {
-        rFacets[static_cast<size_t>(i)]._aulPoints[0] = indices[3 * i];
-        rFacets[static_cast<size_t>(i)]._aulPoints[1] = indices[3 * i + 1];
-        rFacets[static_cast<size_t>(i)]._aulPoints[2] = indices[3 * i + 2];
-    }
+    // the coordinates are no longer needed
+    std::vector<float>().swap(coords);
 
-    verts.resize(vertex_count);
+    std::size_t ulCt = ulCtPts / 3;
+    MeshFacetArray rFacets(ulCt);
+    MeshCore::parallel_chunks(ulCt, blockSize, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            for (std::size_t j = 0; j < 3; j++) {
+                rFacets[i]._aulPoints[j] = pointIndex[firstIndex[3 * i + j]];
+            }
+        }
+    });
 
-    MeshPointArray rPoints;
-    rPoints.reserve(static_cast<size_t>(vertex_count));
-    for (const auto& v : verts) {
-        rPoints.push_back(MeshPoint(v.x, v.y, v.z));
-    }
+    std::vector<std::uint32_t>().swap(firstIndex);
+    std::vector<std::uint32_t>().swap(pointIndex);
 
     _meshKernel.Adopt(rPoints, rFacets, true);
 }
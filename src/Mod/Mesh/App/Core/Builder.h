@@ -191,6 +191,9 @@ private:
  * ...
  * builder.Finish();
  * \endcode
+ * The points of the facets are only stored compactly while adding them. Finish() merges
+ * equal points in parallel with a hash table and builds the point and facet arrays of the
+ * kernel directly. The points keep the order of their first occurrence.
  * @author Werner Mayer
  */
 class MeshExport MeshFastBuilder
@@ -0,0 +1,330 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <limits>
+#endif
+
+#include <Base/Exception.h>
+#include <Base/Matrix.h>
+
+#include "CompactKernel.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+MeshBitset::MeshBitset(std::size_t size)
+    : _size(size)
+{}
+
+void MeshBitset::Resize(std::size_t size)
+{
+    _size = size;
+    Release();
+}
+
+void MeshBitset::Release()
+{
+    std::vector<std::uint64_t>().swap(_bits);
+}
+
+void MeshBitset::Set(std::size_t index)
+{
+    if (!IsAllocated()) {
+        _bits.resize((_size + 63) / 64, 0);
+    }
+    _bits[index / 64] |= std::uint64_t(1) << (index % 64);
+}
+
+void MeshBitset::Reset(std::size_t index)
+{
+    if (IsAllocated()) {
+        _bits[index / 64] &= ~(std::uint64_t(1) << (index % 64));
+    }
+}
+
+void MeshBitset::SetAll()
+{
+    _bits.assign((_size + 63) / 64, ~std::uint64_t(0));
+    // clear the unused bits of the last word so that Count() stays correct
+    if (std::size_t rest = _size % 64) {
+        _bits.back() = (std::uint64_t(1) << rest) - 1;
+    }
+}
+
+void MeshBitset::ResetAll()
+{
+    if (IsAllocated()) {
+        std::fill(_bits.begin(), _bits.end(), 0);
+    }
+}
+
+std::size_t MeshBitset::Count() const
+{
+    std::size_t count = 0;
+    for (std::uint64_t word : _bits) {
+        while (word) {
+            word &= word - 1;
+            ++count;
+        }
+    }
+    return count;
+}
+
+// ----------------------------------------------------------------------------
+
+MeshCompactKernel::MeshCompactKernel(const MeshKernel& rclMesh)
+{
+    Assign(rclMesh);
+}
+
+std::size_t MeshCompactKernel::FlagPosition(unsigned char flag)
+{
+    std::size_t pos = 0;
+    while (flag > 1) {
+        flag >>= 1;
+        ++pos;
+    }
+    return pos;
+}
+
+void MeshCompactKernel::Assign(const MeshKernel& rclMesh)
+{
+    const MeshPointArray& points = rclMesh.GetPoints();
+    const MeshFacetArray& facets = rclMesh.GetFacets();
+    if (points.size() >= INDEX_MAX || facets.size() >= INDEX_MAX) {
+        throw Base::ValueError("Mesh has too many elements for a compact kernel");
+    }
+
+    Clear();
+    std::size_t numPoints = points.size();
+    std::size_t numFacets = facets.size();
+
+    _coords.resize(3 * numPoints);
+    unsigned char pointFlags = 0;
+    bool pointProps = false;
+    for (std::size_t i = 0; i < numPoints; i++) {
+        const MeshPoint& pnt = points[i];
+        _coords[3 * i] = pnt.x;
+        _coords[3 * i + 1] = pnt.y;
+        _coords[3 * i + 2] = pnt.z;
+        pointFlags |= pnt._ucFlag;
+        pointProps = pointProps || pnt._ulProp != 0;
+    }
+
+    _indices.resize(3 * numFacets);
+    _neighbours.resize(3 * numFacets);
+    unsigned char facetFlags = 0;
+    bool facetProps = false;
+    for (std::size_t i = 0; i < numFacets; i++) {
+        const MeshFacet& face = facets[i];
+        for (int j = 0; j < 3; j++) {
+            _indices[3 * i + j] = Index(face._aulPoints[j]);
+            FacetIndex nb = face._aulNeighbours[j];
+            _neighbours[3 * i + j] = nb == FACET_INDEX_MAX ? INDEX_MAX : Index(nb);
+        }
+        facetFlags |= face._ucFlag;
+        facetProps = facetProps || face._ulProp != 0;
+    }
+
+    for (auto& it : _pointFlags) {
+        it.Resize(numPoints);
+    }
+    for (auto& it : _facetFlags) {
+        it.Resize(numFacets);
+    }
+
+    // only allocate the bits of flags that are in use
+    for (std::size_t pos = 0; pos < 8; pos++) {
+        unsigned char flag = static_cast<unsigned char>(1 << pos);
+        if (pointFlags & flag) {
+            for (std::size_t i = 0; i < numPoints; i++) {
+                if (points[i]._ucFlag & flag) {
+                    _pointFlags[pos].Set(i);
+                }
+            }
+        }
+        if (facetFlags & flag) {
+            for (std::size_t i = 0; i < numFacets; i++) {
+                if (facets[i]._ucFlag & flag) {
+                    _facetFlags[pos].Set(i);
+                }
+            }
+        }
+    }
+
+    if (pointProps) {
+        _pointProps.resize(numPoints);
+        for (std::size_t i = 0; i < numPoints; i++) {
+            _pointProps[i] = points[i]._ulProp;
+        }
+    }
+    if (facetProps) {
+        _facetProps.resize(numFacets);
+        for (std::size_t i = 0; i < numFacets; i++) {
+            _facetProps[i] = facets[i]._ulProp;
+        }
+    }
+}
+
+void MeshCompactKernel::CopyTo(MeshKernel& rclMesh) const
+{
+    std::size_t numPoints = CountPoints();
+    std::size_t numFacets = CountFacets();
+
+    MeshPointArray points(numPoints);
+    for (std::size_t i = 0; i < numPoints; i++) {
+        MeshPoint& pnt = points[i];
+        pnt.Set(_coords[3 * i], _coords[3 * i + 1], _coords[3 * i + 2]);
+        unsigned char flag = 0;
+        for (std::size_t pos = 0; pos < 8; pos++) {
+            if (_pointFlags[pos].Test(i)) {
+                flag |= static_cast<unsigned char>(1 << pos);
+            }
+        }
+        pnt._ucFlag = flag;
+        pnt._ulProp = _pointProps.empty() ? 0 : _pointProps[i];
+    }
+
+    MeshFacetArray facets(numFacets);
+    for (std::size_t i = 0; i < numFacets; i++) {
+        MeshFacet& face = facets[i];
+        for (int j = 0; j < 3; j++) {
+            face._aulPoints[j] = _indices[3 * i + j];
+            Index nb = _neighbours[3 * i + j];
+            face._aulNeighbours[j] = nb == INDEX_MAX ? FACET_INDEX_MAX : FacetIndex(nb);
+        }
+        unsigned char flag = 0;
+        for (std::size_t pos = 0; pos < 8; pos++) {
+            if (_facetFlags[pos].Test(i)) {
+                flag |= static_cast<unsigned char>(1 << pos);
+            }
+        }
+        face._ucFlag = flag;
+        face._ulProp = _facetProps.empty() ? 0 : _facetProps[i];
+    }
+
+    rclMesh.Adopt(points, facets, false);
+}
+
+void MeshCompactKernel::Clear()
+{
+    std::vector<float>().swap(_coords);
+    std::vector<Index>().swap(_indices);
+    std::vector<Index>().swap(_neighbours);
+    for (auto& it : _pointFlags) {
+        it.Resize(0);
+    }
+    for (auto& it : _facetFlags) {
+        it.Resize(0);
+    }
+    std::vector<Property>().swap(_pointProps);
+    std::vector<Property>().swap(_facetProps);
+}
+
+MeshGeomFacet MeshCompactKernel::GetFacet(Index ulIndex) const
+{
+    const Index* pts = GetFacetPoints(ulIndex);
+    return MeshGeomFacet(GetPoint(pts[0]), GetPoint(pts[1]), GetPoint(pts[2]));
+}
+
+Base::BoundBox3f MeshCompactKernel::GetBoundBox() const
+{
+    Base::BoundBox3f box;
+    for (std::size_t i = 0; i < _coords.size(); i += 3) {
+        box.Add(Base::Vector3f(_coords[i], _coords[i + 1], _coords[i + 2]));
+    }
+    return box;
+}
+
+void MeshCompactKernel::Transform(const Base::Matrix4D& rclMat)
+{
+    for (std::size_t i = 0; i < _coords.size(); i += 3) {
+        Base::Vector3f pnt(_coords[i], _coords[i + 1], _coords[i + 2]);
+        pnt = rclMat * pnt;
+        _coords[i] = pnt.x;
+        _coords[i + 1] = pnt.y;
+        _coords[i + 2] = pnt.z;
+    }
+}
+
+MeshBitset& MeshCompactKernel::PointFlags(MeshPoint::TFlagType tF)
+{
+    return _pointFlags[FlagPosition(static_cast<unsigned char>(tF))];
+}
+
+const MeshBitset& MeshCompactKernel::PointFlags(MeshPoint::TFlagType tF) const
+{
+    return _pointFlags[FlagPosition(static_cast<unsigned char>(tF))];
+}
+
+MeshBitset& MeshCompactKernel::FacetFlags(MeshFacet::TFlagType tF)
+{
+    return _facetFlags[FlagPosition(static_cast<unsigned char>(tF))];
+}
+
+const MeshBitset& MeshCompactKernel::FacetFlags(MeshFacet::TFlagType tF) const
+{
+    return _facetFlags[FlagPosition(static_cast<unsigned char>(tF))];
+}
+
+std::vector<MeshCompactKernel::Property>& MeshCompactKernel::PointProperties()
+{
+    _pointProps.resize(CountPoints());
+    return _pointProps;
+}
+
+std::vector<MeshCompactKernel::Property>& MeshCompactKernel::FacetProperties()
+{
+    _facetProps.resize(CountFacets());
+    return _facetProps;
+}
+
+void MeshCompactKernel::ReleaseFlagsAndProperties()
+{
+    for (auto& it : _pointFlags) {
+        it.Release();
+    }
+    for (auto& it : _facetFlags) {
+        it.Release();
+    }
+    std::vector<Property>().swap(_pointProps);
+    std::vector<Property>().swap(_facetProps);
+}
+
+std::size_t MeshCompactKernel::GetMemSize() const
+{
+    std::size_t size = _coords.size() * sizeof(float);
+    size += (_indices.size() + _neighbours.size()) * sizeof(Index);
+    size += (_pointProps.size() + _facetProps.size()) * sizeof(Property);
+    for (const auto& it : _pointFlags) {
+        size += it.GetMemSize();
+    }
+    for (const auto& it : _facetFlags) {
+        size += it.GetMemSize();
+    }
+    return size;
+}
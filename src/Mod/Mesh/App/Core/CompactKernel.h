@@ -0,0 +1,202 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef MESH_COMPACTKERNEL_H
+#define MESH_COMPACTKERNEL_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "Elements.h"
+
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshBitset class keeps one bit per element. The bits are only allocated
+ * when a bit gets set for the first time, so unused flags do not cost any memory.
+ */
+class MeshExport MeshBitset
+{
+public:
+    explicit MeshBitset(std::size_t size = 0);
+
+    /// Changes the number of elements and releases the bits
+    void Resize(std::size_t size);
+    std::size_t Size() const
+    {
+        return _size;
+    }
+    bool IsAllocated() const
+    {
+        return !_bits.empty();
+    }
+    /// Frees the memory, all bits are reset afterwards
+    void Release();
+
+    bool Test(std::size_t index) const
+    {
+        return IsAllocated() && (_bits[index / 64] & (std::uint64_t(1) << (index % 64))) != 0;
+    }
+    void Set(std::size_t index);
+    void Reset(std::size_t index);
+    void SetAll();
+    void ResetAll();
+    /// Returns the number of set bits
+    std::size_t Count() const;
+    std::size_t GetMemSize() const
+    {
+        return _bits.size() * sizeof(std::uint64_t);
+    }
+
+private:
+    std::size_t _size;
+    std::vector<std::uint64_t> _bits;
+};
+
+/**
+ * The MeshCompactKernel class stores a mesh as structure of arrays. The point
+ * coordinates are packed as xyz triples and the corner points and neighbours of
+ * the facets are stored as 32-bit indices. Flags and properties are kept apart in
+ * optional arrays that are only allocated when an algorithm needs them.
+ * Compared to MeshKernel this reduces the memory of a facet from 64 to 24 bytes
+ * and of a point from 24 to 12 bytes on 64-bit platforms.
+ *
+ * Algorithms that work on a MeshKernel can be used with CopyTo() and Assign(),
+ * which convert between both layouts including flags and properties.
+ */
+class MeshExport MeshCompactKernel
+{
+public:
+    using Index = std::uint32_t;
+    /// The same type as the properties of MeshPoint and MeshFacet, so no value gets truncated
+    using Property = unsigned long;
+    static constexpr Index INDEX_MAX = UINT32_MAX;
+
+    /** @name Construction */
+    //@{
+    MeshCompactKernel() = default;
+    explicit MeshCompactKernel(const MeshKernel& rclMesh);
+    //@}
+
+    /** @name Conversion */
+    //@{
+    /** Converts the mesh kernel into the compact layout. The flags and properties
+     * are only kept if any element uses them.
+     * Throws a Base::ValueError if the mesh has too many elements for 32-bit indices.
+     */
+    void Assign(const MeshKernel& rclMesh);
+    /// Builds up a mesh kernel to be used with the existing algorithms.
+    void CopyTo(MeshKernel& rclMesh) const;
+    void Clear();
+    //@}
+
+    /** @name Geometry and topology */
+    //@{
+    std::size_t CountPoints() const
+    {
+        return _coords.size() / 3;
+    }
+    std::size_t CountFacets() const
+    {
+        return _indices.size() / 3;
+    }
+    Base::Vector3f GetPoint(Index ulIndex) const
+    {
+        const float* xyz = &_coords[3 * std::size_t(ulIndex)];
+        return Base::Vector3f(xyz[0], xyz[1], xyz[2]);
+    }
+    void SetPoint(Index ulIndex, const Base::Vector3f& rclPt)
+    {
+        float* xyz = &_coords[3 * std::size_t(ulIndex)];
+        xyz[0] = rclPt.x;
+        xyz[1] = rclPt.y;
+        xyz[2] = rclPt.z;
+    }
+    /// Returns the three corner point indices of the facet
+    const Index* GetFacetPoints(Index ulIndex) const
+    {
+        return &_indices[3 * std::size_t(ulIndex)];
+    }
+    /// Returns the three neighbour indices of the facet, INDEX_MAX if there is none
+    const Index* GetFacetNeighbours(Index ulIndex) const
+    {
+        return &_neighbours[3 * std::size_t(ulIndex)];
+    }
+    MeshGeomFacet GetFacet(Index ulIndex) const;
+    Base::BoundBox3f GetBoundBox() const;
+    void Transform(const Base::Matrix4D& rclMat);
+    /// Packed xyz coordinates of all points
+    const std::vector<float>& GetCoordinates() const
+    {
+        return _coords;
+    }
+    const std::vector<Index>& GetIndices() const
+    {
+        return _indices;
+    }
+    const std::vector<Index>& GetNeighbours() const
+    {
+        return _neighbours;
+    }
+    //@}
+
+    /** @name Flags and properties */
+    //@{
+    /// The bits of the given point flag, allocated on first use
+    MeshBitset& PointFlags(MeshPoint::TFlagType tF);
+    const MeshBitset& PointFlags(MeshPoint::TFlagType tF) const;
+    /// The bits of the given facet flag, allocated on first use
+    MeshBitset& FacetFlags(MeshFacet::TFlagType tF);
+    const MeshBitset& FacetFlags(MeshFacet::TFlagType tF) const;
+    /// The point properties, allocated with the first call
+    std::vector<Property>& PointProperties();
+    /// The facet properties, allocated with the first call
+    std::vector<Property>& FacetProperties();
+    /// Frees all flags and properties
+    void ReleaseFlagsAndProperties();
+    //@}
+
+    /// Returns the number of required memory in bytes
+    std::size_t GetMemSize() const;
+
+private:
+    static std::size_t FlagPosition(unsigned char flag);
+
+private:
+    std::vector<float> _coords;
+    std::vector<Index> _indices;
+    std::vector<Index> _neighbours;
+    std::array<MeshBitset, 8> _pointFlags;
+    std::array<MeshBitset, 8> _facetFlags;
+    std::vector<Property> _pointProps;
+    std::vector<Property> _facetProps;
+};
+
+}  // namespace MeshCore
+
+#endif  // MESH_COMPACTKERNEL_H
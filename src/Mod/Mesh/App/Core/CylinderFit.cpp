@@ -66,10 +66,17 @@
 #include <Mod/Mesh/App/WildMagic4/Wm4ApprLineFit3.h>
 
 #include "CylinderFit.h"
+#include "Functional.h"
 
 
 using namespace MeshCoreFit;
 
+namespace
+{
+// the observations of fewer points are summed up on a single thread
+constexpr std::size_t MinChunkSize = 2048;
+}  // namespace
+
 CylinderFit::CylinderFit()
     : _vBase(0, 0, 0)
     , _vAxis(0, 0, 1)
@@ -293,6 +300,7 @@ float CylinderFit::Fit()
     // Initialise some matrices and vectors
     const int dim = 5;
     std::vector<Base::Vector3d> residuals(CountPoints(), Base::Vector3d(0.0, 0.0, 0.0));
+    std::vector<Base::Vector3f> points(_vPoints.begin(), _vPoints.end());
     Matrix5x5 atpa;
     Eigen::VectorXd atpl(dim);
 
@@ -303,7 +311,7 @@ float CylinderFit::Fit()
         ++_numIter;
 
         // Set up the quasi parametric normal equations
-        setupNormalEquationMatrices(solDir, residuals, atpa, atpl);
+        setupNormalEquationMatrices(solDir, points, residuals, atpa, atpl);
 
         // Solve the equations for the unknown corrections
         Eigen::LLT<Matrix5x5> llt(atpa);
@@ -326,7 +334,7 @@ float CylinderFit::Fit()
         // Before updating the unknowns, compute the residuals and sigma0 and check the residual
         // convergence
         bool vConverged {};
-        if (!computeResiduals(solDir, x, residuals, sigma0, _vConvLimit, vConverged)) {
+        if (!computeResiduals(solDir, points, x, residuals, sigma0, _vConvLimit, vConverged)) {
             return FLOAT_MAX;
         }
         if (!vConverged) {
@@ -447,27 +455,45 @@ double CylinderFit::meanZObs()
 // atpa ... 5x5 normal matrix
 // atpl ... 5x1 matrix (right-hand side of equation)
 void CylinderFit::setupNormalEquationMatrices(SolutionD solDir,
+                                              const std::vector<Base::Vector3f>& points,
                                               const std::vector<Base::Vector3d>& residuals,
                                               Matrix5x5& atpa,
                                               Eigen::VectorXd& atpl) const
 {
-    // Zero matrices
-    atpa.setZero();
-    atpl.setZero();
+    const int dim = 5;
+    struct NormalEquations
+    {
+        Matrix5x5 atpa;
+        Eigen::VectorXd atpl;
+    };
 
     // For each point, setup the observation equation coefficients and add their
-    // contribution into the normal equation matrices
-    DoubleArray5 a {};
-    DoubleArray3 b {};
-    double f0 {};
-    double qw {};
-    auto vIt = residuals.begin();
-    for (auto cIt = _vPoints.begin(); cIt != _vPoints.end(); ++cIt, ++vIt) {
-        // if (using this point) { // currently all given points are used (could modify this if
-        // eliminating outliers, etc....
-        setupObservation(solDir, *cIt, *vIt, a, f0, qw, b);
-        addObservationU(a, f0, qw, atpa, atpl);
-        // }
+    // contribution into the normal equation matrices of its chunk
+    auto parts = MeshCore::parallel_partials(
+        points.size(),
+        MinChunkSize,
+        [&](std::size_t begin, std::size_t end) {
+            NormalEquations part {Matrix5x5::Zero(), Eigen::VectorXd::Zero(dim)};
+            DoubleArray5 a {};
+            DoubleArray3 b {};
+            double f0 {};
+            double qw {};
+            for (std::size_t i = begin; i < end; ++i) {
+                // if (using this point) { // currently all given points are used (could modify
+                // this if eliminating outliers, etc....
+                setupObservation(solDir, points[i], residuals[i], a, f0, qw, b);
+                addObservationU(a, f0, qw, part.atpa, part.atpl);
+                // }
+            }
+            return part;
+        });
+
+    // Zero matrices and add up the chunks
+    atpa.setZero();
+    atpl.setZero();
+    for (const auto& it : parts) {
+        atpa += it.atpa;
+        atpl += it.atpl;
     }
     setLowerPart(atpa);
 }
@@ -619,6 +645,7 @@ void CylinderFit::setLowerPart(Matrix5x5& atpa) const
 
 // Compute the residuals and sigma0 and check the residual convergence
 bool CylinderFit::computeResiduals(SolutionD solDir,
+                                   const std::vector<Base::Vector3f>& points,
                                    const Eigen::VectorXd& x,
                                    std::vector<Base::Vector3d>& residuals,
                                    double& sigma0,
@@ -628,60 +655,57 @@ bool CylinderFit::computeResiduals(SolutionD solDir,
     const int dim = 5;
     // A minimum of 5 surface points is needed to define a cylinder
     const int minPts = 5;
+    struct Partial
+    {
+        double sigma0;
+        bool converged;
+    };
+
+    auto parts = MeshCore::parallel_partials(
+        points.size(),
+        MinChunkSize,
+        [&](std::size_t begin, std::size_t end) {
+            Partial part {0.0, true};
+            DoubleArray5 a {};
+            DoubleArray3 b {};
+            double f0 {};
+            double qw {};
+            for (std::size_t i = begin; i < end; ++i) {
+                Base::Vector3d& v = residuals[i];
+                setupObservation(solDir, points[i], v, a, f0, qw, b);
+                double qv = -f0;
+                for (int j = 0; j < dim; ++j) {
+                    qv += a[j] * x(j);
+                }
+
+                // We are using equal weights for cylinder point coordinate observations (see
+                // setupObservation) i.e. w[0] = w[1] = w[2] = 1.0;
+                double vx = -qw * qv * b[0];
+                double vy = -qw * qv * b[1];
+                double vz = -qw * qv * b[2];
+                double dVx = fabs(vx - v.x);
+                double dVy = fabs(vy - v.y);
+                double dVz = fabs(vz - v.z);
+                v.x = vx;
+                v.y = vy;
+                v.z = vz;
+
+                part.sigma0 += v.x * v.x + v.y * v.y + v.z * v.z;
+
+                if ((dVx > vConvLimit) || (dVy > vConvLimit) || (dVz > vConvLimit)) {
+                    part.converged = false;
+                }
+            }
+            return part;
+        });
+
+    // currently all given points are used
+    int nPtsUsed = int(points.size());
     vConverged = true;
-    int nPtsUsed = 0;
     sigma0 = 0.0;
-    DoubleArray5 a {};
-    DoubleArray3 b {};
-    double f0 {};
-    double qw {};
-    // double maxdVx = 0.0;
-    // double maxdVy = 0.0;
-    // double maxdVz = 0.0;
-    // double rmsVv = 0.0;
-    auto vIt = residuals.begin();
-    for (auto cIt = _vPoints.begin(); cIt != _vPoints.end(); ++cIt, ++vIt) {
-        // if (using this point) { // currently all given points are used (could modify this if
-        // eliminating outliers, etc....
-        ++nPtsUsed;
-        Base::Vector3d& v = *vIt;
-        setupObservation(solDir, *cIt, v, a, f0, qw, b);
-        double qv = -f0;
-        for (int i = 0; i < dim; ++i) {
-            qv += a[i] * x(i);
-        }
-
-        // We are using equal weights for cylinder point coordinate observations (see
-        // setupObservation) i.e. w[0] = w[1] = w[2] = 1.0;
-        // double vx = -qw * qv * b[0] / w[0];
-        // double vy = -qw * qv * b[1] / w[1];
-        // double vz = -qw * qv * b[2] / w[2];
-        double vx = -qw * qv * b[0];
-        double vy = -qw * qv * b[1];
-        double vz = -qw * qv * b[2];
-        double dVx = fabs(vx - v.x);
-        double dVy = fabs(vy - v.y);
-        double dVz = fabs(vz - v.z);
-        v.x = vx;
-        v.y = vy;
-        v.z = vz;
-
-        // double vv = v.x * v.x + v.y * v.y + v.z * v.z;
-        // rmsVv += vv * vv;
-
-        // sigma0 += v.x * w[0] * v.x + v.y * w[1] * v.y + v.z * w[2] * v.z;
-        sigma0 += v.x * v.x + v.y * v.y + v.z * v.z;
-
-        if ((dVx > vConvLimit) || (dVy > vConvLimit) || (dVz > vConvLimit)) {
-            vConverged = false;
-        }
-
-        // if (dVx > maxdVx)
-        //	maxdVx = dVx;
-        // if (dVy > maxdVy)
-        //	maxdVy = dVy;
-        // if (dVz > maxdVz)
-        //	maxdVz = dVz;
+    for (const auto& it : parts) {
+        sigma0 += it.sigma0;
+        vConverged = vConverged && it.converged;
     }
 
     // Compute degrees of freedom and sigma0
@@ -697,10 +721,6 @@ bool CylinderFit::computeResiduals(SolutionD solDir,
         sigma0 = sqrt(sigma0 / (double)df);
     }
 
-    // rmsVv = sqrt(rmsVv / (double)nPtsUsed);
-    // Base::Console().Message("X: %0.3e %0.3e %0.3e %0.3e %0.3e , Max dV: %0.4f %0.4f %0.4f , RMS
-    // Vv: %0.4f\n", x(0), x(1), x(2), x(3), x(4), maxdVx, maxdVy, maxdVz, rmsVv);
-
     return true;
 }
 
@@ -137,6 +137,7 @@ protected:
      * Set up the normal equations
      */
     void setupNormalEquationMatrices(SolutionD solDir,
+                                     const std::vector<Base::Vector3f>& points,
                                      const std::vector<Base::Vector3d>& residuals,
                                      Matrix5x5& atpa,
                                      Eigen::VectorXd& atpl) const;
@@ -167,6 +168,7 @@ protected:
      * Compute the residuals and sigma0 and check the residual convergence
      */
     bool computeResiduals(SolutionD solDir,
+                          const std::vector<Base::Vector3f>& points,
                           const Eigen::VectorXd& x,
                           std::vector<Base::Vector3d>& residuals,
                           double& sigma0,
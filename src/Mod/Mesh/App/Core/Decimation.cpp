@@ -22,6 +22,15 @@
 
 #include "PreCompiled.h"
 
+#ifndef _PreComp_
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <numeric>
+#include <thread>
+#include <vector>
+#endif
+
 #include "Decimation.h"
 #include "MeshKernel.h"
 #include "Simplify.h"
@@ -29,117 +38,253 @@
 
 using namespace MeshCore;
 
+namespace
+{
+// Splitting smaller meshes doesn't pay off
+const std::size_t minPartitionSize = 4096;
+
+void addVertex(Simplify& alg, const Base::Vector3f& pnt, int id, bool locked)
+{
+    Simplify::Vertex v;
+    v.tstart = 0;
+    v.tcount = 0;
+    v.border = 0;
+    v.locked = locked ? 1 : 0;
+    v.id = id;
+    v.p = pnt;
+    alg.vertices.push_back(v);
+}
+
+void addTriangle(Simplify& alg, int v0, int v1, int v2)
+{
+    Simplify::Triangle t;
+    t.deleted = 0;
+    t.dirty = 0;
+    for (double& j : t.err) {
+        j = 0.0;
+    }
+    t.v[0] = v0;
+    t.v[1] = v1;
+    t.v[2] = v2;
+    alg.triangles.push_back(t);
+}
+
+// Recursively splits the facets in [begin, end) at the median of their centres along the
+// longest axis and appends the end of each partition to bounds
+void splitFacets(const std::vector<Base::Vector3f>& centers,
+                 std::vector<FacetIndex>& order,
+                 std::size_t begin,
+                 std::size_t end,
+                 std::size_t numParts,
+                 std::vector<std::size_t>& bounds)
+{
+    if (numParts < 2) {
+        bounds.push_back(end);
+        return;
+    }
+
+    Base::BoundBox3f box;
+    for (std::size_t i = begin; i < end; i++) {
+        box.Add(centers[order[i]]);
+    }
+
+    int axis = 0;
+    if (box.LengthY() > box.LengthX()) {
+        axis = 1;
+    }
+    if (box.LengthZ() > std::max(box.LengthX(), box.LengthY())) {
+        axis = 2;
+    }
+
+    std::size_t leftParts = numParts / 2;
+    std::size_t mid = begin + (end - begin) * leftParts / numParts;
+    std::nth_element(order.begin() + std::ptrdiff_t(begin),
+                     order.begin() + std::ptrdiff_t(mid),
+                     order.begin() + std::ptrdiff_t(end),
+                     [&centers, axis](FacetIndex a, FacetIndex b) {
+                         return centers[a][axis] < centers[b][axis];
+                     });
+
+    splitFacets(centers, order, begin, mid, leftParts, bounds);
+    splitFacets(centers, order, mid, end, numParts - leftParts, bounds);
+}
+}  // namespace
+
 MeshSimplify::MeshSimplify(MeshKernel& mesh)
     : myKernel(mesh)
 {}
 
+void MeshSimplify::setThreadCount(int count)
+{
+    threadCount = count;
+}
+
 void MeshSimplify::simplify(float tolerance, float reduction)
 {
+    std::size_t numFacets = myKernel.CountFacets();
+    int target_count = static_cast<int>(static_cast<float>(numFacets) * (1.0F - reduction));
+    simplify(target_count, tolerance);
+}
+
+void MeshSimplify::simplify(int targetSize)
+{
+    simplify(targetSize, FLT_MAX);
+}
+
+void MeshSimplify::simplify(int targetSize, float tolerance)
+{
+    std::size_t numFacets = myKernel.CountFacets();
+    std::size_t threads = threadCount > 0
+        ? std::size_t(threadCount)
+        : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    std::size_t numParts = std::min(threads, numFacets / minPartitionSize);
+    if (numParts > 1 && targetSize >= 0 && std::size_t(targetSize) < numFacets) {
+        simplifyPartitions(targetSize, tolerance, numParts);
+        return;
+    }
+
     Simplify alg;
 
     const MeshPointArray& points = myKernel.GetPoints();
-    for (std::size_t i = 0; i < points.size(); i++) {
-        Simplify::Vertex v;
-        v.tstart = 0;
-        v.tcount = 0;
-        v.border = 0;
-        v.p = points[i];
-        alg.vertices.push_back(v);
+    alg.vertices.reserve(points.size());
+    for (const auto& point : points) {
+        addVertex(alg, point, -1, false);
     }
 
     const MeshFacetArray& facets = myKernel.GetFacets();
-    for (std::size_t i = 0; i < facets.size(); i++) {
-        Simplify::Triangle t;
-        t.deleted = 0;
-        t.dirty = 0;
-        for (double& j : t.err) {
-            j = 0.0;
-        }
-        for (int j = 0; j < 3; j++) {
-            t.v[j] = facets[i]._aulPoints[j];
-        }
-        alg.triangles.push_back(t);
+    alg.triangles.reserve(facets.size());
+    for (const auto& facet : facets) {
+        addTriangle(alg,
+                    static_cast<int>(facet._aulPoints[0]),
+                    static_cast<int>(facet._aulPoints[1]),
+                    static_cast<int>(facet._aulPoints[2]));
     }
 
-    int target_count = static_cast<int>(static_cast<float>(facets.size()) * (1.0F - reduction));
-
     // Simplification starts
-    alg.simplify_mesh(target_count, tolerance);
+    alg.simplify_mesh(targetSize, tolerance);
 
     // Simplification done
-    MeshPointArray new_points;
-    new_points.reserve(alg.vertices.size());
-    for (const auto& vertex : alg.vertices) {
-        new_points.push_back(vertex.p);
+    adopt(alg);
+}
+
+void MeshSimplify::simplifyPartitions(int targetSize, float tolerance, std::size_t numParts)
+{
+    const MeshPointArray& points = myKernel.GetPoints();
+    const MeshFacetArray& facets = myKernel.GetFacets();
+
+    std::vector<Base::Vector3f> centers;
+    centers.reserve(facets.size());
+    for (const auto& facet : facets) {
+        centers.push_back((points[facet._aulPoints[0]] + points[facet._aulPoints[1]]
+                           + points[facet._aulPoints[2]])
+                          / 3.0F);
     }
 
-    std::size_t numFacets = 0;
-    for (const auto& triangle : alg.triangles) {
-        if (!triangle.deleted) {
-            numFacets++;
+    std::vector<FacetIndex> order(facets.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::vector<std::size_t> bounds {0};
+    splitFacets(centers, order, 0, order.size(), numParts, bounds);
+
+    // points that are used by several partitions must neither be moved nor removed
+    const std::size_t noPart = numParts;
+    std::vector<std::size_t> owner(points.size(), noPart);
+    std::vector<char> locked(points.size(), 0);
+    for (std::size_t part = 0; part < numParts; part++) {
+        for (std::size_t i = bounds[part]; i < bounds[part + 1]; i++) {
+            for (PointIndex pt : facets[order[i]]._aulPoints) {
+                if (owner[pt] == noPart) {
+                    owner[pt] = part;
+                }
+                else if (owner[pt] != part) {
+                    locked[pt] = 1;
+                }
+            }
         }
     }
-    MeshFacetArray new_facets;
-    new_facets.reserve(numFacets);
-    for (const auto& triangle : alg.triangles) {
-        if (!triangle.deleted) {
-            MeshFacet face;
-            face._aulPoints[0] = triangle.v[0];
-            face._aulPoints[1] = triangle.v[1];
-            face._aulPoints[2] = triangle.v[2];
-            new_facets.push_back(face);
+
+    // simplify the partitions independently
+    float ratio = float(targetSize) / float(facets.size());
+    std::vector<Simplify> algs(numParts);
+    auto simplifyPart = [&](std::size_t part) {
+        Simplify& alg = algs[part];
+        std::size_t begin = bounds[part];
+        std::size_t end = bounds[part + 1];
+
+        std::vector<PointIndex> ids;
+        ids.reserve(3 * (end - begin));
+        for (std::size_t i = begin; i < end; i++) {
+            const MeshFacet& facet = facets[order[i]];
+            ids.insert(ids.end(), std::begin(facet._aulPoints), std::end(facet._aulPoints));
         }
-    }
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
 
-    myKernel.Adopt(new_points, new_facets, true);
-}
+        alg.vertices.reserve(ids.size());
+        for (PointIndex id : ids) {
+            addVertex(alg, points[id], static_cast<int>(id), locked[id] != 0);
+        }
 
-void MeshSimplify::simplify(int targetSize)
-{
-    Simplify alg;
+        auto local = [&ids](PointIndex id) {
+            return static_cast<int>(std::lower_bound(ids.begin(), ids.end(), id) - ids.begin());
+        };
+        alg.triangles.reserve(end - begin);
+        for (std::size_t i = begin; i < end; i++) {
+            const MeshFacet& facet = facets[order[i]];
+            addTriangle(alg,
+                        local(facet._aulPoints[0]),
+                        local(facet._aulPoints[1]),
+                        local(facet._aulPoints[2]));
+        }
 
-    const MeshPointArray& points = myKernel.GetPoints();
-    for (std::size_t i = 0; i < points.size(); i++) {
-        Simplify::Vertex v;
-        v.tstart = 0;
-        v.tcount = 0;
-        v.border = 0;
-        v.p = points[i];
-        alg.vertices.push_back(v);
+        int target = static_cast<int>(std::ceil(ratio * float(end - begin)));
+        alg.simplify_mesh(target, tolerance);
+    };
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(numParts - 1);
+    for (std::size_t part = 1; part < numParts; part++) {
+        futures.push_back(std::async(std::launch::async, simplifyPart, part));
+    }
+    simplifyPart(0);
+    for (auto& future : futures) {
+        future.get();
     }
 
-    const MeshFacetArray& facets = myKernel.GetFacets();
-    for (std::size_t i = 0; i < facets.size(); i++) {
-        Simplify::Triangle t;
-        t.deleted = 0;
-        t.dirty = 0;
-        for (double& j : t.err) {
-            j = 0.0;
+    // merge the partitions, the locked points are shared by their original index
+    Simplify merged;
+    std::vector<int> index(points.size(), -1);
+    for (auto& alg : algs) {
+        std::vector<int> local(alg.vertices.size());
+        for (std::size_t i = 0; i < alg.vertices.size(); i++) {
+            const Simplify::Vertex& v = alg.vertices[i];
+            int& pos = index[v.id];
+            if (pos < 0) {
+                pos = static_cast<int>(merged.vertices.size());
+                addVertex(merged, v.p, -1, false);
+            }
+            local[i] = pos;
         }
-        for (int j = 0; j < 3; j++) {
-            t.v[j] = facets[i]._aulPoints[j];
+        for (const auto& t : alg.triangles) {
+            addTriangle(merged, local[t.v[0]], local[t.v[1]], local[t.v[2]]);
         }
-        alg.triangles.push_back(t);
+        alg = Simplify();
     }
 
-    // Simplification starts
-    alg.simplify_mesh(targetSize, FLT_MAX);
+    // simplify along the seams of the partitions
+    merged.simplify_mesh(targetSize, tolerance);
+    adopt(merged);
+}
 
-    // Simplification done
+void MeshSimplify::adopt(const Simplify& alg)
+{
     MeshPointArray new_points;
     new_points.reserve(alg.vertices.size());
     for (const auto& vertex : alg.vertices) {
         new_points.push_back(vertex.p);
     }
 
-    std::size_t numFacets = 0;
-    for (const auto& triangle : alg.triangles) {
-        if (!triangle.deleted) {
-            numFacets++;
-        }
-    }
     MeshFacetArray new_facets;
-    new_facets.reserve(numFacets);
+    new_facets.reserve(alg.triangles.size());
     for (const auto& triangle : alg.triangles) {
         if (!triangle.deleted) {
             MeshFacet face;
@@ -24,21 +24,39 @@
 #ifndef MESH_DECIMATION_H
 #define MESH_DECIMATION_H
 
+#include <cstddef>
+
 #include <Mod/Mesh/MeshGlobal.h>
 
+class Simplify;
+
 namespace MeshCore
 {
 class MeshKernel;
 
+/**
+ * The MeshSimplify class reduces the number of facets of a mesh with the quadric error metric.
+ * Large meshes are split into spatial partitions that are simplified on several threads. The
+ * vertices shared by different partitions are kept fixed and the remaining seams are
+ * simplified in a final pass over the merged mesh.
+ */
 class MeshExport MeshSimplify
 {
 public:
     explicit MeshSimplify(MeshKernel&);
+    /// Sets the number of threads. A value <= 0 uses all available cores.
+    void setThreadCount(int count);
     void simplify(float tolerance, float reduction);
     void simplify(int targetSize);
 
+private:
+    void simplify(int targetSize, float tolerance);
+    void simplifyPartitions(int targetSize, float tolerance, std::size_t numParts);
+    void adopt(const Simplify& alg);
+
 private:
     MeshKernel& myKernel;
+    int threadCount = 0;
 };
 
 }  // namespace MeshCore
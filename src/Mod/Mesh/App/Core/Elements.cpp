@@ -22,6 +22,7 @@
 
 #include "PreCompiled.h"
 
+#include <Base/BulkVector.h>
 #include <Mod/Mesh/App/WildMagic4/Wm4DistSegment3Triangle3.h>
 #include <Mod/Mesh/App/WildMagic4/Wm4DistVector3Triangle3.h>
 #include <Mod/Mesh/App/WildMagic4/Wm4IntrSegment3Box3.h>
@@ -98,8 +99,8 @@ MeshPointArray& MeshPointArray::operator=(MeshPointArray&& rclPAry) = default;
 
 void MeshPointArray::Transform(const Base::Matrix4D& mat)
 {
-    for (auto& pP : *this) {
-        mat.multVec(pP, pP);
+    if (!empty()) {
+        Base::BulkVector::transform(mat, &front(), size(), sizeof(MeshPoint));
     }
 }
 
@@ -24,14 +24,21 @@
 
 #ifndef _PreComp_
 #include <algorithm>
+#include <atomic>
+#include <exception>
+#include <future>
+#include <iomanip>
+#include <sstream>
 #include <vector>
 #endif
 
 #include <Base/Matrix.h>
 #include <Base/Sequencer.h>
+#include <Base/TimeInfo.h>
 
 #include "Algorithm.h"
 #include "Approximation.h"
+#include "BVH.h"
 #include "Evaluation.h"
 #include "Functional.h"
 #include "Grid.h"
@@ -42,6 +49,89 @@
 using namespace MeshCore;
 
 
+void MeshEvaluationPipeline::AddStage(const std::string& name,
+                                      std::function<bool()> evaluate,
+                                      bool exclusive)
+{
+    Stage stage;
+    stage.name = name;
+    stage.evaluate = std::move(evaluate);
+    stage.exclusive = exclusive;
+    _stages.push_back(std::move(stage));
+}
+
+bool MeshEvaluationPipeline::Run()
+{
+    Base::TimeElapsed start;
+
+    // This launcher is the active one so that the launchers created by the stages in other
+    // threads are ignored
+    Base::SequencerLauncher seq("Evaluating mesh...", _stages.size());
+
+    auto runStage = [](Stage& stage) {
+        Base::TimeElapsed begin;
+        stage.result = stage.evaluate();
+        stage.seconds = Base::TimeElapsed::diffTimeF(begin, Base::TimeElapsed());
+    };
+
+    std::vector<std::future<void>> futures;
+    for (auto& stage : _stages) {
+        if (!stage.exclusive) {
+            futures.push_back(std::async(std::launch::async, runStage, std::ref(stage)));
+        }
+    }
+
+    std::exception_ptr error;
+    for (auto& stage : _stages) {
+        if (stage.exclusive) {
+            try {
+                runStage(stage);
+            }
+            catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+            seq.next();
+        }
+    }
+
+    for (auto& future : futures) {
+        try {
+            future.get();
+        }
+        catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+        seq.next();
+    }
+
+    _elapsed = Base::TimeElapsed::diffTimeF(start, Base::TimeElapsed());
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    return std::all_of(_stages.begin(), _stages.end(), [](const Stage& stage) {
+        return stage.result;
+    });
+}
+
+std::string MeshEvaluationPipeline::Report() const
+{
+    std::stringstream str;
+    str << std::fixed << std::setprecision(3);
+    for (const auto& stage : _stages) {
+        str << stage.name << ": " << (stage.result ? "passed" : "failed") << " (" << stage.seconds
+            << " s)\n";
+    }
+    str << "Total: " << _elapsed << " s\n";
+    return str.str();
+}
+
+// ----------------------------------------------------
+
 MeshOrientationVisitor::MeshOrientationVisitor() = default;
 
 bool MeshOrientationVisitor::Visit(const MeshFacet& rclFacet,
@@ -331,6 +421,29 @@ struct Edge_Less
     }
 };
 
+// Collects the edges of the facets starting at \a first, sorted by their end points
+static void CollectSortedEdges(const MeshFacetArray& rFacets,
+                               FacetIndex first,
+                               std::vector<Edge_Index>& edges)
+{
+    std::size_t count = rFacets.size() - first;
+    edges.resize(3 * count);
+    MeshCore::parallel_chunks(count, 10000, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t index = begin; index < end; index++) {
+            const MeshFacet& face = rFacets[first + index];
+            for (int i = 0; i < 3; i++) {
+                Edge_Index& item = edges[3 * index + i];
+                item.p0 = std::min<PointIndex>(face._aulPoints[i], face._aulPoints[(i + 1) % 3]);
+                item.p1 = std::max<PointIndex>(face._aulPoints[i], face._aulPoints[(i + 1) % 3]);
+                item.f = first + index;
+            }
+        }
+    });
+
+    int threads = int(std::thread::hardware_concurrency());
+    MeshCore::parallel_sort(edges.begin(), edges.end(), Edge_Less(), threads);
+}
+
 }  // namespace MeshCore
 
 bool MeshEvalTopology::Evaluate()
@@ -339,25 +452,10 @@ bool MeshEvalTopology::Evaluate()
     // than a map.
     const MeshFacetArray& rclFAry = _rclMesh.GetFacets();
     std::vector<Edge_Index> edges;
-    edges.reserve(3 * rclFAry.size());
 
-    // build up an array of edges
-    MeshFacetArray::_TConstIterator pI;
-    Base::SequencerLauncher seq("Checking topology...", rclFAry.size());
-    for (pI = rclFAry.begin(); pI != rclFAry.end(); ++pI) {
-        for (int i = 0; i < 3; i++) {
-            Edge_Index item {};
-            item.p0 = std::min<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
-            item.p1 = std::max<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
-            item.f = pI - rclFAry.begin();
-            edges.push_back(item);
-        }
-
-        seq.next();
-    }
-
-    // sort the edges
-    std::sort(edges.begin(), edges.end(), Edge_Less());
+    // build up a sorted array of edges
+    Base::SequencerLauncher seq("Checking topology...", 0);
+    CollectSortedEdges(rclFAry, 0, edges);
 
     // search for non-manifold edges
     PointIndex p0 = POINT_INDEX_MAX, p1 = POINT_INDEX_MAX;
@@ -397,14 +495,14 @@ void MeshEvalTopology::GetFacetManifolds(std::vector<FacetIndex>& raclFacetIndLi
     const MeshFacetArray& rclFAry = _rclMesh.GetFacets();
     MeshFacetArray::_TConstIterator pI;
 
+    // the non-manifold edges are collected in sorted order
     for (pI = rclFAry.begin(); pI != rclFAry.end(); ++pI) {
         for (int i = 0; i < 3; i++) {
             PointIndex ulPt0 = std::min<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
             PointIndex ulPt1 = std::max<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
             std::pair<PointIndex, PointIndex> edge = std::make_pair(ulPt0, ulPt1);
 
-            if (std::find(nonManifoldList.begin(), nonManifoldList.end(), edge)
-                != nonManifoldList.end()) {
+            if (std::binary_search(nonManifoldList.begin(), nonManifoldList.end(), edge)) {
                 raclFacetIndList.push_back(pI - rclFAry.begin());
             }
         }
@@ -600,79 +698,81 @@ bool MeshFixSingleFacet::Fixup()
 
 bool MeshEvalSelfIntersection::Evaluate()
 {
-    // Contains bounding boxes for every facet
-    std::vector<Base::BoundBox3f> boxes;
+    std::vector<std::pair<FacetIndex, FacetIndex>> intersection;
+    CollectIntersections(intersection, true);
+    return intersection.empty();
+}
 
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
+bool MeshEvalSelfIntersection::CollectIntersections(
+    std::vector<std::pair<FacetIndex, FacetIndex>>& intersection,
+    bool firstOnly) const
+{
+    // A bounding volume hierarchy copes better than a grid with meshes of very different
+    // facet sizes and gives each pair of facets only once
+    MeshFacetBVH bvh(_rclMesh);
     const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX {}, ulGridY {}, ulGridZ {};
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
-
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
-    }
-
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX * ulGridY * ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        // Get the facet indices, belonging to the current grid unit
-        std::vector<FacetIndex> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next();
-        if (aulGridElements.empty()) {
-            continue;
-        }
-
-        MeshGeomFacet facet1, facet2;
-        Base::Vector3f pt1, pt2;
-        for (auto it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (auto jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) {  // the identical facet
-                    continue;
-                }
-                // If the facets share a common vertex we do not check for self-intersections
-                // because they could but usually do not intersect each other and the algorithm
-                // below would detect false-positives, otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0]
-                    || rface1._aulPoints[0] == rface2._aulPoints[1]
-                    || rface1._aulPoints[0] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
+    std::size_t numFacets = rFaces.size();
+    std::atomic<bool> found {false};
+
+    // If the facets share a common vertex we do not check for self-intersections
+    // because they could but usually do not intersect each other and the algorithm
+    // below would detect false-positives, otherwise
+    auto shareVertex = [](const MeshFacet& rface1, const MeshFacet& rface2) {
+        for (PointIndex p1 : rface1._aulPoints) {
+            for (PointIndex p2 : rface2._aulPoints) {
+                if (p1 == p2) {
+                    return true;
                 }
-                if (rface1._aulPoints[1] == rface2._aulPoints[0]
-                    || rface1._aulPoints[1] == rface2._aulPoints[1]
-                    || rface1._aulPoints[1] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[2] == rface2._aulPoints[0]
-                    || rface1._aulPoints[2] == rface2._aulPoints[1]
-                    || rface1._aulPoints[2] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        // abort after the first detected self-intersection
-                        return false;
+            }
+        }
+        return false;
+    };
+
+    // the facets are processed in blocks in parallel, the progress is reported per block
+    const std::size_t blockSize = 10000;
+    std::size_t numBlocks = (numFacets + blockSize - 1) / blockSize;
+    std::vector<std::vector<FacetIndex>> partners(std::min(blockSize, numFacets));
+
+    Base::SequencerLauncher seq("Checking for self-intersections...", numBlocks);
+    for (std::size_t block = 0; block < numBlocks && !(firstOnly && found); block++) {
+        std::size_t first = block * blockSize;
+        std::size_t last = std::min(first + blockSize, numFacets);
+        parallel_chunks(last - first, 100, [&](std::size_t begin, std::size_t end) {
+            std::vector<FacetIndex> candidates;
+            Base::Vector3f pt1, pt2;
+            for (std::size_t i = begin; i < end && !(firstOnly && found); i++) {
+                FacetIndex index = first + i;
+                partners[i].clear();
+                MeshGeomFacet facet1 = _rclMesh.GetFacet(index);
+                bvh.Inside(facet1.GetBoundBox(), candidates);
+                std::sort(candidates.begin(), candidates.end());
+                for (FacetIndex partner : candidates) {
+                    if (partner <= index || shareVertex(rFaces[index], rFaces[partner])) {
+                        continue;
+                    }
+                    MeshGeomFacet facet2 = _rclMesh.GetFacet(partner);
+                    if (facet1.IntersectWithFacet(facet2, pt1, pt2) == 2) {
+                        partners[i].push_back(partner);
+                        found = true;
+                        if (firstOnly) {
+                            break;
+                        }
                     }
                 }
             }
+        });
+
+        for (std::size_t i = 0; i < last - first; i++) {
+            for (FacetIndex partner : partners[i]) {
+                intersection.emplace_back(first + i, partner);
+            }
         }
+
+        // only the search for all intersections can be canceled
+        seq.next(!firstOnly);
     }
 
-    return true;
+    return !intersection.empty();
 }
 
 void MeshEvalSelfIntersection::GetIntersections(
@@ -703,77 +803,7 @@ void MeshEvalSelfIntersection::GetIntersections(
 void MeshEvalSelfIntersection::GetIntersections(
     std::vector<std::pair<FacetIndex, FacetIndex>>& intersection) const
 {
-    // Contains bounding boxes for every facet
-    std::vector<Base::BoundBox3f> boxes;
-    // intersection.clear();
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX {}, ulGridY {}, ulGridZ {};
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
-
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
-    }
-
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX * ulGridY * ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        // Get the facet indices, belonging to the current grid unit
-        std::vector<FacetIndex> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next(true);
-        if (aulGridElements.empty()) {
-            continue;
-        }
-
-        MeshGeomFacet facet1, facet2;
-        Base::Vector3f pt1, pt2;
-        for (auto it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (auto jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) {  // the identical facet
-                    continue;
-                }
-                // If the facets share a common vertex we do not check for self-intersections
-                // because they could but usually do not intersect each other and the algorithm
-                // below would detect false-positives, otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0]
-                    || rface1._aulPoints[0] == rface2._aulPoints[1]
-                    || rface1._aulPoints[0] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[1] == rface2._aulPoints[0]
-                    || rface1._aulPoints[1] == rface2._aulPoints[1]
-                    || rface1._aulPoints[1] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[2] == rface2._aulPoints[0]
-                    || rface1._aulPoints[2] == rface2._aulPoints[1]
-                    || rface1._aulPoints[2] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        intersection.emplace_back(*it, *jt);
-                    }
-                }
-            }
-        }
-    }
+    CollectIntersections(intersection, false);
 }
 
 std::vector<FacetIndex> MeshFixSelfIntersection::GetFacets() const
@@ -827,25 +857,10 @@ bool MeshEvalNeighbourhood::Evaluate()
     // than a map.
     const MeshFacetArray& rclFAry = _rclMesh.GetFacets();
     std::vector<Edge_Index> edges;
-    edges.reserve(3 * rclFAry.size());
-
-    // build up an array of edges
-    MeshFacetArray::_TConstIterator pI;
-    Base::SequencerLauncher seq("Checking indices...", rclFAry.size());
-    for (pI = rclFAry.begin(); pI != rclFAry.end(); ++pI) {
-        for (int i = 0; i < 3; i++) {
-            Edge_Index item {};
-            item.p0 = std::min<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
-            item.p1 = std::max<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
-            item.f = pI - rclFAry.begin();
-            edges.push_back(item);
-        }
 
-        seq.next();
-    }
-
-    // sort the edges
-    std::sort(edges.begin(), edges.end(), Edge_Less());
+    // build up a sorted array of edges
+    Base::SequencerLauncher seq("Checking indices...", 0);
+    CollectSortedEdges(rclFAry, 0, edges);
 
     PointIndex p0 = POINT_INDEX_MAX, p1 = POINT_INDEX_MAX;
     PointIndex f0 = FACET_INDEX_MAX, f1 = FACET_INDEX_MAX;
@@ -894,25 +909,10 @@ std::vector<FacetIndex> MeshEvalNeighbourhood::GetIndices() const
     std::vector<FacetIndex> inds;
     const MeshFacetArray& rclFAry = _rclMesh.GetFacets();
     std::vector<Edge_Index> edges;
-    edges.reserve(3 * rclFAry.size());
 
-    // build up an array of edges
-    MeshFacetArray::_TConstIterator pI;
-    Base::SequencerLauncher seq("Checking indices...", rclFAry.size());
-    for (pI = rclFAry.begin(); pI != rclFAry.end(); ++pI) {
-        for (int i = 0; i < 3; i++) {
-            Edge_Index item {};
-            item.p0 = std::min<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
-            item.p1 = std::max<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
-            item.f = pI - rclFAry.begin();
-            edges.push_back(item);
-        }
-
-        seq.next();
-    }
-
-    // sort the edges
-    std::sort(edges.begin(), edges.end(), Edge_Less());
+    // build up a sorted array of edges
+    Base::SequencerLauncher seq("Checking indices...", 0);
+    CollectSortedEdges(rclFAry, 0, edges);
 
     PointIndex p0 = POINT_INDEX_MAX, p1 = POINT_INDEX_MAX;
     PointIndex f0 = FACET_INDEX_MAX, f1 = FACET_INDEX_MAX;
@@ -969,25 +969,9 @@ bool MeshFixNeighbourhood::Fixup()
 
 void MeshKernel::RebuildNeighbours(FacetIndex index)
 {
+    // build up a sorted array of edges
     std::vector<Edge_Index> edges;
-    edges.reserve(3 * (this->_aclFacetArray.size() - index));
-
-    // build up an array of edges
-    auto pB = this->_aclFacetArray.begin();
-    for (auto pI = pB + index; pI != this->_aclFacetArray.end(); ++pI) {
-        for (int i = 0; i < 3; i++) {
-            Edge_Index item {};
-            item.p0 = std::min<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
-            item.p1 = std::max<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
-            item.f = pI - pB;
-            edges.push_back(item);
-        }
-    }
-
-    // sort the edges
-    // std::sort(edges.begin(), edges.end(), Edge_Less());
-    int threads = int(std::thread::hardware_concurrency());
-    MeshCore::parallel_sort(edges.begin(), edges.end(), Edge_Less(), threads);
+    CollectSortedEdges(this->_aclFacetArray, index, edges);
 
     PointIndex p0 = POINT_INDEX_MAX, p1 = POINT_INDEX_MAX;
     PointIndex f0 = FACET_INDEX_MAX, f1 = FACET_INDEX_MAX;
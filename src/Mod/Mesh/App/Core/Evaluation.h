@@ -24,7 +24,10 @@
 #define MESH_EVALUATION_H
 
 #include <cmath>
+#include <functional>
 #include <list>
+#include <string>
+#include <vector>
 
 #include "MeshKernel.h"
 #include "Visitor.h"
@@ -102,6 +105,52 @@ protected:
 
 // ----------------------------------------------------
 
+/**
+ * The MeshEvaluationPipeline class runs several independent evaluations of the same mesh
+ * concurrently and measures the time each stage takes.
+ * Stages that only read the mesh run on their own threads. Stages that change temporary
+ * flags of the facets or points, e.g. MeshEvalOrientation::GetIndices(), must be added as
+ * exclusive. They run one after another in the calling thread.
+ */
+class MeshExport MeshEvaluationPipeline
+{
+public:
+    struct Stage
+    {
+        std::string name;
+        std::function<bool()> evaluate;
+        bool exclusive = false;
+        /** The return value of \a evaluate of the last run. */
+        bool result = true;
+        /** The time in seconds \a evaluate took in the last run. */
+        float seconds = 0.0F;
+    };
+
+    /** Adds a stage. \a evaluate must return false if the mesh is invalid according to
+     * the checked criterion. */
+    void AddStage(const std::string& name, std::function<bool()> evaluate, bool exclusive = false);
+    /** Runs all stages and returns true if all of them succeeded. If a stage throws an exception
+     * it is re-thrown after all other stages have finished. */
+    bool Run();
+    const std::vector<Stage>& GetStages() const
+    {
+        return _stages;
+    }
+    /** Returns the wall-clock time in seconds of the last run. */
+    float GetElapsedTime() const
+    {
+        return _elapsed;
+    }
+    /** Returns a text with one line per stage containing its result and time. */
+    std::string Report() const;
+
+private:
+    std::vector<Stage> _stages;
+    float _elapsed {0.0F};
+};
+
+// ----------------------------------------------------
+
 /**
  * This class searches for nonuniform orientation of neighboured facets.
  * @author Werner Mayer
@@ -337,6 +386,10 @@ public:
                           std::vector<std::pair<Base::Vector3f, Base::Vector3f>>&) const;
     /// collect the index of all facets with self intersections
     void GetIntersections(std::vector<std::pair<FacetIndex, FacetIndex>>&) const;
+
+private:
+    bool CollectIntersections(std::vector<std::pair<FacetIndex, FacetIndex>>& intersection,
+                              bool firstOnly) const;
 };
 
 /**
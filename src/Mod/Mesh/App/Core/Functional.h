@@ -25,6 +25,8 @@
 
 #include <algorithm>
 #include <future>
+#include <thread>
+#include <vector>
 
 
 namespace MeshCore
@@ -62,6 +64,69 @@ static void parallel_sort(Iter begin, Iter end, Pred comp, int threads)
     }
 }
 
+/**
+ * Splits the range [0, count) into contiguous chunks and calls \a func(begin, end) for each of
+ * them on its own thread. Each chunk gets at least \a minChunk elements.
+ */
+template<class Func>
+static void parallel_chunks(std::size_t count, std::size_t minChunk, Func&& func)
+{
+    std::size_t threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    threads = std::max<std::size_t>(1, std::min<std::size_t>(threads, count / minChunk));
+    if (threads == 1) {
+        func(std::size_t(0), count);
+        return;
+    }
+
+    std::size_t chunk = (count + threads - 1) / threads;
+    std::vector<std::future<void>> futures;
+    futures.reserve(threads);
+    for (std::size_t begin = 0; begin < count; begin += chunk) {
+        std::size_t end = std::min(begin + chunk, count);
+        futures.push_back(std::async(std::launch::async, [&func, begin, end]() {
+            func(begin, end);
+        }));
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
+/**
+ * Splits the range [0, count) like parallel_chunks() and returns the results of \a func(begin, end)
+ * in the order of the chunks. Summing up the partial results in this order makes reductions
+ * independent of the thread scheduling.
+ */
+template<class Func>
+static auto parallel_partials(std::size_t count, std::size_t minChunk, Func&& func)
+    -> std::vector<decltype(func(std::size_t(0), std::size_t(0)))>
+{
+    using Result = decltype(func(std::size_t(0), std::size_t(0)));
+    std::size_t threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    threads = std::max<std::size_t>(1, std::min<std::size_t>(threads, count / minChunk));
+
+    std::vector<Result> results;
+    if (threads == 1) {
+        results.push_back(func(std::size_t(0), count));
+        return results;
+    }
+
+    std::size_t chunk = (count + threads - 1) / threads;
+    std::vector<std::future<Result>> futures;
+    futures.reserve(threads);
+    for (std::size_t begin = 0; begin < count; begin += chunk) {
+        std::size_t end = std::min(begin + chunk, count);
+        futures.push_back(std::async(std::launch::async, [&func, begin, end]() {
+            return func(begin, end);
+        }));
+    }
+    results.reserve(futures.size());
+    for (auto& future : futures) {
+        results.push_back(future.get());
+    }
+    return results;
+}
+
 }  // namespace MeshCore
 
 
@@ -24,10 +24,13 @@
 
 #ifndef _PreComp_
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <mutex>
 #endif
 
 #include "Algorithm.h"
+#include "Functional.h"
 #include "Grid.h"
 #include "Iterator.h"
 #include "MeshKernel.h"
@@ -71,7 +74,8 @@ void MeshGrid::Attach(const MeshKernel& rclM)
 
 void MeshGrid::Clear()
 {
-    _aulGrid.clear();
+    _aulElements.clear();
+    _aulOffsets.clear();
     _pclMesh = nullptr;
 }
 
@@ -129,14 +133,72 @@ void MeshGrid::InitGrid()
     }
 
     // Create data structure
-    _aulGrid.clear();
-    _aulGrid.resize(_ulCtGridsX);
-    for (unsigned long i = 0; i < _ulCtGridsX; i++) {
-        _aulGrid[i].resize(_ulCtGridsY);
-        for (unsigned long j = 0; j < _ulCtGridsY; j++) {
-            _aulGrid[i][j].resize(_ulCtGridsZ);
+    _aulElements.clear();
+    _aulOffsets.assign(std::size_t(_ulCtGridsX) * _ulCtGridsY * _ulCtGridsZ + 1, 0);
+}
+
+void MeshGrid::FillGrid(unsigned long ulCtElements,
+                        const std::function<void(ElementIndex, std::vector<std::size_t>&)>& func)
+{
+    // The grid is filled with a counting sort: at first the grid indices of all elements are
+    // determined and counted, then the elements are scattered to their grids.
+    std::size_t numGrids = std::size_t(_ulCtGridsX) * _ulCtGridsY * _ulCtGridsZ;
+    std::vector<std::atomic<std::size_t>> counts(numGrids);
+
+    struct Chunk
+    {
+        std::vector<std::size_t> grids;
+        std::vector<ElementIndex> elements;
+    };
+    std::vector<Chunk> chunks;
+    std::mutex mutex;
+
+    const std::size_t minChunk = 10000;
+    parallel_chunks(ulCtElements, minChunk, [&](std::size_t begin, std::size_t end) {
+        Chunk chunk;
+        chunk.grids.reserve(end - begin);
+        chunk.elements.reserve(end - begin);
+        std::vector<std::size_t> grids;
+        for (std::size_t i = begin; i < end; i++) {
+            grids.clear();
+            func(ElementIndex(i), grids);
+            for (std::size_t grid : grids) {
+                counts[grid].fetch_add(1, std::memory_order_relaxed);
+                chunk.grids.push_back(grid);
+                chunk.elements.push_back(ElementIndex(i));
+            }
         }
-    }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        chunks.push_back(std::move(chunk));
+    });
+
+    _aulOffsets.resize(numGrids + 1);
+    _aulOffsets[0] = 0;
+    for (std::size_t i = 0; i < numGrids; i++) {
+        std::size_t count = counts[i].load(std::memory_order_relaxed);
+        counts[i].store(_aulOffsets[i], std::memory_order_relaxed);
+        _aulOffsets[i + 1] = _aulOffsets[i] + count;
+    }
+
+    _aulElements.resize(_aulOffsets[numGrids]);
+    parallel_chunks(chunks.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const Chunk& chunk = chunks[i];
+            for (std::size_t j = 0; j < chunk.grids.size(); j++) {
+                std::size_t pos = counts[chunk.grids[j]].fetch_add(1, std::memory_order_relaxed);
+                _aulElements[pos] = chunk.elements[j];
+            }
+        }
+    });
+
+    // the chunks are scattered concurrently, so restore the order inside each grid
+    parallel_chunks(numGrids, 1000, [this](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            std::sort(_aulElements.begin() + std::ptrdiff_t(_aulOffsets[i]),
+                      _aulElements.begin() + std::ptrdiff_t(_aulOffsets[i + 1]));
+        }
+    });
 }
 
 unsigned long MeshGrid::Inside(const Base::BoundBox3f& rclBB,
@@ -159,9 +221,8 @@ unsigned long MeshGrid::Inside(const Base::BoundBox3f& rclBB,
     for (auto i = ulMinX; i <= ulMaxX; i++) {
         for (auto j = ulMinY; j <= ulMaxY; j++) {
             for (auto k = ulMinZ; k <= ulMaxZ; k++) {
-                raulElements.insert(raulElements.end(),
-                                    _aulGrid[i][j][k].begin(),
-                                    _aulGrid[i][j][k].end());
+                ElementRange range = GetGridElements(i, j, k);
+                raulElements.insert(raulElements.end(), range.begin(), range.end());
             }
         }
     }
@@ -201,9 +262,8 @@ unsigned long MeshGrid::Inside(const Base::BoundBox3f& rclBB,
         for (auto j = ulMinY; j <= ulMaxY; j++) {
             for (auto k = ulMinZ; k <= ulMaxZ; k++) {
                 if (Base::DistanceP2(GetBoundBox(i, j, k).GetCenter(), rclOrg) < fMinDistP2) {
-                    raulElements.insert(raulElements.end(),
-                                        _aulGrid[i][j][k].begin(),
-                                        _aulGrid[i][j][k].end());
+                    ElementRange range = GetGridElements(i, j, k);
+                    raulElements.insert(raulElements.end(), range.begin(), range.end());
                 }
             }
         }
@@ -238,7 +298,8 @@ unsigned long MeshGrid::Inside(const Base::BoundBox3f& rclBB,
     for (auto i = ulMinX; i <= ulMaxX; i++) {
         for (auto j = ulMinY; j <= ulMaxY; j++) {
             for (auto k = ulMinZ; k <= ulMaxZ; k++) {
-                raulElements.insert(_aulGrid[i][j][k].begin(), _aulGrid[i][j][k].end());
+                ElementRange range = GetGridElements(i, j, k);
+                raulElements.insert(range.begin(), range.end());
             }
         }
     }
@@ -246,6 +307,17 @@ unsigned long MeshGrid::Inside(const Base::BoundBox3f& rclBB,
     return raulElements.size();
 }
 
+void MeshGrid::Inside(const std::vector<Base::BoundBox3f>& rclBBs,
+                      std::vector<std::vector<ElementIndex>>& raulElements) const
+{
+    raulElements.resize(rclBBs.size());
+    parallel_chunks(rclBBs.size(), 100, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            Inside(rclBBs[i], raulElements[i], true);
+        }
+    });
+}
+
 bool MeshGrid::CheckPosition(const Base::Vector3f& rclPoint,
                              unsigned long& rulX,
                              unsigned long& rulY,
@@ -462,7 +534,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nX < _ulCtGridsX) {
                     for (unsigned long i = 0; i < _ulCtGridsY; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsZ; j++) {
-                            indices.insert(_aulGrid[nX][i][j].begin(), _aulGrid[nX][i][j].end());
+                            ElementRange range = GetGridElements(nX, i, j);
+                            indices.insert(range.begin(), range.end());
                         }
                     }
                     nX++;
@@ -474,7 +547,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nX < _ulCtGridsX) {
                     for (unsigned long i = 0; i < _ulCtGridsY; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsZ; j++) {
-                            indices.insert(_aulGrid[nX][i][j].begin(), _aulGrid[nX][i][j].end());
+                            ElementRange range = GetGridElements(nX, i, j);
+                            indices.insert(range.begin(), range.end());
                         }
                     }
                     nX++;
@@ -486,7 +560,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nY < _ulCtGridsY) {
                     for (unsigned long i = 0; i < _ulCtGridsX; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsZ; j++) {
-                            indices.insert(_aulGrid[i][nY][j].begin(), _aulGrid[i][nY][j].end());
+                            ElementRange range = GetGridElements(i, nY, j);
+                            indices.insert(range.begin(), range.end());
                         }
                     }
                     nY++;
@@ -498,7 +573,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nY < _ulCtGridsY) {
                     for (unsigned long i = 0; i < _ulCtGridsX; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsZ; j++) {
-                            indices.insert(_aulGrid[i][nY][j].begin(), _aulGrid[i][nY][j].end());
+                            ElementRange range = GetGridElements(i, nY, j);
+                            indices.insert(range.begin(), range.end());
                         }
                     }
                     nY--;
@@ -510,7 +586,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nZ < _ulCtGridsZ) {
                     for (unsigned long i = 0; i < _ulCtGridsX; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsY; j++) {
-                            indices.insert(_aulGrid[i][j][nZ].begin(), _aulGrid[i][j][nZ].end());
+                            ElementRange range = GetGridElements(i, j, nZ);
+                            indices.insert(range.begin(), range.end());
                         }
                     }
                     nZ++;
@@ -522,7 +599,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nZ < _ulCtGridsZ) {
                     for (unsigned long i = 0; i < _ulCtGridsX; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsY; j++) {
-                            indices.insert(_aulGrid[i][j][nZ].begin(), _aulGrid[i][j][nZ].end());
+                            ElementRange range = GetGridElements(i, j, nZ);
+                            indices.insert(range.begin(), range.end());
                         }
                     }
                     nZ--;
@@ -610,10 +688,10 @@ unsigned long MeshGrid::GetElements(unsigned long ulX,
                                     unsigned long ulZ,
                                     std::set<ElementIndex>& raclInd) const
 {
-    const std::set<ElementIndex>& rclSet = _aulGrid[ulX][ulY][ulZ];
-    if (!rclSet.empty()) {
-        raclInd.insert(rclSet.begin(), rclSet.end());
-        return rclSet.size();
+    ElementRange range = GetGridElements(ulX, ulY, ulZ);
+    if (!range.empty()) {
+        raclInd.insert(range.begin(), range.end());
+        return range.size();
     }
 
     return 0;
@@ -629,9 +707,8 @@ unsigned long MeshGrid::GetElements(const Base::Vector3f& rclPoint,
         return 0;
     }
 
-    aulFacets.resize(_aulGrid[ulX][ulY][ulZ].size());
-
-    std::copy(_aulGrid[ulX][ulY][ulZ].begin(), _aulGrid[ulX][ulY][ulZ].end(), aulFacets.begin());
+    ElementRange range = GetGridElements(ulX, ulY, ulZ);
+    aulFacets.assign(range.begin(), range.end());
     return aulFacets.size();
 }
 
@@ -748,13 +825,9 @@ void MeshFacetGrid::RebuildGrid()
     InitGrid();
 
     // Fill data structure
-    MeshFacetIterator clFIter(*_pclMesh);
-
-    unsigned long i = 0;
-    for (clFIter.Init(); clFIter.More(); clFIter.Next()) {
-        //    AddFacet(*clFIter, i++, 2.0f);
-        AddFacet(*clFIter, i++);
-    }
+    FillGrid(_ulCtElements, [this](ElementIndex index, std::vector<std::size_t>& grids) {
+        GetFacetGrids(_pclMesh->GetFacet(index), grids);
+    });
 }
 
 unsigned long MeshFacetGrid::SearchNearestFromPoint(const Base::Vector3f& rclPt) const
@@ -895,6 +968,31 @@ unsigned long MeshFacetGrid::SearchNearestFromPoint(const Base::Vector3f& rclPt,
     return ulFacetInd;
 }
 
+std::vector<ElementIndex>
+MeshFacetGrid::SearchNearestFromPoints(const std::vector<Base::Vector3f>& rclPts) const
+{
+    std::vector<ElementIndex> facets(rclPts.size());
+    parallel_chunks(rclPts.size(), 100, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            facets[i] = SearchNearestFromPoint(rclPts[i]);
+        }
+    });
+    return facets;
+}
+
+std::vector<ElementIndex>
+MeshFacetGrid::SearchNearestFromPoints(const std::vector<Base::Vector3f>& rclPts,
+                                       float fMaxSearchArea) const
+{
+    std::vector<ElementIndex> facets(rclPts.size());
+    parallel_chunks(rclPts.size(), 100, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            facets[i] = SearchNearestFromPoint(rclPts[i], fMaxSearchArea);
+        }
+    });
+    return facets;
+}
+
 void MeshFacetGrid::SearchNearestFacetInHull(unsigned long ulX,
                                              unsigned long ulY,
                                              unsigned long ulZ,
@@ -985,8 +1083,7 @@ void MeshFacetGrid::SearchNearestFacetInGrid(unsigned long ulX,
                                              float& rfMinDist,
                                              ElementIndex& rulFacetInd) const
 {
-    const std::set<ElementIndex>& rclSet = _aulGrid[ulX][ulY][ulZ];
-    for (ElementIndex pI : rclSet) {
+    for (ElementIndex pI : GetGridElements(ulX, ulY, ulZ)) {
         float fDist = _pclMesh->GetFacet(pI).DistanceToPoint(rclPt);
         if (fDist < rfMinDist) {
             rfMinDist = fDist;
@@ -1029,18 +1126,6 @@ MeshPointGrid::MeshPointGrid(const MeshKernel& rclM, float fGridLen)
             std::max<unsigned long>(static_cast<unsigned long>(clBBMesh.LengthZ() / fGridLen), 1));
 }
 
-void MeshPointGrid::AddPoint(const MeshPoint& rclPt, ElementIndex ulPtIndex, float fEpsilon)
-{
-    (void)fEpsilon;
-    unsigned long ulX {};
-    unsigned long ulY {};
-    unsigned long ulZ {};
-    Pos(Base::Vector3f(rclPt.x, rclPt.y, rclPt.z), ulX, ulY, ulZ);
-    if ((ulX < _ulCtGridsX) && (ulY < _ulCtGridsY) && (ulZ < _ulCtGridsZ)) {
-        _aulGrid[ulX][ulY][ulZ].insert(ulPtIndex);
-    }
-}
-
 void MeshPointGrid::Validate(const MeshKernel& rclMesh)
 {
     if (_pclMesh != &rclMesh) {
@@ -1094,13 +1179,16 @@ void MeshPointGrid::RebuildGrid()
     InitGrid();
 
     // Fill data structure
-
-    MeshPointIterator cPIter(*_pclMesh);
-
-    unsigned long i = 0;
-    for (cPIter.Init(); cPIter.More(); cPIter.Next()) {
-        AddPoint(*cPIter, i++);
-    }
+    const MeshPointArray& points = _pclMesh->GetPoints();
+    FillGrid(_ulCtElements, [this, &points](ElementIndex index, std::vector<std::size_t>& grids) {
+        unsigned long ulX {};
+        unsigned long ulY {};
+        unsigned long ulZ {};
+        Pos(points[index], ulX, ulY, ulZ);
+        if ((ulX < _ulCtGridsX) && (ulY < _ulCtGridsY) && (ulZ < _ulCtGridsZ)) {
+            grids.push_back(GridIndex(ulX, ulY, ulZ));
+        }
+    });
 }
 
 void MeshPointGrid::Pos(const Base::Vector3f& rclPoint,
@@ -1165,9 +1253,8 @@ bool MeshGridIterator::InitOnRay(const Base::Vector3f& rclPt,
     // point lies within global BB
     if (_rclGrid.GetBoundBox().IsInBox(rclPt)) {  // Determine the voxel by the starting point
         _rclGrid.Position(rclPt, _ulX, _ulY, _ulZ);
-        raulElements.insert(raulElements.end(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+        MeshGrid::ElementRange range = _rclGrid.GetGridElements(_ulX, _ulY, _ulZ);
+        raulElements.insert(raulElements.end(), range.begin(), range.end());
         _bValidRay = true;
     }
     else {  // Start point outside
@@ -1182,9 +1269,8 @@ bool MeshGridIterator::InitOnRay(const Base::Vector3f& rclPt,
                 _rclGrid.Position(cP1, _ulX, _ulY, _ulZ);
             }
 
-            raulElements.insert(raulElements.end(),
-                                _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(),
-                                _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+            MeshGrid::ElementRange range = _rclGrid.GetGridElements(_ulX, _ulY, _ulZ);
+            raulElements.insert(raulElements.end(), range.begin(), range.end());
             _bValidRay = true;
         }
     }
@@ -1248,9 +1334,8 @@ bool MeshGridIterator::NextOnRay(std::vector<ElementIndex>& raulElements)
     if (_bValidRay && _rclGrid.CheckPos(_ulX, _ulY, _ulZ)) {
         GridElement pos(_ulX, _ulY, _ulZ);
         _cSearchPositions.insert(pos);
-        raulElements.insert(raulElements.end(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+        MeshGrid::ElementRange range = _rclGrid.GetGridElements(_ulX, _ulY, _ulZ);
+        raulElements.insert(raulElements.end(), range.begin(), range.end());
     }
     else {
         _bValidRay = false;  // Beam leaked
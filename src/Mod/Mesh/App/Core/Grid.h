@@ -23,6 +23,7 @@
 #ifndef MESH_GRID_H
 #define MESH_GRID_H
 
+#include <functional>
 #include <set>
 
 #include <Base/BoundBox.h>
@@ -54,6 +55,37 @@ static constexpr float MESHGRID_BBOX_EXTENSION = 10.0F;
  */
 class MeshExport MeshGrid
 {
+public:
+    /** The element indices of a single grid element. */
+    class ElementRange
+    {
+    public:
+        ElementRange(const ElementIndex* first, const ElementIndex* last)
+            : _first(first)
+            , _last(last)
+        {}
+        const ElementIndex* begin() const
+        {
+            return _first;
+        }
+        const ElementIndex* end() const
+        {
+            return _last;
+        }
+        std::size_t size() const
+        {
+            return static_cast<std::size_t>(_last - _first);
+        }
+        bool empty() const
+        {
+            return _first == _last;
+        }
+
+    private:
+        const ElementIndex* _first;
+        const ElementIndex* _last;
+    };
+
 protected:
     /** @name Construction */
     //@{
@@ -98,6 +130,9 @@ public:
     /** Searches for the nearest grids that contain elements from a point, the result are grid
      * indices. */
     void SearchNearestFromPoint(const Base::Vector3f& pnt, std::set<ElementIndex>& indices) const;
+    /** Does the same as Inside() for each of the bounding boxes but searches them in parallel. */
+    void Inside(const std::vector<Base::BoundBox3f>& rclBBs,
+                std::vector<std::vector<ElementIndex>>& raulElements) const;
     //@}
 
     /** @name Getters */
@@ -109,6 +144,13 @@ public:
                               std::set<ElementIndex>& raclInd) const;
     unsigned long GetElements(const Base::Vector3f& rclPoint,
                               std::vector<ElementIndex>& aulFacets) const;
+    /** Returns the indices of the elements in the given grid without copying them. */
+    ElementRange GetGridElements(unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
+    {
+        std::size_t ulIndex = GridIndex(ulX, ulY, ulZ);
+        const ElementIndex* data = _aulElements.data();
+        return {data + _aulOffsets[ulIndex], data + _aulOffsets[ulIndex + 1]};
+    }
     //@}
 
     /** Returns the lengths of the grid elements in x,y and z direction. */
@@ -151,7 +193,8 @@ public:
     /** Returns the number of elements in a given grid. */
     unsigned long GetCtElements(unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
     {
-        return static_cast<unsigned long>(_aulGrid[ulX][ulY][ulZ].size());
+        std::size_t ulIndex = GridIndex(ulX, ulY, ulZ);
+        return static_cast<unsigned long>(_aulOffsets[ulIndex + 1] - _aulOffsets[ulIndex]);
     }
     /** Validates the grid structure and rebuilds it if needed. Must be implemented in sub-classes.
      */
@@ -192,11 +235,23 @@ protected:
     virtual void RebuildGrid() = 0;
     /** Returns the number of stored elements. Must be implemented in sub-classes. */
     virtual unsigned long HasElements() const = 0;
+    /** Returns the position of a grid element in the grid data structure. */
+    std::size_t GridIndex(unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
+    {
+        return (std::size_t(ulZ) * _ulCtGridsY + ulY) * _ulCtGridsX + ulX;
+    }
+    /** Fills the grid data structure with \a ulCtElements elements. For each element \a
+     * func is called with the element index and must append the indices of the grid elements
+     * (see GridIndex()) the element belongs to. The elements are distributed over several
+     * threads, so \a func must be thread-safe. The elements of each grid are sorted by index.
+     */
+    void FillGrid(unsigned long ulCtElements,
+                  const std::function<void(ElementIndex, std::vector<std::size_t>&)>& func);
 
 protected:
     // NOLINTBEGIN
-    std::vector<std::vector<std::vector<std::set<ElementIndex>>>>
-        _aulGrid;                /**< Grid data structure. */
+    std::vector<ElementIndex> _aulElements; /**< Element indices of all grids, ordered by grid. */
+    std::vector<std::size_t> _aulOffsets; /**< Start of each grid in _aulElements plus the end. */
     const MeshKernel* _pclMesh;  /**< The mesh kernel. */
     unsigned long _ulCtElements; /**< Number of grid elements for validation issues. */
     unsigned long _ulCtGridsX;   /**< Number of grid elements in z. */
@@ -247,6 +302,13 @@ public:
     unsigned long SearchNearestFromPoint(const Base::Vector3f& rclPt) const;
     /** Searches for the nearest facet from a point with the maximum search area. */
     unsigned long SearchNearestFromPoint(const Base::Vector3f& rclPt, float fMaxSearchArea) const;
+    /** Searches for the nearest facet of each point in parallel. */
+    std::vector<ElementIndex>
+    SearchNearestFromPoints(const std::vector<Base::Vector3f>& rclPts) const;
+    /** Searches for the nearest facet of each point in parallel with the maximum search area. If
+     * no facet is found within the area ELEMENT_INDEX_MAX is set for the point. */
+    std::vector<ElementIndex> SearchNearestFromPoints(const std::vector<Base::Vector3f>& rclPts,
+                                                      float fMaxSearchArea) const;
     /** Searches for the nearest facet in a given grid element and returns the facet index and the
      * actual distance. */
     void SearchNearestFacetInGrid(unsigned long ulX,
@@ -284,11 +346,9 @@ protected:
                              unsigned long& rulX,
                              unsigned long& rulY,
                              unsigned long& rulZ) const;
-    /** Adds a new facet element to the grid structure. \a rclFacet is the geometric facet and \a
-     * ulFacetIndex the corresponding index in the mesh kernel. The facet is added to each grid
-     * element that intersects the facet. */
-    inline void
-    AddFacet(const MeshGeomFacet& rclFacet, ElementIndex ulFacetIndex, float fEpsilon = 0.0F);
+    /** Appends the indices of all grid elements that intersect the geometric facet \a rclFacet. */
+    inline void GetFacetGrids(const MeshGeomFacet& rclFacet,
+                              std::vector<std::size_t>& raulGrids) const;
     /** Returns the number of stored elements. */
     unsigned long HasElements() const override
     {
@@ -336,9 +396,6 @@ public:
     bool Verify() const override;
 
 protected:
-    /** Adds a new point element to the grid structure. \a rclPt is the geometric point and \a
-     * ulPtIndex the corresponding index in the mesh kernel. */
-    void AddPoint(const MeshPoint& rclPt, ElementIndex ulPtIndex, float fEpsilon = 0.0F);
     /** Returns the grid numbers to the given point \a rclPoint. */
     void Pos(const Base::Vector3f& rclPoint,
              unsigned long& rulX,
@@ -370,9 +427,8 @@ public:
     /** Returns indices of the elements in the current grid. */
     void GetElements(std::vector<ElementIndex>& raulElements) const
     {
-        raulElements.insert(raulElements.end(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+        MeshGrid::ElementRange range = _rclGrid.GetGridElements(_ulX, _ulY, _ulZ);
+        raulElements.insert(raulElements.end(), range.begin(), range.end());
     }
     /** Returns the number of elements in the current grid. */
     unsigned long GetCtElements() const
@@ -560,14 +616,9 @@ inline void MeshFacetGrid::PosWithCheck(const Base::Vector3f& rclPoint,
     assert((rulX < _ulCtGridsX) && (rulY < _ulCtGridsY) && (rulZ < _ulCtGridsZ));
 }
 
-inline void MeshFacetGrid::AddFacet(const MeshGeomFacet& rclFacet,
-                                    ElementIndex ulFacetIndex,
-                                    float /*fEpsilon*/)
+inline void MeshFacetGrid::GetFacetGrids(const MeshGeomFacet& rclFacet,
+                                         std::vector<std::size_t>& raulGrids) const
 {
-    unsigned long ulX {};
-    unsigned long ulY {};
-    unsigned long ulZ {};
-
     unsigned long ulX1 {};
     unsigned long ulY1 {};
     unsigned long ulZ1 {};
@@ -581,37 +632,23 @@ inline void MeshFacetGrid::AddFacet(const MeshGeomFacet& rclFacet,
     clBB.Add(rclFacet._aclPoints[1]);
     clBB.Add(rclFacet._aclPoints[2]);
 
-    // float fDiagonalLength = clBB.CalcDiagonalLength();
-
-    // clBB.Enlarge(fEpsilon*fDiagonalLength);
-
     Pos(Base::Vector3f(clBB.MinX, clBB.MinY, clBB.MinZ), ulX1, ulY1, ulZ1);
     Pos(Base::Vector3f(clBB.MaxX, clBB.MaxY, clBB.MaxZ), ulX2, ulY2, ulZ2);
 
-    /*
-    if (ulX1 > 0) ulX1--;
-    if (ulY1 > 0) ulY1--;
-    if (ulZ1 > 0) ulZ1--;
-
-    if (ulX2 < (_ulCtGridsX-1)) ulX2++;
-    if (ulY2 < (_ulCtGridsY-1)) ulY2++;
-    if (ulZ2 < (_ulCtGridsZ-1)) ulZ2++;
-    */
-
     // falls Facet ueber mehrere BB reicht
     if ((ulX1 < ulX2) || (ulY1 < ulY2) || (ulZ1 < ulZ2)) {
-        for (ulX = ulX1; ulX <= ulX2; ulX++) {
-            for (ulY = ulY1; ulY <= ulY2; ulY++) {
-                for (ulZ = ulZ1; ulZ <= ulZ2; ulZ++) {
+        for (unsigned long ulX = ulX1; ulX <= ulX2; ulX++) {
+            for (unsigned long ulY = ulY1; ulY <= ulY2; ulY++) {
+                for (unsigned long ulZ = ulZ1; ulZ <= ulZ2; ulZ++) {
                     if (rclFacet.IntersectBoundingBox(GetBoundBox(ulX, ulY, ulZ))) {
-                        _aulGrid[ulX][ulY][ulZ].insert(ulFacetIndex);
+                        raulGrids.push_back(GridIndex(ulX, ulY, ulZ));
                     }
                 }
             }
         }
     }
     else {
-        _aulGrid[ulX1][ulY1][ulZ1].insert(ulFacetIndex);
+        raulGrids.push_back(GridIndex(ulX1, ulY1, ulZ1));
     }
 }
 
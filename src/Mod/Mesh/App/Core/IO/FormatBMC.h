@@ -0,0 +1,191 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+
+#ifndef MESH_IO_FORMAT_BMC_H
+#define MESH_IO_FORMAT_BMC_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <Mod/Mesh/App/Core/Functional.h>
+
+namespace MeshCore
+{
+
+/**
+ * The BMC format is a compact binary mesh format that can be read with a few bulk copies, e.g.
+ * from a memory-mapped file. It consists of a header of 64 bytes followed by these sections,
+ * each starting at an offset aligned to 64 bytes:
+ * \li the point coordinates as float[3 * CountPoints]
+ * \li the corner indices of the facets as uint32[3 * CountFacets]
+ * \li the neighbour indices of the facets as uint32[3 * CountFacets] where 0xffffffff marks an
+ *     open edge
+ * \li for each bit set in PointFlags a bitset of CountPoints bits stored as uint64 words
+ * \li for each bit set in FacetFlags a bitset of CountFacets bits stored as uint64 words
+ *
+ * All values are stored in the byte order of the writing machine which is recorded in the
+ * header. The checksum covers everything after the header.
+ */
+namespace BMC
+{
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+struct Header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint64_t countPoints;
+    std::uint64_t countFacets;
+    std::uint32_t pointFlags;
+    std::uint32_t facetFlags;
+    std::uint64_t dataSize;
+    std::uint64_t checksum;
+    std::uint64_t reserved;
+};
+// NOLINTEND(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+static_assert(sizeof(Header) == 64, "Unexpected padding in BMC header");
+
+constexpr const char* Magic = "FCMESH\x1a";
+constexpr std::uint32_t Version = 1;
+constexpr std::uint32_t ByteOrder = 0x01020304;
+constexpr std::uint32_t OpenEdge = 0xffffffff;
+constexpr std::size_t Alignment = 64;
+constexpr std::size_t BlockSize = 1 << 20;
+
+inline std::size_t align(std::size_t offset)
+{
+    return (offset + Alignment - 1) / Alignment * Alignment;
+}
+
+inline int countBits(std::uint32_t mask)
+{
+    int bits = 0;
+    for (; mask != 0; mask &= mask - 1) {
+        bits++;
+    }
+    return bits;
+}
+
+inline bool isBigEndian()
+{
+    std::uint32_t value = 1;
+    unsigned char first {};
+    std::memcpy(&first, &value, 1);
+    return first == 0;
+}
+
+template<class T>
+inline T swapBytes(T value)
+{
+    unsigned char bytes[sizeof(T)];  // NOLINT
+    std::memcpy(bytes, &value, sizeof(T));
+    std::reverse(bytes, bytes + sizeof(T));
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+/** Offsets of the sections relative to the start of the file. */
+struct Layout
+{
+    explicit Layout(const Header& header)
+    {
+        std::size_t offset = sizeof(Header);
+        points = offset;
+        offset = align(offset + 3 * sizeof(float) * header.countPoints);
+        facets = offset;
+        offset = align(offset + 3 * sizeof(std::uint32_t) * header.countFacets);
+        neighbours = offset;
+        offset = align(offset + 3 * sizeof(std::uint32_t) * header.countFacets);
+        pointFlags = offset;
+        offset = align(offset + countBits(header.pointFlags) * bitsetSize(header.countPoints));
+        facetFlags = offset;
+        offset = align(offset + countBits(header.facetFlags) * bitsetSize(header.countFacets));
+        end = offset;
+    }
+
+    static std::size_t bitsetSize(std::uint64_t count)
+    {
+        return (count + 63) / 64 * sizeof(std::uint64_t);
+    }
+
+    std::size_t points;
+    std::size_t facets;
+    std::size_t neighbours;
+    std::size_t pointFlags;
+    std::size_t facetFlags;
+    std::size_t end;
+};
+
+/**
+ * Computes the checksum of \a size bytes. The data is split into blocks of a fixed size that
+ * are hashed in parallel and the block hashes are combined in order. So, the result doesn't
+ * depend on the number of threads.
+ */
+inline std::uint64_t checksum(const char* data, std::size_t size)
+{
+    constexpr std::uint64_t prime = 0x100000001b3ULL;
+    constexpr std::uint64_t basis = 0xcbf29ce484222325ULL;
+    auto mix = [](std::uint64_t hash, std::uint64_t value) {
+        hash = (hash ^ value) * prime;
+        return hash ^ (hash >> 29);
+    };
+
+    // the words are always interpreted as little-endian to get the same checksum on all machines
+    bool swap = isBigEndian();
+    std::size_t numBlocks = (size + BlockSize - 1) / BlockSize;
+    std::vector<std::uint64_t> blocks(numBlocks);
+    parallel_chunks(numBlocks, 4, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const char* block = data + i * BlockSize;
+            std::size_t length = std::min(BlockSize, size - i * BlockSize);
+            std::uint64_t hash = basis;
+            std::size_t pos = 0;
+            for (; pos + sizeof(std::uint64_t) <= length; pos += sizeof(std::uint64_t)) {
+                std::uint64_t word {};
+                std::memcpy(&word, block + pos, sizeof(word));
+                hash = mix(hash, swap ? swapBytes(word) : word);
+            }
+            for (; pos < length; pos++) {
+                hash = mix(hash, static_cast<unsigned char>(block[pos]));
+            }
+            blocks[i] = hash;
+        }
+    });
+
+    std::uint64_t hash = mix(basis, size);
+    for (std::uint64_t it : blocks) {
+        hash = mix(hash, it);
+    }
+    return hash;
+}
+
+}  // namespace BMC
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_IO_FORMAT_BMC_H
@@ -0,0 +1,271 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <array>
+#include <cstring>
+#include <istream>
+#include <QFile>
+#endif
+
+#include "Core/Functional.h"
+#include <Base/FileInfo.h>
+#include <Base/Stream.h>
+
+#include "FormatBMC.h"
+#include "ReaderBMC.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+constexpr std::size_t MinChunkSize = 65536;
+
+/*
+ * Checks the header at the begin of \a data and brings it into the byte order of this machine.
+ * Returns the number of bytes the whole file must have or 0 if the header is invalid.
+ */
+std::size_t readHeader(const char* data, std::size_t size, BMC::Header& header, bool& swap)
+{
+    if (size < sizeof(header)) {
+        return 0;
+    }
+
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, BMC::Magic, sizeof(header.magic)) != 0) {
+        return 0;
+    }
+
+    swap = header.byteOrder != BMC::ByteOrder;
+    if (swap) {
+        if (BMC::swapBytes(header.byteOrder) != BMC::ByteOrder) {
+            return 0;
+        }
+        header.version = BMC::swapBytes(header.version);
+        header.countPoints = BMC::swapBytes(header.countPoints);
+        header.countFacets = BMC::swapBytes(header.countFacets);
+        header.pointFlags = BMC::swapBytes(header.pointFlags);
+        header.facetFlags = BMC::swapBytes(header.facetFlags);
+        header.dataSize = BMC::swapBytes(header.dataSize);
+        header.checksum = BMC::swapBytes(header.checksum);
+    }
+
+    if (header.version > BMC::Version || header.countPoints >= BMC::OpenEdge
+        || header.countFacets >= BMC::OpenEdge || header.pointFlags > 0xff
+        || header.facetFlags > 0xff) {
+        return 0;
+    }
+
+    BMC::Layout layout(header);
+    if (layout.end != sizeof(header) + header.dataSize) {
+        return 0;
+    }
+    return layout.end;
+}
+
+template<class Element>
+void readBitsets(const char* data, std::vector<Element>& elements, unsigned char flags, bool swap)
+{
+    std::size_t numWords = (elements.size() + 63) / 64;
+    for (int bit = 0; bit < 8; bit++) {
+        auto flag = static_cast<unsigned char>(1 << bit);
+        if ((flags & flag) == 0) {
+            continue;
+        }
+
+        parallel_chunks(numWords, MinChunkSize / 64, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                std::uint64_t word {};
+                std::memcpy(&word, data + i * sizeof(word), sizeof(word));
+                if (swap) {
+                    word = BMC::swapBytes(word);
+                }
+                std::size_t last = std::min(64 * i + 64, elements.size());
+                for (std::size_t j = 64 * i; j < last; j++) {
+                    if ((word >> (j - 64 * i)) & 1) {
+                        elements[j]._ucFlag |= flag;
+                    }
+                }
+            }
+        });
+        data += BMC::Layout::bitsetSize(elements.size());
+    }
+}
+
+template<class T>
+std::array<T, 3> readTriple(const char* data, bool swap)
+{
+    std::array<T, 3> values {};
+    std::memcpy(values.data(), data, sizeof(values));
+    if (swap) {
+        for (auto& it : values) {
+            it = BMC::swapBytes(it);
+        }
+    }
+    return values;
+}
+}  // namespace
+
+ReaderBMC::ReaderBMC(MeshKernel& kernel)
+    : _kernel(kernel)
+{}
+
+bool ReaderBMC::Load(const std::string& filename)
+{
+    QFile file(QString::fromUtf8(filename.c_str()));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    qint64 size = file.size();
+    uchar* data = size > 0 ? file.map(0, size) : nullptr;
+    if (data) {
+        bool ok = Load(reinterpret_cast<const char*>(data), std::size_t(size));  // NOLINT
+        file.unmap(data);
+        return ok;
+    }
+
+    // the file system doesn't support mapping
+    file.close();
+    Base::FileInfo fi(filename);
+    Base::ifstream str(fi, std::ios::in | std::ios::binary);
+    return Load(str);
+}
+
+bool ReaderBMC::Load(std::istream& str)
+{
+    std::array<char, sizeof(BMC::Header)> head {};
+    if (!str.read(head.data(), head.size())) {
+        return false;
+    }
+
+    BMC::Header header {};
+    bool swap = false;
+    std::size_t size = readHeader(head.data(), head.size(), header, swap);
+    if (size == 0) {
+        return false;
+    }
+
+    // a corrupted header must not lead to a huge allocation, so check the length of the stream
+    // if it is seekable and otherwise only grow the buffer with the data actually read
+    std::streampos start = str.tellg();
+    if (start != std::streampos(-1)) {
+        str.seekg(0, std::ios::end);
+        std::streampos end = str.tellg();
+        str.seekg(start);
+        if (end == std::streampos(-1) || std::size_t(end - start) < size - head.size()) {
+            return false;
+        }
+    }
+
+    std::vector<char> buffer(head.begin(), head.end());
+    while (buffer.size() < size) {
+        std::size_t offset = buffer.size();
+        std::size_t count = std::min(size - offset, BMC::BlockSize);
+        buffer.resize(offset + count);
+        if (!str.read(buffer.data() + offset, static_cast<std::streamsize>(count))) {
+            return false;
+        }
+    }
+
+    return Load(buffer.data(), buffer.size());
+}
+
+bool ReaderBMC::IsBMC(const char* data, std::size_t size)
+{
+    return size >= MagicSize() && std::memcmp(data, BMC::Magic, MagicSize()) == 0;
+}
+
+std::size_t ReaderBMC::MagicSize()
+{
+    return sizeof(BMC::Header::magic);
+}
+
+bool ReaderBMC::Load(const char* data, std::size_t size)
+{
+    BMC::Header header {};
+    bool swap = false;
+    std::size_t length = readHeader(data, size, header, swap);
+    if (length == 0 || size < length) {
+        return false;
+    }
+    if (BMC::checksum(data + sizeof(header), header.dataSize) != header.checksum) {
+        return false;
+    }
+
+    BMC::Layout layout(header);
+    MeshPointArray points(header.countPoints);
+    MeshFacetArray facets(header.countFacets);
+
+    parallel_chunks(points.size(), MinChunkSize, [&](std::size_t begin, std::size_t end) {
+        const char* src = data + layout.points + begin * 3 * sizeof(float);
+        for (std::size_t i = begin; i < end; i++) {
+            std::array<std::uint32_t, 3> xyz = readTriple<std::uint32_t>(src, swap);
+            std::memcpy(&points[i].x, &xyz[0], sizeof(float));
+            std::memcpy(&points[i].y, &xyz[1], sizeof(float));
+            std::memcpy(&points[i].z, &xyz[2], sizeof(float));
+            src += sizeof(xyz);
+        }
+    });
+
+    // invalid indices would let the algorithms access memory out of bounds
+    auto valid = parallel_partials(
+        facets.size(),
+        MinChunkSize,
+        [&](std::size_t begin, std::size_t end) {
+            const char* srcPoints = data + layout.facets + begin * 3 * sizeof(std::uint32_t);
+            const char* srcNeighbours =
+                data + layout.neighbours + begin * 3 * sizeof(std::uint32_t);
+            bool ok = true;
+            for (std::size_t i = begin; i < end; i++) {
+                std::array<std::uint32_t, 3> corners = readTriple<std::uint32_t>(srcPoints, swap);
+                std::array<std::uint32_t, 3> neighbours =
+                    readTriple<std::uint32_t>(srcNeighbours, swap);
+                MeshFacet& face = facets[i];
+                for (int j = 0; j < 3; j++) {
+                    ok &= corners[j] < header.countPoints;
+                    ok &= neighbours[j] < header.countFacets || neighbours[j] == BMC::OpenEdge;
+                    face._aulPoints[j] = corners[j];
+                    face._aulNeighbours[j] =
+                        neighbours[j] == BMC::OpenEdge ? FACET_INDEX_MAX : neighbours[j];
+                }
+                srcPoints += sizeof(corners);
+                srcNeighbours += sizeof(neighbours);
+            }
+            return ok;
+        });
+    if (std::find(valid.begin(), valid.end(), false) != valid.end()) {
+        return false;
+    }
+
+    auto pointFlags = static_cast<unsigned char>(header.pointFlags);
+    auto facetFlags = static_cast<unsigned char>(header.facetFlags);
+    readBitsets(data + layout.pointFlags, points, pointFlags, swap);
+    readBitsets(data + layout.facetFlags, facets, facetFlags, swap);
+
+    _kernel.Adopt(points, facets, false);
+    return true;
+}
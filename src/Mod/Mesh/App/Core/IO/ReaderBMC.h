@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+
+#ifndef MESH_IO_READER_BMC_H
+#define MESH_IO_READER_BMC_H
+
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/MeshGlobal.h>
+#include <iosfwd>
+
+namespace MeshCore
+{
+
+/** Loads the mesh object from data in the compact BMC format. */
+class MeshExport ReaderBMC
+{
+public:
+    /*!
+     * \brief ReaderBMC
+     */
+    explicit ReaderBMC(MeshKernel& kernel);
+    /*!
+     * \brief Load the mesh from the file. The file is memory-mapped if possible so that the
+     * mesh data is converted directly from the page cache without an intermediate buffer.
+     * \return true on success and false otherwise
+     */
+    bool Load(const std::string& filename);
+    /*!
+     * \brief Load the mesh from the input stream. The data is read in a single block.
+     * \return true on success and false otherwise
+     */
+    bool Load(std::istream& str);
+    /*!
+     * \brief Load the mesh from a memory block of \a size bytes.
+     * \return true on success and false otherwise
+     */
+    bool Load(const char* data, std::size_t size);
+    /*!
+     * \brief Checks if the \a size bytes of \a data start with the magic number of BMC.
+     */
+    static bool IsBMC(const char* data, std::size_t size);
+    /// The number of bytes IsBMC() needs
+    static std::size_t MagicSize();
+
+private:
+    MeshKernel& _kernel;
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_IO_READER_BMC_H
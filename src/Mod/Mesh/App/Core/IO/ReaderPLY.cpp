@@ -24,12 +24,15 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <boost/lexical_cast.hpp>
+#include <cstring>
 #include <istream>
 #endif
 
+#include "Core/Functional.h"
 #include "Core/MeshIO.h"
 #include "Core/MeshKernel.h"
 #include <Base/Stream.h>
+#include <Base/Swap.h>
 #include <Base/Tools.h>
 
 #include "ReaderPLY.h"
@@ -502,11 +505,20 @@ bool ReaderPLY::LoadAscii(std::istream& input)
 
 void ReaderPLY::addVertexProperty(const PropertyArray& prop)
 {
-    Base::Vector3f pt;
+    meshPoints.emplace_back();
+    if (_material && _material->binding == MeshIO::PER_VERTEX) {
+        _material->diffuseColor.emplace_back();
+    }
+
+    setVertexProperty(meshPoints.size() - 1, prop);
+}
+
+void ReaderPLY::setVertexProperty(std::size_t index, const PropertyArray& prop)
+{
+    MeshPoint& pt = meshPoints[index];
     pt.x = (prop[coord_x]);
     pt.y = (prop[coord_y]);
     pt.z = (prop[coord_z]);
-    meshPoints.push_back(pt);
 
     if (_material && _material->binding == MeshIO::PER_VERTEX) {
         // NOLINTBEGIN
@@ -514,63 +526,104 @@ void ReaderPLY::addVertexProperty(const PropertyArray& prop)
         float g = (prop[color_g]) / 255.0F;
         float b = (prop[color_b]) / 255.0F;
         // NOLINTEND
-        _material->diffuseColor.emplace_back(r, g, b);
+        _material->diffuseColor[index].set(r, g, b);
     }
 }
 
-bool ReaderPLY::ReadVertexes(Base::InputStream& is)
+std::size_t ReaderPLY::sizeOfNumber(Number number)
 {
-    for (std::size_t i = 0; i < v_count; i++) {
-        // go through the vertex properties
-        PropertyArray prop_values {};
-        for (const auto& it : vertex_props) {
-            switch (it.second) {
-                case int8: {
-                    int8_t vt {};
-                    is >> vt;
-                    prop_values[it.first] = static_cast<float>(vt);
-                } break;
-                case uint8: {
-                    uint8_t vt {};
-                    is >> vt;
-                    prop_values[it.first] = static_cast<float>(vt);
-                } break;
-                case int16: {
-                    int16_t vt {};
-                    is >> vt;
-                    prop_values[it.first] = static_cast<float>(vt);
-                } break;
-                case uint16: {
-                    uint16_t vt {};
-                    is >> vt;
-                    prop_values[it.first] = static_cast<float>(vt);
-                } break;
-                case int32: {
-                    int32_t vt {};
-                    is >> vt;
-                    prop_values[it.first] = static_cast<float>(vt);
-                } break;
-                case uint32: {
-                    uint32_t vt {};
-                    is >> vt;
-                    prop_values[it.first] = static_cast<float>(vt);
-                } break;
-                case float32: {
-                    float vt {};
-                    is >> vt;
-                    prop_values[it.first] = vt;
-                } break;
-                case float64: {
-                    double vt {};
-                    is >> vt;
-                    prop_values[it.first] = static_cast<float>(vt);
-                } break;
-                default:
-                    return false;
-            }
+    switch (number) {
+        case int8:
+        case uint8:
+            return 1;
+        case int16:
+        case uint16:
+            return 2;
+        case int32:
+        case uint32:
+        case float32:
+            return 4;
+        case float64:
+            return 8;
+    }
+
+    return 0;
+}
+
+namespace
+{
+template<typename T>
+float decodeValue(const char* data, bool swap)
+{
+    T value {};
+    std::memcpy(&value, data, sizeof(T));
+    if (swap) {
+        Base::SwapEndian<T>(value);
+    }
+    return static_cast<float>(value);
+}
+}  // namespace
+
+float ReaderPLY::decodeNumber(Number number, const char* data, bool swap)
+{
+    switch (number) {
+        case int8:
+            return decodeValue<int8_t>(data, swap);
+        case uint8:
+            return decodeValue<uint8_t>(data, swap);
+        case int16:
+            return decodeValue<int16_t>(data, swap);
+        case uint16:
+            return decodeValue<uint16_t>(data, swap);
+        case int32:
+            return decodeValue<int32_t>(data, swap);
+        case uint32:
+            return decodeValue<uint32_t>(data, swap);
+        case float32:
+            return decodeValue<float>(data, swap);
+        case float64:
+            return decodeValue<double>(data, swap);
+    }
+
+    return 0.0F;
+}
+
+bool ReaderPLY::ReadBinaryVertexes(std::istream& input)
+{
+    // All vertex properties are scalars so that each vertex has the same size. Thus, the
+    // vertexes are read in chunks and each chunk is decoded in parallel.
+    std::vector<std::size_t> offsets;
+    std::size_t recordSize = 0;
+    for (const auto& it : vertex_props) {
+        offsets.push_back(recordSize);
+        recordSize += sizeOfNumber(it.second);
+    }
+
+    bool swap = (format == binary_big_endian);
+    meshPoints.resize(v_count);
+    if (_material && _material->binding == MeshIO::PER_VERTEX) {
+        _material->diffuseColor.resize(v_count);
+    }
+
+    constexpr std::size_t chunkSize = 65536;
+    std::vector<char> chunk(recordSize * std::min(chunkSize, v_count));
+    for (std::size_t i = 0; i < v_count; i += chunkSize) {
+        std::size_t count = std::min(chunkSize, v_count - i);
+        if (!input.read(chunk.data(), static_cast<std::streamsize>(recordSize * count))) {
+            return false;
         }
 
-        addVertexProperty(prop_values);
+        MeshCore::parallel_chunks(count, 4096, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t j = begin; j < end; j++) {
+                const char* record = chunk.data() + recordSize * j;
+                PropertyArray prop_values {};
+                for (std::size_t k = 0; k < vertex_props.size(); k++) {
+                    const auto& it = vertex_props[k];
+                    prop_values[it.first] = decodeNumber(it.second, record + offsets[k], swap);
+                }
+                setVertexProperty(i + j, prop_values);
+            }
+        });
     }
 
     return true;
@@ -651,7 +704,7 @@ bool ReaderPLY::LoadBinary(std::istream& input)
         is.setByteOrder(Base::Stream::BigEndian);
     }
 
-    if (!ReadVertexes(is)) {
+    if (!ReadBinaryVertexes(input)) {
         return false;
     }
 
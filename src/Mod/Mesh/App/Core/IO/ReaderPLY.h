@@ -66,7 +66,7 @@ private:
     bool ReadFaceProperty(std::istream& str);
     bool ReadVertexes(std::istream& input);
     bool ReadFaces(std::istream& input);
-    bool ReadVertexes(Base::InputStream& is);
+    bool ReadBinaryVertexes(std::istream& input);
     bool ReadFaces(Base::InputStream& is);
     bool LoadAscii(std::istream& input);
     bool LoadBinary(std::istream& input);
@@ -88,6 +88,7 @@ private:
     static Property propertyOfName(const std::string& name);
     using PropertyArray = std::array<float, num_props>;
     void addVertexProperty(const PropertyArray& prop);
+    void setVertexProperty(std::size_t index, const PropertyArray& prop);
 
     enum Number
     {
@@ -101,6 +102,9 @@ private:
         float64
     };
 
+    static std::size_t sizeOfNumber(Number number);
+    static float decodeNumber(Number number, const char* data, bool swap);
+
     struct PropertyComp
     {
         using argument_type_1st = std::pair<Property, int>;
@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <array>
+#include <cstring>
+#include <ostream>
+#endif
+
+#include "Core/Functional.h"
+
+#include "FormatBMC.h"
+#include "WriterBMC.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+constexpr std::size_t MinChunkSize = 65536;
+
+template<class Element>
+void writeBitsets(char* data, const std::vector<Element>& elements, unsigned char flags)
+{
+    std::size_t numWords = (elements.size() + 63) / 64;
+    for (int bit = 0; bit < 8; bit++) {
+        auto flag = static_cast<unsigned char>(1 << bit);
+        if ((flags & flag) == 0) {
+            continue;
+        }
+
+        parallel_chunks(numWords, MinChunkSize / 64, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                std::uint64_t word = 0;
+                std::size_t last = std::min(64 * i + 64, elements.size());
+                for (std::size_t j = 64 * i; j < last; j++) {
+                    if ((elements[j]._ucFlag & flag) != 0) {
+                        word |= std::uint64_t(1) << (j - 64 * i);
+                    }
+                }
+                std::memcpy(data + i * sizeof(word), &word, sizeof(word));
+            }
+        });
+        data += BMC::Layout::bitsetSize(elements.size());
+    }
+}
+}  // namespace
+
+WriterBMC::WriterBMC(const MeshKernel& kernel)
+    : _kernel(kernel)
+{}
+
+void WriterBMC::SetPointFlags(unsigned char flags)
+{
+    _pointFlags = flags;
+}
+
+void WriterBMC::SetFacetFlags(unsigned char flags)
+{
+    _facetFlags = flags;
+}
+
+bool WriterBMC::Save(std::ostream& str) const
+{
+    const MeshPointArray& points = _kernel.GetPoints();
+    const MeshFacetArray& facets = _kernel.GetFacets();
+    if (!str || points.size() >= BMC::OpenEdge || facets.size() >= BMC::OpenEdge) {
+        return false;
+    }
+
+    BMC::Header header {};
+    std::memcpy(header.magic, BMC::Magic, sizeof(header.magic));
+    header.version = BMC::Version;
+    header.byteOrder = BMC::ByteOrder;
+    header.countPoints = points.size();
+    header.countFacets = facets.size();
+    header.pointFlags = _pointFlags;
+    header.facetFlags = _facetFlags;
+
+    // the sections are filled in parallel directly at their final position
+    BMC::Layout layout(header);
+    std::vector<char> buffer(layout.end - sizeof(header));
+    auto section = [&buffer](std::size_t offset) {
+        return buffer.data() + offset - sizeof(BMC::Header);
+    };
+
+    parallel_chunks(points.size(), MinChunkSize, [&](std::size_t begin, std::size_t end) {
+        char* dst = section(layout.points) + begin * 3 * sizeof(float);
+        for (std::size_t i = begin; i < end; i++) {
+            const MeshPoint& pnt = points[i];
+            std::array<float, 3> xyz {pnt.x, pnt.y, pnt.z};
+            std::memcpy(dst, xyz.data(), sizeof(xyz));
+            dst += sizeof(xyz);
+        }
+    });
+
+    parallel_chunks(facets.size(), MinChunkSize, [&](std::size_t begin, std::size_t end) {
+        char* dstPoints = section(layout.facets) + begin * 3 * sizeof(std::uint32_t);
+        char* dstNeighbours = section(layout.neighbours) + begin * 3 * sizeof(std::uint32_t);
+        for (std::size_t i = begin; i < end; i++) {
+            const MeshFacet& face = facets[i];
+            std::array<std::uint32_t, 3> corners {};
+            std::array<std::uint32_t, 3> neighbours {};
+            for (int j = 0; j < 3; j++) {
+                corners[j] = static_cast<std::uint32_t>(face._aulPoints[j]);
+                neighbours[j] = face._aulNeighbours[j] == FACET_INDEX_MAX
+                    ? BMC::OpenEdge
+                    : static_cast<std::uint32_t>(face._aulNeighbours[j]);
+            }
+            std::memcpy(dstPoints, corners.data(), sizeof(corners));
+            std::memcpy(dstNeighbours, neighbours.data(), sizeof(neighbours));
+            dstPoints += sizeof(corners);
+            dstNeighbours += sizeof(neighbours);
+        }
+    });
+
+    writeBitsets(section(layout.pointFlags), points, _pointFlags);
+    writeBitsets(section(layout.facetFlags), facets, _facetFlags);
+
+    header.dataSize = buffer.size();
+    header.checksum = BMC::checksum(buffer.data(), buffer.size());
+
+    str.write(reinterpret_cast<const char*>(&header), sizeof(header));  // NOLINT
+    str.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    return str.good();
+}
@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+
+#ifndef MESH_IO_WRITER_BMC_H
+#define MESH_IO_WRITER_BMC_H
+
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/MeshGlobal.h>
+#include <iosfwd>
+
+namespace MeshCore
+{
+
+/** Saves the mesh object in the compact BMC format. */
+class MeshExport WriterBMC
+{
+public:
+    /*!
+     * \brief WriterBMC
+     */
+    explicit WriterBMC(const MeshKernel& kernel);
+    /*!
+     * \brief Additionally store the given flags of the points. By default no flags are stored.
+     */
+    void SetPointFlags(unsigned char flags);
+    /*!
+     * \brief Additionally store the given flags of the facets. By default no flags are stored.
+     */
+    void SetFacetFlags(unsigned char flags);
+    /*!
+     * \brief Save the mesh to the output stream
+     * \return true on success and false otherwise
+     */
+    bool Save(std::ostream& str) const;
+
+private:
+    const MeshKernel& _kernel;
+    unsigned char _pointFlags {0};
+    unsigned char _facetFlags {0};
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_IO_WRITER_BMC_H
@@ -25,6 +25,7 @@
 #ifndef _PreComp_
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 #include <string_view>
@@ -37,9 +38,11 @@
 #include <boost/regex.hpp>
 
 #include "IO/Reader3MF.h"
+#include "IO/ReaderBMC.h"
 #include "IO/ReaderOBJ.h"
 #include "IO/ReaderPLY.h"
 #include "IO/Writer3MF.h"
+#include "IO/WriterBMC.h"
 #include "IO/WriterInventor.h"
 #include "IO/WriterOBJ.h"
 #include <Base/Builder3D.h>
@@ -181,6 +184,7 @@ std::vector<std::string> MeshInput::supportedMeshFormats()
 {
     std::vector<std::string> fmt;
     fmt.emplace_back("bms");
+    fmt.emplace_back("bmc");
     fmt.emplace_back("ply");
     fmt.emplace_back("stl");
     fmt.emplace_back("ast");
@@ -198,6 +202,9 @@ MeshIO::Format MeshInput::getFormat(const char* FileName)
     if (fi.hasExtension("bms")) {
         return MeshIO::Format::BMS;
     }
+    if (fi.hasExtension("bmc")) {
+        return MeshIO::Format::BMC;
+    }
     if (fi.hasExtension("ply")) {
         return MeshIO::Format::PLY;
     }
@@ -231,6 +238,12 @@ bool MeshInput::LoadAny(const char* FileName)
         throw Base::FileException("No permission on the file", FileName);
     }
 
+    // the BMC reader maps the file into memory
+    if (fi.hasExtension("bmc")) {
+        ReaderBMC reader(_rclMesh);
+        return reader.Load(std::string(FileName));
+    }
+
     Base::ifstream str(fi, std::ios::in | std::ios::binary);
 
     if (fi.hasExtension("bms")) {
@@ -286,6 +299,10 @@ bool MeshInput::LoadFormat(std::istream& input, MeshIO::Format fmt)
         case MeshIO::BMS:
             _rclMesh.Read(input);
             return true;
+        case MeshIO::BMC: {
+            ReaderBMC reader(_rclMesh);
+            return reader.Load(input);
+        }
         case MeshIO::APLY:
         case MeshIO::PLY:
             return LoadPLY(input);
@@ -801,8 +818,7 @@ bool MeshInput::LoadAsciiSTL(std::istream& input)
 bool MeshInput::LoadBinarySTL(std::istream& input)
 {
     char szInfo[80];
-    Base::Vector3f clVects[4];
-    uint16_t usAtt = 0;
+    Base::Vector3f clVects[3];
     uint32_t ulCt = 0;
 
     if (!input || input.bad()) {
@@ -842,15 +858,22 @@ bool MeshInput::LoadBinarySTL(std::istream& input)
 #endif
     builder.Initialize(ulCt);
 
-    for (uint32_t i = 0; i < ulCt; i++) {
-        // read normal, points
-        input.read((char*)&clVects, sizeof(clVects));
-
-        std::swap(clVects[0], clVects[3]);
-        builder.AddFacet(clVects);
+    // read the facets in chunks instead of one by one
+    // each record consists of the normal, the points and a 2 bytes attribute
+    constexpr std::size_t recordSize = 50;
+    constexpr uint32_t chunkSize = 8192;
+    std::vector<char> chunk(recordSize * chunkSize);
+    for (uint32_t i = 0; i < ulCt; i += chunkSize) {
+        uint32_t count = std::min(chunkSize, ulCt - i);
+        if (!input.read(chunk.data(), std::streamsize(recordSize * count))) {
+            return false;
+        }
 
-        // overread 2 bytes attribute
-        input.read((char*)&usAtt, sizeof(usAtt));
+        for (uint32_t j = 0; j < count; j++) {
+            const char* record = chunk.data() + recordSize * j;
+            std::memcpy(clVects, record + sizeof(Base::Vector3f), sizeof(clVects));
+            builder.AddFacet(clVects);
+        }
     }
 
     builder.Finish();
@@ -1283,6 +1306,7 @@ std::vector<std::string> MeshOutput::supportedMeshFormats()
 {
     std::vector<std::string> fmt;
     fmt.emplace_back("bms");
+    fmt.emplace_back("bmc");
     fmt.emplace_back("ply");
     fmt.emplace_back("stl");
     fmt.emplace_back("obj");
@@ -1305,6 +1329,9 @@ MeshIO::Format MeshOutput::GetFormat(const char* FileName)
     if (file.hasExtension("bms")) {
         return MeshIO::BMS;
     }
+    if (file.hasExtension("bmc")) {
+        return MeshIO::BMC;
+    }
     if (file.hasExtension("stl")) {
         return MeshIO::BSTL;
     }
@@ -1386,6 +1413,12 @@ bool MeshOutput::SaveAny(const char* FileName, MeshIO::Format format) const
     if (fileformat == MeshIO::BMS) {
         _rclMesh.Write(str);
     }
+    else if (fileformat == MeshIO::BMC) {
+        WriterBMC writer(_rclMesh);
+        if (!writer.Save(str)) {
+            throw Base::FileException("Export of BMC mesh failed", FileName);
+        }
+    }
     else if (fileformat == MeshIO::BSTL) {
         MeshOutput aWriter(_rclMesh);
         aWriter.Transform(this->_transform);
@@ -1533,6 +1566,10 @@ bool MeshOutput::SaveFormat(std::ostream& str, MeshIO::Format fmt) const
         case MeshIO::BMS:
             _rclMesh.Write(str);
             return true;
+        case MeshIO::BMC: {
+            WriterBMC writer(_rclMesh);
+            return writer.Save(str);
+        }
         case MeshIO::ASTL:
             return SaveAsciiSTL(str);
         case MeshIO::BSTL:
@@ -66,7 +66,8 @@ enum Format
     AMF,
     SMF,
     ASY,
-    ThreeMF
+    ThreeMF,
+    BMC
 };
 enum Binding
 {
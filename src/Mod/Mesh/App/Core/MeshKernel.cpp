@@ -30,6 +30,7 @@
 #include <stdexcept>
 #endif
 
+#include <Base/BulkVector.h>
 #include <Base/Exception.h>
 #include <Base/Stream.h>
 #include <Base/Swap.h>
@@ -1105,14 +1106,8 @@ void MeshKernel::operator*=(const Base::Matrix4D& rclMat)
 
 void MeshKernel::Transform(const Base::Matrix4D& rclMat)
 {
-    auto clPIter = _aclPointArray.begin(), clPEIter = _aclPointArray.end();
-
-    _clBoundBox.SetVoid();
-    while (clPIter < clPEIter) {
-        *clPIter *= rclMat;
-        _clBoundBox.Add(*clPIter);
-        clPIter++;
-    }
+    _aclPointArray.Transform(rclMat);
+    RecalcBoundBox();
 }
 
 void MeshKernel::Smooth(int iterations, float stepsize)
@@ -1123,9 +1118,13 @@ void MeshKernel::Smooth(int iterations, float stepsize)
 
 void MeshKernel::RecalcBoundBox() const
 {
-    _clBoundBox.SetVoid();
-    for (const auto& pI : _aclPointArray) {
-        _clBoundBox.Add(pI);
+    if (_aclPointArray.empty()) {
+        _clBoundBox.SetVoid();
+    }
+    else {
+        _clBoundBox = Base::BulkVector::boundBox(&_aclPointArray.front(),
+                                                 _aclPointArray.size(),
+                                                 sizeof(MeshPoint));
     }
 }
 
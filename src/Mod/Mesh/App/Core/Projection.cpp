@@ -27,6 +27,7 @@
 #include <map>
 #endif
 
+#include "BVH.h"
 #include "Grid.h"
 #include "Iterator.h"
 #include "MeshKernel.h"
@@ -139,12 +140,6 @@ bool MeshProjection::projectLineOnMesh(const MeshFacetGrid& grid,
                                        const Base::Vector3f& vd,
                                        std::vector<Base::Vector3f>& polyline)
 {
-    Base::Vector3f dir(v2 - v1);
-    Base::Vector3f base(v1), normal(vd % dir);
-    normal.Normalize();
-    dir.Normalize();
-
-
     std::vector<FacetIndex> facets;
 
     // special case: start and endpoint inside same facet
@@ -166,6 +161,49 @@ bool MeshProjection::projectLineOnMesh(const MeshFacetGrid& grid,
     std::sort(facets.begin(), facets.end());
     facets.erase(std::unique(facets.begin(), facets.end()), facets.end());
 
+    return projectLineOnFacets(facets, v1, f1, v2, f2, vd, polyline);
+}
+
+bool MeshProjection::projectLineOnMesh(const MeshFacetBVH& bvh,
+                                       const Base::Vector3f& v1,
+                                       FacetIndex f1,
+                                       const Base::Vector3f& v2,
+                                       FacetIndex f2,
+                                       const Base::Vector3f& vd,
+                                       std::vector<Base::Vector3f>& polyline)
+{
+    // special case: start and endpoint inside same facet
+    if (f1 == f2) {
+        polyline.push_back(v1);
+        polyline.push_back(v2);
+        return true;
+    }
+
+    // only descend into nodes whose bounding box is cut by the plane
+    std::vector<FacetIndex> facets;
+    bvh.Inside(
+        [&](const Base::BoundBox3f& box) {
+            return bboxInsideRectangle(box, v1, v2, vd);
+        },
+        facets);
+
+    std::sort(facets.begin(), facets.end());
+    return projectLineOnFacets(facets, v1, f1, v2, f2, vd, polyline);
+}
+
+bool MeshProjection::projectLineOnFacets(const std::vector<FacetIndex>& facets,
+                                         const Base::Vector3f& v1,
+                                         FacetIndex f1,
+                                         const Base::Vector3f& v2,
+                                         FacetIndex f2,
+                                         const Base::Vector3f& vd,
+                                         std::vector<Base::Vector3f>& polyline) const
+{
+    Base::Vector3f dir(v2 - v1);
+    Base::Vector3f base(v1), normal(vd % dir);
+    normal.Normalize();
+    dir.Normalize();
+
     // cut all facets with plane
     std::list<std::pair<Base::Vector3f, Base::Vector3f>> cutLine;
     for (FacetIndex facet : facets) {
@@ -39,6 +39,7 @@ class TopoDS_Shape;
 namespace MeshCore
 {
 
+class MeshFacetBVH;
 class MeshFacetGrid;
 class MeshKernel;
 class MeshGeomFacet;
@@ -55,6 +56,13 @@ public:
                            FacetIndex f2,
                            const Base::Vector3f& view,
                            std::vector<Base::Vector3f>& polyline);
+    bool projectLineOnMesh(const MeshFacetBVH& bvh,
+                           const Base::Vector3f& p1,
+                           FacetIndex f1,
+                           const Base::Vector3f& p2,
+                           FacetIndex f2,
+                           const Base::Vector3f& view,
+                           std::vector<Base::Vector3f>& polyline);
 
 protected:
     bool bboxInsideRectangle(const Base::BoundBox3f& bbox,
@@ -68,6 +76,13 @@ protected:
                       const Base::Vector3f& startPoint,
                       const Base::Vector3f& endPoint,
                       std::vector<Base::Vector3f>& polyline) const;
+    bool projectLineOnFacets(const std::vector<FacetIndex>& facets,
+                             const Base::Vector3f& p1,
+                             FacetIndex f1,
+                             const Base::Vector3f& p2,
+                             FacetIndex f2,
+                             const Base::Vector3f& view,
+                             std::vector<Base::Vector3f>& polyline) const;
 
 private:
     const MeshKernel& kernel;
@@ -23,15 +23,167 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #endif
 
 #include "Algorithm.h"
 #include "Approximation.h"
+#include "Functional.h"
 #include "Segmentation.h"
 
 using namespace MeshCore;
 
+namespace
+{
+// the facet tests of smaller meshes are done on a single thread
+constexpr std::size_t MinChunkSize = 4096;
+
+// fewer regions are grown on a single thread
+constexpr std::size_t MinRegionChunkSize = 64;
+
+struct AcceptedRegion
+{
+    FacetIndex seed;
+    // the facets reached from the seed in breadth-first order
+    std::vector<FacetIndex> grown;
+};
+
+/**
+ * Grows the regions over the facets whose test has already been done in advance. The result is
+ * the same as growing one region after another from the first facet not visited yet:
+ * A region is a seed facet and the connected accepted facets that are reached from it. The
+ * connected sets of accepted facets are computed in parallel. Then the seeds are picked in the
+ * order of the facets, where a set that touches several seeds belongs to the first of them.
+ * Finally, all regions are grown on several threads, each one only entering its own facets.
+ * All facets of the regions get the VISIT flag.
+ */
+std::vector<AcceptedRegion> growAcceptedRegions(const MeshFacetArray& facets,
+                                                const std::vector<char>& accepted)
+{
+    const std::size_t count = facets.size();
+    std::vector<char> open(count);
+    std::vector<std::atomic<FacetIndex>> parent(count);
+    parallel_chunks(count, MinChunkSize, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            open[i] = accepted[i] != 0 && !facets[i].IsFlag(MeshFacet::VISIT) ? 1 : 0;
+            parent[i].store(i);
+        }
+    });
+
+    // the root of a set is always its smallest facet index, so the sets and their roots don't
+    // depend on the order in which the threads join them
+    auto find = [&parent](FacetIndex index) {
+        FacetIndex next {};
+        while ((next = parent[index].load()) != index) {
+            index = next;
+        }
+        return index;
+    };
+    auto unite = [&parent, &find](FacetIndex index1, FacetIndex index2) {
+        while (true) {
+            index1 = find(index1);
+            index2 = find(index2);
+            if (index1 == index2) {
+                return;
+            }
+            if (index1 < index2) {
+                std::swap(index1, index2);
+            }
+            if (parent[index1].compare_exchange_strong(index1, index2)) {
+                return;
+            }
+        }
+    };
+
+    parallel_chunks(count, MinChunkSize, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            if (open[i] == 0) {
+                continue;
+            }
+            for (FacetIndex nb : facets[i]._aulNeighbours) {
+                if (nb > i && nb < count && open[nb] != 0) {
+                    unite(i, nb);
+                }
+            }
+        }
+    });
+
+    std::vector<FacetIndex> root(count, FACET_INDEX_MAX);
+    parallel_chunks(count, MinChunkSize, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            if (open[i] != 0) {
+                root[i] = find(i);
+            }
+        }
+    });
+
+    // the seed facet that owns a set, indexed by the root of the set
+    std::vector<FacetIndex> owner(count, FACET_INDEX_MAX);
+    std::vector<AcceptedRegion> regions;
+    for (FacetIndex i = 0; i < count; i++) {
+        if (facets[i].IsFlag(MeshFacet::VISIT)) {
+            continue;
+        }
+        if (open[i] != 0) {
+            // the set was already reached from a seed before
+            if (owner[root[i]] != FACET_INDEX_MAX) {
+                continue;
+            }
+            owner[root[i]] = i;
+        }
+        else {
+            for (FacetIndex nb : facets[i]._aulNeighbours) {
+                if (nb < count && open[nb] != 0 && owner[root[nb]] == FACET_INDEX_MAX) {
+                    owner[root[nb]] = i;
+                }
+            }
+        }
+        regions.push_back({i, {}});
+    }
+
+    auto ownerOf = [&](FacetIndex index) {
+        return open[index] != 0 ? owner[root[index]] : FACET_INDEX_MAX;
+    };
+
+    // a facet is only written by the thread that grows its region
+    std::vector<char> visited(count);
+    parallel_chunks(regions.size(), MinRegionChunkSize, [&](std::size_t begin, std::size_t end) {
+        std::vector<FacetIndex> level;
+        std::vector<FacetIndex> next;
+        for (std::size_t r = begin; r < end; r++) {
+            AcceptedRegion& region = regions[r];
+            visited[region.seed] = 1;
+            level.assign(1, region.seed);
+            while (!level.empty()) {
+                for (FacetIndex index : level) {
+                    for (FacetIndex nb : facets[index]._aulNeighbours) {
+                        if (nb >= count || ownerOf(nb) != region.seed || visited[nb] != 0) {
+                            continue;
+                        }
+                        visited[nb] = 1;
+                        next.push_back(nb);
+                        region.grown.push_back(nb);
+                    }
+                }
+                level.swap(next);
+                next.clear();
+            }
+        }
+    });
+
+    parallel_chunks(count, MinChunkSize, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            if (visited[i] != 0) {
+                facets[i].SetFlag(MeshFacet::VISIT);
+            }
+        }
+    });
+
+    return regions;
+}
+}  // namespace
+
 void MeshSurfaceSegment::Initialize(FacetIndex)
 {}
 
@@ -538,6 +690,10 @@ bool MeshSurfaceVisitor::AllowVisit(const MeshFacet& face,
                                     unsigned long,
                                     unsigned short)
 {
+    // avoid testing (and re-fitting) for facets that are already part of a region
+    if (face.IsFlag(MeshFacet::VISIT)) {
+        return false;
+    }
     return segm.TestFacet(face);
 }
 
@@ -573,6 +729,38 @@ void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm
         cAlgo.ResetFacetsFlag(resetVisited, MeshCore::MeshFacet::VISIT);
         resetVisited.clear();
 
+        // if the test doesn't depend on the region it's done for all facets in parallel and the
+        // regions are grown on several threads
+        if (!it->IsGrowing()) {
+            std::vector<char> accepted(rFAry.size());
+            parallel_chunks(rFAry.size(), MinChunkSize, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; i++) {
+                    accepted[i] = it->TestFacet(rFAry[i]) ? 1 : 0;
+                }
+            });
+
+            for (const auto& region : growAcceptedRegions(rFAry, accepted)) {
+                std::vector<FacetIndex> indices;
+                it->Initialize(region.seed);
+                if (it->TestInitialFacet(region.seed)) {
+                    indices.push_back(region.seed);
+                }
+                for (FacetIndex index : region.grown) {
+                    indices.push_back(index);
+                    it->AddFacet(rFAry[index]);
+                }
+
+                // add or discard the segment
+                if (indices.size() <= 1) {
+                    resetVisited.push_back(region.seed);
+                }
+                else {
+                    it->AddSegment(indices);
+                }
+            }
+            continue;
+        }
+
         MeshCore::MeshIsNotFlag<MeshCore::MeshFacet> flag;
         iCur = std::find_if(iBeg, iEnd, [flag](const MeshFacet& f) {
             return flag(f, MeshFacet::VISIT);
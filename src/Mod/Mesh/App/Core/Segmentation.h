@@ -55,6 +55,15 @@ public:
 
     virtual bool TestFacet(const MeshFacet& rclFacet) const = 0;
     virtual const char* GetType() const = 0;
+    /**
+     * Returns true if the result of TestFacet() depends on the facets added so far. Otherwise
+     * TestFacet() must be thread-safe because it's called for all facets in parallel before the
+     * regions are grown on several threads.
+     */
+    virtual bool IsGrowing() const
+    {
+        return true;
+    }
     virtual void Initialize(FacetIndex);
     virtual bool TestInitialFacet(FacetIndex) const;
     virtual void AddFacet(const MeshFacet& rclFacet);
@@ -270,6 +279,10 @@ public:
     {
         return info.at(pos);
     }
+    bool IsGrowing() const override
+    {
+        return false;
+    }
 
 private:
     const std::vector<CurvatureInfo>& info;
@@ -31,6 +31,7 @@
 #include <Base/Sequencer.h>
 
 #include "Algorithm.h"
+#include "Boolean.h"
 #include "Builder.h"
 #include "Definitions.h"
 #include "Elements.h"
@@ -59,6 +60,31 @@ SetOperations::SetOperations(const MeshKernel& cutMesh1,
 
 void SetOperations::Do()
 {
+    // closed meshes are handled by the corefinement that uses exact predicates
+    MeshBoolean::Operation operation {};
+    switch (_operationType) {
+        case Union:
+            operation = MeshBoolean::Union;
+            break;
+        case Intersect:
+            operation = MeshBoolean::Intersect;
+            break;
+        case Difference:
+            operation = MeshBoolean::Difference;
+            break;
+        case Inner:
+            operation = MeshBoolean::Inner;
+            break;
+        case Outer:
+            operation = MeshBoolean::Outer;
+            break;
+    }
+
+    MeshBoolean boolean(_cutMesh0, _cutMesh1, operation);
+    if (boolean.Perform(_resultMesh)) {
+        return;
+    }
+
     _minDistanceToPoint = 0.000001F;
     float saveMinMeshDistance = MeshDefinitions::_fMinPointDistance;
     MeshDefinitions::SetMinPointDistance(0.000001F);
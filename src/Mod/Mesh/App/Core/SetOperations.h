@@ -73,6 +73,7 @@ public:
     /** Cut this mesh with another one. The result is a list of polylines
      * If the distance of the polyline to one of the points is less than minDistanceToPoint the
      * polyline goes direct to the point
+     * If both meshes are closed the operation is done by MeshBoolean.
      */
     void Do();
 
@@ -22,20 +22,109 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
 #include <cmath>
+#include <numeric>
 #endif
 
 #include <Base/Tools.h>
 
-#include "Algorithm.h"
 #include "Approximation.h"
-#include "Iterator.h"
+#include "Functional.h"
 #include "MeshKernel.h"
 #include "Smoothing.h"
 
 
 using namespace MeshCore;
 
+namespace
+{
+// the minimum number of elements handled by a thread
+const std::size_t minChunkSize = 1024;
+}  // namespace
+
+MeshPointAdjacency::MeshPointAdjacency(const MeshKernel& mesh)
+{
+    Rebuild(mesh);
+}
+
+void MeshPointAdjacency::Rebuild(const MeshKernel& mesh)
+{
+    const MeshFacetArray& facets = mesh.GetFacets();
+    std::size_t numPoints = mesh.CountPoints();
+    numFacets = facets.size();
+
+    // the facets of each point, a degenerated facet is counted only once
+    auto isDuplicate = [](const MeshFacet& facet, int corner) {
+        const PointIndex* pts = facet._aulPoints;
+        return (corner > 0 && pts[corner] == pts[0]) || (corner == 2 && pts[2] == pts[1]);
+    };
+
+    facetOffsets.assign(numPoints + 1, 0);
+    for (const auto& facet : facets) {
+        for (int i = 0; i < 3; i++) {
+            if (!isDuplicate(facet, i)) {
+                facetOffsets[facet._aulPoints[i] + 1]++;
+            }
+        }
+    }
+    std::partial_sum(facetOffsets.begin(), facetOffsets.end(), facetOffsets.begin());
+
+    facetIndices.resize(facetOffsets.back());
+    std::vector<std::size_t> fill(facetOffsets.begin(), facetOffsets.end() - 1);
+    for (FacetIndex index = 0; index < numFacets; index++) {
+        const MeshFacet& facet = facets[index];
+        for (int i = 0; i < 3; i++) {
+            if (!isDuplicate(facet, i)) {
+                facetIndices[fill[facet._aulPoints[i]]++] = index;
+            }
+        }
+    }
+
+    // the neighbour points are counted in a first pass and written in a second one
+    auto collectPoints = [&](PointIndex pos, std::vector<PointIndex>& neighbours) {
+        neighbours.clear();
+        for (FacetIndex index : NeighbourFacets(pos)) {
+            for (PointIndex pt : facets[index]._aulPoints) {
+                if (pt != pos) {
+                    neighbours.push_back(pt);
+                }
+            }
+        }
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+    };
+
+    pointOffsets.assign(numPoints + 1, 0);
+    parallel_chunks(numPoints, minChunkSize, [&](std::size_t begin, std::size_t end) {
+        std::vector<PointIndex> neighbours;
+        for (std::size_t pos = begin; pos < end; pos++) {
+            collectPoints(pos, neighbours);
+            pointOffsets[pos + 1] = neighbours.size();
+        }
+    });
+    std::partial_sum(pointOffsets.begin(), pointOffsets.end(), pointOffsets.begin());
+
+    pointIndices.resize(pointOffsets.back());
+    parallel_chunks(numPoints, minChunkSize, [&](std::size_t begin, std::size_t end) {
+        std::vector<PointIndex> neighbours;
+        for (std::size_t pos = begin; pos < end; pos++) {
+            collectPoints(pos, neighbours);
+            std::copy(neighbours.begin(),
+                      neighbours.end(),
+                      pointIndices.begin() + std::ptrdiff_t(pointOffsets[pos]));
+        }
+    });
+}
+
+void MeshPointAdjacency::Clear()
+{
+    pointOffsets.clear();
+    pointIndices.clear();
+    facetOffsets.clear();
+    facetIndices.clear();
+    numFacets = 0;
+}
 
 AbstractSmoothing::AbstractSmoothing(MeshKernel& m)
     : kernel(m)
@@ -49,91 +138,80 @@ void AbstractSmoothing::initialize(Component comp, Continuity cont)
     this->continuity = cont;
 }
 
+const MeshPointAdjacency& AbstractSmoothing::GetAdjacency()
+{
+    if (adjacency.CountPoints() != kernel.CountPoints()
+        || adjacency.CountFacets() != kernel.CountFacets()) {
+        adjacency.Rebuild(kernel);
+    }
+    return adjacency;
+}
+
+void AbstractSmoothing::ResetAdjacency()
+{
+    adjacency.Clear();
+}
+
+void AbstractSmoothing::SetPoints(const std::vector<Base::Vector3f>& points,
+                                  const std::vector<PointIndex>& indices)
+{
+    // SetPoint() only changes the coordinates so that distinct points can be set concurrently
+    parallel_chunks(points.size(), minChunkSize, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            kernel.SetPoint(indices.empty() ? i : indices[i], points[i]);
+        }
+    });
+}
+
 PlaneFitSmoothing::PlaneFitSmoothing(MeshKernel& m)
     : AbstractSmoothing(m)
 {}
 
 void PlaneFitSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshPoint center;
-    MeshCore::MeshPointArray PointArray = kernel.GetPoints();
-
-    MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
-
     for (unsigned int i = 0; i < iterations; i++) {
-        Base::Vector3f N, L;
-        for (v_it.Begin(); v_it.More(); v_it.Next()) {
-            MeshCore::PlaneFit pf;
-            pf.AddPoint(*v_it);
-            center = *v_it;
-            const std::set<PointIndex>& cv = vv_it[v_it.Position()];
-            if (cv.size() < 3) {
-                continue;
-            }
-
-            std::set<PointIndex>::const_iterator cv_it;
-            for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-                pf.AddPoint(v_beg[*cv_it]);
-                center += v_beg[*cv_it];
-            }
-
-            float scale = 1.0F / (static_cast<float>(cv.size()) + 1.0F);
-            center.Scale(scale, scale, scale);
-
-            // get the mean plane of the current vertex with the surrounding vertices
-            pf.Fit();
-            N = pf.GetNormal();
-            N.Normalize();
-
-            // look in which direction we should move the vertex
-            L.Set(v_it->x - center.x, v_it->y - center.y, v_it->z - center.z);
-            if (N * L < 0.0F) {
-                N.Scale(-1.0, -1.0, -1.0);
-            }
-
-            // maximum value to move is distance to mean plane
-            float d = std::min<float>(std::fabs(this->maximum), fabs(N * L));
-            N.Scale(d, d, d);
-
-            PointArray[v_it.Position()].Set(v_it->x - N.x, v_it->y - N.y, v_it->z - N.z);
-        }
-
-        // assign values without affecting iterators
-        PointIndex count = kernel.CountPoints();
-        for (PointIndex idx = 0; idx < count; idx++) {
-            kernel.SetPoint(idx, PointArray[idx]);
-        }
+        UpdatePoints({});
     }
 }
 
 void PlaneFitSmoothing::SmoothPoints(unsigned int iterations,
                                      const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshPoint center;
-    MeshCore::MeshPointArray PointArray = kernel.GetPoints();
-
-    MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
+    // an empty list would select all points
+    if (point_indices.empty()) {
+        return;
+    }
 
     for (unsigned int i = 0; i < iterations; i++) {
-        Base::Vector3f N, L;
-        for (PointIndex it : point_indices) {
-            v_it.Set(it);
-            MeshCore::PlaneFit pf;
-            pf.AddPoint(*v_it);
-            center = *v_it;
-            const std::set<PointIndex>& cv = vv_it[v_it.Position()];
+        UpdatePoints(point_indices);
+    }
+}
+
+void PlaneFitSmoothing::UpdatePoints(const std::vector<PointIndex>& indices)
+{
+    const MeshPointAdjacency& adj = GetAdjacency();
+    const MeshPointArray& points = kernel.GetPoints();
+
+    // compute all new points before assigning them
+    std::size_t count = indices.empty() ? points.size() : indices.size();
+    std::vector<Base::Vector3f> newPoints(count);
+    parallel_chunks(count, minChunkSize, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            PointIndex pos = indices.empty() ? i : indices[i];
+            const MeshPoint& pnt = points[pos];
+            newPoints[i] = pnt;
+
+            auto cv = adj.NeighbourPoints(pos);
             if (cv.size() < 3) {
                 continue;
             }
 
-            std::set<PointIndex>::const_iterator cv_it;
-            for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-                pf.AddPoint(v_beg[*cv_it]);
-                center += v_beg[*cv_it];
+            MeshCore::PlaneFit pf;
+            pf.AddPoint(pnt);
+            Base::Vector3f center = pnt;
+            for (PointIndex nb : cv) {
+                pf.AddPoint(points[nb]);
+                center += points[nb];
             }
 
             float scale = 1.0F / (static_cast<float>(cv.size()) + 1.0F);
@@ -141,126 +219,87 @@ void PlaneFitSmoothing::SmoothPoints(unsigned int iterations,
 
             // get the mean plane of the current vertex with the surrounding vertices
             pf.Fit();
-            N = pf.GetNormal();
+            Base::Vector3f N = pf.GetNormal();
             N.Normalize();
 
             // look in which direction we should move the vertex
-            L.Set(v_it->x - center.x, v_it->y - center.y, v_it->z - center.z);
+            Base::Vector3f L = pnt - center;
             if (N * L < 0.0F) {
                 N.Scale(-1.0, -1.0, -1.0);
             }
 
             // maximum value to move is distance to mean plane
-            float d = std::min<float>(std::fabs(this->maximum), fabs(N * L));
+            float d = std::min<float>(std::fabs(this->maximum), std::fabs(N * L));
             N.Scale(d, d, d);
 
-            PointArray[v_it.Position()].Set(v_it->x - N.x, v_it->y - N.y, v_it->z - N.z);
+            newPoints[i] = pnt - N;
         }
+    });
 
-        // assign values without affecting iterators
-        PointIndex count = kernel.CountPoints();
-        for (PointIndex idx = 0; idx < count; idx++) {
-            kernel.SetPoint(idx, PointArray[idx]);
-        }
-    }
+    SetPoints(newPoints, indices);
 }
 
 LaplaceSmoothing::LaplaceSmoothing(MeshKernel& m)
     : AbstractSmoothing(m)
 {}
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it,
-                                double stepsize)
-{
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_it, v_beg = points.begin(), v_end = points.end();
-
-    PointIndex pos = 0;
-    for (v_it = points.begin(); v_it != v_end; ++v_it, ++pos) {
-        const std::set<PointIndex>& cv = vv_it[pos];
-        if (cv.size() < 3) {
-            continue;
-        }
-        if (cv.size() != vf_it[pos].size()) {
-            // do nothing for border points
-            continue;
-        }
-
-        size_t n_count = cv.size();
-        double w {};
-        w = 1.0 / double(n_count);
-
-        double delx = 0.0, dely = 0.0, delz = 0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-            delx += w * static_cast<double>((v_beg[*cv_it]).x - v_it->x);
-            dely += w * static_cast<double>((v_beg[*cv_it]).y - v_it->y);
-            delz += w * static_cast<double>((v_beg[*cv_it]).z - v_it->z);
-        }
-
-        float x = static_cast<float>(static_cast<double>(v_it->x) + stepsize * delx);
-        float y = static_cast<float>(static_cast<double>(v_it->y) + stepsize * dely);
-        float z = static_cast<float>(static_cast<double>(v_it->z) + stepsize * delz);
-        kernel.SetPoint(pos, x, y, z);
-    }
-}
-
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it,
-                                double stepsize,
-                                const std::vector<PointIndex>& point_indices)
+void LaplaceSmoothing::Umbrella(double stepsize, const std::vector<PointIndex>& indices)
 {
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_beg = points.begin();
-
-    for (PointIndex it : point_indices) {
-        const std::set<PointIndex>& cv = vv_it[it];
-        if (cv.size() < 3) {
-            continue;
-        }
-        if (cv.size() != vf_it[it].size()) {
-            // do nothing for border points
-            continue;
-        }
+    const MeshPointAdjacency& adj = GetAdjacency();
+    const MeshPointArray& points = kernel.GetPoints();
+
+    // compute all new points before assigning them
+    std::size_t count = indices.empty() ? points.size() : indices.size();
+    std::vector<Base::Vector3f> newPoints(count);
+    parallel_chunks(count, minChunkSize, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            PointIndex pos = indices.empty() ? i : indices[i];
+            const MeshPoint& pnt = points[pos];
+            newPoints[i] = pnt;
+
+            auto cv = adj.NeighbourPoints(pos);
+            if (cv.size() < 3) {
+                continue;
+            }
+            if (adj.IsBorder(pos)) {
+                // do nothing for border points
+                continue;
+            }
 
-        size_t n_count = cv.size();
-        double w {};
-        w = 1.0 / double(n_count);
+            double delx = 0.0, dely = 0.0, delz = 0.0;
+            for (PointIndex nb : cv) {
+                delx += static_cast<double>(points[nb].x - pnt.x);
+                dely += static_cast<double>(points[nb].y - pnt.y);
+                delz += static_cast<double>(points[nb].z - pnt.z);
+            }
 
-        double delx = 0.0, dely = 0.0, delz = 0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-            delx += w * static_cast<double>((v_beg[*cv_it]).x - (v_beg[it]).x);
-            dely += w * static_cast<double>((v_beg[*cv_it]).y - (v_beg[it]).y);
-            delz += w * static_cast<double>((v_beg[*cv_it]).z - (v_beg[it]).z);
+            double w = stepsize / double(cv.size());
+            newPoints[i].Set(static_cast<float>(static_cast<double>(pnt.x) + w * delx),
+                             static_cast<float>(static_cast<double>(pnt.y) + w * dely),
+                             static_cast<float>(static_cast<double>(pnt.z) + w * delz));
         }
+    });
 
-        float x = static_cast<float>(static_cast<double>((v_beg[it]).x) + stepsize * delx);
-        float y = static_cast<float>(static_cast<double>((v_beg[it]).y) + stepsize * dely);
-        float z = static_cast<float>(static_cast<double>((v_beg[it]).z) + stepsize * delz);
-        kernel.SetPoint(it, x, y, z);
-    }
+    SetPoints(newPoints, indices);
 }
 
 void LaplaceSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
     for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda);
+        Umbrella(lambda, {});
     }
 }
 
 void LaplaceSmoothing::SmoothPoints(unsigned int iterations,
                                     const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    // an empty list would select all points
+    if (point_indices.empty()) {
+        return;
+    }
 
     for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda, point_indices);
+        Umbrella(lambda, point_indices);
     }
 }
 
@@ -270,28 +309,27 @@ TaubinSmoothing::TaubinSmoothing(MeshKernel& m)
 
 void TaubinSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations + 1) / 2;  // two steps per iteration
     for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, GetLambda());
-        Umbrella(vv_it, vf_it, -(GetLambda() + micro));
+        Umbrella(GetLambda(), {});
+        Umbrella(-(GetLambda() + micro), {});
     }
 }
 
 void TaubinSmoothing::SmoothPoints(unsigned int iterations,
                                    const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    // an empty list would select all points
+    if (point_indices.empty()) {
+        return;
+    }
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations + 1) / 2;  // two steps per iteration
     for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, GetLambda(), point_indices);
-        Umbrella(vv_it, vf_it, -(GetLambda() + micro), point_indices);
+        Umbrella(GetLambda(), point_indices);
+        Umbrella(-(GetLambda() + micro), point_indices);
     }
 }
 
@@ -327,94 +365,106 @@ MedianFilterSmoothing::MedianFilterSmoothing(MeshKernel& m)
 
 void MedianFilterSmoothing::Smooth(unsigned int iterations)
 {
-    std::vector<unsigned long> point_indices(kernel.CountPoints());
-    std::generate(point_indices.begin(), point_indices.end(), Base::iotaGen<unsigned long>(0));
-    MeshCore::MeshRefFacetToFacets ff_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    std::vector<PointIndex> point_indices(kernel.CountPoints());
+    std::iota(point_indices.begin(), point_indices.end(), 0);
 
     for (unsigned int i = 0; i < iterations; i++) {
-        UpdatePoints(ff_it, vf_it, point_indices);
+        UpdatePoints(point_indices);
     }
 }
 
 void MedianFilterSmoothing::SmoothPoints(unsigned int iterations,
                                          const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefFacetToFacets ff_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
     for (unsigned int i = 0; i < iterations; i++) {
-        UpdatePoints(ff_it, vf_it, point_indices);
+        UpdatePoints(point_indices);
     }
 }
 
-void MedianFilterSmoothing::UpdatePoints(const MeshRefFacetToFacets& ff_it,
-                                         const MeshRefPointToFacets& vf_it,
-                                         const std::vector<PointIndex>& point_indices)
+void MedianFilterSmoothing::UpdatePoints(const std::vector<PointIndex>& point_indices)
 {
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    const MeshCore::MeshFacetArray& facets = kernel.GetFacets();
+    const MeshPointAdjacency& adj = GetAdjacency();
+    const MeshPointArray& points = kernel.GetPoints();
+    const MeshFacetArray& facets = kernel.GetFacets();
 
     // Initialize the array with the real normals
-    std::vector<Base::Vector3d> faceNormals;
-    faceNormals.reserve(facets.size());
-    MeshCore::MeshFacetIterator iter(kernel);
-    for (iter.Init(); iter.More(); iter.Next()) {
-        faceNormals.emplace_back(Base::toVector<double>(iter->GetNormal()));
-    }
+    std::vector<Base::Vector3d> realNormals(facets.size());
+    parallel_chunks(facets.size(), minChunkSize, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t pos = begin; pos < end; pos++) {
+            realNormals[pos] = Base::toVector<double>(kernel.GetFacet(pos).GetNormal());
+        }
+    });
 
     // Step 1: determine face normals
-    for (FacetIndex pos = 0; pos < facets.size(); pos++) {
-        iter.Set(pos);
-        Base::Vector3d refNormal = Base::toVector<double>(iter->GetNormal());
-        const std::set<FacetIndex>& cv = ff_it[pos];
-        const MeshCore::MeshFacet& facet = facets[pos];
-
+    std::vector<Base::Vector3d> faceNormals(facets.size());
+    parallel_chunks(facets.size(), minChunkSize, [&](std::size_t begin, std::size_t end) {
+        std::vector<FacetIndex> cv;
         std::vector<AngleNormal> anglesWithFaces;
-        for (auto fi : cv) {
-            iter.Set(fi);
-            Base::Vector3d faceNormal = Base::toVector<double>(iter->GetNormal());
-            double angle = refNormal.GetAngle(faceNormal);
-
-            int absWeight = std::abs(weights);
-            if (absWeight > 1 && facet.IsNeighbour(fi)) {
-                if (weights < 0) {
-                    angle = -angle;
+        for (std::size_t pos = begin; pos < end; pos++) {
+            const MeshCore::MeshFacet& facet = facets[pos];
+            const Base::Vector3d& refNormal = realNormals[pos];
+
+            // all facets sharing a point with this facet, including itself
+            cv.clear();
+            for (PointIndex pt : facet._aulPoints) {
+                auto range = adj.NeighbourFacets(pt);
+                cv.insert(cv.end(), range.begin(), range.end());
+            }
+            std::sort(cv.begin(), cv.end());
+            cv.erase(std::unique(cv.begin(), cv.end()), cv.end());
+
+            anglesWithFaces.clear();
+            for (auto fi : cv) {
+                const Base::Vector3d& faceNormal = realNormals[fi];
+                double angle = refNormal.GetAngle(faceNormal);
+
+                int absWeight = std::abs(weights);
+                if (absWeight > 1 && facet.IsNeighbour(fi)) {
+                    if (weights < 0) {
+                        angle = -angle;
+                    }
+                    for (int i = 0; i < absWeight; i++) {
+                        anglesWithFaces.emplace_back(angle, faceNormal);
+                    }
                 }
-                for (int i = 0; i < absWeight; i++) {
+                else {
                     anglesWithFaces.emplace_back(angle, faceNormal);
                 }
             }
-            else {
-                anglesWithFaces.emplace_back(angle, faceNormal);
-            }
-        }
 
-        faceNormals[pos] = find_median(anglesWithFaces);
-    }
+            faceNormals[pos] = find_median(anglesWithFaces);
+        }
+    });
 
     // Step 2: move vertices
-    for (auto pos : point_indices) {
-        Base::Vector3d P = Base::toVector<double>(points[pos]);
-        const std::set<FacetIndex>& cv = vf_it[pos];
-
-        double totalArea = 0.0;
-        Base::Vector3d totalvT;
-        for (auto it : cv) {
-            iter.Set(it);
-
-            double faceArea = iter->Area();
-            totalArea += faceArea;
-
-            Base::Vector3d C = Base::toVector<double>(iter->GetGravityPoint());
+    std::vector<Base::Vector3f> newPoints(point_indices.size());
+    parallel_chunks(point_indices.size(), minChunkSize, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            PointIndex pos = point_indices[i];
+            Base::Vector3d P = Base::toVector<double>(points[pos]);
+
+            double totalArea = 0.0;
+            Base::Vector3d totalvT;
+            for (auto it : adj.NeighbourFacets(pos)) {
+                MeshGeomFacet face = kernel.GetFacet(it);
+
+                double faceArea = face.Area();
+                totalArea += faceArea;
+
+                Base::Vector3d C = Base::toVector<double>(face.GetGravityPoint());
+
+                Base::Vector3d PC = C - P;
+                Base::Vector3d mT = faceNormals[it];
+                Base::Vector3d vT = (PC * mT) * mT;
+                totalvT += vT * faceArea;
+            }
 
-            Base::Vector3d PC = C - P;
-            Base::Vector3d mT = faceNormals[it];
-            Base::Vector3d vT = (PC * mT) * mT;
-            totalvT += vT * faceArea;
+            if (totalArea > 0.0) {
+                P = P + totalvT / totalArea;
+            }
+            newPoints[i] = Base::toVector<float>(P);
         }
+    });
 
-        P = P + totalvT / totalArea;
-        kernel.SetPoint(pos, Base::toVector<float>(P));
-    }
+    SetPoints(newPoints, point_indices);
 }
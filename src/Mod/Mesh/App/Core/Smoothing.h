@@ -24,17 +24,84 @@
 #define MESH_SMOOTHING_H
 
 #include <cfloat>
+#include <cstddef>
 #include <vector>
 
+#include <Base/Vector3D.h>
+
 #include "Definitions.h"
 
 
 namespace MeshCore
 {
 class MeshKernel;
-class MeshRefPointToPoints;
-class MeshRefPointToFacets;
-class MeshRefFacetToFacets;
+
+/**
+ * The MeshPointAdjacency class keeps the neighbour points and the adjacent facets of all points
+ * of a mesh in compressed sparse row format, i.e. the indices of all points are stored in one
+ * array together with the offsets of each point. Unlike MeshRefPointToPoints and
+ * MeshRefPointToFacets it allocates only a few arrays and is built on several threads.
+ */
+class MeshExport MeshPointAdjacency
+{
+public:
+    template<typename T>
+    struct Range
+    {
+        const T* first;
+        const T* last;
+        const T* begin() const
+        {
+            return first;
+        }
+        const T* end() const
+        {
+            return last;
+        }
+        std::size_t size() const
+        {
+            return static_cast<std::size_t>(last - first);
+        }
+    };
+
+    MeshPointAdjacency() = default;
+    explicit MeshPointAdjacency(const MeshKernel&);
+    void Rebuild(const MeshKernel&);
+    void Clear();
+
+    std::size_t CountPoints() const
+    {
+        return pointOffsets.empty() ? 0 : pointOffsets.size() - 1;
+    }
+    std::size_t CountFacets() const
+    {
+        return numFacets;
+    }
+    /// The sorted indices of the points connected with \a pos by an edge
+    Range<PointIndex> NeighbourPoints(PointIndex pos) const
+    {
+        return {pointIndices.data() + pointOffsets[pos],
+                pointIndices.data() + pointOffsets[pos + 1]};
+    }
+    /// The sorted indices of the facets that reference \a pos
+    Range<FacetIndex> NeighbourFacets(PointIndex pos) const
+    {
+        return {facetIndices.data() + facetOffsets[pos],
+                facetIndices.data() + facetOffsets[pos + 1]};
+    }
+    /// A point inside a manifold mesh has as many neighbour points as facets
+    bool IsBorder(PointIndex pos) const
+    {
+        return NeighbourPoints(pos).size() != NeighbourFacets(pos).size();
+    }
+
+private:
+    std::vector<std::size_t> pointOffsets;
+    std::vector<PointIndex> pointIndices;
+    std::vector<std::size_t> facetOffsets;
+    std::vector<FacetIndex> facetIndices;
+    std::size_t numFacets {0};
+};
 
 /** Base class for smoothing algorithms. */
 class MeshExport AbstractSmoothing
@@ -67,6 +134,20 @@ public:
     virtual void Smooth(unsigned int) = 0;
     virtual void SmoothPoints(unsigned int, const std::vector<PointIndex>&) = 0;
 
+    /** Returns the adjacency of the mesh points. It is built on first use and kept for further
+     * calls of Smooth() as long as the number of points and facets doesn't change.
+     */
+    const MeshPointAdjacency& GetAdjacency();
+    /** Discards the adjacency. This must be called after changing the topology of the mesh
+     * while keeping the number of elements.
+     */
+    void ResetAdjacency();
+
+protected:
+    /// Writes the new points to the mesh, \a indices is empty if all points have been computed
+    void SetPoints(const std::vector<Base::Vector3f>& points,
+                   const std::vector<PointIndex>& indices);
+
 protected:
     // NOLINTBEGIN
     MeshKernel& kernel;
@@ -74,6 +155,9 @@ protected:
     Component component {Normal};
     Continuity continuity {C0};
     // NOLINTEND
+
+private:
+    MeshPointAdjacency adjacency;
 };
 
 class MeshExport PlaneFitSmoothing: public AbstractSmoothing
@@ -87,6 +171,9 @@ public:
     void Smooth(unsigned int) override;
     void SmoothPoints(unsigned int, const std::vector<PointIndex>&) override;
 
+private:
+    void UpdatePoints(const std::vector<PointIndex>&);
+
 private:
     float maximum {FLT_MAX};
 };
@@ -107,11 +194,9 @@ public:
     }
 
 protected:
-    void Umbrella(const MeshRefPointToPoints&, const MeshRefPointToFacets&, double);
-    void Umbrella(const MeshRefPointToPoints&,
-                  const MeshRefPointToFacets&,
-                  double,
-                  const std::vector<PointIndex>&);
+    /// Moves the given points, or all points if \a indices is empty, towards the centre of
+    /// their neighbours
+    void Umbrella(double, const std::vector<PointIndex>& indices);
 
 private:
     double lambda {0.6307};
@@ -149,9 +234,7 @@ public:
     void SmoothPoints(unsigned int, const std::vector<PointIndex>&) override;
 
 private:
-    void UpdatePoints(const MeshRefFacetToFacets&,
-                      const MeshRefPointToFacets&,
-                      const std::vector<PointIndex>&);
+    void UpdatePoints(const std::vector<PointIndex>&);
 
 private:
     int weights {1};
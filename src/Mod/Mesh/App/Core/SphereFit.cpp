@@ -29,10 +29,17 @@
 #endif
 
 #include "SphereFit.h"
+#include "Functional.h"
 
 
 using namespace MeshCoreFit;
 
+namespace
+{
+// the observations of fewer points are summed up on a single thread
+constexpr std::size_t MinChunkSize = 2048;
+}  // namespace
+
 SphereFit::SphereFit()
     : _vCenter(0, 0, 0)
 {}
@@ -197,6 +204,7 @@ float SphereFit::Fit()
 
     // Initialise some matrices and vectors
     std::vector<Base::Vector3d> residuals(CountPoints(), Base::Vector3d(0.0, 0.0, 0.0));
+    std::vector<Base::Vector3f> points(_vPoints.begin(), _vPoints.end());
     Matrix4x4 atpa;
     Eigen::VectorXd atpl(4);
 
@@ -207,7 +215,7 @@ float SphereFit::Fit()
         ++_numIter;
 
         // Set up the quasi parametric normal equations
-        setupNormalEquationMatrices(residuals, atpa, atpl);
+        setupNormalEquationMatrices(points, residuals, atpa, atpl);
 
         // Solve the equations for the unknown corrections
         Eigen::LLT<Matrix4x4> llt(atpa);
@@ -226,7 +234,7 @@ float SphereFit::Fit()
         // Before updating the unknowns, compute the residuals and sigma0 and check the residual
         // convergence
         bool vConverged {};
-        if (!computeResiduals(x, residuals, sigma0, _vConvLimit, vConverged)) {
+        if (!computeResiduals(points, x, residuals, sigma0, _vConvLimit, vConverged)) {
             return FLOAT_MAX;
         }
         if (!vConverged) {
@@ -254,25 +262,42 @@ float SphereFit::Fit()
 // Set up the normal equation matrices
 // atpa ... 4x4 normal matrix
 // atpl ... 4x1 matrix (right-hand side of equation)
-void SphereFit::setupNormalEquationMatrices(const std::vector<Base::Vector3d>& residuals,
+void SphereFit::setupNormalEquationMatrices(const std::vector<Base::Vector3f>& points,
+                                            const std::vector<Base::Vector3d>& residuals,
                                             Matrix4x4& atpa,
                                             Eigen::VectorXd& atpl) const
 {
-    // Zero matrices
-    atpa.setZero();
-    atpl.setZero();
+    struct NormalEquations
+    {
+        Matrix4x4 atpa;
+        Eigen::VectorXd atpl;
+    };
 
     // For each point, setup the observation equation coefficients and add their
-    // contribution into the normal equation matrices
-    double a[4] {}, b[3] {};
-    double f0 {}, qw {};
-    std::vector<Base::Vector3d>::const_iterator vIt = residuals.begin();
-    for (auto cIt = _vPoints.begin(); cIt != _vPoints.end(); ++cIt, ++vIt) {
-        // if (using this point) { // currently all given points are used (could modify this if
-        // eliminating outliers, etc....
-        setupObservation(*cIt, *vIt, a, f0, qw, b);
-        addObservationU(a, f0, qw, atpa, atpl);
-        // }
+    // contribution into the normal equation matrices of its chunk
+    auto parts = MeshCore::parallel_partials(
+        points.size(),
+        MinChunkSize,
+        [&](std::size_t begin, std::size_t end) {
+            NormalEquations part {Matrix4x4::Zero(), Eigen::VectorXd::Zero(4)};
+            double a[4] {}, b[3] {};
+            double f0 {}, qw {};
+            for (std::size_t i = begin; i < end; ++i) {
+                // if (using this point) { // currently all given points are used (could modify
+                // this if eliminating outliers, etc....
+                setupObservation(points[i], residuals[i], a, f0, qw, b);
+                addObservationU(a, f0, qw, part.atpa, part.atpl);
+                // }
+            }
+            return part;
+        });
+
+    // Zero matrices and add up the chunks
+    atpa.setZero();
+    atpl.setZero();
+    for (const auto& it : parts) {
+        atpa += it.atpa;
+        atpl += it.atpl;
     }
     setLowerPart(atpa);
 }
@@ -364,64 +389,62 @@ void SphereFit::setLowerPart(Matrix4x4& atpa) const
 }
 
 // Compute the residuals and sigma0 and check the residual convergence
-bool SphereFit::computeResiduals(const Eigen::VectorXd& x,
+bool SphereFit::computeResiduals(const std::vector<Base::Vector3f>& points,
+                                 const Eigen::VectorXd& x,
                                  std::vector<Base::Vector3d>& residuals,
                                  double& sigma0,
                                  double vConvLimit,
                                  bool& vConverged) const
 {
+    struct Partial
+    {
+        double sigma0;
+        bool converged;
+    };
+
+    auto parts = MeshCore::parallel_partials(
+        points.size(),
+        MinChunkSize,
+        [&](std::size_t begin, std::size_t end) {
+            Partial part {0.0, true};
+            double a[4] {}, b[3] {};
+            double f0 {}, qw {};
+            for (std::size_t i = begin; i < end; ++i) {
+                Base::Vector3d& v = residuals[i];
+                setupObservation(points[i], v, a, f0, qw, b);
+                double qv = -f0;
+                for (int j = 0; j < 4; ++j) {
+                    qv += a[j] * x(j);
+                }
+
+                // We are using equal weights for sphere point coordinate observations (see
+                // setupObservation) i.e. w[0] = w[1] = w[2] = 1.0;
+                double vx = -qw * qv * b[0];
+                double vy = -qw * qv * b[1];
+                double vz = -qw * qv * b[2];
+                double dVx = fabs(vx - v.x);
+                double dVy = fabs(vy - v.y);
+                double dVz = fabs(vz - v.z);
+                v.x = vx;
+                v.y = vy;
+                v.z = vz;
+
+                part.sigma0 += v.x * v.x + v.y * v.y + v.z * v.z;
+
+                if ((dVx > vConvLimit) || (dVy > vConvLimit) || (dVz > vConvLimit)) {
+                    part.converged = false;
+                }
+            }
+            return part;
+        });
+
+    // currently all given points are used
+    int nPtsUsed = int(points.size());
     vConverged = true;
-    int nPtsUsed = 0;
     sigma0 = 0.0;
-    double a[4] {}, b[3] {};
-    double f0 {}, qw {};
-    // double maxdVx = 0.0;
-    // double maxdVy = 0.0;
-    // double maxdVz = 0.0;
-    // double rmsVv = 0.0;
-    std::vector<Base::Vector3d>::iterator vIt = residuals.begin();
-    for (auto cIt = _vPoints.begin(); cIt != _vPoints.end(); ++cIt, ++vIt) {
-        // if (using this point) { // currently all given points are used (could modify this if
-        // eliminating outliers, etc....
-        ++nPtsUsed;
-        Base::Vector3d& v = *vIt;
-        setupObservation(*cIt, v, a, f0, qw, b);
-        double qv = -f0;
-        for (int i = 0; i < 4; ++i) {
-            qv += a[i] * x(i);
-        }
-
-        // We are using equal weights for sphere point coordinate observations (see
-        // setupObservation) i.e. w[0] = w[1] = w[2] = 1.0;
-        // double vx = -qw * qv * b[0] / w[0];
-        // double vy = -qw * qv * b[1] / w[1];
-        // double vz = -qw * qv * b[2] / w[2];
-        double vx = -qw * qv * b[0];
-        double vy = -qw * qv * b[1];
-        double vz = -qw * qv * b[2];
-        double dVx = fabs(vx - v.x);
-        double dVy = fabs(vy - v.y);
-        double dVz = fabs(vz - v.z);
-        v.x = vx;
-        v.y = vy;
-        v.z = vz;
-
-        // double vv = v.x * v.x + v.y * v.y + v.z * v.z;
-        // rmsVv += vv * vv;
-
-        // sigma0 += v.x * w[0] * v.x + v.y * w[1] * v.y + v.z * w[2] * v.z;
-        sigma0 += v.x * v.x + v.y * v.y + v.z * v.z;
-
-        if ((dVx > vConvLimit) || (dVy > vConvLimit) || (dVz > vConvLimit)) {
-            vConverged = false;
-        }
-
-        // if (dVx > maxdVx)
-        //	maxdVx = dVx;
-        // if (dVy > maxdVy)
-        //	maxdVy = dVy;
-        // if (dVz > maxdVz)
-        //	maxdVz = dVz;
+    for (const auto& it : parts) {
+        sigma0 += it.sigma0;
+        vConverged = vConverged && it.converged;
     }
 
     // Compute degrees of freedom and sigma0
@@ -438,9 +461,5 @@ bool SphereFit::computeResiduals(const Eigen::VectorXd& x,
         sigma0 = sqrt(sigma0 / (double)df);
     }
 
-    // rmsVv = sqrt(rmsVv / (double)nPtsUsed);
-    // Base::Console().Message("X: %0.3e %0.3e %0.3e %0.3e , Max dV: %0.4f %0.4f %0.4f , RMS Vv:
-    // %0.4f\n", x(0), x(1), x(2), x(3), maxdVx, maxdVy, maxdVz, rmsVv);
-
     return true;
 }
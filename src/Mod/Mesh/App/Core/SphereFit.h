@@ -94,7 +94,8 @@ protected:
     /**
      * Set up the normal equations
      */
-    void setupNormalEquationMatrices(const std::vector<Base::Vector3d>& residuals,
+    void setupNormalEquationMatrices(const std::vector<Base::Vector3f>& points,
+                                     const std::vector<Base::Vector3d>& residuals,
                                      Matrix4x4& atpa,
                                      Eigen::VectorXd& atpl) const;
     /**
@@ -122,7 +123,8 @@ protected:
     /**
      * Compute the residuals and sigma0 and check the residual convergence
      */
-    bool computeResiduals(const Eigen::VectorXd& x,
+    bool computeResiduals(const std::vector<Base::Vector3f>& points,
+                          const Eigen::VectorXd& x,
                           std::vector<Base::Vector3d>& residuals,
                           double& sigma0,
                           double vConvLimit,
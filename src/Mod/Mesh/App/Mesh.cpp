@@ -23,6 +23,7 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <algorithm>
+#include <iterator>
 #include <sstream>
 #endif
 
@@ -43,6 +44,8 @@
 #include "Core/Degeneration.h"
 #include "Core/Grid.h"
 #include "Core/Info.h"
+#include "Core/IO/ReaderBMC.h"
+#include "Core/IO/WriterBMC.h"
 #include "Core/Iterator.h"
 #include "Core/MeshKernel.h"
 #include "Core/Segmentation.h"
@@ -517,9 +520,76 @@ void MeshObject::save(std::ostream& out) const
     _kernel.Write(out);
 }
 
+void MeshObject::saveCompact(std::ostream& out) const
+{
+    MeshCore::WriterBMC writer(_kernel);
+    if (!writer.Save(out)) {
+        throw Base::FileException("Writing mesh to stream failed");
+    }
+}
+
+namespace
+{
+/*
+ * Reads the given bytes first and then the rest of the wrapped stream buffer. This allows to
+ * look at the beginning of a stream that cannot seek back, e.g. a file of a project archive.
+ */
+class PrefixStreambuf: public std::streambuf
+{
+public:
+    PrefixStreambuf(std::string prefix, std::streambuf* rest)
+        : prefix(std::move(prefix))
+        , rest(rest)
+    {
+        setg(this->prefix.data(), this->prefix.data(), this->prefix.data() + this->prefix.size());
+    }
+
+protected:
+    int_type underflow() override
+    {
+        return rest->sgetc();
+    }
+    int_type uflow() override
+    {
+        return rest->sbumpc();
+    }
+    std::streamsize xsgetn(char* data, std::streamsize count) override
+    {
+        std::streamsize num = std::min<std::streamsize>(count, egptr() - gptr());
+        std::copy(gptr(), gptr() + num, data);
+        gbump(static_cast<int>(num));
+        if (num < count) {
+            num += rest->sgetn(data + num, count - num);
+        }
+        return num;
+    }
+
+private:
+    std::string prefix;
+    std::streambuf* rest;
+};
+}  // namespace
+
 void MeshObject::load(std::istream& in)
 {
-    _kernel.Read(in);
+    // BMC starts with a magic text while every other stream is one of the BMS formats. The
+    // legacy BMS formats start with the number of points, so only the whole magic text decides.
+    std::string magic(MeshCore::ReaderBMC::MagicSize(), '\0');
+    in.read(magic.data(), static_cast<std::streamsize>(magic.size()));
+    magic.resize(static_cast<std::size_t>(in.gcount()));
+    bool compact = MeshCore::ReaderBMC::IsBMC(magic.data(), magic.size());
+
+    PrefixStreambuf buf(std::move(magic), in.rdbuf());
+    std::istream str(&buf);
+    if (compact) {
+        MeshCore::ReaderBMC reader(_kernel);
+        if (!reader.Load(str)) {
+            throw Base::BadFormatError("Reading mesh from stream failed");
+        }
+    }
+    else {
+        _kernel.Read(str);
+    }
     this->_segments.clear();
 
 #ifndef FC_DEBUG
@@ -1115,6 +1185,26 @@ void MeshObject::crossSections(const std::vector<MeshObject::TPlane>& planes,
     MeshCore::MeshKernel kernel(this->_kernel);
     kernel.Transform(this->_Mtrx);
 
+    // parallel planes are cut at once
+    bool parallel = std::all_of(planes.begin(), planes.end(), [&planes](const TPlane& plane) {
+        return plane.second == planes.front().second;
+    });
+    if (parallel && !planes.empty()) {
+        std::vector<Base::Vector3f> bases;
+        bases.reserve(planes.size());
+        for (const auto& plane : planes) {
+            bases.push_back(plane.first);
+        }
+
+        MeshCore::MeshSlicer slicer(kernel, planes.front().second);
+        std::vector<TPolylines> polylines =
+            slicer.CutWithPlanes(bases, fMinEps, bConnectPolygons);
+        sections.insert(sections.end(),
+                        std::make_move_iterator(polylines.begin()),
+                        std::make_move_iterator(polylines.end()));
+        return;
+    }
+
     MeshCore::MeshFacetGrid grid(kernel);
     MeshCore::MeshAlgorithm algo(kernel);
     for (const auto& plane : planes) {
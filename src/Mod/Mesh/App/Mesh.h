@@ -206,8 +206,9 @@ public:
               const char* objectname = nullptr) const;
     bool load(const char* file, MeshCore::Material* mat = nullptr);
     bool load(std::istream&, MeshCore::MeshIO::Format f, MeshCore::Material* mat = nullptr);
-    // Save and load in internal format
+    // Save and load in internal format, load also accepts the compact BMC format
     void save(std::ostream&) const;
+    void saveCompact(std::ostream&) const;
     void load(std::istream&);
     void writeInventor(std::ostream& str, float creaseangle = 0.0F) const;
     //@}
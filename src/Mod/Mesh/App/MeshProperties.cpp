@@ -22,6 +22,7 @@
 
 #include "PreCompiled.h"
 
+#include <App/Application.h>
 #include <Base/Converter.h>
 #include <Base/Exception.h>
 #include <Base/Reader.h>
@@ -880,6 +881,17 @@ void PropertyMeshKernel::setPyObject(PyObject* value)
     }
 }
 
+namespace
+{
+// The compact BMC format is opt-in, documents are written in the BMS format by default
+bool saveCompactFormat()
+{
+    return App::GetApplication()
+        .GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Mesh")
+        ->GetBool("SaveCompactFormat", false);
+}
+}  // namespace
+
 void PropertyMeshKernel::Save(Base::Writer& writer) const
 {
     if (writer.isForceXML()) {
@@ -888,7 +900,9 @@ void PropertyMeshKernel::Save(Base::Writer& writer) const
         saver.SaveXML(writer);
     }
     else {
-        writer.Stream() << writer.ind() << "<Mesh file=\"" << writer.addFile("MeshKernel.bms", this)
+        saveCompact = saveCompactFormat();
+        const char* file = saveCompact ? "MeshKernel.bmc" : "MeshKernel.bms";
+        writer.Stream() << writer.ind() << "<Mesh file=\"" << writer.addFile(file, this)
                         << "\"/>" << std::endl;
     }
 }
@@ -921,7 +935,12 @@ void PropertyMeshKernel::Restore(Base::XMLReader& reader)
 
 void PropertyMeshKernel::SaveDocFile(Base::Writer& writer) const
 {
-    _meshObject->save(writer.Stream());
+    if (saveCompact) {
+        _meshObject->saveCompact(writer.Stream());
+    }
+    else {
+        _meshObject->save(writer.Stream());
+    }
 }
 
 void PropertyMeshKernel::RestoreDocFile(Base::Reader& reader)
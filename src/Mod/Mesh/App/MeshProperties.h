@@ -323,6 +323,8 @@ public:
 private:
     Base::Reference<MeshObject> _meshObject;
     MeshPy* meshPyObject {nullptr};
+    // The format chosen by Save() that SaveDocFile() must write
+    mutable bool saveCompact {false};
 };
 
 }  // namespace Mesh
@@ -162,6 +162,7 @@ PyObject* MeshPy::read(PyObject* args, PyObject* kwds)
     MeshCore::MeshIO::Format format = MeshCore::MeshIO::Undefined;
     std::map<std::string, MeshCore::MeshIO::Format> ext;
     ext["BMS"] = MeshCore::MeshIO::BMS;
+    ext["BMC"] = MeshCore::MeshIO::BMC;
     ext["STL"] = MeshCore::MeshIO::BSTL;
     ext["AST"] = MeshCore::MeshIO::ASTL;
     ext["OBJ"] = MeshCore::MeshIO::OBJ;
@@ -212,6 +213,7 @@ PyObject* MeshPy::write(PyObject* args, PyObject* kwds)
     MeshCore::MeshIO::Format format = MeshCore::MeshIO::Undefined;
     std::map<std::string, MeshCore::MeshIO::Format> ext;
     ext["BMS"] = MeshCore::MeshIO::BMS;
+    ext["BMC"] = MeshCore::MeshIO::BMC;
     ext["STL"] = MeshCore::MeshIO::BSTL;
     ext["AST"] = MeshCore::MeshIO::ASTL;
     ext["OBJ"] = MeshCore::MeshIO::OBJ;
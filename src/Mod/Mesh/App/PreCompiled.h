@@ -48,8 +48,10 @@
 
 // STL
 #include <algorithm>
+#include <future>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <list>
 #include <map>
 #include <queue>
@@ -57,6 +59,7 @@
 #include <sstream>
 #include <stack>
 #include <string>
+#include <thread>
 #include <vector>
 
 // boost
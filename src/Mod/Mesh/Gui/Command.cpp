@@ -332,11 +332,12 @@ void CmdMeshImport::activated(int)
 {
     // use current path as default
     QStringList filter;
-    filter << QStringLiteral("%1 (*.stl *.ast *.bms *.obj *.off *.iv *.ply *.nas *.bdf)")
+    filter << QStringLiteral("%1 (*.stl *.ast *.bms *.bmc *.obj *.off *.iv *.ply *.nas *.bdf)")
                   .arg(QObject::tr("All Mesh Files"));
     filter << QStringLiteral("%1 (*.stl)").arg(QObject::tr("Binary STL"));
     filter << QStringLiteral("%1 (*.ast)").arg(QObject::tr("ASCII STL"));
     filter << QStringLiteral("%1 (*.bms)").arg(QObject::tr("Binary Mesh"));
+    filter << QStringLiteral("%1 (*.bmc)").arg(QObject::tr("Compact Binary Mesh"));
     filter << QStringLiteral("%1 (*.obj)").arg(QObject::tr("Alias Mesh"));
     filter << QStringLiteral("%1 (*.off)").arg(QObject::tr("Object File Format"));
     filter << QStringLiteral("%1 (*.iv)").arg(QObject::tr("Inventor V2.1 ASCII"));
@@ -398,6 +399,7 @@ void CmdMeshExport::activated(int)
     ext << qMakePair<QString, QByteArray>(QStringLiteral("%1 (*.stl)").arg(QObject::tr("ASCII STL")), "AST");
     ext << qMakePair<QString, QByteArray>(QStringLiteral("%1 (*.ast)").arg(QObject::tr("ASCII STL")), "AST");
     ext << qMakePair<QString, QByteArray>(QStringLiteral("%1 (*.bms)").arg(QObject::tr("Binary Mesh")), "BMS");
+    ext << qMakePair<QString, QByteArray>(QStringLiteral("%1 (*.bmc)").arg(QObject::tr("Compact Binary Mesh")), "BMC");
     ext << qMakePair<QString, QByteArray>(QStringLiteral("%1 (*.obj)").arg(QObject::tr("Alias Mesh")), "OBJ");
     ext << qMakePair<QString, QByteArray>(QStringLiteral("%1 (*.smf)").arg(QObject::tr("Simple Model Format")), "SMF");
     ext << qMakePair<QString, QByteArray>(QStringLiteral("%1 (*.off)").arg(QObject::tr("Object File Format")), "OFF");
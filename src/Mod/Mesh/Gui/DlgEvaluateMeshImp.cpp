@@ -22,6 +22,9 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <functional>
+#include <vector>
+
 #include <QDockWidget>
 #include <QMessageBox>
 #include <QPointer>
@@ -1178,6 +1181,14 @@ void DlgEvaluateMeshImp::onRepairAllTogetherClicked()
         Gui::Document* doc = Gui::Application::Instance->getDocument(docName);
         doc->openCommand(QT_TRANSLATE_NOOP("Command", "Repair mesh"));
 
+        // each check evaluates the mesh and knows how to repair it
+        struct Check
+        {
+            const char* name;
+            std::function<bool()> evaluate;
+            std::function<void()> repair;
+        };
+
         bool run = false;
         bool self = true;
         int max_iter = 10;
@@ -1185,89 +1196,100 @@ void DlgEvaluateMeshImp::onRepairAllTogetherClicked()
         try {
             do {
                 run = false;
-                {
-                    MeshEvalSelfIntersection eval(rMesh);
-                    if (self && !eval.Evaluate()) {
+                std::vector<Check> checks;
+                if (self) {
+                    checks.push_back({"Self-intersections", [&rMesh, &self]() {
+                        MeshEvalSelfIntersection eval(rMesh);
+                        bool ok = eval.Evaluate();
+                        if (ok) {
+                            self = false; // once no self-intersections found do not repeat it later on
+                        }
+                        return ok;
+                    }, [docName, objName]() {
                         Gui::Command::doCommand(Gui::Command::App,
                             "App.getDocument(\"%s\").getObject(\"%s\").fixSelfIntersections()",
                             docName, objName);
-                        run = true;
-                    }
-                    else {
-                        self = false; // once no self-intersections found do not repeat it later on
-                    }
-                    qApp->processEvents();
+                    }});
                 }
                 if (d->enableFoldsCheck) {
-                    MeshEvalFoldsOnSurface s_eval(rMesh);
-                    MeshEvalFoldsOnBoundary b_eval(rMesh);
-                    MeshEvalFoldOversOnSurface f_eval(rMesh);
-                    if (!s_eval.Evaluate() || !b_eval.Evaluate() || !f_eval.Evaluate()) {
+                    checks.push_back({"Folds", [&rMesh]() {
+                        MeshEvalFoldsOnSurface s_eval(rMesh);
+                        MeshEvalFoldsOnBoundary b_eval(rMesh);
+                        MeshEvalFoldOversOnSurface f_eval(rMesh);
+                        return s_eval.Evaluate() && b_eval.Evaluate() && f_eval.Evaluate();
+                    }, [docName, objName]() {
                         Gui::Command::doCommand(Gui::Command::App,
                             "App.getDocument(\"%s\").getObject(\"%s\").removeFoldsOnSurface()",
                             docName, objName);
-                        run = true;
-                    }
-                    qApp->processEvents();
+                    }});
                 }
-                {
+                checks.push_back({"Orientation", [&rMesh]() {
                     MeshEvalOrientation eval(rMesh);
-                    if (!eval.Evaluate()) {
-                        Gui::Command::doCommand(Gui::Command::App,
-                            "App.getDocument(\"%s\").getObject(\"%s\").harmonizeNormals()",
-                            docName, objName);
-                        run = true;
-                    }
-                    qApp->processEvents();
-                }
-                {
+                    return eval.Evaluate();
+                }, [docName, objName]() {
+                    Gui::Command::doCommand(Gui::Command::App,
+                        "App.getDocument(\"%s\").getObject(\"%s\").harmonizeNormals()",
+                        docName, objName);
+                }});
+                checks.push_back({"Non-manifolds", [&rMesh]() {
                     MeshEvalTopology eval(rMesh);
-                    if (!eval.Evaluate()) {
-                        Gui::Command::doCommand(Gui::Command::App,
-                            "App.getDocument(\"%s\").getObject(\"%s\").removeNonManifolds()",
-                            docName, objName);
-                        run = true;
-                    }
-                    qApp->processEvents();
-                }
-                {
+                    return eval.Evaluate();
+                }, [docName, objName]() {
+                    Gui::Command::doCommand(Gui::Command::App,
+                        "App.getDocument(\"%s\").getObject(\"%s\").removeNonManifolds()",
+                        docName, objName);
+                }});
+                checks.push_back({"Indices", [&rMesh]() {
                     MeshEvalRangeFacet rf(rMesh);
                     MeshEvalRangePoint rp(rMesh);
                     MeshEvalCorruptedFacets cf(rMesh);
                     MeshEvalNeighbourhood nb(rMesh);
-                    if (!rf.Evaluate() || !rp.Evaluate() || !cf.Evaluate() || !nb.Evaluate()) {
-                        Gui::Command::doCommand(Gui::Command::App,
-                            "App.getDocument(\"%s\").getObject(\"%s\").fixIndices()",
-                            docName, objName);
-                        run = true;
-                    }
-                }
-                {
-                    MeshEvalDegeneratedFacets eval(rMesh, d->epsilonDegenerated);
-                    if (!eval.Evaluate()) {
-                        Gui::Command::doCommand(Gui::Command::App,
-                            "App.getDocument(\"%s\").getObject(\"%s\").fixDegenerations(%f)",
-                            docName, objName, d->epsilonDegenerated);
-                        run = true;
-                    }
-                    qApp->processEvents();
-                }
-                {
+                    return rf.Evaluate() && rp.Evaluate() && cf.Evaluate() && nb.Evaluate();
+                }, [docName, objName]() {
+                    Gui::Command::doCommand(Gui::Command::App,
+                        "App.getDocument(\"%s\").getObject(\"%s\").fixIndices()",
+                        docName, objName);
+                }});
+                float epsilon = d->epsilonDegenerated;
+                checks.push_back({"Degenerations", [&rMesh, epsilon]() {
+                    MeshEvalDegeneratedFacets eval(rMesh, epsilon);
+                    return eval.Evaluate();
+                }, [docName, objName, epsilon]() {
+                    Gui::Command::doCommand(Gui::Command::App,
+                        "App.getDocument(\"%s\").getObject(\"%s\").fixDegenerations(%f)",
+                        docName, objName, epsilon);
+                }});
+                checks.push_back({"Duplicated faces", [&rMesh]() {
                     MeshEvalDuplicateFacets eval(rMesh);
-                    if (!eval.Evaluate()) {
-                        Gui::Command::doCommand(Gui::Command::App,
-                            "App.getDocument(\"%s\").getObject(\"%s\").removeDuplicatedFacets()",
-                            docName, objName);
-                        run = true;
-                    }
-                    qApp->processEvents();
-                }
-                {
+                    return eval.Evaluate();
+                }, [docName, objName]() {
+                    Gui::Command::doCommand(Gui::Command::App,
+                        "App.getDocument(\"%s\").getObject(\"%s\").removeDuplicatedFacets()",
+                        docName, objName);
+                }});
+                checks.push_back({"Duplicated points", [&rMesh]() {
                     MeshEvalDuplicatePoints eval(rMesh);
-                    if (!eval.Evaluate()) {
-                        Gui::Command::doCommand(Gui::Command::App,
-                            "App.getDocument(\"%s\").getObject(\"%s\").removeDuplicatedPoints()",
-                            docName, objName);
+                    return eval.Evaluate();
+                }, [docName, objName]() {
+                    Gui::Command::doCommand(Gui::Command::App,
+                        "App.getDocument(\"%s\").getObject(\"%s\").removeDuplicatedPoints()",
+                        docName, objName);
+                }});
+
+                // the checks are independent of each other and can be evaluated concurrently
+                MeshCore::MeshEvaluationPipeline pipeline;
+                for (const auto& check : checks) {
+                    pipeline.AddStage(check.name, check.evaluate);
+                }
+                pipeline.Run();
+                Base::Console().Log("Mesh evaluation:\n%s", pipeline.Report().c_str());
+
+                const auto& stages = pipeline.GetStages();
+                for (std::size_t i = 0; i < checks.size(); i++) {
+                    // after a repair the results of the pipeline are outdated
+                    bool ok = run ? checks[i].evaluate() : stages[i].result;
+                    if (!ok) {
+                        checks[i].repair();
                         run = true;
                     }
                     qApp->processEvents();
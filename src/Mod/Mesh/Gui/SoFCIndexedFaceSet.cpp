@@ -30,7 +30,10 @@
 
 #ifndef _PreComp_
 #include <algorithm>
+#include <array>
 #include <climits>
+#include <cmath>
+#include <unordered_map>
 #ifdef FC_OS_MACOSX
 #include <OpenGL/gl.h>
 #include <OpenGL/glext.h>
@@ -49,8 +52,10 @@
 #include <Inventor/elements/SoGLCoordinateElement.h>
 #include <Inventor/elements/SoGLLazyElement.h>
 #include <Inventor/elements/SoMaterialBindingElement.h>
+#include <Inventor/elements/SoModelMatrixElement.h>
 #include <Inventor/elements/SoNormalBindingElement.h>
 #include <Inventor/elements/SoProjectionMatrixElement.h>
+#include <Inventor/elements/SoViewVolumeElement.h>
 #include <Inventor/elements/SoViewingMatrixElement.h>
 #include <Inventor/errors/SoDebugError.h>
 #include <Inventor/nodes/SoCoordinate3.h>
@@ -60,6 +65,7 @@
 #include <Gui/GLBuffer.h>
 #include <Gui/SoFCInteractiveElement.h>
 #include <Gui/Selection/SoFCSelectionAction.h>
+#include <Mod/Mesh/App/Core/Functional.h>
 
 #include "SoFCIndexedFaceSet.h"
 
@@ -70,11 +76,46 @@ using namespace MeshGui;
 
 #if defined RENDER_GL_VAO
 
+namespace
+{
+// number of triangles of a cluster
+constexpr std::size_t ClusterSize = 16384;
+// the triangles are grouped by a grid of 2^CellBits cells per axis
+constexpr int CellBits = 5;
+// the proxy of a cluster has roughly 1/ProxyRatio of its triangles
+constexpr float ProxyRatio = 16.0F;
+
+uint32_t spreadBits(uint32_t value)
+{
+    uint32_t bits = 0;
+    for (int i = 0; i < CellBits; i++) {
+        bits |= ((value >> i) & 1) << (3 * i);
+    }
+    return bits;
+}
+}  // namespace
+
 class MeshRenderer::Private
 {
 public:
+    /**
+     * A spatially coherent range of the index buffer with its bounding box. The proxy is a
+     * coarse version of the cluster that is drawn during user interaction.
+     */
+    struct Cluster
+    {
+        SbBox3f box;
+        std::size_t offset {0};
+        std::size_t count {0};
+        std::size_t proxyOffset {0};
+        std::size_t proxyCount {0};
+    };
+
     Gui::OpenGLMultiBuffer vertices;
     Gui::OpenGLMultiBuffer indices;
+    std::vector<Cluster> clusters;
+    std::size_t numIndices {0};
+    bool hasProxies {false};
     const SbColor* pcolors {nullptr};
     SoMaterialBindingElement::Binding matbinding {SoMaterialBindingElement::OVERALL};
     bool initialized {false};
@@ -84,14 +125,20 @@ public:
     void generateGLArrays(SoGLRenderAction* action,
                           SoMaterialBindingElement::Binding matbind,
                           std::vector<float>& vertex,
-                          std::vector<int32_t>& index);
-    void renderFacesGLArray(SoGLRenderAction*);
+                          std::vector<int32_t>& index,
+                          bool proxy);
+    void renderFacesGLArray(SoGLRenderAction*, bool proxy);
     void renderCoordsGLArray(SoGLRenderAction*);
     void update();
     bool needUpdate(SoGLRenderAction*);
 
 private:
-    void renderGLArray(SoGLRenderAction*, GLenum);
+    void buildClusters(const std::vector<float>& vertex,
+                       std::vector<int32_t>& index,
+                       std::size_t stride,
+                       bool proxy);
+    void renderGLArray(SoGLRenderAction*, GLenum, bool proxy);
+    void drawClusters(SoState*, GLenum, bool proxy) const;
 };
 
 MeshRenderer::Private::Private()
@@ -118,12 +165,17 @@ bool MeshRenderer::Private::canRenderGLArray(SoGLRenderAction* action) const
 void MeshRenderer::Private::generateGLArrays(SoGLRenderAction* action,
                                              SoMaterialBindingElement::Binding matbind,
                                              std::vector<float>& vertex,
-                                             std::vector<int32_t>& index)
+                                             std::vector<int32_t>& index,
+                                             bool proxy)
 {
     if (vertex.empty() || index.empty()) {
         return;
     }
 
+    // color, normal and vertex or only normal and vertex
+    std::size_t stride = matbind != SoMaterialBindingElement::OVERALL ? 10 : 6;
+    buildClusters(vertex, index, stride, proxy);
+
     // lazy initialization
     vertices.setCurrentContext(action->getCacheContext());
     indices.setCurrentContext(action->getCacheContext());
@@ -142,7 +194,206 @@ void MeshRenderer::Private::generateGLArrays(SoGLRenderAction* action,
     this->matbinding = matbind;
 }
 
-void MeshRenderer::Private::renderGLArray(SoGLRenderAction* action, GLenum mode)
+/**
+ * Sorts the triangles by the grid cell of their center so that consecutive triangles are
+ * close to each other and splits them into clusters that can be culled against the view
+ * volume. If \a proxy is true the index buffer additionally gets a coarse version of each
+ * cluster by snapping the vertices to a grid and skipping the collapsed triangles.
+ */
+void MeshRenderer::Private::buildClusters(const std::vector<float>& vertex,
+                                          std::vector<int32_t>& index,
+                                          std::size_t stride,
+                                          bool proxy)
+{
+    clusters.clear();
+    numIndices = index.size();
+    hasProxies = false;
+
+    std::size_t numTria = index.size() / 3;
+    if (numTria < 2 * ClusterSize) {
+        return;
+    }
+
+    auto point = [&vertex, stride](int32_t i) {
+        const float* pnt = &vertex[std::size_t(i) * stride + stride - 3];
+        return SbVec3f(pnt[0], pnt[1], pnt[2]);
+    };
+
+    SbBox3f bbox;
+    for (std::size_t i = stride - 3; i < vertex.size(); i += stride) {
+        bbox.extendBy(SbVec3f(vertex[i], vertex[i + 1], vertex[i + 2]));
+    }
+
+    const uint32_t cells = 1 << CellBits;
+    SbVec3f bmin = bbox.getMin();
+    SbVec3f scale;
+    for (int k = 0; k < 3; k++) {
+        float len = bbox.getMax()[k] - bmin[k];
+        scale[k] = len > 0.0F ? float(cells) / len : 0.0F;
+    }
+    auto cellOf = [&](const SbVec3f& pnt) {
+        uint32_t code = 0;
+        for (int k = 0; k < 3; k++) {
+            auto coord = static_cast<uint32_t>((pnt[k] - bmin[k]) * scale[k]);
+            code |= spreadBits(std::min(coord, cells - 1)) << k;
+        }
+        return code;
+    };
+
+    // counting sort of the triangles by the Morton order of their cells
+    std::vector<uint32_t> cellOfTria(numTria);
+    std::vector<std::size_t> cellEnd(cells * cells * cells + 1, 0);
+    float area = 0.0F;
+    for (std::size_t i = 0; i < numTria; i++) {
+        SbVec3f p0 = point(index[3 * i]);
+        SbVec3f p1 = point(index[3 * i + 1]);
+        SbVec3f p2 = point(index[3 * i + 2]);
+        cellOfTria[i] = cellOf((p0 + p1 + p2) / 3.0F);
+        cellEnd[cellOfTria[i] + 1]++;
+        area += 0.5F * (p1 - p0).cross(p2 - p0).length();
+    }
+    for (std::size_t i = 1; i < cellEnd.size(); i++) {
+        cellEnd[i] += cellEnd[i - 1];
+    }
+
+    std::vector<int32_t> sorted(index.size());
+    for (std::size_t i = 0; i < numTria; i++) {
+        std::size_t pos = 3 * cellEnd[cellOfTria[i]]++;
+        std::copy_n(&index[3 * i], 3, &sorted[pos]);
+    }
+    index.swap(sorted);
+
+    // In Morton order the cells of an octree node are consecutive. So, each cluster gets the
+    // largest node with at most ClusterSize triangles which keeps its bounding box tight.
+    const uint32_t numCells = cells * cells * cells;
+    auto start = [&cellEnd](uint32_t cell) {
+        return cell > 0 ? cellEnd[cell - 1] : std::size_t(0);
+    };
+    uint32_t cell = 0;
+    while (cell < numCells) {
+        uint32_t size = 1;
+        while (cell % (8 * size) == 0 && 8 * size <= numCells
+               && start(cell + 8 * size) - start(cell) <= ClusterSize) {
+            size *= 8;
+        }
+        for (std::size_t first = start(cell); first < start(cell + size); first += ClusterSize) {
+            Cluster cluster;
+            cluster.offset = 3 * first;
+            cluster.count = 3 * (std::min(first + ClusterSize, start(cell + size)) - first);
+            clusters.push_back(cluster);
+        }
+        cell += size;
+    }
+
+    // the proxy grid is chosen so that each grid cell holds about two proxy triangles
+    float cellSize = std::sqrt(2.0F * area * ProxyRatio / float(numTria));
+    proxy = proxy && cellSize > 0.0F;
+
+    std::vector<std::vector<int32_t>> proxies(clusters.size());
+    MeshCore::parallel_chunks(clusters.size(), 1, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            Cluster& cluster = clusters[i];
+            for (std::size_t j = cluster.offset; j < cluster.offset + cluster.count; j++) {
+                cluster.box.extendBy(point(index[j]));
+            }
+            if (!proxy) {
+                continue;
+            }
+
+            std::unordered_map<uint64_t, int32_t> representatives;
+            representatives.reserve(cluster.count / 3);
+            auto representative = [&](int32_t vertexIndex) {
+                SbVec3f pnt = point(vertexIndex);
+                uint64_t key = 0;
+                for (int k = 0; k < 3; k++) {
+                    auto coord = static_cast<uint64_t>((pnt[k] - bmin[k]) / cellSize);
+                    key |= (coord & 0x1fffff) << (21 * k);
+                }
+                return representatives.emplace(key, vertexIndex).first->second;
+            };
+
+            std::vector<int32_t>& coarse = proxies[i];
+            for (std::size_t j = cluster.offset; j < cluster.offset + cluster.count; j += 3) {
+                int32_t v0 = representative(index[j]);
+                int32_t v1 = representative(index[j + 1]);
+                int32_t v2 = representative(index[j + 2]);
+                if (v0 != v1 && v1 != v2 && v2 != v0) {
+                    coarse.push_back(v0);
+                    coarse.push_back(v1);
+                    coarse.push_back(v2);
+                }
+            }
+        }
+    });
+
+    if (proxy) {
+        for (std::size_t i = 0; i < clusters.size(); i++) {
+            clusters[i].proxyOffset = index.size();
+            clusters[i].proxyCount = proxies[i].size();
+            index.insert(index.end(), proxies[i].begin(), proxies[i].end());
+        }
+        hasProxies = true;
+    }
+}
+
+/**
+ * Draws the clusters that are not completely outside of the view volume. Adjacent clusters
+ * are merged into one draw call.
+ */
+void MeshRenderer::Private::drawClusters(SoState* state, GLenum mode, bool proxy) const
+{
+    // the planes of the view volume in object space with the normals pointing inside
+    std::array<SbPlane, 6> planes;
+    const SbViewVolume& volume = SoViewVolumeElement::get(state);
+    volume.getViewVolumePlanes(planes.data());
+    SbMatrix toObject = SoModelMatrixElement::get(state).inverse();
+    for (auto& plane : planes) {
+        plane.transform(toObject);
+    }
+
+    auto isOutside = [&planes](const SbBox3f& box) {
+        const SbVec3f& min = box.getMin();
+        const SbVec3f& max = box.getMax();
+        for (const auto& plane : planes) {
+            const SbVec3f& normal = plane.getNormal();
+            SbVec3f corner(normal[0] > 0.0F ? max[0] : min[0],
+                           normal[1] > 0.0F ? max[1] : min[1],
+                           normal[2] > 0.0F ? max[2] : min[2]);
+            if (plane.getDistance(corner) < 0.0F) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    std::size_t first = 0;
+    std::size_t count = 0;
+    auto draw = [&]() {
+        if (count > 0) {
+            auto offset = reinterpret_cast<const void*>(first * sizeof(uint32_t));  // NOLINT
+            glDrawElements(mode, static_cast<GLsizei>(count), GL_UNSIGNED_INT, offset);
+        }
+    };
+
+    for (const auto& it : clusters) {
+        if (isOutside(it.box)) {
+            continue;
+        }
+        std::size_t offset = proxy ? it.proxyOffset : it.offset;
+        std::size_t size = proxy ? it.proxyCount : it.count;
+        if (count > 0 && first + count == offset) {
+            count += size;
+        }
+        else {
+            draw();
+            first = offset;
+            count = size;
+        }
+    }
+    draw();
+}
+
+void MeshRenderer::Private::renderGLArray(SoGLRenderAction* action, GLenum mode, bool proxy)
 {
     if (!initialized) {
         SoDebugError::postWarning("MeshRenderer", "not initialized");
@@ -166,7 +417,12 @@ void MeshRenderer::Private::renderGLArray(SoGLRenderAction* action, GLenum mode)
         glInterleavedArrays(GL_N3F_V3F, 0, nullptr);
     }
 
-    glDrawElements(mode, indices.size() / sizeof(uint32_t), GL_UNSIGNED_INT, nullptr);
+    if (clusters.empty()) {
+        glDrawElements(mode, static_cast<GLsizei>(numIndices), GL_UNSIGNED_INT, nullptr);
+    }
+    else {
+        drawClusters(action->getState(), mode, proxy && hasProxies);
+    }
 
     vertices.release();
     indices.release();
@@ -176,20 +432,21 @@ void MeshRenderer::Private::renderGLArray(SoGLRenderAction* action, GLenum mode)
     glDisableClientState(GL_VERTEX_ARRAY);
 }
 
-void MeshRenderer::Private::renderFacesGLArray(SoGLRenderAction* action)
+void MeshRenderer::Private::renderFacesGLArray(SoGLRenderAction* action, bool proxy)
 {
-    renderGLArray(action, GL_TRIANGLES);
+    renderGLArray(action, GL_TRIANGLES, proxy);
 }
 
 void MeshRenderer::Private::renderCoordsGLArray(SoGLRenderAction* action)
 {
-    renderGLArray(action, GL_POINTS);
+    renderGLArray(action, GL_POINTS, false);
 }
 
 void MeshRenderer::Private::update()
 {
     vertices.destroy();
     indices.destroy();
+    clusters.clear();
 }
 
 bool MeshRenderer::Private::needUpdate(SoGLRenderAction* action)
@@ -215,8 +472,9 @@ public:
     void generateGLArrays(SoGLRenderAction* action,
                           SoMaterialBindingElement::Binding matbind,
                           std::vector<float>& vertex,
-                          std::vector<int32_t>& index);
-    void renderFacesGLArray(SoGLRenderAction* action);
+                          std::vector<int32_t>& index,
+                          bool proxy);
+    void renderFacesGLArray(SoGLRenderAction* action, bool proxy);
     void renderCoordsGLArray(SoGLRenderAction* action);
     void update()
     {}
@@ -234,7 +492,8 @@ bool MeshRenderer::Private::canRenderGLArray(SoGLRenderAction*) const
 void MeshRenderer::Private::generateGLArrays(SoGLRenderAction*,
                                              SoMaterialBindingElement::Binding matbind,
                                              std::vector<float>& vertex,
-                                             std::vector<int32_t>& index)
+                                             std::vector<int32_t>& index,
+                                             bool)
 {
     if (vertex.empty() || index.empty()) {
         return;
@@ -248,7 +507,7 @@ void MeshRenderer::Private::generateGLArrays(SoGLRenderAction*,
     this->matbinding = matbind;
 }
 
-void MeshRenderer::Private::renderFacesGLArray(SoGLRenderAction* action)
+void MeshRenderer::Private::renderFacesGLArray(SoGLRenderAction* action, bool)
 {
     (void)action;
     int cnt = index_array.size();
@@ -305,9 +564,10 @@ public:
     void generateGLArrays(SoGLRenderAction*,
                           SoMaterialBindingElement::Binding,
                           std::vector<float>&,
-                          std::vector<int32_t>&)
+                          std::vector<int32_t>&,
+                          bool)
     {}
-    void renderFacesGLArray(SoGLRenderAction*)
+    void renderFacesGLArray(SoGLRenderAction*, bool)
     {}
     void renderCoordsGLArray(SoGLRenderAction*)
     {}
@@ -342,13 +602,14 @@ bool MeshRenderer::needUpdate(SoGLRenderAction* action)
 void MeshRenderer::generateGLArrays(SoGLRenderAction* action,
                                     SoMaterialBindingElement::Binding matbind,
                                     std::vector<float>& vertex,
-                                    std::vector<int32_t>& index)
+                                    std::vector<int32_t>& index,
+                                    bool proxy)
 {
     SoGLLazyElement* gl = SoGLLazyElement::getInstance(action->getState());
     if (gl) {
         p->pcolors = gl->getDiffusePointer();
     }
-    p->generateGLArrays(action, matbind, vertex, index);
+    p->generateGLArrays(action, matbind, vertex, index, proxy);
 }
 
 // Implementation                            | FPS
@@ -376,9 +637,12 @@ void MeshRenderer::renderCoordsGLArray(SoGLRenderAction* action)
 // With GL_PRIMITIVE_RESTART_FIXED_INDEX     |  0.9
 // Without GL_PRIMITIVE_RESTART              |  8.5
 // Vertex-Array-Object (RENDER_GL_VAO)       | 60.0
-void MeshRenderer::renderFacesGLArray(SoGLRenderAction* action)
+//
+// With RENDER_GL_VAO large meshes are split into clusters that are culled against the view
+// volume. If \a proxy is true a coarse version of the clusters is drawn if available.
+void MeshRenderer::renderFacesGLArray(SoGLRenderAction* action, bool proxy)
 {
-    p->renderFacesGLArray(action);
+    p->renderFacesGLArray(action, proxy);
 }
 
 bool MeshRenderer::canRenderGLArray(SoGLRenderAction* action) const
@@ -512,9 +776,12 @@ void SoFCIndexedFaceSet::GLRender(SoGLRenderAction* action)
         }
 
         if (render.matchMaterial(state)) {
+            // draw the coarse proxies while navigating through huge meshes
+            SbBool interactive = Gui::SoFCInteractiveElement::get(state);
+            unsigned int num = this->coordIndex.getNum() / 4;
             SoMaterialBundle mb(action);
             mb.sendFirst();
-            render.renderFacesGLArray(action);
+            render.renderFacesGLArray(action, interactive && num > this->renderTriangleLimit);
         }
         else {
             drawFaces(action);
@@ -546,7 +813,7 @@ void SoFCIndexedFaceSet::drawFaces(SoGLRenderAction* action)
                 updateGLArray.setValue(false);
                 generateGLArrays(action);
             }
-            render.renderFacesGLArray(action);
+            render.renderFacesGLArray(action, false);
         }
         else {
             inherited::GLRender(action);
@@ -912,7 +1179,8 @@ void SoFCIndexedFaceSet::generateGLArrays(SoGLRenderAction* action)
         }
     }
 
-    render.generateGLArrays(action, matbind, face_vertices, face_indices);
+    bool proxy = numTria > this->renderTriangleLimit;
+    render.generateGLArrays(action, matbind, face_vertices, face_indices, proxy);
 
     // getVertexData() internally calls readLockNormalCache() that read locks
     // the normal cache. When the cache is not needed any more we must call
@@ -52,8 +52,9 @@ public:
     void generateGLArrays(SoGLRenderAction*,
                           SoMaterialBindingElement::Binding binding,
                           std::vector<float>& vertex,
-                          std::vector<int32_t>& index);
-    void renderFacesGLArray(SoGLRenderAction* action);
+                          std::vector<int32_t>& index,
+                          bool proxy);
+    void renderFacesGLArray(SoGLRenderAction* action, bool proxy);
     void renderCoordsGLArray(SoGLRenderAction* action);
     bool canRenderGLArray(SoGLRenderAction* action) const;
     bool matchMaterial(SoState*) const;
@@ -54,9 +54,8 @@
 #include <Base/Exception.h>
 #include <Gui/SoFCInteractiveElement.h>
 #include <Gui/Selection/SoFCSelectionAction.h>
-#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/BVH.h>
 #include <Mod/Mesh/App/Core/Elements.h>
-#include <Mod/Mesh/App/Core/Grid.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
 
 #include "SoFCMeshObject.h"
@@ -360,7 +359,7 @@ SoFCMeshPickNode::SoFCMeshPickNode()
 */
 SoFCMeshPickNode::~SoFCMeshPickNode()
 {
-    delete meshGrid;
+    delete meshBVH;
 }
 
 // Doc from superclass.
@@ -371,15 +370,11 @@ void SoFCMeshPickNode::initClass()
 
 void SoFCMeshPickNode::notify(SoNotList* list)
 {
+    // the BVH is rebuilt on the next pick so that editing the mesh doesn't pay for it
     SoField* f = list->getLastField();
     if (f == &mesh) {
-        const Mesh::MeshObject* meshObject = mesh.getValue();
-        if (meshObject) {
-            MeshCore::MeshAlgorithm alg(meshObject->getKernel());
-            float fAvgLen = alg.GetAverageEdgeLength();
-            delete meshGrid;
-            meshGrid = new MeshCore::MeshFacetGrid(meshObject->getKernel(), 5.0F * fAvgLen);
-        }
+        delete meshBVH;
+        meshBVH = nullptr;
     }
 }
 
@@ -394,7 +389,12 @@ void SoFCMeshPickNode::pick(SoPickAction* action)
     raypick->setObjectSpace();
 
     const Mesh::MeshObject* meshObject = mesh.getValue();
-    MeshCore::MeshAlgorithm alg(meshObject->getKernel());
+    if (!meshObject) {
+        return;
+    }
+    if (!meshBVH) {
+        meshBVH = new MeshCore::MeshFacetBVH(meshObject->getKernel());
+    }
 
     const SbLine& line = raypick->getLine();
     const SbVec3f& pos = line.getPosition();
@@ -402,7 +402,7 @@ void SoFCMeshPickNode::pick(SoPickAction* action)
     Base::Vector3f pt(pos[0], pos[1], pos[2]);
     Base::Vector3f dr(dir[0], dir[1], dir[2]);
     Mesh::FacetIndex index {};
-    if (alg.NearestFacetOnRay(pt, dr, *meshGrid, pt, index)) {
+    if (meshBVH->NearestFacetOnRay(pt, dr, pt, index)) {
         SoPickedPoint* pp = raypick->addIntersection(SbVec3f(pt.x, pt.y, pt.z));
         if (pp) {
             SoFaceDetail* det = new SoFaceDetail();
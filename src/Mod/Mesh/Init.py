@@ -6,6 +6,7 @@ import FreeCAD
 # Append the open handler
 FreeCAD.addImportType("STL Mesh (*.stl *.STL *.ast *.AST)", "Mesh")
 FreeCAD.addImportType("Binary Mesh (*.bms *.BMS)", "Mesh")
+FreeCAD.addImportType("Compact Binary Mesh (*.bmc *.BMC)", "Mesh")
 FreeCAD.addImportType("Alias Mesh (*.obj *.OBJ)", "Mesh")
 FreeCAD.addImportType("Object File Format Mesh (*.off *.OFF)", "Mesh")
 FreeCAD.addImportType("Stanford Triangle Mesh (*.ply *.PLY)", "Mesh")
@@ -14,6 +15,7 @@ FreeCAD.addImportType("3D Manufacturing Format (*.3mf *.3MF)", "Mesh")
 
 FreeCAD.addExportType("STL Mesh (*.stl *.ast)", "Mesh")
 FreeCAD.addExportType("Binary Mesh (*.bms)", "Mesh")
+FreeCAD.addExportType("Compact Binary Mesh (*.bmc)", "Mesh")
 FreeCAD.addExportType("Alias Mesh (*.obj)", "Mesh")
 FreeCAD.addExportType("Object File Format Mesh (*.off)", "Mesh")
 FreeCAD.addExportType("Stanford Triangle Mesh (*.ply)", "Mesh")
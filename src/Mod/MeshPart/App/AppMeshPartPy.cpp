@@ -139,6 +139,22 @@ public:
             "    SegPerEdge (optional, float)\n"
             "    SegPerRadius (optional, float)\n"
         );
+        add_keyword_method("meshFromShapes",&Module::meshFromShapes,
+            "Create a single surface mesh from a list of shapes\n"
+            "\n"
+            "    meshFromShapes(Shapes, LinearDeflection,\n"
+            "                           AngularDeflection=0.5,\n"
+            "                           Relative=False)\n"
+            "\n"
+            "The shapes are meshed in parallel with the standard mesher. Shapes that\n"
+            "only differ in their placement, like link instances, are meshed once.\n"
+            "\n"
+            "Args:\n"
+            "    Shapes (required, list of topology) - TopoShapes to create the mesh of.\n"
+            "    LinearDeflection (required, float)\n"
+            "    AngularDeflection (optional, float)\n"
+            "    Relative (optional, boolean)\n"
+        );
         initialize("This module is the MeshPart module."); // register with Python
     }
 
@@ -640,6 +656,45 @@ private:
 
         throw Py::TypeError("Wrong arguments");
     }
+    Py::Object meshFromShapes(const Py::Tuple& args, const Py::Dict& kwds)
+    {
+        PyObject *shapes;
+        double lindeflection=0;
+        double angdeflection=0.5;
+        PyObject* relative = Py_False;
+
+        static const std::array<const char *, 5> kwds_shapes{"Shapes", "LinearDeflection", "AngularDeflection",
+                                                             "Relative", nullptr};
+        if (!Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "Od|dO!", kwds_shapes,
+                                                 &shapes, &lindeflection, &angdeflection,
+                                                 &(PyBool_Type), &relative)) {
+            throw Py::Exception();
+        }
+
+        TopoDS_Shape nullShape;
+        MeshPart::Mesher settings(nullShape);
+        settings.setMethod(MeshPart::Mesher::Standard);
+        settings.setDeflection(lindeflection);
+        settings.setAngularDeflection(angdeflection);
+        settings.setRelative(Base::asBoolean(relative));
+
+        MeshPart::BatchMesher mesher(settings);
+        Py::Sequence list(shapes);
+        for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+            PyObject* item = (*it).ptr();
+            if (!PyObject_TypeCheck(item, &(Part::TopoShapePy::Type))) {
+                throw Py::TypeError("Expected a list of shapes");
+            }
+            mesher.addShape(static_cast<Part::TopoShapePy*>(item)->getTopoShapePtr()->getShape());
+        }
+
+        Mesh::MeshObject* mesh;
+        {
+            Base::PyGILStateRelease releaser{};
+            mesh = mesher.createMesh();
+        }
+        return Py::asObject(new Mesh::MeshPy(mesh));
+    }
 };
 
 PyObject* initModule()
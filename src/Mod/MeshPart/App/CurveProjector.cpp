@@ -37,6 +37,7 @@
 #include <GeomAPI_IntCS.hxx>
 #include <Geom_Curve.hxx>
 #include <Geom_Plane.hxx>
+#include <OSD_Parallel.hxx>
 #include <Standard_Failure.hxx>
 #include <TopExp_Explorer.hxx>
 #include <TopoDS.hxx>
@@ -50,6 +51,7 @@
 #include <Base/Stream.h>
 
 #include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/BVH.h>
 #include <Mod/Mesh/App/Core/Grid.h>
 #include <Mod/Mesh/App/Core/Iterator.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
@@ -494,6 +496,47 @@ MeshProjection::MeshProjection(const MeshKernel& rMesh)
     : _rcMesh(rMesh)
 {}
 
+MeshProjection::~MeshProjection() = default;
+
+void MeshProjection::setCacheEnabled(bool on)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    cacheEnabled = on;
+    if (!on) {
+        facetBVH.reset();
+        cachedEdges.clear();
+    }
+}
+
+bool MeshProjection::isCacheEnabled() const
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return cacheEnabled;
+}
+
+void MeshProjection::clearCache()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    facetBVH.reset();
+    cachedEdges.clear();
+}
+
+std::shared_ptr<const MeshCore::MeshFacetBVH> MeshProjection::getFacetBVH() const
+{
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        if (cacheEnabled) {
+            if (!facetBVH) {
+                facetBVH = std::make_shared<MeshCore::MeshFacetBVH>(_rcMesh);
+            }
+            return facetBVH;
+        }
+    }
+
+    // without caching the mesh may have been modified since the last call
+    return std::make_shared<MeshCore::MeshFacetBVH>(_rcMesh);
+}
+
 void MeshProjection::discretize(const TopoDS_Edge& aEdge,
                                 std::vector<Base::Vector3f>& polyline,
                                 std::size_t minPoints) const
@@ -664,10 +707,11 @@ void MeshProjection::projectOnMesh(const std::vector<Base::Vector3f>& pointsIn,
                                    float tolerance,
                                    std::vector<Base::Vector3f>& pointsOut) const
 {
-    // calculate the average edge length and create a grid
-    MeshAlgorithm clAlg(_rcMesh);
-    float fAvgLen = clAlg.GetAverageEdgeLength();
-    MeshFacetGrid cGrid(_rcMesh, 5.0f * fAvgLen);
+    // shoot all rays at once
+    std::vector<Base::Vector3f> directions(pointsIn.size(), dir);
+    std::vector<MeshCore::FacetIndex> hitFacets;
+    std::vector<Base::Vector3f> hitPoints;
+    getFacetBVH()->NearestFacetsOnRays(pointsIn, directions, hitFacets, hitPoints);
 
     // get all boundary points and edges of the mesh
     std::vector<Base::Vector3f> boundaryPoints;
@@ -691,10 +735,11 @@ void MeshProjection::projectOnMesh(const std::vector<Base::Vector3f>& pointsIn,
 
     Base::SequencerLauncher seq("Project points on mesh", pointsIn.size());
 
-    for (auto it : pointsIn) {
-        Base::Vector3f result;
-        MeshCore::FacetIndex index;
-        if (clAlg.NearestFacetOnRay(it, dir, cGrid, result, index)) {
+    for (std::size_t i = 0; i < pointsIn.size(); i++) {
+        const Base::Vector3f& it = pointsIn[i];
+        Base::Vector3f result = hitPoints[i];
+        MeshCore::FacetIndex index = hitFacets[i];
+        if (index != MeshCore::FACET_INDEX_MAX) {
             MeshCore::MeshGeomFacet geomFacet = _rcMesh.GetFacet(index);
             if (tolerance > 0 && geomFacet.IntersectPlaneWithLine(it, dir, result)) {
                 if (geomFacet.IsPointOfFace(result, tolerance)) {
@@ -744,112 +789,132 @@ void MeshProjection::projectParallelToMesh(const TopoDS_Shape& aShape,
                                            const Base::Vector3f& dir,
                                            std::vector<PolyLine>& rPolyLines) const
 {
-    // calculate the average edge length and create a grid
-    MeshAlgorithm clAlg(_rcMesh);
-    float fAvgLen = clAlg.GetAverageEdgeLength();
-    MeshFacetGrid cGrid(_rcMesh, 5.0f * fAvgLen);
-    TopExp_Explorer Ex;
-
-    int iCnt = 0;
-    for (Ex.Init(aShape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
-        iCnt++;
+    std::vector<TopoDS_Edge> edges;
+    for (TopExp_Explorer Ex(aShape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
+        edges.push_back(TopoDS::Edge(Ex.Current()));
     }
 
-    Base::SequencerLauncher seq("Project curve on mesh", iCnt);
+    projectParallelToMesh(edges, dir, rPolyLines);
+}
 
-    for (Ex.Init(aShape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
-        const TopoDS_Edge& aEdge = TopoDS::Edge(Ex.Current());
-        std::vector<Base::Vector3f> points;
-        discretize(aEdge, points, 5);
-
-        using HitPoint = std::pair<Base::Vector3f, MeshCore::FacetIndex>;
-        std::vector<HitPoint> hitPoints;
-        using HitPoints = std::pair<HitPoint, HitPoint>;
-        std::vector<HitPoints> hitPointPairs;
-        for (auto it : points) {
-            Base::Vector3f result;
-            MeshCore::FacetIndex index;
-            if (clAlg.NearestFacetOnRay(it, dir, cGrid, result, index)) {
-                hitPoints.emplace_back(result, index);
-
-                if (hitPoints.size() > 1) {
-                    HitPoint p1 = hitPoints[hitPoints.size() - 2];
-                    HitPoint p2 = hitPoints[hitPoints.size() - 1];
-                    hitPointPairs.emplace_back(p1, p2);
+void MeshProjection::projectParallelToMesh(const std::vector<TopoDS_Edge>& aEdges,
+                                           const Base::Vector3f& dir,
+                                           std::vector<PolyLine>& rPolyLines) const
+{
+    std::shared_ptr<const MeshCore::MeshFacetBVH> bvh = getFacetBVH();
+    std::vector<PolyLine> polylines(aEdges.size());
+
+    // look up the edges that have been projected before
+    std::vector<std::size_t> todo;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        for (std::size_t i = 0; i < aEdges.size(); i++) {
+            bool found = false;
+            if (cacheEnabled) {
+                auto range = cachedEdges.equal_range(aEdges[i].TShape().get());
+                for (auto it = range.first; it != range.second; ++it) {
+                    if (it->second.edge.IsEqual(aEdges[i]) && it->second.dir == dir) {
+                        polylines[i] = it->second.polyline;
+                        found = true;
+                        break;
+                    }
                 }
             }
-        }
-
-        MeshCore::MeshProjection meshProjection(_rcMesh);
-        PolyLine polyline;
-        for (auto it : hitPointPairs) {
-            points.clear();
-            if (meshProjection.projectLineOnMesh(cGrid,
-                                                 it.first.first,
-                                                 it.first.second,
-                                                 it.second.first,
-                                                 it.second.second,
-                                                 dir,
-                                                 points)) {
-                polyline.points.insert(polyline.points.end(), points.begin(), points.end());
+            if (!found) {
+                todo.push_back(i);
             }
         }
-        rPolyLines.push_back(polyline);
+    }
 
+    // the sequencer must only be advanced from this thread, so the edges are handed over
+    // to the worker threads in blocks
+    const std::size_t blockSize = 64;
+    Base::SequencerLauncher seq("Project curve on mesh", (todo.size() + blockSize - 1) / blockSize);
+    for (std::size_t first = 0; first < todo.size(); first += blockSize) {
+        int count = static_cast<int>(std::min(blockSize, todo.size() - first));
+        OSD_Parallel::For(0, count, [&](int i) {
+            std::size_t index = todo[first + i];
+            std::vector<Base::Vector3f> points;
+            discretize(aEdges[index], points, 5);
+            polylines[index] = projectPolyLine(points, dir, *bvh);
+        });
         seq.next();
     }
+
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        // don't mix in results if the cache has been cleared in the meantime
+        if (cacheEnabled && facetBVH == bvh) {
+            for (std::size_t index : todo) {
+                CachedEdge entry {aEdges[index], dir, polylines[index]};
+                cachedEdges.emplace(aEdges[index].TShape().get(), entry);
+            }
+        }
+    }
+
+    rPolyLines.insert(rPolyLines.end(), polylines.begin(), polylines.end());
 }
 
 void MeshProjection::projectParallelToMesh(const std::vector<PolyLine>& aEdges,
                                            const Base::Vector3f& dir,
                                            std::vector<PolyLine>& rPolyLines) const
 {
-    // calculate the average edge length and create a grid
-    MeshAlgorithm clAlg(_rcMesh);
-    float fAvgLen = clAlg.GetAverageEdgeLength();
-    MeshFacetGrid cGrid(_rcMesh, 5.0f * fAvgLen);
+    std::shared_ptr<const MeshCore::MeshFacetBVH> bvh = getFacetBVH();
+    std::vector<PolyLine> polylines(aEdges.size());
+
+    const std::size_t blockSize = 64;
+    Base::SequencerLauncher seq("Project curve on mesh",
+                                (aEdges.size() + blockSize - 1) / blockSize);
+    for (std::size_t first = 0; first < aEdges.size(); first += blockSize) {
+        int count = static_cast<int>(std::min(blockSize, aEdges.size() - first));
+        OSD_Parallel::For(0, count, [&](int i) {
+            polylines[first + i] = projectPolyLine(aEdges[first + i].points, dir, *bvh);
+        });
+        seq.next();
+    }
 
-    Base::SequencerLauncher seq("Project curve on mesh", aEdges.size());
-
-    for (const auto& it : aEdges) {
-        std::vector<Base::Vector3f> points = it.points;
-
-        using HitPoint = std::pair<Base::Vector3f, MeshCore::FacetIndex>;
-        std::vector<HitPoint> hitPoints;
-        using HitPoints = std::pair<HitPoint, HitPoint>;
-        std::vector<HitPoints> hitPointPairs;
-        for (auto it : points) {
-            Base::Vector3f result;
-            MeshCore::FacetIndex index;
-            if (clAlg.NearestFacetOnRay(it, dir, cGrid, result, index)) {
-                hitPoints.emplace_back(result, index);
-
-                if (hitPoints.size() > 1) {
-                    HitPoint p1 = hitPoints[hitPoints.size() - 2];
-                    HitPoint p2 = hitPoints[hitPoints.size() - 1];
-                    hitPointPairs.emplace_back(p1, p2);
-                }
-            }
-        }
+    rPolyLines.insert(rPolyLines.end(), polylines.begin(), polylines.end());
+}
 
-        MeshCore::MeshProjection meshProjection(_rcMesh);
-        PolyLine polyline;
-        for (auto it : hitPointPairs) {
-            points.clear();
-            if (meshProjection.projectLineOnMesh(cGrid,
-                                                 it.first.first,
-                                                 it.first.second,
-                                                 it.second.first,
-                                                 it.second.second,
-                                                 dir,
-                                                 points)) {
-                polyline.points.insert(polyline.points.end(), points.begin(), points.end());
+MeshProjection::PolyLine MeshProjection::projectPolyLine(const std::vector<Base::Vector3f>& points,
+                                                         const Base::Vector3f& dir,
+                                                         const MeshCore::MeshFacetBVH& bvh) const
+{
+    using HitPoint = std::pair<Base::Vector3f, MeshCore::FacetIndex>;
+    std::vector<HitPoint> hitPoints;
+    using HitPoints = std::pair<HitPoint, HitPoint>;
+    std::vector<HitPoints> hitPointPairs;
+    for (auto it : points) {
+        Base::Vector3f result;
+        MeshCore::FacetIndex index;
+        if (bvh.NearestFacetOnRay(it, dir, result, index)) {
+            hitPoints.emplace_back(result, index);
+
+            if (hitPoints.size() > 1) {
+                HitPoint p1 = hitPoints[hitPoints.size() - 2];
+                HitPoint p2 = hitPoints[hitPoints.size() - 1];
+                hitPointPairs.emplace_back(p1, p2);
             }
         }
-        rPolyLines.push_back(polyline);
+    }
 
-        seq.next();
+    MeshCore::MeshProjection meshProjection(_rcMesh);
+    PolyLine polyline;
+    std::vector<Base::Vector3f> segment;
+    for (auto it : hitPointPairs) {
+        segment.clear();
+        if (meshProjection.projectLineOnMesh(bvh,
+                                             it.first.first,
+                                             it.first.second,
+                                             it.second.first,
+                                             it.second.second,
+                                             dir,
+                                             segment)) {
+            polyline.points.insert(polyline.points.end(), segment.begin(), segment.end());
+        }
     }
+
+    return polyline;
 }
 
 void MeshProjection::projectEdgeToEdge(const TopoDS_Edge& aEdge,
@@ -23,6 +23,10 @@
 #ifndef _CurveProjector_h_
 #define _CurveProjector_h_
 
+#include <map>
+#include <memory>
+#include <mutex>
+
 #include <TopoDS_Edge.hxx>
 
 #include <Mod/Mesh/App/Mesh.h>
@@ -35,6 +39,7 @@ namespace MeshCore
 class MeshKernel;
 class MeshGeomFacet;
 class MeshFacetGrid;
+class MeshFacetBVH;
 }  // namespace MeshCore
 
 using MeshCore::MeshGeomFacet;
@@ -166,6 +171,11 @@ protected:
 
 /**
  * The MeshProjection class projects a shape onto a mesh.
+ *
+ * By default the search structure for the parallel projection is built anew for every call.
+ * If caching is enabled it is built on first use and kept together with the projected edges,
+ * so that a single instance can project many curves one after another. Modifications of the
+ * mesh are not detected then, see setCacheEnabled().
  * @author Werner Mayer
  */
 class MeshPartExport MeshProjection
@@ -188,6 +198,28 @@ public:
     };
 
     explicit MeshProjection(const MeshKernel& rMesh);
+    ~MeshProjection();
+
+    MeshProjection(const MeshProjection&) = delete;
+    MeshProjection(MeshProjection&&) = delete;
+    MeshProjection& operator=(const MeshProjection&) = delete;
+    MeshProjection& operator=(MeshProjection&&) = delete;
+
+    /** @name Caching */
+    //@{
+    /**
+     * If enabled the search structure of the mesh and the results of projectParallelToMesh()
+     * per edge and direction are kept and re-used by later calls. Modifications of the mesh
+     * are not detected, so the caller must call clearCache() after changing the mesh. By
+     * default caching is disabled and the search structure is rebuilt for every call.
+     */
+    void setCacheEnabled(bool on);
+    bool isCacheEnabled() const;
+    /**
+     * Drops the search structure and the cached results.
+     */
+    void clearCache();
+    //@}
 
     /**
      * @brief findSectionParameters
@@ -231,6 +263,13 @@ public:
     void projectParallelToMesh(const TopoDS_Shape& aShape,
                                const Base::Vector3f& dir,
                                std::vector<PolyLine>& rPolyLines) const;
+    /**
+     * Project all edges onto the mesh using parallel projection. The edges are projected
+     * in parallel and the polylines are appended to \a rPolyLines in the order of \a aEdges.
+     */
+    void projectParallelToMesh(const std::vector<TopoDS_Edge>& aEdges,
+                               const Base::Vector3f& dir,
+                               std::vector<PolyLine>& rPolyLines) const;
     /**
      * Project all polylines onto the mesh using parallel projection.
      */
@@ -254,7 +293,25 @@ protected:
                           Base::Vector3f& res) const;
 
 private:
+    std::shared_ptr<const MeshCore::MeshFacetBVH> getFacetBVH() const;
+    PolyLine projectPolyLine(const std::vector<Base::Vector3f>& points,
+                             const Base::Vector3f& dir,
+                             const MeshCore::MeshFacetBVH& bvh) const;
+
+private:
+    struct CachedEdge
+    {
+        TopoDS_Edge edge;
+        Base::Vector3f dir;
+        PolyLine polyline;
+    };
+
     const MeshKernel& _rcMesh;
+    bool cacheEnabled {false};
+    mutable std::mutex cacheMutex;
+    mutable std::shared_ptr<const MeshCore::MeshFacetBVH> facetBVH;
+    /// the projected edges, the key is the TShape of the edge
+    mutable std::multimap<const void*, CachedEdge> cachedEdges;
 };
 
 }  // namespace MeshPart
@@ -23,10 +23,15 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <algorithm>
+#include <memory>
 
 #include <BRepMesh_IncrementalMesh.hxx>
 #include <BRepTools.hxx>
+#include <BRep_Builder.hxx>
+#include <OSD_Parallel.hxx>
 #include <Standard_Version.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS_Compound.hxx>
 #include <TopoDS_Shape.hxx>
 #endif
 
@@ -581,3 +586,142 @@ Mesh::MeshObject* Mesher::createFrom(SMESH_Mesh* mesh) const
     meshdata->swap(kernel);
     return meshdata;
 }
+
+// ----------------------------------------------------------------------------
+
+namespace
+{
+/*
+ * Writes the mesh moved to \a placement into the arrays, starting at the given indices.
+ * A mirroring placement would turn the facets inside out, so their orientation is reversed.
+ */
+void placeMesh(const MeshCore::MeshKernel& mesh,
+               const Base::Matrix4D& placement,
+               MeshCore::MeshPointArray& points,
+               std::size_t pointIndex,
+               MeshCore::MeshFacetArray& facets,
+               std::size_t facetIndex)
+{
+    auto offset = static_cast<MeshCore::PointIndex>(pointIndex);
+    for (const auto& it : mesh.GetPoints()) {
+        placement.multVec(it, points[pointIndex++]);
+    }
+
+    bool flip = placement.determinant3() < 0.0;
+    for (const auto& it : mesh.GetFacets()) {
+        MeshCore::PointIndex p0 = it._aulPoints[0] + offset;
+        MeshCore::PointIndex p1 = it._aulPoints[1] + offset;
+        MeshCore::PointIndex p2 = it._aulPoints[2] + offset;
+        facets[facetIndex++] =
+            flip ? MeshCore::MeshFacet(p0, p2, p1) : MeshCore::MeshFacet(p0, p1, p2);
+    }
+}
+}  // namespace
+
+BatchMesher::BatchMesher(const Mesher& settings)
+    : settings(settings)
+{}
+
+void BatchMesher::addShape(const TopoDS_Shape& shape)
+{
+    std::pair<const void*, int> key(shape.TShape().get(), static_cast<int>(shape.Orientation()));
+    auto it = shapeIndex.find(key);
+    if (it == shapeIndex.end()) {
+        it = shapeIndex.emplace(key, uniqueShapes.size()).first;
+        uniqueShapes.push_back(shape.Located(TopLoc_Location()));
+    }
+
+    instances.push_back({it->second, Part::TopoShape::convert(shape.Location().Transformation())});
+}
+
+std::vector<MeshCore::MeshKernel> BatchMesher::meshUniqueShapes() const
+{
+    std::vector<MeshCore::MeshKernel> meshes(uniqueShapes.size());
+    if (settings.getMethod() == Mesher::Standard) {
+        // Mesh all shapes with a single call so that BRepMesh can run over the faces in parallel
+        // and sub-shapes shared by several shapes are handled properly
+        TopoDS_Compound comp;
+        BRep_Builder builder;
+        builder.MakeCompound(comp);
+        for (const auto& it : uniqueShapes) {
+            if (!it.IsNull()) {
+                builder.Add(comp, it);
+            }
+        }
+        BRepTools::Clean(comp);
+        BRepMesh_IncrementalMesh aMesh(comp,
+                                       settings.getDeflection(),
+                                       settings.isRelative(),
+                                       settings.getAngularDeflection(),
+                                       Standard_True);
+
+        // The conversion only reads the triangulations. Segments and colors are not created
+        // because only the kernels of the meshes are kept.
+        BrepMesh brepmesh(false, {});
+        OSD_Parallel::For(0, static_cast<int>(uniqueShapes.size()), [&](int index) {
+            std::vector<Part::TopoShape::Domain> domains;
+            Part::TopoShape(uniqueShapes[index]).getDomains(domains);
+            std::unique_ptr<Mesh::MeshObject> mesh(brepmesh.create(domains));
+            meshes[index] = mesh->getKernel();
+        });
+    }
+    else {
+        Mesher mesher(settings);
+        mesher.setSegments(false);
+        mesher.setColors({});
+        for (std::size_t index = 0; index < uniqueShapes.size(); index++) {
+            mesher.shape = uniqueShapes[index];
+            std::unique_ptr<Mesh::MeshObject> mesh(mesher.createMesh());
+            meshes[index] = mesh->getKernel();
+        }
+    }
+
+    return meshes;
+}
+
+Mesh::MeshObject* BatchMesher::createMesh() const
+{
+    std::vector<MeshCore::MeshKernel> meshes = meshUniqueShapes();
+
+    // Each shape gets its own range in the merged arrays so that they can be filled in parallel
+    std::vector<std::size_t> pointOffset(instances.size() + 1, 0);
+    std::vector<std::size_t> facetOffset(instances.size() + 1, 0);
+    for (std::size_t i = 0; i < instances.size(); i++) {
+        const MeshCore::MeshKernel& mesh = meshes[instances[i].unique];
+        pointOffset[i + 1] = pointOffset[i] + mesh.CountPoints();
+        facetOffset[i + 1] = facetOffset[i] + mesh.CountFacets();
+    }
+
+    MeshCore::MeshPointArray points(pointOffset.back());
+    MeshCore::MeshFacetArray facets(facetOffset.back());
+    OSD_Parallel::For(0, static_cast<int>(instances.size()), [&](int i) {
+        placeMesh(meshes[instances[i].unique],
+                  instances[i].placement,
+                  points,
+                  pointOffset[i],
+                  facets,
+                  facetOffset[i]);
+    });
+
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+
+    Mesh::MeshObject* meshdata = new Mesh::MeshObject();
+    meshdata->swap(kernel);
+    return meshdata;
+}
+
+void BatchMesher::createMeshes(const std::function<void(const MeshCore::MeshKernel&)>& func) const
+{
+    std::vector<MeshCore::MeshKernel> meshes = meshUniqueShapes();
+    for (const auto& it : instances) {
+        const MeshCore::MeshKernel& mesh = meshes[it.unique];
+        MeshCore::MeshPointArray points(mesh.CountPoints());
+        MeshCore::MeshFacetArray facets(mesh.CountFacets());
+        placeMesh(mesh, it.placement, points, 0, facets, 0);
+
+        MeshCore::MeshKernel kernel;
+        kernel.Adopt(points, facets, true);
+        func(kernel);
+    }
+}
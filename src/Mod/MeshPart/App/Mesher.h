@@ -23,18 +23,29 @@
 #ifndef MESHPART_MESHER_H
 #define MESHPART_MESHER_H
 
+#include <functional>
+#include <map>
 #include <sstream>
+#include <utility>
+#include <vector>
 
+#include <TopoDS_Shape.hxx>
+
+#include <Base/Matrix.h>
 #include <Base/Stream.h>
+#include <Mod/MeshPart/MeshPartGlobal.h>
 
 #ifdef HAVE_SMESH
 #include <SMESH_Version.h>
 #endif
 
-class TopoDS_Shape;
 class SMESH_Gen;
 class SMESH_Mesh;
 
+namespace MeshCore
+{
+class MeshKernel;
+}
 namespace Mesh
 {
 class MeshObject;
@@ -42,7 +53,7 @@ class MeshObject;
 namespace MeshPart
 {
 
-class Mesher
+class MeshPartExport Mesher
 {
 public:
     enum Method
@@ -218,7 +229,8 @@ private:
     Mesh::MeshObject* createFrom(SMESH_Mesh*) const;
 
 private:
-    const TopoDS_Shape& shape;
+    friend class BatchMesher;
+    TopoDS_Shape shape;
     Method method {None};
     double maxLength {0};
     double maxArea {0};
@@ -243,6 +255,59 @@ private:
     static SMESH_Gen* _mesh_gen;
 };
 
+/**
+ * The BatchMesher class meshes many shapes with the same settings, e.g. all parts of an assembly.
+ * Shapes that only differ in their placement, like the instances of a link, are meshed once and
+ * the mesh is moved to each placement.
+ * With the standard mesher all shapes are meshed in parallel. The SMESH based methods are not
+ * thread-safe and mesh one shape after the other.
+ */
+class MeshPartExport BatchMesher
+{
+public:
+    /** The method and its parameters are taken from \a settings, its shape is ignored. The
+     * meshes are created without segments, so the segments and colors of \a settings are
+     * ignored as well.
+     */
+    explicit BatchMesher(const Mesher& settings);
+
+    void addShape(const TopoDS_Shape&);
+    /// Returns the number of added shapes
+    std::size_t countShapes() const
+    {
+        return instances.size();
+    }
+    /// Returns the number of shapes that are actually meshed
+    std::size_t countUniqueShapes() const
+    {
+        return uniqueShapes.size();
+    }
+
+    /// Meshes all shapes and merges them into a single mesh
+    Mesh::MeshObject* createMesh() const;
+    /** Meshes all shapes and passes the placed mesh of each shape to \a func in the order the
+     * shapes were added. This way the meshes can be written to a file without creating the
+     * merged mesh.
+     */
+    void createMeshes(const std::function<void(const MeshCore::MeshKernel&)>& func) const;
+
+private:
+    std::vector<MeshCore::MeshKernel> meshUniqueShapes() const;
+
+private:
+    struct Instance
+    {
+        std::size_t unique;
+        Base::Matrix4D placement;
+    };
+
+    Mesher settings;
+    std::vector<TopoDS_Shape> uniqueShapes;
+    std::vector<Instance> instances;
+    /// maps the underlying shape and its orientation to the index of the unique shape
+    std::map<std::pair<const void*, int>, std::size_t> shapeIndex;
+};
+
 class MeshingOutput: public std::streambuf
 {
 public:
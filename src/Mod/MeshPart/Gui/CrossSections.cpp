@@ -51,7 +51,6 @@
 #include <Gui/View3DInventorViewer.h>
 #include <Gui/ViewProvider.h>
 #include <Mod/Mesh/App/Core/Algorithm.h>
-#include <Mod/Mesh/App/Core/Grid.h>
 #include <Mod/Mesh/App/MeshFeature.h>
 #include <Mod/Part/App/PartFeature.h>
 #include <Mod/Part/App/Tools.h>
@@ -125,14 +124,12 @@ class MeshCrossSection
 {
 public:
     MeshCrossSection(const MeshCore::MeshKernel& mesh,
-                     const MeshCore::MeshFacetGrid& grid,
                      double x,
                      double y,
                      double z,
                      bool connectEdges,
                      double eps)
-        : mesh(mesh)
-        , grid(grid)
+        : slicer(mesh, Base::Vector3f(x, y, z))
         , x(x)
         , y(y)
         , z(z)
@@ -142,10 +139,8 @@ public:
     std::list<TopoDS_Wire> section(double d)
     {
         Mesh::MeshObject::TPolylines polylines;
-        MeshCore::MeshAlgorithm algo(mesh);
         Base::Vector3f p(x * d, y * d, z * d);
-        Base::Vector3f n(x, y, z);
-        algo.CutWithPlane(p, n, grid, polylines, epsilon, connectEdges);
+        slicer.CutWithPlane(p, polylines, epsilon, connectEdges);
 
         std::list<TopoDS_Wire> wires;
         for (const auto& polyline : polylines) {
@@ -163,8 +158,8 @@ public:
     }
 
 private:
-    const MeshCore::MeshKernel& mesh;
-    const MeshCore::MeshFacetGrid& grid;
+    // the slabs along the normal are shared by all sections
+    MeshCore::MeshSlicer slicer;
     double x, y, z;
     bool connectEdges;
     double epsilon;
@@ -303,10 +298,8 @@ void CrossSections::apply()
         MeshCore::MeshKernel kernel(mesh.getKernel());
         kernel.Transform(mesh.getTransform());
 
-        MeshCore::MeshFacetGrid grid(kernel);
-
         // NOLINTBEGIN
-        MeshCrossSection cs(kernel, grid, a, b, c, connectEdges, eps);
+        MeshCrossSection cs(kernel, a, b, c, connectEdges, eps);
         QFuture<std::list<TopoDS_Wire>> future =
             QtConcurrent::mapped(d, std::bind(&MeshCrossSection::section, &cs, sp::_1));
         future.waitForFinished();
@@ -23,7 +23,12 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 # include <algorithm>
+# include <cmath>
+# include <exception>
+# include <memory>
+# include <Bnd_Box.hxx>
 # include <BRepAdaptor_Surface.hxx>
+# include <BRepBndLib.hxx>
 # include <Mod/Part/App/FCBRepAlgoAPI_Common.h>
 # include <Mod/Part/App/FCBRepAlgoAPI_Cut.h>
 # include <Mod/Part/App/FCBRepAlgoAPI_Section.h>
@@ -31,6 +36,7 @@
 # include <BRepBuilderAPI_MakeWire.hxx>
 # include <BRepPrimAPI_MakeHalfSpace.hxx>
 # include <gp_Pln.hxx>
+# include <OSD_Parallel.hxx>
 # include <Precision.hxx>
 # include <ShapeAnalysis_FreeBounds.hxx>
 # include <ShapeFix_Wire.hxx>
@@ -49,30 +55,92 @@
 
 using namespace Part;
 
-CrossSection::CrossSection(double a, double b, double c, const TopoDS_Shape& s)
-  : a(a), b(b), c(c), s(s)
+namespace {
+
+template<typename ShapeT>
+SliceInterval<ShapeT> makeInterval(const ShapeT& shape, const TopoDS_Shape& tds, bool solid,
+                                   double a, double b, double c)
 {
+    SliceInterval<ShapeT> interval {shape, solid, -Precision::Infinite(), Precision::Infinite()};
+
+    // The plane of a slice at distance d is a*x + b*y + c*z = d, so project the
+    // bounding box onto (a,b,c) to get the range of distances crossing the shape.
+    Bnd_Box box;
+    BRepBndLib::Add(tds, box, Standard_False);
+    if (box.IsVoid() || box.IsOpen()) {
+        return interval;
+    }
+
+    double xMin, yMin, zMin, xMax, yMax, zMax;
+    box.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+    double tol = Precision::Confusion() * std::sqrt(a * a + b * b + c * c);
+    interval.first = (a > 0 ? a * xMin : a * xMax)
+                   + (b > 0 ? b * yMin : b * yMax)
+                   + (c > 0 ? c * zMin : c * zMax) - tol;
+    interval.last = (a > 0 ? a * xMax : a * xMin)
+                  + (b > 0 ? b * yMax : b * yMin)
+                  + (c > 0 ? c * zMax : c * zMin) + tol;
+    return interval;
 }
 
-std::list<TopoDS_Wire> CrossSection::slice(double d) const
+}
+
+CrossSection::CrossSection(double a, double b, double c, const TopoDS_Shape& s)
+  : a(a), b(b), c(c), s(s)
 {
-    std::list<TopoDS_Wire> wires;
     // Fixes: 0001228: Cross section of Torus in Part Workbench fails or give wrong results
     // Fixes: 0001137: Incomplete slices when using Part.slice on a torus
     TopExp_Explorer xp;
     for (xp.Init(s, TopAbs_SOLID); xp.More(); xp.Next()) {
-        sliceSolid(d, xp.Current(), wires);
+        intervals.push_back(makeInterval(xp.Current(), xp.Current(), true, a, b, c));
     }
     for (xp.Init(s, TopAbs_SHELL, TopAbs_SOLID); xp.More(); xp.Next()) {
-        sliceNonSolid(d, xp.Current(), wires);
+        intervals.push_back(makeInterval(xp.Current(), xp.Current(), false, a, b, c));
     }
     for (xp.Init(s, TopAbs_FACE, TopAbs_SHELL); xp.More(); xp.Next()) {
-        sliceNonSolid(d, xp.Current(), wires);
+        intervals.push_back(makeInterval(xp.Current(), xp.Current(), false, a, b, c));
+    }
+}
+
+std::list<TopoDS_Wire> CrossSection::slice(double d) const
+{
+    std::list<TopoDS_Wire> wires;
+    for (const auto& interval : intervals) {
+        if (!interval.contains(d)) {
+            continue;
+        }
+        if (interval.solid) {
+            sliceSolid(d, interval.shape, wires);
+        }
+        else {
+            sliceNonSolid(d, interval.shape, wires);
+        }
     }
 
     return removeDuplicates(wires);
 }
 
+std::vector<std::list<TopoDS_Wire>> CrossSection::slices(const std::vector<double>& d) const
+{
+    std::vector<std::list<TopoDS_Wire>> wires(d.size());
+    std::vector<std::exception_ptr> errors(d.size());
+    OSD_Parallel::For(0, static_cast<int>(d.size()), [&](int i) {
+        try {
+            wires[i] = slice(d[i]);
+        }
+        catch (...) {
+            errors[i] = std::current_exception();
+        }
+    }, d.size() < 2);
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    return wires;
+}
+
 std::list<TopoDS_Wire> CrossSection::removeDuplicates(const std::list<TopoDS_Wire>& wires) const
 {
     std::list<TopoDS_Wire> wires_reduce;
@@ -222,31 +290,44 @@ TopoDS_Wire CrossSection::fixWire(const TopoDS_Wire& wire) const
 
 TopoCrossSection::TopoCrossSection(double a, double b, double c, const TopoShape& s, const char *op)
     : a(a), b(b), c(c), shape(s), op(op?op:Part::OpCodes::Slice)
-{
-}
-
-void TopoCrossSection::slice(int idx, double d, std::vector<TopoShape>& wires) const
 {
     // Fixes: 0001228: Cross section of Torus in Part Workbench fails or give wrong results
     // Fixes: 0001137: Incomplete slices when using Part.slice on a torus
-    bool found = false;
-    for (auto& s : shape.getSubTopoShapes(TopAbs_SOLID)) {
-        sliceSolid(idx, d, s, wires);
-        found = true;
+    for (auto& sub : shape.getSubTopoShapes(TopAbs_SOLID)) {
+        intervals.push_back(makeInterval(sub, sub.getShape(), true, a, b, c));
     }
-    if (!found) {
-        for (auto& s : shape.getSubTopoShapes(TopAbs_SHELL)) {
-            sliceNonSolid(idx, d, s, wires);
-            found = true;
+    if (intervals.empty()) {
+        for (auto& sub : shape.getSubTopoShapes(TopAbs_SHELL)) {
+            intervals.push_back(makeInterval(sub, sub.getShape(), false, a, b, c));
         }
-        if (!found) {
-            for (auto& s : shape.getSubTopoShapes(TopAbs_FACE)) {
-                sliceNonSolid(idx, d, s, wires);
-            }
+    }
+    if (intervals.empty()) {
+        for (auto& sub : shape.getSubTopoShapes(TopAbs_FACE)) {
+            intervals.push_back(makeInterval(sub, sub.getShape(), false, a, b, c));
         }
     }
 }
 
+/// The OCC operations of a single sub-shape section
+struct TopoCrossSection::Section
+{
+    int idx;
+    double d;
+    const SliceInterval<TopoShape>* interval;
+    std::string prefix;
+
+    TopoDS_Face face;
+    std::unique_ptr<BRepPrimAPI_MakeHalfSpace> mkSolid;
+    std::unique_ptr<FCBRepAlgoAPI_Cut> mkCut;
+    std::unique_ptr<FCBRepAlgoAPI_Section> mkSection;
+    std::exception_ptr error;
+};
+
+void TopoCrossSection::slice(int idx, double d, std::vector<TopoShape>& wires) const
+{
+    slices(idx, std::vector<double>{d}, wires);
+}
+
 TopoShape TopoCrossSection::slice(int idx, double d) const
 {
     std::vector<TopoShape> wires;
@@ -257,53 +338,120 @@ TopoShape TopoCrossSection::slice(int idx, double d) const
         TopoShape::SingleShapeCompoundCreationPolicy::returnShape);
 }
 
-void TopoCrossSection::sliceNonSolid(int idx,
-                                     double d,
-                                     const TopoShape& shape,
-                                     std::vector<TopoShape>& wires) const
+void TopoCrossSection::slices(const std::vector<double>& distances,
+                              std::vector<TopoShape>& wires) const
 {
-    FCBRepAlgoAPI_Section cs(shape.getShape(), gp_Pln(a, b, c, -d));
-    if (cs.IsDone()) {
-        std::string prefix(op);
-        prefix += Data::indexSuffix(idx);
-        auto res = TopoShape()
-                       .makeElementShape(cs, shape, prefix.c_str())
-                       .makeElementWires()
-                       .getSubTopoShapes(TopAbs_WIRE);
-        wires.insert(wires.end(), res.begin(), res.end());
+    slices(1, distances, wires);
+}
+
+void TopoCrossSection::slices(int idx,
+                              const std::vector<double>& distances,
+                              std::vector<TopoShape>& wires) const
+{
+    std::vector<Section> sections;
+    for (std::size_t i = 0; i < distances.size(); ++i) {
+        for (const auto& interval : intervals) {
+            if (interval.contains(distances[i])) {
+                Section section {};
+                section.idx = idx + static_cast<int>(i);
+                section.d = distances[i];
+                section.interval = &interval;
+                section.prefix = op;
+                section.prefix += Data::indexSuffix(section.idx);
+                sections.push_back(std::move(section));
+            }
+        }
+    }
+
+    // The section operations neither modify the input shape nor touch the
+    // element maps, so run them in parallel. Their results keep the whole
+    // history of the booleans, so they are mapped and released in batches
+    // of a few sections per thread.
+    const int batchSize = 2 * std::max(1, OSD_Parallel::NbLogicalProcessors());
+    const int count = static_cast<int>(sections.size());
+    for (int first = 0; first < count; first += batchSize) {
+        int last = std::min(first + batchSize, count);
+        OSD_Parallel::For(first, last, [&](int i) {
+            try {
+                makeSection(sections[i]);
+            }
+            catch (...) {
+                sections[i].error = std::current_exception();
+            }
+        }, last - first < 2);
+
+        for (int i = first; i < last; ++i) {
+            auto& section = sections[i];
+            if (section.error) {
+                std::rethrow_exception(section.error);
+            }
+            if (section.interval->solid) {
+                sliceSolid(section, wires);
+            }
+            else {
+                sliceNonSolid(section, wires);
+            }
+            section.mkSection.reset();
+            section.mkCut.reset();
+            section.mkSolid.reset();
+            section.face.Nullify();
+        }
     }
 }
 
-void TopoCrossSection::sliceSolid(int idx,
-                                  double d,
-                                  const TopoShape& shape,
-                                  std::vector<TopoShape>& wires) const
+void TopoCrossSection::makeSection(Section& section) const
 {
-    gp_Pln slicePlane(a, b, c, -d);
+    const TopoDS_Shape& tds = section.interval->shape.getShape();
+    gp_Pln slicePlane(a, b, c, -section.d);
+    if (!section.interval->solid) {
+        section.mkSection = std::make_unique<FCBRepAlgoAPI_Section>(tds, slicePlane);
+        return;
+    }
+
     BRepBuilderAPI_MakeFace mkFace(slicePlane);
-    TopoShape face(idx);
-    face.setShape(mkFace.Face());
+    section.face = mkFace.Face();
 
     // Make sure to choose a point that does not lie on the plane (fixes #0001228)
     gp_Vec tempVector(a, b, c);
     tempVector.Normalize();  // just in case.
-    tempVector *= (d + 1.0);
+    tempVector *= (section.d + 1.0);
     gp_Pnt refPoint(0.0, 0.0, 0.0);
     refPoint.Translate(tempVector);
 
-    BRepPrimAPI_MakeHalfSpace mkSolid(TopoDS::Face(face.getShape()), refPoint);
-    TopoShape solid(idx);
-    std::string prefix(op);
-    prefix += Data::indexSuffix(idx);
-    solid.makeElementShape(mkSolid, face, prefix.c_str());
-    FCBRepAlgoAPI_Cut mkCut(shape.getShape(), solid.getShape());
+    section.mkSolid = std::make_unique<BRepPrimAPI_MakeHalfSpace>(section.face, refPoint);
+    section.mkCut = std::make_unique<FCBRepAlgoAPI_Cut>(tds, section.mkSolid->Solid());
+}
+
+void TopoCrossSection::sliceNonSolid(Section& section, std::vector<TopoShape>& wires) const
+{
+    auto& cs = *section.mkSection;
+    if (cs.IsDone()) {
+        auto res = TopoShape()
+                       .makeElementShape(cs, section.interval->shape, section.prefix.c_str())
+                       .makeElementWires()
+                       .getSubTopoShapes(TopAbs_WIRE);
+        wires.insert(wires.end(), res.begin(), res.end());
+    }
+}
+
+void TopoCrossSection::sliceSolid(Section& section, std::vector<TopoShape>& wires) const
+{
+    const TopoShape& shape = section.interval->shape;
+    const char* prefix = section.prefix.c_str();
+    gp_Pln slicePlane(a, b, c, -section.d);
+    TopoShape face(section.idx);
+    face.setShape(section.face);
+
+    TopoShape solid(section.idx);
+    solid.makeElementShape(*section.mkSolid, face, prefix);
+    auto& mkCut = *section.mkCut;
 
     if (mkCut.IsDone()) {
         TopoShape res(shape.Tag, shape.Hasher);
         std::vector<TopoShape> shapes;
         shapes.push_back(shape);
         shapes.push_back(solid);
-        res.makeElementShape(mkCut, shapes, prefix.c_str());
+        res.makeElementShape(mkCut, shapes, prefix);
         for (auto& face : res.getSubTopoShapes(TopAbs_FACE)) {
             BRepAdaptor_Surface adapt(TopoDS::Face(face.getShape()));
             if (adapt.GetType() == GeomAbs_Plane) {
@@ -312,7 +460,7 @@ void TopoCrossSection::sliceSolid(int idx,
                     && plane.Distance(slicePlane.Location()) < Precision::Confusion()) {
                     auto repaired_wires = TopoShape(face.Tag)
                                               .makeElementWires(face.getSubTopoShapes(TopAbs_EDGE),
-                                                                prefix.c_str(),
+                                                                prefix,
                                                                 true)
                                               .getSubTopoShapes(TopAbs_WIRE);
                     wires.insert(wires.end(), repaired_wires.begin(), repaired_wires.end());
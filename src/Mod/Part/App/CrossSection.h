@@ -24,6 +24,7 @@
 #define PART_CROSSSECTION_H
 
 #include <list>
+#include <vector>
 #include <TopTools_IndexedMapOfShape.hxx>
 #include <Mod/Part/PartGlobal.h>
 #include "TopoShape.h"
@@ -34,11 +35,32 @@ class TopoDS_Wire;
 
 namespace Part {
 
+/**
+ * The sub-shapes of a shape to be sliced, together with their extent along the
+ * slicing direction. It is computed once so that each section plane is only
+ * intersected with the sub-shapes it actually crosses.
+ */
+template<typename ShapeT>
+struct SliceInterval
+{
+    ShapeT shape;
+    bool solid;
+    double first;
+    double last;
+
+    bool contains(double d) const
+    {
+        return first <= d && d <= last;
+    }
+};
+
 class PartExport CrossSection
 {
 public:
     CrossSection(double a, double b, double c, const TopoDS_Shape& s);
     std::list<TopoDS_Wire> slice(double d) const;
+    /// Makes the slices at the given distances in parallel
+    std::vector<std::list<TopoDS_Wire>> slices(const std::vector<double>& d) const;
 
 private:
     void sliceNonSolid(double d, const TopoDS_Shape&, std::list<TopoDS_Wire>& wires) const;
@@ -51,6 +73,7 @@ private:
 private:
     double a,b,c;
     const TopoDS_Shape& s;
+    std::vector<SliceInterval<TopoDS_Shape>> intervals;
 };
 
 class PartExport TopoCrossSection
@@ -59,15 +82,26 @@ public:
     TopoCrossSection(double a, double b, double c, const TopoShape& s, const char* op = 0);
     void slice(int idx, double d, std::vector<TopoShape>& wires) const;
     TopoShape slice(int idx, double d) const;
+    /** Makes the slices at the given distances
+     *
+     * The section operations run in parallel, while the element maps of the
+     * results are built afterwards in the order of the distances. The slice
+     * at distances[i] uses the index i + 1.
+     */
+    void slices(const std::vector<double>& distances, std::vector<TopoShape>& wires) const;
 
 private:
-    void sliceNonSolid(int idx, double d, const TopoShape&, std::vector<TopoShape>& wires) const;
-    void sliceSolid(int idx, double d, const TopoShape&, std::vector<TopoShape>& wires) const;
+    struct Section;
+    void slices(int idx, const std::vector<double>& distances, std::vector<TopoShape>& wires) const;
+    void makeSection(Section& section) const;
+    void sliceNonSolid(Section& section, std::vector<TopoShape>& wires) const;
+    void sliceSolid(Section& section, std::vector<TopoShape>& wires) const;
 
 private:
     double a, b, c;
     const TopoShape& shape;
     const char* op;
+    std::vector<SliceInterval<TopoShape>> intervals;
 };
 
 }  // namespace Part
@@ -46,15 +46,21 @@
 
 // STL
 #include <array>
+#include <condition_variable>
+#include <deque>
 #include <fcntl.h>
 #include <fstream>
+#include <future>
 #include <list>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <vector>
 
 // Qt
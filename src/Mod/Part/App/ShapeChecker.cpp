@@ -0,0 +1,312 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <condition_variable>
+# include <deque>
+# include <future>
+# include <mutex>
+# include <thread>
+# include <BRepCheck_Analyzer.hxx>
+# include <BRepCheck_ListIteratorOfListOfStatus.hxx>
+# include <BRepCheck_Result.hxx>
+# include <Standard_Failure.hxx>
+# include <TopExp.hxx>
+# include <TopExp_Explorer.hxx>
+# include <TopTools_MapOfShape.hxx>
+#endif
+
+#include "ShapeChecker.h"
+#include "TopoShape.h"
+
+
+using namespace Part;
+
+ShapeChecker::ShapeChecker(const TopoDS_Shape& shape, TopAbs_ShapeEnum splitType)
+{
+    if (shape.IsNull()) {
+        return;
+    }
+
+    for (int type = TopAbs_COMPOUND; type < TopAbs_SHAPE; ++type) {
+        TopExp::MapShapes(shape, static_cast<TopAbs_ShapeEnum>(type), shapeMaps[type]);
+    }
+
+    auto addResult = [this](const TopoDS_Shape& subShape) {
+        Result result;
+        result.name = elementName(subShape);
+        result.shape = subShape;
+        results.push_back(result);
+    };
+
+    // Nothing to split
+    if (shape.ShapeType() >= splitType) {
+        addResult(shape);
+        return;
+    }
+
+    const auto& splitMap = shapeMaps[splitType];
+    for (int index = 1; index <= splitMap.Extent(); ++index) {
+        addResult(splitMap(index));
+    }
+
+    // Collect the free shapes of a lower type, i.e. shapes that are not part of the next
+    // higher type. Shapes that are part of the next higher type have already been added or
+    // are checked together with it.
+    TopTools_MapOfShape freeShapes;
+    for (int type = splitType + 1; type < TopAbs_SHAPE; ++type) {
+        auto toFind = static_cast<TopAbs_ShapeEnum>(type);
+        auto toAvoid = static_cast<TopAbs_ShapeEnum>(type - 1);
+        for (TopExp_Explorer xp(shape, toFind, toAvoid); xp.More(); xp.Next()) {
+            if (freeShapes.Add(xp.Current())) {
+                addResult(xp.Current());
+            }
+        }
+    }
+}
+
+void ShapeChecker::setThreadCount(int count)
+{
+    threadCount = count;
+}
+
+bool ShapeChecker::perform(const Callback& callback)
+{
+    std::size_t count = results.size();
+    std::size_t threads = threadCount > 0 ? std::size_t(threadCount)
+                                          : std::size_t(std::thread::hardware_concurrency());
+    threads = std::max<std::size_t>(1, std::min(threads, count));
+
+    std::atomic<std::size_t> next(0);
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<std::size_t> finished;
+    std::size_t running = threads;
+
+    auto worker = [&]() {
+        for (std::size_t index = next++; index < count && !aborted; index = next++) {
+            check(results[index]);
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.push_back(index);
+            condition.notify_one();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        --running;
+        condition.notify_one();
+    };
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        futures.push_back(std::async(std::launch::async, worker));
+    }
+
+    // Report the results in the calling thread as they come in
+    try {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            condition.wait(lock, [&]() {
+                return !finished.empty() || running == 0;
+            });
+            if (finished.empty()) {
+                break;
+            }
+            std::size_t index = finished.front();
+            finished.pop_front();
+            if (callback) {
+                lock.unlock();
+                bool proceed = callback(results[index]);
+                lock.lock();
+                if (!proceed) {
+                    aborted = true;
+                }
+            }
+        }
+    }
+    catch (...) {
+        aborted = true;
+        for (auto& future : futures) {
+            future.wait();
+        }
+        throw;
+    }
+
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    return !aborted;
+}
+
+void ShapeChecker::abort()
+{
+    aborted = true;
+}
+
+void ShapeChecker::reset()
+{
+    aborted = false;
+}
+
+bool ShapeChecker::isAborted() const
+{
+    return aborted;
+}
+
+bool ShapeChecker::isValid() const
+{
+    return std::all_of(results.begin(), results.end(), [](const Result& result) {
+        return result.checked && result.valid;
+    });
+}
+
+const std::vector<ShapeChecker::Result>& ShapeChecker::getResults() const
+{
+    return results;
+}
+
+std::string ShapeChecker::elementName(const TopoDS_Shape& shape) const
+{
+    TopAbs_ShapeEnum type = shape.ShapeType();
+    int index = shapeMaps[type].FindIndex(shape);
+    return TopoShape::shapeName(type) + std::to_string(index);
+}
+
+void ShapeChecker::check(Result& result) const
+{
+    try {
+        BRepCheck_Analyzer analyzer(result.shape);
+        result.valid = analyzer.IsValid();
+        if (!result.valid) {
+            for (int type = TopAbs_VERTEX; type >= TopAbs_COMPOUND; --type) {
+                TopTools_IndexedMapOfShape subShapes;
+                TopExp::MapShapes(result.shape, static_cast<TopAbs_ShapeEnum>(type), subShapes);
+                for (int index = 1; index <= subShapes.Extent(); ++index) {
+                    const TopoDS_Shape& subShape = subShapes(index);
+                    if (analyzer.IsValid(subShape)) {
+                        continue;
+                    }
+                    const Handle(BRepCheck_Result)& checkResult = analyzer.Result(subShape);
+                    if (checkResult.IsNull()) {
+                        continue;
+                    }
+                    BRepCheck_ListIteratorOfListOfStatus it(checkResult->StatusOnShape(subShape));
+                    for (; it.More(); it.Next()) {
+                        if (it.Value() != BRepCheck_NoError) {
+                            result.errors.push_back(elementName(subShape) + ": "
+                                                    + statusText(it.Value()));
+                        }
+                    }
+                }
+            }
+        }
+    }
+    catch (const Standard_Failure& e) {
+        result.valid = false;
+        result.errors.emplace_back(std::string("Check failed: ") + e.GetMessageString());
+    }
+    catch (...) {
+        result.valid = false;
+        result.errors.emplace_back(statusText(BRepCheck_CheckFail));
+    }
+    result.checked = true;
+}
+
+const char* ShapeChecker::statusText(BRepCheck_Status status)
+{
+    switch (status) {
+        case BRepCheck_NoError:
+            return "No error";
+        case BRepCheck_InvalidPointOnCurve:
+            return "Invalid point on curve";
+        case BRepCheck_InvalidPointOnCurveOnSurface:
+            return "Invalid point on curve on surface";
+        case BRepCheck_InvalidPointOnSurface:
+            return "Invalid point on surface";
+        case BRepCheck_No3DCurve:
+            return "No 3D curve";
+        case BRepCheck_Multiple3DCurve:
+            return "Multiple 3D curve";
+        case BRepCheck_Invalid3DCurve:
+            return "Invalid 3D curve";
+        case BRepCheck_NoCurveOnSurface:
+            return "No curve on surface";
+        case BRepCheck_InvalidCurveOnSurface:
+            return "Invalid curve on surface";
+        case BRepCheck_InvalidCurveOnClosedSurface:
+            return "Invalid curve on closed surface";
+        case BRepCheck_InvalidSameRangeFlag:
+            return "Invalid same-range flag";
+        case BRepCheck_InvalidSameParameterFlag:
+            return "Invalid same-parameter flag";
+        case BRepCheck_InvalidDegeneratedFlag:
+            return "Invalid degenerated flag";
+        case BRepCheck_FreeEdge:
+            return "Free edge";
+        case BRepCheck_InvalidMultiConnexity:
+            return "Invalid multi-connexity";
+        case BRepCheck_InvalidRange:
+            return "Invalid range";
+        case BRepCheck_EmptyWire:
+            return "Empty wire";
+        case BRepCheck_RedundantEdge:
+            return "Redundant edge";
+        case BRepCheck_SelfIntersectingWire:
+            return "Self-intersecting wire";
+        case BRepCheck_NoSurface:
+            return "No surface";
+        case BRepCheck_InvalidWire:
+            return "Invalid wires";
+        case BRepCheck_RedundantWire:
+            return "Redundant wires";
+        case BRepCheck_IntersectingWires:
+            return "Intersecting wires";
+        case BRepCheck_InvalidImbricationOfWires:
+            return "Invalid imbrication of wires";
+        case BRepCheck_EmptyShell:
+            return "Empty shell";
+        case BRepCheck_RedundantFace:
+            return "Redundant face";
+        case BRepCheck_UnorientableShape:
+            return "Unorientable shape";
+        case BRepCheck_NotClosed:
+            return "Not closed";
+        case BRepCheck_NotConnected:
+            return "Not connected";
+        case BRepCheck_SubshapeNotInShape:
+            return "Sub-shape not in shape";
+        case BRepCheck_BadOrientation:
+            return "Bad orientation";
+        case BRepCheck_BadOrientationOfSubshape:
+            return "Bad orientation of sub-shape";
+        case BRepCheck_InvalidToleranceValue:
+            return "Invalid tolerance value";
+        case BRepCheck_CheckFail:
+            return "Check failed";
+        default:
+            return "Undetermined error";
+    }
+}
@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef PART_SHAPECHECKER_H
+#define PART_SHAPECHECKER_H
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <BRepCheck_Status.hxx>
+#include <TopAbs_ShapeEnum.hxx>
+#include <TopoDS_Shape.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+
+#include <Mod/Part/PartGlobal.h>
+
+
+namespace Part
+{
+
+/**
+ * The ShapeChecker class checks the validity of a shape by splitting it into sub-shapes
+ * of a given type (solids by default) and analyzing them independently on several threads.
+ * Free shapes of a lower type that are not part of such a sub-shape are checked on their
+ * own. Checks that span several of the sub-shapes, e.g. whether a shell is closed when
+ * splitting into faces, are not done.
+ */
+class PartExport ShapeChecker
+{
+public:
+    struct Result
+    {
+        /// The element name of the checked sub-shape, e.g. Solid2 or Face12
+        std::string name;
+        TopoDS_Shape shape;
+        bool checked = false;
+        bool valid = true;
+        /// One entry per error, e.g. "Edge3: Free edge"
+        std::vector<std::string> errors;
+    };
+
+    /// Called in the thread of perform() whenever a sub-shape is checked.
+    /// Returning false aborts the check.
+    using Callback = std::function<bool(const Result&)>;
+
+    explicit ShapeChecker(const TopoDS_Shape& shape, TopAbs_ShapeEnum splitType = TopAbs_SOLID);
+
+    /// Sets the number of threads. A value <= 0 uses all available cores.
+    void setThreadCount(int count);
+    /// Checks all sub-shapes and returns false if it has been aborted.
+    bool perform(const Callback& callback = Callback());
+    /// Stops the check. Can be called from any thread, also before perform() has started.
+    void abort();
+    /// Clears the abort flag so that perform() can be called again.
+    void reset();
+    bool isAborted() const;
+    /// Returns true if all sub-shapes have been checked and are valid.
+    bool isValid() const;
+    const std::vector<Result>& getResults() const;
+
+    static const char* statusText(BRepCheck_Status status);
+
+private:
+    std::string elementName(const TopoDS_Shape& shape) const;
+    void check(Result& result) const;
+
+private:
+    std::vector<Result> results;
+    std::array<TopTools_IndexedMapOfShape, TopAbs_SHAPE> shapeMaps;
+    std::atomic<bool> aborted {false};
+    int threadCount = 0;
+};
+
+}  // namespace Part
+
+#endif  // PART_SHAPECHECKER_H
@@ -180,6 +180,7 @@
 #include "Interface.h"
 #include "modelRefine.h"
 #include "PartPyCXX.h"
+#include "ShapeChecker.h"
 #include "ProgressIndicator.h"
 #include "Tools.h"
 #include "TopoShapeCompoundPy.h"
@@ -1480,116 +1481,7 @@ bool TopoShape::analyze(bool runBopCheck, std::ostream& str) const
 
                     BRepCheck_ListIteratorOfListOfStatus it(status);
                     while (it.More()) {
-                        BRepCheck_Status& val = it.Value();
-                        switch (val)
-                        {
-                        case BRepCheck_NoError:
-                            str << "No error" << std::endl;
-                            break;
-                        case BRepCheck_InvalidPointOnCurve:
-                            str << "Invalid point on curve" << std::endl;
-                            break;
-                        case BRepCheck_InvalidPointOnCurveOnSurface:
-                            str << "Invalid point on curve on surface" << std::endl;
-                            break;
-                        case BRepCheck_InvalidPointOnSurface:
-                            str << "Invalid point on surface" << std::endl;
-                            break;
-                        case BRepCheck_No3DCurve:
-                            str << "No 3D curve" << std::endl;
-                            break;
-                        case BRepCheck_Multiple3DCurve:
-                            str << "Multiple 3D curve" << std::endl;
-                            break;
-                        case BRepCheck_Invalid3DCurve:
-                            str << "Invalid 3D curve" << std::endl;
-                            break;
-                        case BRepCheck_NoCurveOnSurface:
-                            str << "No curve on surface" << std::endl;
-                            break;
-                        case BRepCheck_InvalidCurveOnSurface:
-                            str << "Invalid curve on surface" << std::endl;
-                            break;
-                        case BRepCheck_InvalidCurveOnClosedSurface:
-                            str << "Invalid curve on closed surface" << std::endl;
-                            break;
-                        case BRepCheck_InvalidSameRangeFlag:
-                            str << "Invalid same-range flag" << std::endl;
-                            break;
-                        case BRepCheck_InvalidSameParameterFlag:
-                            str << "Invalid same-parameter flag" << std::endl;
-                            break;
-                        case BRepCheck_InvalidDegeneratedFlag:
-                            str << "Invalid degenerated flag" << std::endl;
-                            break;
-                        case BRepCheck_FreeEdge:
-                            str << "Free edge" << std::endl;
-                            break;
-                        case BRepCheck_InvalidMultiConnexity:
-                            str << "Invalid multi-connexity" << std::endl;
-                            break;
-                        case BRepCheck_InvalidRange:
-                            str << "Invalid range" << std::endl;
-                            break;
-                        case BRepCheck_EmptyWire:
-                            str << "Empty wire" << std::endl;
-                            break;
-                        case BRepCheck_RedundantEdge:
-                            str << "Redundant edge" << std::endl;
-                            break;
-                        case BRepCheck_SelfIntersectingWire:
-                            str << "Self-intersecting wire" << std::endl;
-                            break;
-                        case BRepCheck_NoSurface:
-                            str << "No surface" << std::endl;
-                            break;
-                        case BRepCheck_InvalidWire:
-                            str << "Invalid wires" << std::endl;
-                            break;
-                        case BRepCheck_RedundantWire:
-                            str << "Redundant wires" << std::endl;
-                            break;
-                        case BRepCheck_IntersectingWires:
-                            str << "Intersecting wires" << std::endl;
-                            break;
-                        case BRepCheck_InvalidImbricationOfWires:
-                            str << "Invalid imbrication of wires" << std::endl;
-                            break;
-                        case BRepCheck_EmptyShell:
-                            str << "Empty shell" << std::endl;
-                            break;
-                        case BRepCheck_RedundantFace:
-                            str << "Redundant face" << std::endl;
-                            break;
-                        case BRepCheck_UnorientableShape:
-                            str << "Unorientable shape" << std::endl;
-                            break;
-                        case BRepCheck_NotClosed:
-                            str << "Not closed" << std::endl;
-                            break;
-                        case BRepCheck_NotConnected:
-                            str << "Not connected" << std::endl;
-                            break;
-                        case BRepCheck_SubshapeNotInShape:
-                            str << "Sub-shape not in shape" << std::endl;
-                            break;
-                        case BRepCheck_BadOrientation:
-                            str << "Bad orientation" << std::endl;
-                            break;
-                        case BRepCheck_BadOrientationOfSubshape:
-                            str << "Bad orientation of sub-shape" << std::endl;
-                            break;
-                        case BRepCheck_InvalidToleranceValue:
-                            str << "Invalid tolerance value" << std::endl;
-                            break;
-                        case BRepCheck_CheckFail:
-                            str << "Check failed" << std::endl;
-                            break;
-                        default:
-                            str << "Undetermined error" << std::endl;
-                            break;
-                        }
-
+                        str << ShapeChecker::statusText(it.Value()) << std::endl;
                         it.Next();
                     }
                 }
@@ -1876,11 +1768,8 @@ std::list<TopoDS_Wire> TopoShape::slice(const Base::Vector3d& dir, double d) con
 
 TopoDS_Compound TopoShape::slices(const Base::Vector3d& dir, const std::vector<double>& d) const
 {
-    std::vector< std::list<TopoDS_Wire> > wire_list;
     CrossSection cs(dir.x, dir.y, dir.z, this->_Shape);
-    for (double jt : d) {
-        wire_list.push_back(cs.slice(jt));
-    }
+    std::vector< std::list<TopoDS_Wire> > wire_list = cs.slices(d);
 
     std::vector< std::list<TopoDS_Wire> >::const_iterator ft;
     TopoDS_Compound comp;
@@ -23,10 +23,128 @@
  ***************************************************************************/
 
 #include "PreCompiled.h"
+#include "ShapeMapHasher.h"
 #include "TopoShapeCache.h"
 
 using namespace Part;
 
+namespace
+{
+struct ShapeMapsRegistry
+{
+    using Key = std::tuple<const TopoDS_TShape*, TopAbs_Orientation, std::size_t>;
+
+    std::mutex mutex;
+    std::map<Key, std::weak_ptr<TopoShapeCache::ShapeMaps>> maps;
+
+    static ShapeMapsRegistry& instance()
+    {
+        // Never destroyed, as shapes may still be released during static destruction
+        static auto* registry = new ShapeMapsRegistry;
+        return *registry;
+    }
+
+    static Key key(const TopoDS_Shape& tds, std::size_t stamp)
+    {
+        return {tds.TShape().get(), tds.Orientation(), stamp};
+    }
+};
+
+void combineHash(std::size_t& hash, std::size_t value)
+{
+    hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+}
+
+void stampSubShapes(const TopoDS_Shape& tds, const ShapeMapHasher& hasher, std::size_t& hash)
+{
+    for (TopoDS_Iterator it(tds, false, false); it.More(); it.Next()) {
+        combineHash(hash, hasher(it.Value()) * 4 + std::size_t(it.Value().Orientation()));
+        stampSubShapes(it.Value(), hasher, hash);
+    }
+    // Mark the end of the children so that the same sub-shapes at another level differ
+    combineHash(hash, 1);
+}
+
+/// Hash of the TShape, location and orientation of all sub-shapes at any level. OCCT keeps
+/// no modification counter on a TShape, so this is what changes when sub-shapes are added,
+/// removed or replaced in place.
+std::size_t stampSubShapes(const TopoDS_Shape& tds)
+{
+    std::size_t hash = 0;
+    stampSubShapes(tds, ShapeMapHasher(), hash);
+    return hash;
+}
+}  // namespace
+
+std::shared_ptr<TopoShapeCache::ShapeMaps> TopoShapeCache::ShapeMaps::get(const TopoDS_Shape& tds)
+{
+    if (tds.IsNull()) {
+        return std::make_shared<ShapeMaps>(tds);
+    }
+
+    // The stamp is computed before locking, a shape modified in place gets a new entry while
+    // the maps of the old state stay with their current users
+    std::size_t stamp = stampSubShapes(tds);
+    auto& registry = ShapeMapsRegistry::instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto& entry = registry.maps[ShapeMapsRegistry::key(tds, stamp)];
+    auto maps = entry.lock();
+    if (!maps) {
+        maps = std::make_shared<ShapeMaps>(tds, stamp);
+        entry = maps;
+    }
+    return maps;
+}
+
+TopoShapeCache::ShapeMaps::ShapeMaps(const TopoDS_Shape& tds, std::size_t stamp)
+    : shape(tds.Located(TopLoc_Location()))
+    , stamp(stamp)
+{}
+
+TopoShapeCache::ShapeMaps::~ShapeMaps()
+{
+    if (shape.IsNull()) {
+        return;
+    }
+    auto& registry = ShapeMapsRegistry::instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.maps.find(ShapeMapsRegistry::key(shape, stamp));
+    // The entry may have been replaced in the meantime
+    if (it != registry.maps.end() && it->second.expired()) {
+        registry.maps.erase(it);
+    }
+}
+
+const TopTools_IndexedMapOfShape& TopoShapeCache::ShapeMaps::getShapes(TopAbs_ShapeEnum type)
+{
+    std::call_once(shapesFlags.at(type), [this, type]() {
+        if (shape.IsNull()) {
+            return;
+        }
+        if (type == TopAbs_SHAPE) {
+            for (TopoDS_Iterator it(shape); it.More(); it.Next()) {
+                shapes[type].Add(it.Value());
+            }
+        }
+        else {
+            TopExp::MapShapes(shape, type, shapes[type]);
+        }
+    });
+    return shapes[type];
+}
+
+const TopTools_IndexedDataMapOfShapeListOfShape&
+TopoShapeCache::ShapeMaps::getAncestors(TopAbs_ShapeEnum subType, TopAbs_ShapeEnum type)
+{
+    auto& ancestorMap = ancestors.at(type).at(subType);
+    std::call_once(ancestorsFlags[type][subType], [this, subType, type, &ancestorMap]() {
+        if (!shape.IsNull()) {
+            TopExp::MapShapesAndAncestors(shape, subType, type, ancestorMap);
+        }
+    });
+    return ancestorMap;
+}
+
 ShapeRelationKey::ShapeRelationKey(Data::MappedName name, HistoryTraceType historyTraceType)
     : name(std::move(name))
     , historyTraceType(historyTraceType)
@@ -44,7 +162,7 @@ TopoShape TopoShapeCache::Ancestry::_getTopoShape(const TopoShape& parent, int i
 {
     auto& ts = topoShapes[index - 1];
     if (ts.isNull()) {
-        ts.setShape(shapes.FindKey(index), true);
+        ts.setShape(shapes->FindKey(index), true);
         ts.initCache();
         ts._cache->subLocation = ts._Shape.Location();
     }
@@ -98,20 +216,20 @@ void TopoShapeCache::Ancestry::clear()
 TopoShape TopoShapeCache::Ancestry::getTopoShape(const TopoShape& parent, int index)
 {
     TopoShape res;
-    if (index <= 0 || index > shapes.Extent()) {
+    if (index <= 0 || index > count()) {
         return res;
     }
-    topoShapes.resize(shapes.Extent());
+    topoShapes.resize(count());
     return _getTopoShape(parent, index);
 }
 
 std::vector<TopoShape> TopoShapeCache::Ancestry::getTopoShapes(const TopoShape& parent)
 {
-    int count = shapes.Extent();
+    int shapeCount = count();
     std::vector<TopoShape> res;
-    res.reserve(count);
-    topoShapes.resize(count);
-    for (int i = 1; i <= count; ++i) {
+    res.reserve(shapeCount);
+    topoShapes.resize(shapeCount);
+    for (int i = 1; i <= shapeCount; ++i) {
         res.push_back(_getTopoShape(parent, i));
     }
     return res;
@@ -129,26 +247,29 @@ TopoDS_Shape TopoShapeCache::Ancestry::stripLocation(const TopoDS_Shape& parent,
 
 int TopoShapeCache::Ancestry::find(const TopoDS_Shape& parent, const TopoDS_Shape& subShape)
 {
+    if (!shapes) {
+        return 0;
+    }
     if (parent.Location().IsIdentity()) {
-        return shapes.FindIndex(subShape);
+        return shapes->FindIndex(subShape);
     }
-    return shapes.FindIndex(stripLocation(parent, subShape));
+    return shapes->FindIndex(stripLocation(parent, subShape));
 }
 
 TopoDS_Shape TopoShapeCache::Ancestry::find(const TopoDS_Shape& parent, int index)
 {
-    if (index <= 0 || index > shapes.Extent()) {
+    if (index <= 0 || index > count()) {
         return {};
     }
     if (parent.Location().IsIdentity()) {
-        return shapes.FindKey(index);
+        return shapes->FindKey(index);
     }
-    return TopoShape::moved(shapes.FindKey(index), parent.Location());
+    return TopoShape::moved(shapes->FindKey(index), parent.Location());
 }
 
 int TopoShapeCache::Ancestry::count() const
 {
-    return shapes.Extent();
+    return shapes ? shapes->Extent() : 0;
 }
 
 
@@ -156,6 +277,14 @@ TopoShapeCache::TopoShapeCache(const TopoDS_Shape& tds)
     : shape(tds.Located(TopLoc_Location()))
 {}
 
+const std::shared_ptr<TopoShapeCache::ShapeMaps>& TopoShapeCache::getShapeMaps()
+{
+    if (!shapeMaps) {
+        shapeMaps = ShapeMaps::get(shape);
+    }
+    return shapeMaps;
+}
+
 void TopoShapeCache::insertRelation(const ShapeRelationKey& key,
                                     const QVector<Data::MappedElement>& value)
 {
@@ -178,16 +307,7 @@ TopoShapeCache::Ancestry& TopoShapeCache::getAncestry(TopAbs_ShapeEnum type)
     auto& ancestry = shapeAncestryCache.at(type);
     if (!ancestry.owner) {
         ancestry.owner = this;
-        if (!shape.IsNull()) {
-            if (type == TopAbs_SHAPE) {
-                for (TopoDS_Iterator it(shape); it.More(); it.Next()) {
-                    ancestry.shapes.Add(it.Value());
-                }
-            }
-            else {
-                TopExp::MapShapes(shape, type, ancestry.shapes);
-            }
-        }
+        ancestry.shapes = &getShapeMaps()->getShapes(type);
     }
     return ancestry;
 }
@@ -228,19 +348,14 @@ TopoDS_Shape TopoShapeCache::findAncestor(const TopoDS_Shape& parent,
 
     auto& info = getAncestry(type);
 
-    auto& ancestorInfo = info.ancestors.at(subShape.ShapeType());
-    if (!ancestorInfo.initialized) {
-        ancestorInfo.initialized = true;
-        // ancestorInfo.shapes is the output variable here, storing (and caching) the actual map
-        TopExp::MapShapesAndAncestors(shape, subShape.ShapeType(), type, ancestorInfo.shapes);
-    }
+    const auto& ancestorMap = getShapeMaps()->getAncestors(subShape.ShapeType(), type);
     int index = parent.Location().IsIdentity()
-        ? ancestorInfo.shapes.FindIndex(subShape)
-        : ancestorInfo.shapes.FindIndex(info.stripLocation(parent, subShape));
+        ? ancestorMap.FindIndex(subShape)
+        : ancestorMap.FindIndex(info.stripLocation(parent, subShape));
     if (index == 0) {
         return nullShape;
     }
-    const auto& shapes = ancestorInfo.shapes.FindFromIndex(index);
+    const auto& shapes = ancestorMap.FindFromIndex(index);
     if (shapes.Extent() == 0) {
         return nullShape;
     }
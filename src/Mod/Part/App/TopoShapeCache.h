@@ -37,6 +37,10 @@
 #include <TopExp.hxx>
 #include <TopExp_Explorer.hxx>
 #include <TopTools_ListIteratorOfListOfShape.hxx>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <tuple>
 #include <utility>
 #endif
 
@@ -59,6 +63,49 @@ struct PartExport ShapeRelationKey
 class PartExport TopoShapeCache: public std::enable_shared_from_this<TopoShapeCache>
 {
 public:
+    /// Sub-shape and ancestor maps of a location-less TopoDS_Shape. They only depend on the
+    /// TShape, its sub-shapes and the orientation of the shape, so they are shared by the caches of all TopoShape
+    /// instances referring to it, e.g. copies with a different placement or a shape re-created
+    /// by a recompute of a feature. The maps are built on first use and can be safely queried
+    /// from several threads.
+    class PartExport ShapeMaps
+    {
+    public:
+        /// Returns the shared maps of the given shape, creating them if needed
+        static std::shared_ptr<ShapeMaps> get(const TopoDS_Shape& tds);
+
+        explicit ShapeMaps(const TopoDS_Shape& tds, std::size_t stamp = 0);
+        ~ShapeMaps();
+
+        ShapeMaps(const ShapeMaps&) = delete;
+        ShapeMaps(ShapeMaps&&) = delete;
+        ShapeMaps& operator=(const ShapeMaps&) = delete;
+        ShapeMaps& operator=(ShapeMaps&&) = delete;
+
+        /// Sub-shapes of the given type. For TopAbs_SHAPE the direct children are returned.
+        const TopTools_IndexedMapOfShape& getShapes(TopAbs_ShapeEnum type);
+
+        /// Map from sub-shapes of type subType to their ancestors of the given type
+        const TopTools_IndexedDataMapOfShapeListOfShape& getAncestors(TopAbs_ShapeEnum subType,
+                                                                      TopAbs_ShapeEnum type);
+
+    private:
+        TopoDS_Shape shape;
+        /** Hash over the sub-shapes at all levels when the maps were registered. It is part
+         * of the registry key together with the TShape and orientation, so that a shape
+         * modified in place gets new maps.
+         */
+        std::size_t stamp = 0;
+
+        std::array<std::once_flag, TopAbs_SHAPE + 1> shapesFlags;
+        std::array<TopTools_IndexedMapOfShape, TopAbs_SHAPE + 1> shapes;
+
+        std::array<std::array<std::once_flag, TopAbs_SHAPE>, TopAbs_SHAPE> ancestorsFlags;
+        std::array<std::array<TopTools_IndexedDataMapOfShapeListOfShape, TopAbs_SHAPE>,
+                   TopAbs_SHAPE>
+            ancestors;
+    };
+
     /// Reference counted element map for the owner TopoShape. The ElementMap of
     /// a TopoShape is normally accessed through the inherited member function
     /// ComplexGeoData::elementMap(). The extra shared pointer here is so that
@@ -79,11 +126,9 @@ public:
     /// Inverse of location
     TopLoc_Location locationInverse;
 
-    struct PartExport AncestorInfo
-    {
-        bool initialized = false;
-        TopTools_IndexedDataMapOfShapeListOfShape shapes;
-    };
+    /// Sub-shape and ancestor maps shared with other caches of the same shape, looked up
+    /// on first use by getShapeMaps()
+    std::shared_ptr<ShapeMaps> shapeMaps;
 
     /// Class for caching the ancestor and children shapes mapping
     class PartExport Ancestry
@@ -92,18 +137,12 @@ public:
         TopoShapeCache* owner = nullptr;
 
         /// OCCT map from the owner TopoShape to a list of children (i.e. lower hierarchical)
-        /// TopoDS_Shape
-        TopTools_IndexedMapOfShape shapes;
+        /// TopoDS_Shape, owned by the shared ShapeMaps of the owner
+        const TopTools_IndexedMapOfShape* shapes = nullptr;
 
         /// One-to-one corresponding TopoShape to each child TopoDS_Shape
         std::vector<TopoShape> topoShapes;
 
-        /// Caches the OCCT ancestor shape maps, e.g.
-        ///     Cache::shapeAncestryCache[TopAbs_FACE].ancestors[TopAbs_EDGE]
-        /// stores an OCCT TopTools_IndexedDataMapOfShapeListOfShape that can return a list of
-        /// faces containing a given edge.
-        std::array<AncestorInfo, TopAbs_SHAPE + 1> ancestors;
-
         TopoShape _getTopoShape(const TopoShape& parent, int index);
 
     public:
@@ -121,14 +160,19 @@ public:
     explicit TopoShapeCache(const TopoDS_Shape& tds);
     void insertRelation(const ShapeRelationKey& key, const QVector<Data::MappedElement>& value);
     bool isTouched(const TopoDS_Shape& tds) const;
+
+    /// Returns the shared sub-shape and ancestor maps, looking them up on first use
+    const std::shared_ptr<ShapeMaps>& getShapeMaps();
+
     Ancestry& getAncestry(TopAbs_ShapeEnum type);
     int countShape(TopAbs_ShapeEnum type);
     int findShape(const TopoDS_Shape& parent, const TopoDS_Shape& subShape);
     TopoDS_Shape findShape(const TopoDS_Shape& parent, TopAbs_ShapeEnum type, int index);
 
     /// Given a parent shape and a child (sub) shape, call TopExp::MapShapesAndAncestors and cache
-    /// the result. Subsequent calls to this method given unchanged geometry will use the cached
-    /// data rather than re-running MapShapesAndAncestors.
+    /// the result. Subsequent calls to this method given unchanged geometry, including calls on
+    /// other caches of the same shape, will use the cached data rather than re-running
+    /// MapShapesAndAncestors.
     /// If ancestors is given, it is cleared and overwritten with the ancestry data.
     TopoDS_Shape findAncestor(const TopoDS_Shape& parent,
                               const TopoDS_Shape& subShape,
@@ -3929,10 +3929,7 @@ TopoShape& TopoShape::makeElementSlices(const TopoShape& shape,
 {
     std::vector<TopoShape> wires;
     TopoCrossSection cs(dir.x, dir.y, dir.z, shape, op);
-    int index = 0;
-    for (auto& distance : distances) {
-        cs.slice(++index, distance, wires);
-    }
+    cs.slices(distances, wires);
     return makeElementCompound(wires, op, SingleShapeCompoundCreationPolicy::returnShape);
 }
 
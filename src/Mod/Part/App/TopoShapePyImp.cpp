@@ -95,6 +95,7 @@
 
 #include "OCCError.h"
 #include "PartPyCXX.h"
+#include "ShapeChecker.h"
 #include "ShapeMapHasher.h"
 #include "TopoShapeMapper.h"
 
@@ -673,6 +674,70 @@ PyObject*  TopoShapePy::check(PyObject *args)
     Py_Return;
 }
 
+namespace {
+Py::Tuple checkResultToPy(const ShapeChecker::Result& result)
+{
+    Py::List errors;
+    for (const auto& error : result.errors) {
+        errors.append(Py::String(error));
+    }
+    return Py::TupleN(Py::String(result.name), Py::Boolean(result.valid), errors);
+}
+}
+
+PyObject* TopoShapePy::checkParallel(PyObject *args, PyObject *keywds)
+{
+    static const std::array<const char *, 4> kwlist{"splitType", "callback", "threads", nullptr};
+
+    const char* splitType = "Solid";
+    PyObject* callback = Py_None;
+    int threads = 0;
+    if (!Base::Wrapped_ParseTupleAndKeywords(args, keywds, "|sOi", kwlist,
+                                             &splitType, &callback, &threads)) {
+        return nullptr;
+    }
+
+    if (callback != Py_None && !PyCallable_Check(callback)) {
+        PyErr_SetString(PyExc_TypeError, "callback must be callable");
+        return nullptr;
+    }
+
+    PY_TRY {
+        TopAbs_ShapeEnum type = TopoShape::shapeType(splitType);
+        ShapeChecker checker(getTopoShapePtr()->getShape(), type);
+        checker.setThreadCount(threads);
+
+        // The callback is invoked in this thread, so no need to release the GIL in between
+        bool pyError = false;
+        checker.perform([&](const ShapeChecker::Result& result) {
+            if (callback == Py_None) {
+                return true;
+            }
+            try {
+                Py::Callable func(callback);
+                Py::Object ret = func.apply(checkResultToPy(result));
+                return ret.isNone() || ret.isTrue();
+            }
+            catch (Py::Exception&) {
+                pyError = true;
+                return false;
+            }
+        });
+
+        if (pyError) {
+            return nullptr;
+        }
+
+        Py::List list;
+        for (const auto& result : checker.getResults()) {
+            if (result.checked) {
+                list.append(checkResultToPy(result));
+            }
+        }
+        return Py::new_reference_to(list);
+    } PY_CATCH_OCC
+}
+
 static PyObject *makeShape(const char *op,const TopoShape &shape, PyObject *args) {
     double tol=0;
     PyObject *pcObj;
@@ -43,6 +43,7 @@
 # include <GeomAdaptor_Curve.hxx>
 # include <GeomLProp_CLProps.hxx>
 # include <GProp_GProps.hxx>
+# include <OSD_Parallel.hxx>
 # include <ShapeAnalysis_Wire.hxx>
 # include <ShapeFix_ShapeTolerance.hxx>
 # include <ShapeExtend_WireData.hxx>
@@ -51,6 +52,7 @@
 # include <TopExp.hxx>
 # include <TopExp_Explorer.hxx>
 # include <TopTools_HSequenceOfShape.hxx>
+# include <TopTools_MapOfShape.hxx>
 #endif
 
 #include <BRepTools_History.hxx>
@@ -1000,7 +1002,11 @@ public:
         }
     };
 
-    void checkSelfIntersection(const EdgeInfo &info, std::set<IntersectInfo> &params) const
+    // The check functions below only record the intersections in the order they are found.
+    // splitEdges() merges them afterwards, so that the checks can run concurrently.
+    using IntersectArray = std::vector<IntersectInfo>;
+
+    void checkSelfIntersection(const EdgeInfo &info, IntersectArray &params) const
     {
         // Early return if checking for self intersection (only for non linear spline curves)
         if (info.type <= GeomAbs_Parabola || info.isLinear) {
@@ -1035,8 +1041,8 @@ public:
 
         assert(points2d.Length() == points3d.Length());
         for (int i=1; i<=points2d.Length(); ++i) {
-            params.emplace(points2d(i).ParamOnFirst(), points3d(i), info.edge);
-            params.emplace(points2d(i).ParamOnSecond(), points3d(i), info.edge);
+            params.emplace_back(points2d(i).ParamOnFirst(), points3d(i), info.edge);
+            params.emplace_back(points2d(i).ParamOnSecond(), points3d(i), info.edge);
         }
     }
 
@@ -1044,8 +1050,8 @@ public:
     // cognitive complexity
     bool checkIntersectionPlanar(const EdgeInfo& info,
                                  const EdgeInfo& other,
-                                 std::set<IntersectInfo>& params1,
-                                 std::set<IntersectInfo>& params2)
+                                 IntersectArray& params1,
+                                 IntersectArray& params2)
     {
         gp_Pln pln;
         bool planar = TopoShape(info.edge).findPlane(pln);
@@ -1069,11 +1075,11 @@ public:
                     auto s2 = extss.SupportOnShape2(i);
                     if (s1.ShapeType() == TopAbs_EDGE) {
                         extss.ParOnEdgeS1(i, par);
-                        pushIntersection(params1, par, extss.PointOnShape1(i), other.edge);
+                        params1.emplace_back(par, extss.PointOnShape1(i), other.edge);
                     }
                     if (s2.ShapeType() == TopAbs_EDGE) {
                         extss.ParOnEdgeS2(i, par);
-                        pushIntersection(params2, par, extss.PointOnShape2(i), info.edge);
+                        params2.emplace_back(par, extss.PointOnShape2(i), info.edge);
                     }
                 }
                 return false;
@@ -1168,8 +1174,8 @@ public:
 
     void checkIntersection(const EdgeInfo &info,
                            const EdgeInfo &other,
-                           std::set<IntersectInfo> &params1,
-                           std::set<IntersectInfo> &params2)
+                           IntersectArray &params1,
+                           IntersectArray &params2)
     {
         if(!checkIntersectionPlanar(info, other, params1, params2)){
             return;
@@ -1205,8 +1211,8 @@ public:
 
         assert(points2d.Length() == points3d.Length());
         for (int i=1; i<=points2d.Length(); ++i) {
-            pushIntersection(params1, points2d(i).ParamOnFirst(), points3d(i), other.edge);
-            pushIntersection(params2, points2d(i).ParamOnSecond(), points3d(i), info.edge);
+            params1.emplace_back(points2d(i).ParamOnFirst(), points3d(i), other.edge);
+            params2.emplace_back(points2d(i).ParamOnSecond(), points3d(i), info.edge);
         }
     }
 
@@ -1292,83 +1298,255 @@ public:
         }
     }
 
-    // Try splitting any edges that intersects other edge
-    void splitEdges()
+    struct PairCheck {
+        const EdgeInfo* other;
+        IntersectArray params1;
+        IntersectArray params2;
+    };
+
+    struct EdgeCheck {
+        IntersectArray params;
+        std::vector<PairCheck> pairs;
+    };
+
+    bool canRunParallel() const
     {
-        std::unordered_map<const EdgeInfo*, std::set<IntersectInfo>> intersects;
+        // showShape() creates document objects, which must only happen in the main thread
+        return !canShowShape()
+            && App::GetApplication()
+                   .GetParameterGroupByPath("User parameter:BaseApp/Preferences/WireJoiner")
+                   ->GetBool("Parallel", true);
+    }
 
-        int idx=0;
-        for (auto& info : edges) {
-            info.iteration = ++idx;
+    // This method was originally part of WireJoinerP::splitEdges(), split to reduce cognitive
+    // complexity
+    void splitEdgesCandidates(const EdgeInfo& info, EdgeCheck& check) const
+    {
+        for (auto vit = boxMap.qbegin(bgi::intersects(info.box)); vit != boxMap.qend(); ++vit) {
+            const auto& other = *(*vit);
+            if (other.iteration <= info.iteration) {
+                // means the edge is before us, and we will check intersection from the other side
+                continue;
+            }
+            check.pairs.push_back({&other, {}, {}});
         }
+    }
 
-        std::unique_ptr<Base::SequencerLauncher> seq(
-                new Base::SequencerLauncher("Splitting edges", edges.size()));
+    static bool canSelfIntersect(const EdgeInfo& info)
+    {
+        return info.type > GeomAbs_Parabola && !info.isLinear;
+    }
 
-        idx = 0;
-        for (auto& info : edges) {
-            seq->next(true);
-            ++idx;
-            auto &params = intersects[&info];
-            checkSelfIntersection(info, params);
-
-            for (auto vit=boxMap.qbegin(bgi::intersects(info.box)); vit!=boxMap.qend(); ++vit) {
-                const auto &other = *(*vit);
-                if (other.iteration <= idx) {
-                    // means the edge is before us, and we've already checked intersection
-                    continue;
-                }
-                checkIntersection(info, other, params, intersects[&other]);
-            }
+    // This method was originally part of WireJoinerP::splitEdges(), split to reduce cognitive
+    // complexity
+    void splitEdgesCheck(const EdgeInfo& info, EdgeCheck& check)
+    {
+        splitEdgesCandidates(info, check);
+        checkSelfIntersection(info, check.params);
+        for (auto& pair : check.pairs) {
+            checkIntersection(info, *pair.other, pair.params1, pair.params2);
         }
+    }
 
-        idx=0;
-        std::vector<SplitInfo> splits;
-        for (auto it=edges.begin(); it!=edges.end(); ) {
-            ++idx;
-            auto iter = intersects.find(&(*it));
-            if (iter == intersects.end()) {
-                ++it;
-                continue;
-            }
-            auto &info = *it;
-            auto &params = iter->second;
-            if (params.empty()) {
-                ++it;
-                continue;
+    // Checks the edges [begin, end) in a worker thread. The intersection checks build wires and
+    // faces from the edges, which may update the tolerance and pcurves of the input. So, the
+    // worker copies all edges it needs once, keeping the vertices they share, and runs the checks
+    // on the copies. The copies share the geometry with the input, which is only read.
+    void splitEdgesCheckRange(const std::vector<Edges::iterator>& edgeArray,
+                              std::vector<EdgeCheck>& checks,
+                              int begin,
+                              int end)
+    {
+        BRep_Builder builder;
+        TopoDS_Compound comp;
+        builder.MakeCompound(comp);
+        TopTools_MapOfShape added;
+        auto addEdge = [&](const TopoDS_Edge& edge) {
+            if (added.Add(edge)) {
+                builder.Add(comp, edge);
             }
+        };
 
-            auto itParam = params.begin();
-            if (itParam->point.SquareDistance(info.p1) < myTol2) {
-                params.erase(itParam);
+        for (int index = begin; index < end; ++index) {
+            const EdgeInfo& info = *edgeArray[index];
+            auto& check = checks[index];
+            splitEdgesCandidates(info, check);
+            if (canSelfIntersect(info) || !check.pairs.empty()) {
+                addEdge(info.edge);
             }
-            params.emplace(info.firstParam, info.p1, TopoDS_Shape());
-            itParam = params.end();
-            --itParam;
-            if (itParam->point.SquareDistance(info.p2) < myTol2) {
-                params.erase(itParam);
+            for (const auto& pair : check.pairs) {
+                addEdge(pair.other->edge);
             }
-            params.emplace(info.lastParam, info.p2, TopoDS_Shape());
+        }
+        if (added.IsEmpty()) {
+            return;
+        }
+
+        BRepBuilderAPI_Copy copy(comp, /*copyGeom*/ Standard_False);
+        auto copyOf = [&copy](const EdgeInfo& info) {
+            TopoDS_Shape edge = copy.ModifiedShape(info.edge).Oriented(info.edge.Orientation());
+            return EdgeInfo(TopoDS::Edge(edge),
+                            info.p1,
+                            info.p2,
+                            info.box,
+                            info.queryBBox,
+                            info.isLinear);
+        };
 
-            if (params.size() <= 2) {
-                ++it;
+        for (int index = begin; index < end; ++index) {
+            const EdgeInfo& info = *edgeArray[index];
+            auto& check = checks[index];
+            if (!canSelfIntersect(info) && check.pairs.empty()) {
                 continue;
             }
+            EdgeInfo infoCopy = copyOf(info);
+            checkSelfIntersection(infoCopy, check.params);
+            for (auto& param : check.params) {
+                param.intersectShape = info.edge;
+            }
+            for (auto& pair : check.pairs) {
+                const EdgeInfo& other = *pair.other;
+                EdgeInfo otherCopy = copyOf(other);
+                checkIntersection(infoCopy, otherCopy, pair.params1, pair.params2);
+                for (auto& param : pair.params1) {
+                    param.intersectShape = other.edge;
+                }
+                for (auto& param : pair.params2) {
+                    param.intersectShape = info.edge;
+                }
+            }
+        }
+    }
+
+    // This method was originally part of WireJoinerP::splitEdges(), split to reduce cognitive
+    // complexity
+    void splitEdgesPrepare(const EdgeInfo& info,
+                           std::set<IntersectInfo>& params,
+                           std::vector<SplitInfo>& splits)
+    {
+        if (params.empty()) {
+            return;
+        }
+
+        auto itParam = params.begin();
+        if (itParam->point.SquareDistance(info.p1) < myTol2) {
+            params.erase(itParam);
+        }
+        params.emplace(info.firstParam, info.p1, TopoDS_Shape());
+        itParam = params.end();
+        --itParam;
+        if (itParam->point.SquareDistance(info.p2) < myTol2) {
+            params.erase(itParam);
+        }
+        params.emplace(info.lastParam, info.p2, TopoDS_Shape());
+
+        if (params.size() <= 2) {
+            return;
+        }
 
+        itParam = params.begin();
+        splitEdgesMakeEdges(itParam, params, info, splits);
+
+        if (splits.size() <= 1) {
             splits.clear();
-            itParam = params.begin();
+        }
+    }
 
-            splitEdgesMakeEdges(itParam, params, info, splits);
+    // Try splitting any edges that intersects other edge
+    void splitEdges()
+    {
+        FC_TIME_INIT2(t, t1);
 
-            if (splits.size() <= 1) {
-                ++it;
-                continue;
+        std::vector<Edges::iterator> edgeArray;
+        std::vector<Edges::iterator> boxed;
+        edgeArray.reserve(edges.size());
+        for (auto it = edges.begin(); it != edges.end(); ++it) {
+            edgeArray.push_back(it);
+            it->iteration = static_cast<int>(edgeArray.size());
+            if (it->queryBBox) {
+                boxed.push_back(it);
             }
+        }
 
-            showShape(info.edge, "remove");
-            auto removedEdge = info.edge;
+        // Rebuild the box tree with bulk loading, which gives a much better balanced tree than
+        // inserting the edges one by one while they are added.
+        boxMap = decltype(boxMap)(boxed.begin(), boxed.end());
+        FC_TIME_LOG(t1, "box tree of " << boxed.size() << " edges");
+
+        const bool parallel = canRunParallel();
+        const int count = static_cast<int>(edgeArray.size());
+
+        std::unique_ptr<Base::SequencerLauncher> seq(
+                new Base::SequencerLauncher("Splitting edges", edgeArray.size()));
+
+        // Find the intersections of each edge with the edges behind it. This is the expensive
+        // part and runs concurrently. The results are merged afterwards in the same order as
+        // the edges, so the result does not depend on the number of threads.
+        std::vector<EdgeCheck> checks(edgeArray.size());
+        if (!parallel) {
+            for (int index = 0; index < count; ++index) {
+                seq->next(true);
+                splitEdgesCheck(*edgeArray[index], checks[index]);
+            }
+        }
+        else {
+            // The edges are checked in batches, one range per worker, so that the progress is
+            // updated and the user can abort in between
+            const int workers = std::max(1, OSD_Parallel::NbLogicalProcessors());
+            const int rangeSize = 64;
+            for (int batch = 0; batch < count; batch += workers * rangeSize) {
+                const int batchEnd = std::min(count, batch + workers * rangeSize);
+                const int ranges = (batchEnd - batch + rangeSize - 1) / rangeSize;
+                OSD_Parallel::For(0, ranges, [&](int range) {
+                    int begin = batch + range * rangeSize;
+                    splitEdgesCheckRange(edgeArray,
+                                         checks,
+                                         begin,
+                                         std::min(batchEnd, begin + rangeSize));
+                });
+                for (int index = batch; index < batchEnd; ++index) {
+                    seq->next(true);
+                }
+            }
+        }
+        FC_TIME_LOG(t1, "intersection check");
+
+        std::vector<std::set<IntersectInfo>> intersects(edgeArray.size());
+        for (int index = 0; index < count; ++index) {
+            auto& check = checks[index];
+            auto& params = intersects[index];
+            params.insert(check.params.begin(), check.params.end());
+            for (const auto& pair : check.pairs) {
+                auto& otherParams = intersects[pair.other->iteration - 1];
+                for (const auto& param : pair.params1) {
+                    pushIntersection(params, param.param, param.point, param.intersectShape);
+                }
+                for (const auto& param : pair.params2) {
+                    pushIntersection(otherParams, param.param, param.point, param.intersectShape);
+                }
+            }
+        }
+        checks.clear();
+
+        // Making the split edges only reads the curve of the edge to split.
+        std::vector<std::vector<SplitInfo>> splits(edgeArray.size());
+        OSD_Parallel::For(
+            0,
+            count,
+            [&](int index) {
+                splitEdgesPrepare(*edgeArray[index], intersects[index], splits[index]);
+            },
+            !parallel);
+        FC_TIME_LOG(t1, "make split edges");
+
+        for (int index = 0; index < count; ++index) {
+            if (splits[index].empty()) {
+                continue;
+            }
+            auto it = edgeArray[index];
+            showShape(it->edge, "remove");
             it = remove(it);
-            for (const auto& split : splits) {
+            for (const auto& split : splits[index]) {
                 if (!add(split.edge, false, split.bbox, it)) {
                     continue;
                 }
@@ -1379,6 +1557,8 @@ public:
                 showShape(newInfo.edge, "split");
             }
         }
+        FC_TIME_LOG(t1, "replace split edges");
+        FC_TIME_LOG(t, "splitEdges");
     }
 
     // This method was originally part of WireJoinerP::findSuperEdges(), split to reduce cognitive
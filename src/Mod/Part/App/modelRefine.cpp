@@ -48,6 +48,7 @@
 # include <gp_Cylinder.hxx>
 # include <gp_Pln.hxx>
 # include <GProp_GProps.hxx>
+# include <OSD_Parallel.hxx>
 # include <ShapeAnalysis_Curve.hxx>
 # include <ShapeAnalysis_Shell.hxx>
 # include <ShapeBuild_ReShape.hxx>
@@ -72,6 +73,8 @@
 #include "modelRefine.h"
 
 
+FC_LOG_LEVEL_INIT("ModelRefine", true, true)
+
 using namespace ModelRefine;
 
 
@@ -158,15 +161,24 @@ bool FaceTypeSplitter::hasType(const GeomAbs_SurfaceType &type) const
 
 void FaceTypeSplitter::split()
 {
+    FaceVectorType faces;
     TopExp_Explorer shellIt;
     for (shellIt.Init(shell, TopAbs_FACE); shellIt.More(); shellIt.Next())
+        faces.push_back(TopoDS::Face(shellIt.Current()));
+
+    // Determining the surface type is read-only, so it is done concurrently. The faces
+    // are then sorted in serially to keep the order of the explorer.
+    std::vector<GeomAbs_SurfaceType> types(faces.size());
+    OSD_Parallel::For(0, int(faces.size()), [&](int index) {
+        types[index] = FaceTypedBase::getFaceType(faces[index]);
+    });
+
+    for (std::size_t index = 0; index < faces.size(); ++index)
     {
-        TopoDS_Face tempFace(TopoDS::Face(shellIt.Current()));
-        GeomAbs_SurfaceType currentType = FaceTypedBase::getFaceType(tempFace);
-        SplitMapType::iterator mapIt = typeMap.find(currentType);
+        SplitMapType::iterator mapIt = typeMap.find(types[index]);
         if (mapIt == typeMap.end())
             continue;
-        (*mapIt).second.push_back(tempFace);
+        (*mapIt).second.push_back(faces[index]);
     }
 }
 
@@ -198,9 +210,14 @@ FaceAdjacencySplitter::FaceAdjacencySplitter(const TopoDS_Shell &shell)
 
 void FaceAdjacencySplitter::split(const FaceVectorType &facesIn)
 {
-    facesInMap.Clear();
-    processedMap.Clear();
     adjacencyArray.clear();
+    split(facesIn, adjacencyArray);
+}
+
+void FaceAdjacencySplitter::split(const FaceVectorType &facesIn, std::vector<FaceVectorType> &groupsOut) const
+{
+    TopTools_MapOfShape facesInMap;
+    TopTools_MapOfShape processedMap;
 
     FaceVectorType::const_iterator it;
     for (it = facesIn.begin(); it != facesIn.end(); ++it)
@@ -221,15 +238,16 @@ void FaceAdjacencySplitter::split(const FaceVectorType &facesIn)
 
         tempFaces.clear();
         processedMap.Add(*it);
-        recursiveFind(*it, tempFaces);
+        recursiveFind(*it, facesInMap, processedMap, tempFaces);
         if (tempFaces.size() > 1)
         {
-            adjacencyArray.push_back(tempFaces);
+            groupsOut.push_back(tempFaces);
         }
     }
 }
 
-void FaceAdjacencySplitter::recursiveFind(const TopoDS_Face &face, FaceVectorType &outVector)
+void FaceAdjacencySplitter::recursiveFind(const TopoDS_Face &face, const TopTools_MapOfShape &facesInMap,
+                                          TopTools_MapOfShape &processedMap, FaceVectorType &outVector) const
 {
     outVector.push_back(face);
 
@@ -246,7 +264,7 @@ void FaceAdjacencySplitter::recursiveFind(const TopoDS_Face &face, FaceVectorTyp
             if (processedMap.Contains(faceIt.Value()))
                 continue;
             processedMap.Add(faceIt.Value());
-            recursiveFind(TopoDS::Face(faceIt.Value()), outVector);
+            recursiveFind(TopoDS::Face(faceIt.Value()), facesInMap, processedMap, outVector);
         }
     }
 }
@@ -1037,6 +1055,8 @@ bool FaceUniter::process()
     typeObjects.push_back(&getBSplineObject());
     //add more face types.
 
+    FC_TIME_INIT2(t, t1);
+
     bool checkFinalShell = false;
     ModelRefine::FaceTypeSplitter splitter;
     splitter.addShell(workShell);
@@ -1044,51 +1064,70 @@ bool FaceUniter::process()
     for(typeIt = typeObjects.begin(); typeIt != typeObjects.end(); ++typeIt)
         splitter.registerType((*typeIt)->getType());
     splitter.split();
+    FC_TIME_LOG(t1, "type split");
 
     ModelRefine::FaceVectorType facesToRemove;
     ModelRefine::FaceVectorType facesToSew;
 
     ModelRefine::FaceAdjacencySplitter adjacencySplitter(workShell);
-
-    for(typeIt = typeObjects.begin(); typeIt != typeObjects.end(); ++typeIt)
+    FC_TIME_LOG(t1, "adjacency maps");
+
+    // Grouping the faces only reads the shell and is therefore done concurrently, first
+    // per surface type and then per group of equal surfaces. The results are stored per
+    // index so that the faces below are built in exactly the same order as before.
+    std::vector<ModelRefine::FaceEqualitySplitter> equalitySplitters(typeObjects.size());
+    OSD_Parallel::For(0, int(typeObjects.size()), [&](int index) {
+        FaceTypedBase *object = typeObjects[index];
+        equalitySplitters[index].split(splitter.getTypedFaceVector(object->getType()), object);
+    });
+    FC_TIME_LOG(t1, "equality split");
+
+    struct AdjacencyJob
     {
-        ModelRefine::FaceVectorType typedFaces = splitter.getTypedFaceVector((*typeIt)->getType());
-        ModelRefine::FaceEqualitySplitter equalitySplitter;
-        equalitySplitter.split(typedFaces, *typeIt);
+        FaceTypedBase *object;
+        const FaceVectorType *faces;
+        std::vector<FaceVectorType> groups;
+    };
+    std::vector<AdjacencyJob> jobs;
+    for (std::size_t indexType(0); indexType < typeObjects.size(); ++indexType)
+    {
+        const ModelRefine::FaceEqualitySplitter &equalitySplitter = equalitySplitters[indexType];
         for (std::size_t indexEquality(0); indexEquality < equalitySplitter.getGroupCount(); ++indexEquality)
+            jobs.push_back({typeObjects[indexType], &equalitySplitter.getGroup(indexEquality), {}});
+    }
+    OSD_Parallel::For(0, int(jobs.size()), [&](int index) {
+        adjacencySplitter.split(*jobs[index].faces, jobs[index].groups);
+    });
+    FC_TIME_LOG(t1, "adjacency split (" << jobs.size() << " groups)");
+
+    // Building the faces must stay serial because BRepLib_MakeFace and ShapeFix_Face add
+    // pcurves to the boundary edges, which are shared with faces of other groups.
+    for (const auto &job : jobs)
+    {
+        for (const auto &group : job.groups)
         {
-            adjacencySplitter.split(equalitySplitter.getGroup(indexEquality));
-//            std::cout << "      adjacency group count: " << adjacencySplitter.getGroupCount() << std::endl;
-            for (std::size_t adjacentIndex(0); adjacentIndex < adjacencySplitter.getGroupCount(); ++adjacentIndex)
+            TopoDS_Face newFace = job.object->buildFace(group);
+            if (!newFace.IsNull())
             {
-//                    std::cout << "         face count is: " << adjacencySplitter.getGroup(adjacentIndex).size() << std::endl;
-                TopoDS_Face newFace = (*typeIt)->buildFace(adjacencySplitter.getGroup(adjacentIndex));
-                if (!newFace.IsNull())
-                {
-                    // the created face should have the same orientation as the input faces
-                    const FaceVectorType& faces = adjacencySplitter.getGroup(adjacentIndex);
-                    if (!faces.empty() && newFace.Orientation() != faces[0].Orientation()) {
-                        checkFinalShell = true;
-                    }
-                    facesToSew.push_back(newFace);
-                    if (facesToRemove.capacity() <= facesToRemove.size() + adjacencySplitter.getGroup(adjacentIndex).size())
-                        facesToRemove.reserve(facesToRemove.size() + adjacencySplitter.getGroup(adjacentIndex).size());
-                    FaceVectorType temp = adjacencySplitter.getGroup(adjacentIndex);
-                    facesToRemove.insert(facesToRemove.end(), temp.begin(), temp.end());
-                    // the first shape will be marked as modified, i.e. replaced by newFace, all others are marked as deleted
-                    // jrheinlaender: IMHO this is not correct because references to the deleted faces will be broken, whereas they should
-                    // be replaced by references to the new face. To achieve this all shapes should be marked as
-                    // modified, producing one single new face. This is the inverse behaviour to faces that are split e.g.
-                    // by a boolean cut, where one old shape is marked as modified, producing multiple new shapes
-                    if (!temp.empty())
-                    {
-                        for (const auto & f : temp)
-                              modifiedShapes.emplace_back(f, newFace);
-                    }
+                // the created face should have the same orientation as the input faces
+                if (!group.empty() && newFace.Orientation() != group[0].Orientation()) {
+                    checkFinalShell = true;
                 }
+                facesToSew.push_back(newFace);
+                if (facesToRemove.capacity() <= facesToRemove.size() + group.size())
+                    facesToRemove.reserve(facesToRemove.size() + group.size());
+                facesToRemove.insert(facesToRemove.end(), group.begin(), group.end());
+                // the first shape will be marked as modified, i.e. replaced by newFace, all others are marked as deleted
+                // jrheinlaender: IMHO this is not correct because references to the deleted faces will be broken, whereas they should
+                // be replaced by references to the new face. To achieve this all shapes should be marked as
+                // modified, producing one single new face. This is the inverse behaviour to faces that are split e.g.
+                // by a boolean cut, where one old shape is marked as modified, producing multiple new shapes
+                for (const auto & f : group)
+                    modifiedShapes.emplace_back(f, newFace);
             }
         }
     }
+    FC_TIME_LOG(t1, "build faces (" << facesToSew.size() << " new)");
     if (!facesToSew.empty())
     {
         modifiedSignal = true;
@@ -1203,7 +1242,9 @@ bool FaceUniter::process()
             }
             // TODO: Handle vertices that have disappeared in the fusion of the edges
         }
+        FC_TIME_LOG(t1, "sewing and edge fusion");
     }
+    FC_TIME_LOG(t, "refine shell");
     return true;
 }
 
@@ -130,15 +130,17 @@ namespace ModelRefine
     public:
         FaceAdjacencySplitter(const TopoDS_Shell &shell);
         void split(const FaceVectorType &facesIn);
+        //! re-entrant version of split(). It only reads the adjacency maps and may be
+        //! called from several threads at once.
+        void split(const FaceVectorType &facesIn, std::vector<FaceVectorType> &groupsOut) const;
         std::size_t getGroupCount() const {return adjacencyArray.size();}
         const FaceVectorType& getGroup(const std::size_t &index) const {return adjacencyArray[index];}
 
     private:
         FaceAdjacencySplitter() = default;
-        void recursiveFind(const TopoDS_Face &face, FaceVectorType &outVector);
+        void recursiveFind(const TopoDS_Face &face, const TopTools_MapOfShape &facesInMap,
+                           TopTools_MapOfShape &processedMap, FaceVectorType &outVector) const;
         std::vector<FaceVectorType> adjacencyArray;
-        TopTools_MapOfShape processedMap;
-        TopTools_MapOfShape facesInMap;
 
         TopTools_IndexedDataMapOfShapeListOfShape faceToEdgeMap;
         TopTools_IndexedDataMapOfShapeListOfShape edgeToFaceMap;
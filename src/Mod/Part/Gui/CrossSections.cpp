@@ -24,7 +24,6 @@
 
 #ifndef _PreComp_
 # include <cfloat>
-# include <QFuture>
 # include <QKeyEvent>
 
 # include <BRep_Builder.hxx>
@@ -56,8 +55,6 @@
 
 
 using namespace PartGui;
-namespace sp = std::placeholders;
-#undef CS_FUTURE // multi-threading causes some problems
 
 namespace PartGui {
 class ViewProviderCrossSections : public Gui::ViewProvider
@@ -237,35 +234,13 @@ void CrossSections::apply()
             break;
     }
 
-#ifdef CS_FUTURE
-    Standard::SetReentrant(Standard_True);
-    for (std::vector<App::DocumentObject*>::iterator it = obj.begin(); it != obj.end(); ++it) {
-        Part::CrossSection cs(a,b,c,static_cast<Part::Feature*>(*it)->Shape.getValue());
-        QFuture< std::list<TopoDS_Wire> > future = QtConcurrent::mapped
-            (d, std::bind(&Part::CrossSection::section, &cs, sp::_1));
-        future.waitForFinished();
-        QFuture< std::list<TopoDS_Wire> >::const_iterator ft;
-        TopoDS_Compound comp;
-        BRep_Builder builder;
-        builder.MakeCompound(comp);
-
-        for (ft = future.begin(); ft != future.end(); ++ft) {
-            const std::list<TopoDS_Wire>& w = *ft;
-            for (std::list<TopoDS_Wire>::const_iterator wt = w.begin(); wt != w.end(); ++wt) {
-                if (!wt->IsNull())
-                    builder.Add(comp, *wt);
-            }
-        }
-
-        App::Document* doc = (*it)->getDocument();
-        std::string s = (*it)->getNameInDocument();
-        s += "_cs";
-        auto* section = doc->addObject<Part::Feature>(s.c_str());
-        section->Shape.setValue(comp);
-        section->purgeTouched();
+    // Part.Shape.slices() computes all the sections of a shape in parallel
+    QStringList planes;
+    for (double jt : d) {
+        planes << QString::number(jt);
     }
-#else
-    Base::SequencerLauncher seq("Cross-sections...", obj.size() * (d.size() +1));
+
+    Base::SequencerLauncher seq("Cross-sections...", obj.size());
     Gui::Command::runCommand(Gui::Command::App, "import Part\n");
     Gui::Command::runCommand(Gui::Command::App, "from FreeCAD import Base\n");
     for (auto it : obj) {
@@ -273,18 +248,12 @@ void CrossSections::apply()
         std::string s = it->getNameInDocument();
         s += "_cs";
         Gui::Command::runCommand(Gui::Command::App, QStringLiteral(
-            "wires=list()\n"
-            "shape=FreeCAD.getDocument(\"%1\").%2.Shape\n")
+            "shape=FreeCAD.getDocument(\"%1\").%2.Shape\n"
+            "wires=shape.slices(Base.Vector(%3,%4,%5),[%6]).Wires\n")
             .arg(QLatin1String(doc->getName()),
-                 QLatin1String(it->getNameInDocument())).toLatin1());
-
-        for (double jt : d) {
-            Gui::Command::runCommand(Gui::Command::App, QStringLiteral(
-                "for i in shape.slice(Base.Vector(%1,%2,%3),%4):\n"
-                "    wires.append(i)\n"
-                ).arg(a).arg(b).arg(c).arg(jt).toLatin1());
-            seq.next();
-        }
+                 QLatin1String(it->getNameInDocument()))
+            .arg(a).arg(b).arg(c)
+            .arg(planes.join(QLatin1String(","))).toLatin1());
 
         Gui::Command::runCommand(Gui::Command::App, QStringLiteral(
             "comp=Part.Compound(wires)\n"
@@ -297,7 +266,6 @@ void CrossSections::apply()
 
         seq.next();
     }
-#endif
 }
 
 void CrossSections::xyPlaneClicked()
@@ -421,6 +421,10 @@ void TaskCheckGeometryResults::goCheck()
     reportViewStrings.clear();
     reportViewStrings << QLatin1String("\n");
 
+    ParameterGrp::handle group = App::GetApplication().GetUserParameter().
+    GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod")->GetGroup("Part")->GetGroup("CheckGeometry");
+    bool runSingleThreaded = group->GetBool("RunSingleThreaded", false);
+
     std::string scopeName {tr("Boolean operation check...").toStdString()};
 #if OCC_VERSION_HEX < 0x070500
     Handle(Message_ProgressIndicator) theProgress = new BOPProgressIndicator(tr("Check geometry"),
@@ -482,7 +486,13 @@ void TaskCheckGeometryResults::goCheck()
 
         buildShapeContent(sel.pObject, baseName, shape);
 
+#if OCC_VERSION_HEX >= 0x070600
+        // check the sub-shapes of the shape in parallel
+        BRepCheck_Analyzer shapeCheck(shape, Standard_True, !runSingleThreaded);
+#else
+        Q_UNUSED(runSingleThreaded)
         BRepCheck_Analyzer shapeCheck(shape);
+#endif
         if (!shapeCheck.IsValid())
         {
             invalidShapes++;
@@ -508,8 +518,6 @@ void TaskCheckGeometryResults::goCheck()
           //so only run it when the shape seems valid to BRepCheck_Analyzer And
           //when the option is set.
 
-          ParameterGrp::handle group = App::GetApplication().GetUserParameter().
-          GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod")->GetGroup("Part")->GetGroup("CheckGeometry");
           bool runSignal = group->GetBool("RunBOPCheck", false);
           group->SetBool("RunBOPCheck", runSignal);
           if (runSignal) {
@@ -22,12 +22,12 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
-#include <QtConcurrentMap>
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <cmath>
 #include <iostream>
 #endif
 
+#include <Base/BulkVector.h>
 #include <Base/Matrix.h>
 #include <Base/Stream.h>
 #include <Base/Writer.h>
@@ -36,10 +36,6 @@
 #include "PointsAlgos.h"
 
 
-#ifdef _MSC_VER
-#include <ppl.h>
-#endif
-
 using namespace Points;
 using namespace std;
 
@@ -84,46 +80,12 @@ Data::Segment* PointKernel::getSubElement(const char* /*Type*/, unsigned long /*
 void PointKernel::transformGeometry(const Base::Matrix4D& rclMat)
 {
     std::vector<value_type>& kernel = getBasicPoints();
-#ifdef _MSC_VER
-    // Win32-only at the moment since ppl.h is a Microsoft library. Points is not using Qt so we
-    // cannot use QtConcurrent We could also rewrite Points to leverage SIMD instructions Other
-    // option: openMP. But with VC2013 results in high CPU usage even after computation (busy-waits
-    // for >100ms)
-    Concurrency::parallel_for_each(kernel.begin(), kernel.end(), [rclMat](value_type& value) {
-        value = rclMat * value;
-    });
-#else
-    QtConcurrent::blockingMap(kernel, [rclMat](value_type& value) {
-        rclMat.multVec(value, value);
-    });
-#endif
+    Base::BulkVector::transform(rclMat, kernel.data(), kernel.size());
 }
 
 Base::BoundBox3d PointKernel::getBoundBox() const
 {
-    Base::BoundBox3d bnd;
-
-#ifdef _MSC_VER
-    // Thread-local bounding boxes
-    Concurrency::combinable<Base::BoundBox3d> bbs;
-    // Cannot use a const_point_iterator here as it is *not* a proper iterator (fails the for_each
-    // template)
-    Concurrency::parallel_for_each(_Points.begin(),
-                                   _Points.end(),
-                                   [this, &bbs](const value_type& value) {
-                                       Base::Vector3d vertd(value.x, value.y, value.z);
-                                       bbs.local().Add(this->_Mtrx * vertd);
-                                   });
-    // Combine each thread-local bounding box in the final bounding box
-    bbs.combine_each([&bnd](const Base::BoundBox3d& lbb) {
-        bnd.Add(lbb);
-    });
-#else
-    for (const auto& it : *this) {
-        bnd.Add(it);
-    }
-#endif
-    return bnd;
+    return Base::BulkVector::boundBox(_Mtrx, _Points.data(), _Points.size());
 }
 
 PointKernel& PointKernel::operator=(const PointKernel& Kernel)
@@ -25,6 +25,9 @@
 #ifdef FC_OS_LINUX
 #include <unistd.h>
 #endif
+#include <algorithm>
+#include <cstring>
+#include <exception>
 #include <memory>
 #include <sstream>
 
@@ -32,6 +35,7 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>  // needed for compilation on some systems
 #include <boost/regex.hpp>
+#include <QtConcurrentMap>
 #endif
 
 #include <Base/Console.h>
@@ -40,8 +44,11 @@
 #include <Base/FileInfo.h>
 #include <Base/Sequencer.h>
 #include <Base/Stream.h>
+#include <Base/Swap.h>
+#include <Base/TimeInfo.h>
 
 #include "PointsAlgos.h"
+#include "PointsOctree.h"
 #include <E57Format.h>
 
 
@@ -190,6 +197,31 @@ int Reader::getHeight() const
     return height;
 }
 
+void Reader::setOctree(PointsOctree* tree)
+{
+    octree = tree;
+}
+
+void Reader::addToOctree(const Eigen::MatrixXd& data, std::size_t x, std::size_t y, std::size_t z)
+{
+    const Eigen::Index batchSize = 1000000;
+    std::vector<Base::Vector3f> batch;
+    for (Eigen::Index i = 0; i < data.rows(); i += batchSize) {
+        Eigen::Index end = std::min(i + batchSize, data.rows());
+        batch.clear();
+        batch.reserve(end - i);
+        for (Eigen::Index j = i; j < end; j++) {
+            batch.emplace_back(float(data(j, Eigen::Index(x))),
+                               float(data(j, Eigen::Index(y))),
+                               float(data(j, Eigen::Index(z))));
+        }
+        octree->add(batch);
+    }
+
+    this->width = 0;
+    this->height = 1;
+}
+
 // ----------------------------------------------------------------------------
 
 AscReader::AscReader() = default;
@@ -212,6 +244,7 @@ public:
     virtual ~Converter() = default;
     virtual std::string toString(double) const = 0;
     virtual double toDouble(Base::InputStream&) const = 0;
+    virtual double toDouble(const char*, bool swapByteOrder) const = 0;
     virtual int getSizeOf() const = 0;
 
     Converter(const Converter&) = delete;
@@ -238,6 +271,15 @@ public:
         str >> c;
         return static_cast<double>(c);
     }
+    double toDouble(const char* ptr, bool swapByteOrder) const override
+    {
+        T c;
+        std::memcpy(&c, ptr, sizeof(T));
+        if (swapByteOrder) {
+            Base::SwapEndian(c);
+        }
+        return static_cast<double>(c);
+    }
     int getSizeOf() const override
     {
         return sizeof(T);
@@ -284,6 +326,13 @@ protected:
     {
         return _end - _cur;
     }
+    std::streamsize xsgetn(char* s, std::streamsize n) override
+    {
+        std::streamsize count = std::min<std::streamsize>(n, _end - _cur);
+        std::memcpy(s, _buffer.data() + _cur, count);
+        _cur += int(count);
+        return count;
+    }
     pos_type seekoff(std::streambuf::off_type off,
                      std::ios_base::seekdir way,
                      std::ios_base::openmode mode = std::ios::in | std::ios::out) override
@@ -543,6 +592,283 @@ lzfDecompress(const void* const in_data, unsigned int in_len, void* out_data, un
 }  // namespace Points
 // NOLINTEND
 
+namespace
+{
+// the number of rows converted by one task
+const Eigen::Index RowsPerTask = 65536;
+
+/*!
+ * \brief Parses a number of an ASCII file.
+ * Numbers with at most 15 significant digits and a small exponent are exactly representable as
+ * product or quotient of two doubles, which gives the correctly rounded result without going
+ * through a stream. All other numbers are passed to boost::lexical_cast.
+ */
+double parseNumber(const char* first, const char* last)
+{
+    static const double powers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                    1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    const char* ptr = first;
+    bool negative = false;
+    if (ptr != last && (*ptr == '-' || *ptr == '+')) {
+        negative = (*ptr == '-');
+        ++ptr;
+    }
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool valid = false;
+    auto addDigit = [&](char c) {
+        if (digits < 19) {
+            mantissa = mantissa * 10 + uint64_t(c - '0');
+            if (mantissa > 0) {
+                digits++;
+            }
+            return true;
+        }
+        return false;
+    };
+
+    for (; ptr != last && *ptr >= '0' && *ptr <= '9'; ++ptr) {
+        valid = true;
+        if (!addDigit(*ptr)) {
+            exponent++;
+        }
+    }
+    if (ptr != last && *ptr == '.') {
+        for (++ptr; ptr != last && *ptr >= '0' && *ptr <= '9'; ++ptr) {
+            valid = true;
+            if (addDigit(*ptr)) {
+                exponent--;
+            }
+        }
+    }
+    if (valid && ptr != last && (*ptr == 'e' || *ptr == 'E')) {
+        ++ptr;
+        bool negExp = false;
+        if (ptr != last && (*ptr == '-' || *ptr == '+')) {
+            negExp = (*ptr == '-');
+            ++ptr;
+        }
+        int value = 0;
+        valid = (ptr != last);
+        for (; ptr != last && *ptr >= '0' && *ptr <= '9'; ++ptr) {
+            value = std::min(value * 10 + (*ptr - '0'), 10000);
+        }
+        exponent += negExp ? -value : value;
+    }
+
+    if (!valid || ptr != last || digits > 15 || exponent < -22 || exponent > 22) {
+        return boost::lexical_cast<double>(std::string(first, last));
+    }
+
+    double value = static_cast<double>(mantissa);
+    value = exponent < 0 ? value / powers[-exponent] : value * powers[exponent];
+    return negative ? -value : value;
+}
+
+/*!
+ * \brief Reads the rows of an ASCII file after skipping \a skip non-empty lines.
+ * The text is read in blocks and the lines of a block are parsed on several threads.
+ */
+void readAsciiRows(std::istream& inp, std::size_t skip, Eigen::MatrixXd& data)
+{
+    const std::size_t blockSize = 1 << 24;
+    Eigen::Index numPoints = data.rows();
+    Eigen::Index numFields = data.cols();
+    Eigen::Index row = 0;
+
+    std::string block;
+    std::vector<std::pair<const char*, const char*>> lines;
+    auto isSpace = [](char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    };
+
+    while (row < numPoints && inp) {
+        std::size_t keep = block.size();
+        block.resize(keep + blockSize);
+        inp.read(&block[keep], blockSize);
+        block.resize(keep + static_cast<std::size_t>(inp.gcount()));
+
+        // only parse complete lines unless the end of the file is reached
+        std::size_t pos = block.rfind('\n');
+        if (pos == std::string::npos && inp) {
+            continue;
+        }
+        std::size_t end = inp ? pos + 1 : block.size();
+
+        lines.clear();
+        const char* ptr = block.data();
+        const char* stop = ptr + end;
+        while (ptr < stop && row + Eigen::Index(lines.size()) < numPoints) {
+            const char* next = static_cast<const char*>(std::memchr(ptr, '\n', stop - ptr));
+            const char* first = ptr;
+            const char* last = next ? next : stop;
+            ptr = next ? next + 1 : stop;
+            while (first < last && isSpace(*first)) {
+                ++first;
+            }
+            while (last > first && isSpace(*(last - 1))) {
+                --last;
+            }
+            if (first == last) {
+                continue;
+            }
+            if (skip > 0) {
+                skip--;
+                continue;
+            }
+            lines.emplace_back(first, last);
+        }
+
+        std::vector<Eigen::Index> tasks;
+        for (Eigen::Index i = 0; i < Eigen::Index(lines.size()); i += RowsPerTask) {
+            tasks.push_back(i);
+        }
+
+        std::vector<std::exception_ptr> errors(tasks.size());
+        QtConcurrent::blockingMap(tasks, [&](Eigen::Index begin) {
+            try {
+                Eigen::Index count = std::min(begin + RowsPerTask, Eigen::Index(lines.size()));
+                for (Eigen::Index i = begin; i < count; i++) {
+                    const char* it = lines[i].first;
+                    const char* last = lines[i].second;
+                    for (Eigen::Index col = 0; col < numFields && it < last; col++) {
+                        const char* token = it;
+                        while (it < last && !isSpace(*it)) {
+                            ++it;
+                        }
+                        data(row + i, col) = parseNumber(token, it);
+                        while (it < last && isSpace(*it)) {
+                            ++it;
+                        }
+                    }
+                }
+            }
+            catch (...) {
+                errors[begin / RowsPerTask] = std::current_exception();
+            }
+        });
+        for (const auto& it : errors) {
+            if (it) {
+                std::rethrow_exception(it);
+            }
+        }
+
+        row += Eigen::Index(lines.size());
+        block.erase(0, end);
+    }
+}
+
+/*!
+ * \brief Converts \a numRows binary rows of \a buffer on several threads into the rows of \a data
+ * starting at \a firstRow. Each row of \a buffer has \a rowSize bytes and holds the fields of
+ * \a converters which go into the columns starting at \a firstColumn.
+ */
+void convertBinary(const char* buffer,
+                   const std::vector<Points::ConverterPtr>& converters,
+                   std::size_t rowSize,
+                   Eigen::Index firstColumn,
+                   Eigen::Index firstRow,
+                   Eigen::Index numRows,
+                   bool swapByteOrder,
+                   Eigen::MatrixXd& data)
+{
+    std::vector<std::size_t> offsets;
+    std::size_t offset = 0;
+    for (const auto& it : converters) {
+        offsets.push_back(offset);
+        offset += it->getSizeOf();
+    }
+
+    std::vector<Eigen::Index> tasks;
+    for (Eigen::Index i = 0; i < numRows; i += RowsPerTask) {
+        tasks.push_back(i);
+    }
+
+    QtConcurrent::blockingMap(tasks, [&](Eigen::Index begin) {
+        Eigen::Index end = std::min(begin + RowsPerTask, numRows);
+        for (std::size_t j = 0; j < converters.size(); j++) {
+            const Points::Converter& convert = *converters[j];
+            Eigen::Index col = firstColumn + Eigen::Index(j);
+            for (Eigen::Index i = begin; i < end; i++) {
+                const char* ptr = buffer + std::size_t(i) * rowSize + offsets[j];
+                data(firstRow + i, col) = convert.toDouble(ptr, swapByteOrder);
+            }
+        }
+    });
+}
+
+/*!
+ * \brief Reads the binary rows into \a data in blocks of bounded size.
+ * If \a transpose is true the data is stored column by column.
+ */
+void readBinaryRows(std::istream& inp,
+                    const std::vector<Points::ConverterPtr>& converters,
+                    bool swapByteOrder,
+                    bool transpose,
+                    Eigen::MatrixXd& data)
+{
+    const std::size_t blockSize = 1 << 24;
+    Eigen::Index numPoints = data.rows();
+
+    std::vector<char> buffer;
+    auto readBlock = [&](std::size_t size) {
+        buffer.resize(size);
+        inp.read(buffer.data(), static_cast<std::streamsize>(size));
+        if (inp.gcount() != static_cast<std::streamsize>(size)) {
+            throw Base::BadFormatError("Unexpected end of file");
+        }
+    };
+    auto readRows = [&](const std::vector<Points::ConverterPtr>& fields,
+                        std::size_t rowSize,
+                        Eigen::Index firstColumn) {
+        if (rowSize == 0) {
+            return;
+        }
+        auto rowsPerBlock = Eigen::Index(std::max<std::size_t>(blockSize / rowSize, 1));
+        for (Eigen::Index row = 0; row < numPoints; row += rowsPerBlock) {
+            Eigen::Index count = std::min(rowsPerBlock, numPoints - row);
+            readBlock(rowSize * std::size_t(count));
+            convertBinary(buffer.data(),
+                          fields,
+                          rowSize,
+                          firstColumn,
+                          row,
+                          count,
+                          swapByteOrder,
+                          data);
+        }
+    };
+
+    if (transpose) {
+        // the values of one field for all points are followed by those of the next field
+        for (std::size_t j = 0; j < converters.size(); j++) {
+            readRows({converters[j]}, converters[j]->getSizeOf(), Eigen::Index(j));
+        }
+    }
+    else {
+        std::size_t rowSize = 0;
+        for (const auto& it : converters) {
+            rowSize += it->getSizeOf();
+        }
+        readRows(converters, rowSize, 0);
+    }
+}
+
+void logThroughput(const std::string& filename, std::size_t count, const Base::TimeElapsed& start)
+{
+    float seconds = Base::TimeElapsed::diffTimeF(start);
+    Base::Console().Log("Read %zu points from %s in %.2f s (%.0f points/s)\n",
+                        count,
+                        filename.c_str(),
+                        seconds,
+                        seconds > 0.0F ? float(count) / seconds : 0.0F);
+}
+}  // namespace
+
 PlyReader::PlyReader() = default;
 
 void PlyReader::read(const std::string& filename)
@@ -557,6 +883,7 @@ void PlyReader::read(const std::string& filename)
     std::vector<std::string> types;
     std::vector<int> sizes;
     std::size_t offset = 0;
+    Base::TimeElapsed start;
     Eigen::Index numPoints = Eigen::Index(readHeader(inp, format, offset, fields, types, sizes));
 
     this->width = numPoints;
@@ -665,6 +992,11 @@ void PlyReader::read(const std::string& filename)
     bool hasIntensity = (greyvalue != max_size);
     bool hasColor = (red != max_size && green != max_size && blue != max_size);
 
+    if (hasData && octree) {
+        addToOctree(data, x, y, z);
+        return;
+    }
+
     if (hasData) {
         points.reserve(numPoints);
         for (Eigen::Index i = 0; i < numPoints; i++) {
@@ -715,6 +1047,8 @@ void PlyReader::read(const std::string& filename)
             }
         }
     }
+
+    logThroughput(filename, std::size_t(numPoints), start);
 }
 
 std::size_t PlyReader::readHeader(std::istream& in,
@@ -889,35 +1223,7 @@ std::size_t PlyReader::readHeader(std::istream& in,
 
 void PlyReader::readAscii(std::istream& inp, std::size_t offset, Eigen::MatrixXd& data)
 {
-    std::string line;
-    Eigen::Index row = 0;
-    Eigen::Index numPoints = Eigen::Index(data.rows());
-    Eigen::Index numFields = Eigen::Index(data.cols());
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty()) {
-            continue;
-        }
-
-        if (offset > 0) {
-            offset--;
-            continue;
-        }
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        Eigen::Index size = Eigen::Index(list.size());
-        for (Eigen::Index col = 0; col < size && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
-    }
+    readAsciiRows(inp, offset, data);
 }
 
 void PlyReader::readBinary(bool swapByteOrder,
@@ -1007,14 +1313,7 @@ void PlyReader::readBinary(bool swapByteOrder,
         }
     }
 
-    Base::InputStream str(inp);
-    str.setByteOrder(swapByteOrder ? Base::Stream::BigEndian : Base::Stream::LittleEndian);
-    for (Eigen::Index i = 0; i < numPoints; i++) {
-        for (Eigen::Index j = 0; j < numFields; j++) {
-            double value = converters[j]->toDouble(str);
-            data(i, j) = value;
-        }
-    }
+    readBinaryRows(inp, converters, swapByteOrder, false, data);
 }
 
 // ----------------------------------------------------------------------------
@@ -1034,6 +1333,7 @@ void PcdReader::read(const std::string& filename)
     std::vector<std::string> fields;
     std::vector<std::string> types;
     std::vector<int> sizes;
+    Base::TimeElapsed start;
     Eigen::Index numPoints = Eigen::Index(readHeader(inp, format, fields, types, sizes));
 
     Eigen::MatrixXd data(numPoints, fields.size());
@@ -1140,6 +1440,11 @@ void PcdReader::read(const std::string& filename)
     bool hasIntensity = (greyvalue != max_size);
     bool hasColor = (rgba != max_size);
 
+    if (hasData && octree) {
+        addToOctree(data, x, y, z);
+        return;
+    }
+
     if (hasData) {
         points.reserve(numPoints);
         for (Eigen::Index i = 0; i < numPoints; i++) {
@@ -1184,6 +1489,8 @@ void PcdReader::read(const std::string& filename)
             }
         }
     }
+
+    logThroughput(filename, std::size_t(numPoints), start);
 }
 
 std::size_t PcdReader::readHeader(std::istream& in,
@@ -1259,30 +1566,7 @@ std::size_t PcdReader::readHeader(std::istream& in,
 
 void PcdReader::readAscii(std::istream& inp, Eigen::MatrixXd& data)
 {
-    std::string line;
-    Eigen::Index row = 0;
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty()) {
-            continue;
-        }
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        Eigen::Index size = Eigen::Index(list.size());
-        for (Eigen::Index col = 0; col < size && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
-    }
+    readAsciiRows(inp, 0, data);
 }
 
 void PcdReader::readBinary(bool transpose,
@@ -1371,23 +1655,7 @@ void PcdReader::readBinary(bool transpose,
         }
     }
 
-    Base::InputStream str(inp);
-    if (transpose) {
-        for (Eigen::Index j = 0; j < numFields; j++) {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
-        }
-    }
-    else {
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            for (Eigen::Index j = 0; j < numFields; j++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
-        }
-    }
+    readBinaryRows(inp, converters, false, transpose, data);
 }
 
 // ----------------------------------------------------------------------------
@@ -1399,6 +1667,7 @@ class E57ReaderImp
 public:
     E57ReaderImp(const std::string& filename, bool color, bool state, double distance)
         : imfi(filename, "r")
+        , filename {filename}
         , useColor {color}
         , checkState {state}
         , minDistance {distance}
@@ -1409,45 +1678,178 @@ public:
         e57::StructureNode root = imfi.root();
         if (root.isDefined("data3D")) {
             e57::VectorNode data3D(root.get("data3D"));
-            readData3D(data3D);
+            // the octree is not thread-safe, so the scans are read one after another then
+            if (octree) {
+                readData3D(data3D);
+            }
+            else {
+                readScans(data3D);
+            }
         }
     }
 
-    std::vector<App::Color> getColors() const
+    std::vector<App::Color>& getColors()
     {
         return colors;
     }
 
-    std::vector<float> getItensity() const
+    std::vector<float>& getItensity()
     {
         return intensity;
     }
 
-    const PointKernel& getPoints() const
+    PointKernel& getPoints()
     {
         return points;
     }
 
-    const std::vector<Base::Vector3f>& getNormals() const
+    std::vector<Base::Vector3f>& getNormals()
     {
         return normals;
     }
 
+    std::size_t countPoints() const
+    {
+        return numPoints;
+    }
+
+    void setOctree(PointsOctree* tree)
+    {
+        octree = tree;
+    }
+
 private:
+    /// The range of the output arrays a scan writes its points to
+    struct Slice
+    {
+        /// index of the first point of the scan
+        std::size_t offset = 0;
+        /// number of points written, the filtered ones are skipped
+        std::size_t count = 0;
+    };
+
     void readData3D(const e57::VectorNode& data3D)
     {
         for (int child = 0; child < data3D.childCount(); ++child) {
-            e57::StructureNode scan_data(data3D.get(child));
-            Base::Placement plm;
-            bool hasPlacement = getPlacement(scan_data, plm);
+            Slice slice;
+            readScan(data3D, child, *this, slice);
+        }
+    }
 
+    void readScan(const e57::VectorNode& data3D, int child, E57ReaderImp& target, Slice& slice)
+    {
+        e57::StructureNode scan_data(data3D.get(child));
+        Base::Placement plm;
+        bool hasPlacement = getPlacement(scan_data, plm);
+
+        e57::CompressedVectorNode cvn(scan_data.get("points"));
+        e57::StructureNode prototype(cvn.prototype());
+        Proto proto = readProto(prototype);
+        processProto(cvn, proto, hasPlacement, plm, target, slice);
+    }
+
+    void readScans(const e57::VectorNode& data3D)
+    {
+        // The output arrays are allocated once for the records of all scans and each scan
+        // writes to its own slice of them
+        int count = int(data3D.childCount());
+        std::vector<Slice> slices(count);
+        std::size_t total = 0;
+        bool hasColor = false;
+        bool hasItensity = false;
+        bool hasNormal = false;
+        for (int child = 0; child < count; ++child) {
+            e57::StructureNode scan_data(data3D.get(child));
             e57::CompressedVectorNode cvn(scan_data.get("points"));
             e57::StructureNode prototype(cvn.prototype());
-            Proto proto = readProto(prototype);
-            processProto(cvn, proto, hasPlacement, plm);
+            hasColor = hasColor
+                || (useColor && prototype.isDefined("colorRed")
+                    && prototype.isDefined("colorGreen") && prototype.isDefined("colorBlue"));
+            hasItensity = hasItensity || prototype.isDefined("intensity");
+            hasNormal = hasNormal
+                || (prototype.isDefined("nor:normalX") && prototype.isDefined("nor:normalY")
+                    && prototype.isDefined("nor:normalZ"));
+            slices[child].offset = total;
+            total += std::size_t(cvn.childCount());
+        }
+
+        points.resize(total);
+        if (hasColor) {
+            colors.resize(total);
+        }
+        if (hasItensity) {
+            intensity.resize(total);
+        }
+        if (hasNormal) {
+            normals.resize(total);
+        }
+
+        if (count == 1) {
+            readScan(data3D, 0, *this, slices[0]);
+        }
+        else if (count > 1) {
+            // an image file must not be accessed from several threads, so each scan is decoded
+            // with its own handle
+            std::vector<int> children;
+            for (int child = 0; child < count; ++child) {
+                children.push_back(child);
+            }
+
+            std::vector<std::exception_ptr> errors(count);
+            QtConcurrent::blockingMap(children, [this, &slices, &errors](int child) {
+                try {
+                    E57ReaderImp scan(filename, useColor, checkState, minDistance);
+                    e57::VectorNode scanData3D(scan.imfi.root().get("data3D"));
+                    scan.readScan(scanData3D, child, *this, slices[child]);
+                }
+                catch (...) {
+                    errors[child] = std::current_exception();
+                }
+            });
+            for (const auto& it : errors) {
+                if (it) {
+                    std::rethrow_exception(it);
+                }
+            }
+        }
+
+        // close the gaps left by the filtered points
+        for (const auto& it : slices) {
+            if (it.offset != numPoints) {
+                moveSlice(it, numPoints);
+            }
+            numPoints += it.count;
+        }
+        points.resize(numPoints);
+        if (hasColor) {
+            colors.resize(numPoints);
+        }
+        if (hasItensity) {
+            intensity.resize(numPoints);
+        }
+        if (hasNormal) {
+            normals.resize(numPoints);
         }
     }
 
+    template<typename T>
+    static void moveRange(std::vector<T>& data, const Slice& slice, std::size_t offset)
+    {
+        if (!data.empty()) {
+            auto first = data.begin() + std::ptrdiff_t(slice.offset);
+            auto last = first + std::ptrdiff_t(slice.count);
+            std::copy(first, last, data.begin() + std::ptrdiff_t(offset));
+        }
+    }
+
+    void moveSlice(const Slice& slice, std::size_t offset)
+    {
+        moveRange(points.getBasicPoints(), slice, offset);
+        moveRange(colors, slice, offset);
+        moveRange(intensity, slice, offset);
+        moveRange(normals, slice, offset);
+    }
+
     struct Proto
     {
         bool inty = false;
@@ -1630,7 +2032,9 @@ private:
     void processProto(e57::CompressedVectorNode& cvn,
                       const Proto& proto,
                       bool hasPlacement,
-                      const Base::Placement& plm)
+                      const Base::Placement& plm,
+                      E57ReaderImp& target,
+                      Slice& slice)
     {
         if (proto.cnt_xyz != 3) {
             throw Base::BadFormatError("Missing channels xyz");
@@ -1639,11 +2043,15 @@ private:
         unsigned cnt_pts = 0;
         Base::Vector3d pt, last;
         e57::CompressedVectorReader cvr(cvn.reader(proto.sdb));
-        bool hasColor = (proto.cnt_rgb == 3) && useColor;
-        bool hasItensity = proto.inty;
-        bool hasNormal = (proto.cnt_nor == 3);
+        // the channels are only written if they have been allocated for the slices
+        bool hasColor = (proto.cnt_rgb == 3) && useColor && !target.colors.empty();
+        bool hasItensity = proto.inty && !target.intensity.empty();
+        bool hasNormal = (proto.cnt_nor == 3) && !target.normals.empty();
         bool hasState = proto.inv_state && checkState;
         bool filter = false;
+        // with an octree the points are passed on in batches and the other channels are skipped
+        const std::size_t batchSize = 1000000;
+        std::vector<Base::Vector3f> batch;
 
         while ((count = cvr.read())) {
             for (size_t i = 0; i < count; ++i) {
@@ -1661,22 +2069,37 @@ private:
                         filter = true;
                     }
                 }
-                if (!filter) {
+                if (!filter && octree) {
                     cnt_pts++;
-                    points.push_back(pt);
+                    batch.push_back(Base::convertTo<Base::Vector3f>(pt));
+                    last = pt;
+                    if (batch.size() >= batchSize) {
+                        octree->add(batch);
+                        batch.clear();
+                    }
+                }
+                else if (!filter) {
+                    cnt_pts++;
+                    std::size_t index = slice.offset + slice.count++;
+                    target.points.getBasicPoints()[index] = Base::convertTo<Base::Vector3f>(pt);
                     last = pt;
                     if (hasColor) {
-                        colors.push_back(getColor(proto, i));
+                        target.colors[index] = getColor(proto, i);
                     }
                     if (hasItensity) {
-                        intensity.push_back(proto.intensity[i]);
+                        target.intensity[index] = proto.intensity[i];
                     }
                     if (hasNormal) {
-                        normals.push_back(getNormal(proto, i, hasPlacement, plm.getRotation()));
+                        target.normals[index] =
+                            getNormal(proto, i, hasPlacement, plm.getRotation());
                     }
                 }
             }
         }
+
+        if (!batch.empty()) {
+            octree->add(batch);
+        }
     }
 
     Base::Vector3d
@@ -1765,14 +2188,17 @@ private:
 
 private:
     e57::ImageFile imfi;
+    std::string filename;
     bool useColor;
     bool checkState;
     double minDistance;
-    const size_t buf_size = 1024;
+    const size_t buf_size = 16384;
     std::vector<App::Color> colors;
     std::vector<float> intensity;
     PointKernel points;
     std::vector<Base::Vector3f> normals;
+    std::size_t numPoints {0};
+    PointsOctree* octree {nullptr};
 };
 }  // namespace
 
@@ -1785,14 +2211,17 @@ E57Reader::E57Reader(bool Color, bool State, double Distance)
 void E57Reader::read(const std::string& filename)
 {
     try {
+        Base::TimeElapsed start;
         E57ReaderImp reader(filename, useColor, checkState, minDistance);
+        reader.setOctree(octree);
         reader.read();
-        points = reader.getPoints();
-        normals = reader.getNormals();
-        colors = reader.getColors();
-        intensity = reader.getItensity();
+        points = std::move(reader.getPoints());
+        normals = std::move(reader.getNormals());
+        colors = std::move(reader.getColors());
+        intensity = std::move(reader.getItensity());
         width = points.size();
         height = 1;
+        logThroughput(filename, reader.countPoints(), start);
     }
     catch (const Base::BadFormatError&) {
         throw;
@@ -31,6 +31,7 @@
 
 namespace Points
 {
+class PointsOctree;
 
 /** The Points algorithms container class
  */
@@ -64,12 +65,17 @@ public:
     bool isStructured() const;
     int getWidth() const;
     int getHeight() const;
+    /// Passes the points to \a tree instead of keeping them. Only the coordinates are read then.
+    void setOctree(PointsOctree* tree);
 
     Reader(const Reader&) = delete;
     Reader(Reader&&) = delete;
     Reader& operator=(const Reader&) = delete;
     Reader& operator=(Reader&&) = delete;
 
+protected:
+    void addToOctree(const Eigen::MatrixXd& data, std::size_t x, std::size_t y, std::size_t z);
+
 protected:
     // NOLINTBEGIN
     PointKernel points;
@@ -78,6 +84,7 @@ protected:
     std::vector<Base::Vector3f> normals;
     int width {0};
     int height {1};
+    PointsOctree* octree {nullptr};
     // NOLINTEND
 };
 
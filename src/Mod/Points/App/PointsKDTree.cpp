@@ -0,0 +1,343 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <QtConcurrentMap>
+#endif
+
+#include <Eigen/Eigenvalues>
+
+#include <Base/BoundBox.h>
+
+#include "Points.h"
+#include "PointsKDTree.h"
+
+
+using namespace Points;
+
+namespace
+{
+constexpr std::uint32_t MaxLeafSize = 16;
+constexpr std::uint32_t LeafAxis = 3;
+constexpr std::size_t PointsPerTask = 4096;
+// the tree is balanced, so its depth is at most 32 and each level adds at most one entry
+constexpr std::size_t MaxStackSize = 64;
+
+bool isValid(const Base::Vector3f& pnt)
+{
+    return !std::isnan(pnt.x) && !std::isnan(pnt.y) && !std::isnan(pnt.z);
+}
+
+// unlike Vector3f::operator[] this can be inlined
+inline float coordinate(const Base::Vector3f& pnt, std::uint32_t axis)
+{
+    return axis == 0 ? pnt.x : (axis == 1 ? pnt.y : pnt.z);
+}
+}  // namespace
+
+PointsKDTree::PointsKDTree(const PointKernel& kernel)
+{
+    points.reserve(kernel.size());
+    for (const auto& pnt : kernel) {
+        points.push_back(Base::toVector<float>(pnt));
+    }
+    build();
+}
+
+PointsKDTree::PointsKDTree(const std::vector<Base::Vector3f>& points)
+    : points(points)
+{
+    build();
+}
+
+void PointsKDTree::build()
+{
+    order.reserve(points.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        if (isValid(points[i])) {
+            order.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+
+    if (order.empty()) {
+        return;
+    }
+
+    nodes.reserve(2 * (order.size() / MaxLeafSize + 1));
+    buildNode(0, static_cast<std::uint32_t>(order.size()));
+
+    sorted.resize(order.size());
+    for (std::size_t i = 0; i < order.size(); i++) {
+        sorted[i] = points[order[i]];
+    }
+}
+
+void PointsKDTree::buildNode(std::uint32_t first, std::uint32_t last)
+{
+    auto index = static_cast<std::uint32_t>(nodes.size());
+    nodes.push_back({0.0F, LeafAxis, first, last - first});
+    if (last - first <= MaxLeafSize) {
+        return;
+    }
+
+    // split at the median of the longest side
+    Base::BoundBox3f box;
+    for (std::uint32_t i = first; i < last; i++) {
+        box.Add(points[order[i]]);
+    }
+    std::uint32_t axis = 0;
+    if (box.LengthY() > box.LengthX()) {
+        axis = 1;
+    }
+    if (box.LengthZ() > std::max(box.LengthX(), box.LengthY())) {
+        axis = 2;
+    }
+
+    std::uint32_t mid = first + (last - first) / 2;
+    std::nth_element(order.begin() + first,
+                     order.begin() + mid,
+                     order.begin() + last,
+                     [this, axis](std::uint32_t a, std::uint32_t b) {
+                         return coordinate(points[a], axis) < coordinate(points[b], axis);
+                     });
+    float split = coordinate(points[order[mid]], axis);
+
+    buildNode(first, mid);
+    nodes[index] = {split, axis, static_cast<std::uint32_t>(nodes.size()), 0};
+    buildNode(mid, last);
+}
+
+void PointsKDTree::nearestNeighbours(const Base::Vector3f& pnt,
+                                     int k,
+                                     std::vector<int>& indices) const
+{
+    indices.clear();
+    if (k <= 0 || nodes.empty()) {
+        return;
+    }
+
+    // max-heap of the k nearest points found so far
+    using Candidate = std::pair<float, std::uint32_t>;
+    std::vector<Candidate> heap;
+    heap.reserve(k);
+    auto bound = [&heap, k]() {
+        return heap.size() < std::size_t(k) ? std::numeric_limits<float>::max()
+                                             : heap.front().first;
+    };
+
+    // the squared distance to the cell of a node is accumulated from its offsets along the axes
+    struct Entry
+    {
+        std::uint32_t node;
+        float dist2;
+        std::array<float, 3> offset;
+    };
+    std::array<Entry, MaxStackSize> stack {};
+    int top = 0;
+    stack[top++] = {0, 0.0F, {0.0F, 0.0F, 0.0F}};
+    while (top > 0) {
+        Entry entry = stack[--top];
+        if (entry.dist2 >= bound()) {
+            continue;
+        }
+
+        const Node& node = nodes[entry.node];
+        if (node.axis == LeafAxis) {
+            for (std::uint32_t i = node.index; i < node.index + node.count; i++) {
+                float dist2 = Base::DistanceP2(sorted[i], pnt);
+                if (heap.size() < std::size_t(k)) {
+                    heap.emplace_back(dist2, i);
+                    std::push_heap(heap.begin(), heap.end());
+                }
+                else if (dist2 < heap.front().first) {
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.back() = Candidate(dist2, i);
+                    std::push_heap(heap.begin(), heap.end());
+                }
+            }
+            continue;
+        }
+
+        // visit the side of the point first
+        float diff = coordinate(pnt, node.axis) - node.split;
+        std::uint32_t left = entry.node + 1;
+        std::uint32_t right = node.index;
+        std::uint32_t nearer = diff < 0 ? left : right;
+        std::uint32_t farther = diff < 0 ? right : left;
+        Entry far = entry;
+        far.node = farther;
+        far.dist2 += diff * diff - entry.offset[node.axis] * entry.offset[node.axis];
+        far.offset[node.axis] = diff;
+        stack[top++] = far;
+        entry.node = nearer;
+        stack[top++] = entry;
+    }
+
+    std::sort_heap(heap.begin(), heap.end());
+    indices.reserve(heap.size());
+    for (const auto& it : heap) {
+        indices.push_back(static_cast<int>(order[it.second]));
+    }
+}
+
+void PointsKDTree::radiusNeighbours(const Base::Vector3f& pnt,
+                                    float radius,
+                                    std::vector<int>& indices) const
+{
+    indices.clear();
+    if (radius <= 0 || nodes.empty()) {
+        return;
+    }
+
+    float radius2 = radius * radius;
+    std::vector<std::pair<float, std::uint32_t>> found;
+    std::array<std::uint32_t, MaxStackSize> stack {};
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        std::uint32_t left = stack[--top] + 1;
+        const Node& node = nodes[left - 1];
+        if (node.axis == LeafAxis) {
+            for (std::uint32_t i = node.index; i < node.index + node.count; i++) {
+                float dist2 = Base::DistanceP2(sorted[i], pnt);
+                if (dist2 <= radius2) {
+                    found.emplace_back(dist2, i);
+                }
+            }
+            continue;
+        }
+
+        float diff = coordinate(pnt, node.axis) - node.split;
+        if (diff - radius < 0) {
+            stack[top++] = left;
+        }
+        if (diff + radius >= 0) {
+            stack[top++] = node.index;
+        }
+    }
+
+    std::sort(found.begin(), found.end());
+    indices.reserve(found.size());
+    for (const auto& it : found) {
+        indices.push_back(static_cast<int>(order[it.second]));
+    }
+}
+
+template<class Func>
+void PointsKDTree::forEachPoint(Func&& func) const
+{
+    // Visiting the points in the order of the leaves keeps the queries of a task close to each
+    // other, which is much more cache friendly than the original order
+    std::vector<std::size_t> tasks;
+    for (std::size_t start = 0; start < order.size(); start += PointsPerTask) {
+        tasks.push_back(start);
+    }
+
+    QtConcurrent::blockingMap(tasks, [this, &func](std::size_t start) {
+        std::size_t end = std::min(start + PointsPerTask, order.size());
+        for (std::size_t i = start; i < end; i++) {
+            func(order[i]);
+        }
+    });
+}
+
+void PointsKDTree::nearestNeighbours(int k, std::vector<std::vector<int>>& indices) const
+{
+    indices.clear();
+    indices.resize(points.size());
+    forEachPoint([this, k, &indices](std::size_t index) {
+        nearestNeighbours(points[index], k, indices[index]);
+    });
+}
+
+void PointsKDTree::radiusNeighbours(float radius, std::vector<std::vector<int>>& indices) const
+{
+    indices.clear();
+    indices.resize(points.size());
+    forEachPoint([this, radius, &indices](std::size_t index) {
+        radiusNeighbours(points[index], radius, indices[index]);
+    });
+}
+
+void PointsKDTree::estimateNormals(int k,
+                                   float radius,
+                                   std::vector<Base::Vector3f>& normals,
+                                   std::vector<float>* curvatures) const
+{
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    normals.assign(points.size(), Base::Vector3f(nan, nan, nan));
+    if (curvatures) {
+        curvatures->assign(points.size(), nan);
+    }
+
+    forEachPoint([&](std::size_t index) {
+        thread_local std::vector<int> neighbours;
+        const Base::Vector3f& pnt = points[index];
+        if (k > 0) {
+            nearestNeighbours(pnt, k, neighbours);
+        }
+        else {
+            radiusNeighbours(pnt, radius, neighbours);
+        }
+        if (neighbours.size() < 3) {
+            return;
+        }
+
+        // covariance matrix relative to the centroid
+        Eigen::Vector3d center = Eigen::Vector3d::Zero();
+        for (int it : neighbours) {
+            const Base::Vector3f& neighbour = points[it];
+            center += Eigen::Vector3d(neighbour.x, neighbour.y, neighbour.z);
+        }
+        center /= double(neighbours.size());
+        Eigen::Matrix3d covariance = Eigen::Matrix3d::Zero();
+        for (int it : neighbours) {
+            const Base::Vector3f& neighbour = points[it];
+            Eigen::Vector3d diff = Eigen::Vector3d(neighbour.x, neighbour.y, neighbour.z) - center;
+            covariance += diff * diff.transpose();
+        }
+
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver;
+        solver.computeDirect(covariance);
+        Eigen::Vector3d eigenvalues = solver.eigenvalues();
+        Eigen::Vector3d normal = solver.eigenvectors().col(0);
+
+        // orient the normal towards the origin
+        Eigen::Vector3d toOrigin(-pnt.x, -pnt.y, -pnt.z);
+        if (normal.dot(toOrigin) < 0) {
+            normal = -normal;
+        }
+        normals[index] = Base::Vector3f(float(normal.x()), float(normal.y()), float(normal.z()));
+
+        if (curvatures) {
+            double sum = eigenvalues.sum();
+            (*curvatures)[index] = sum > 0 ? float(eigenvalues(0) / sum) : 0.0F;
+        }
+    });
+}
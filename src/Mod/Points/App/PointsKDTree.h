@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+
+#ifndef POINTS_KDTREE_H
+#define POINTS_KDTREE_H
+
+#include <cstdint>
+#include <vector>
+
+#include <Base/Vector3D.h>
+
+#include <Mod/Points/PointsGlobal.h>
+
+namespace Points
+{
+
+class PointKernel;
+
+/**
+ * The PointsKDTree class is a balanced k-d tree over a point cloud to search for the nearest
+ * neighbours of a point. Points with NaN coordinates are not indexed and are never returned as
+ * neighbours, but the indices of the other points refer to the original point array.
+ *
+ * All queries are const and can be called from several threads at once. The batched queries run
+ * for all points of the cloud on several threads.
+ */
+class PointsExport PointsKDTree
+{
+public:
+    /// Builds the tree over the points of the kernel with its placement applied
+    explicit PointsKDTree(const PointKernel& kernel);
+    explicit PointsKDTree(const std::vector<Base::Vector3f>& points);
+
+    /// Returns the number of points passed to the constructor
+    std::size_t size() const
+    {
+        return points.size();
+    }
+    /// Returns the number of indexed points
+    std::size_t countIndexed() const
+    {
+        return order.size();
+    }
+    const Base::Vector3f& getPoint(std::size_t index) const
+    {
+        return points[index];
+    }
+    const std::vector<Base::Vector3f>& getPoints() const
+    {
+        return points;
+    }
+
+    /** @name Search */
+    //@{
+    /** Searches the \a k nearest points of \a pnt. The indices are sorted by increasing
+     * distance. */
+    void nearestNeighbours(const Base::Vector3f& pnt, int k, std::vector<int>& indices) const;
+    /** Searches all points within the distance \a radius of \a pnt. The indices are sorted by
+     * increasing distance. */
+    void radiusNeighbours(const Base::Vector3f& pnt, float radius, std::vector<int>& indices) const;
+    //@}
+
+    /** @name Batched search */
+    //@{
+    /** Does the same as nearestNeighbours() for each point of the cloud in parallel. Points
+     * with NaN coordinates get no neighbours. */
+    void nearestNeighbours(int k, std::vector<std::vector<int>>& indices) const;
+    /** Does the same as radiusNeighbours() for each point of the cloud in parallel. */
+    void radiusNeighbours(float radius, std::vector<std::vector<int>>& indices) const;
+    //@}
+
+    /** @name Normals */
+    //@{
+    /** Estimates the normal of each point as the eigenvector to the smallest eigenvalue of the
+     * covariance matrix of its neighbours. The neighbours are the \a k nearest points if \a k
+     * is positive, and the points within \a radius otherwise.
+     * Like PCL the normals are oriented towards the origin and the curvature is the smallest
+     * eigenvalue divided by the sum of all eigenvalues. Points with less than three neighbours
+     * get a NaN normal.
+     */
+    void estimateNormals(int k,
+                         float radius,
+                         std::vector<Base::Vector3f>& normals,
+                         std::vector<float>* curvatures = nullptr) const;
+    //@}
+
+private:
+    struct Node
+    {
+        /// the splitting coordinate of an inner node
+        float split;
+        /// the splitting axis of an inner node, 3 for a leaf
+        std::uint32_t axis;
+        /// the first point of a leaf or the second child of an inner node
+        std::uint32_t index;
+        /// number of points of a leaf
+        std::uint32_t count;
+    };
+
+    void build();
+    void buildNode(std::uint32_t first, std::uint32_t last);
+    template<class Func>
+    void forEachPoint(Func&& func) const;
+
+private:
+    std::vector<Base::Vector3f> points;
+    std::vector<Node> nodes;
+    /// the indices of the points in the order of the leaves
+    std::vector<std::uint32_t> order;
+    /// the points in the order of the leaves
+    std::vector<Base::Vector3f> sorted;
+};
+
+}  // namespace Points
+
+
+#endif  // POINTS_KDTREE_H
@@ -0,0 +1,408 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <unordered_set>
+#include <QtConcurrentMap>
+#endif
+
+#include <Base/Exception.h>
+
+#include "PointsOctree.h"
+
+
+using namespace Points;
+
+static_assert(sizeof(Base::Vector3f) == 3 * sizeof(float), "Unexpected padding of Vector3f");
+
+PointsPageCache::PointsPageCache(std::size_t maxPoints)
+    : maxPoints(maxPoints)
+{}
+
+PointsPageCache::~PointsPageCache()
+{
+    if (swapOut) {
+        swapIn.reset();
+        swapOut.reset();
+        swapFile.deleteFile();
+    }
+}
+
+std::size_t PointsPageCache::create()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::size_t page = entries.size();
+    entries.emplace_back();
+    Entry& entry = entries.back();
+    entry.data = std::make_shared<const std::vector<Base::Vector3f>>();
+    entry.resident = true;
+    lru.push_front(page);
+    entry.lru = lru.begin();
+    return page;
+}
+
+void PointsPageCache::store(std::size_t page, std::vector<Base::Vector3f>&& points)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry& entry = entries.at(page);
+    if (entry.resident) {
+        residentPoints -= entry.count;
+        touch(page);
+    }
+    else {
+        lru.push_front(page);
+        entry.lru = lru.begin();
+        entry.resident = true;
+    }
+
+    // a copy on disk is outdated now
+    entry.offset = -1;
+    entry.count = points.size();
+    entry.data = std::make_shared<const std::vector<Base::Vector3f>>(std::move(points));
+    residentPoints += entry.count;
+    evict();
+}
+
+PointsPageCache::Page PointsPageCache::load(std::size_t page)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry& entry = entries.at(page);
+    if (entry.resident) {
+        touch(page);
+    }
+    else {
+        read(page);
+    }
+
+    Page data = entry.data;
+    evict();
+    return data;
+}
+
+std::size_t PointsPageCache::count(std::size_t page) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.at(page).count;
+}
+
+std::size_t PointsPageCache::countResident() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return residentPoints;
+}
+
+bool PointsPageCache::isResident(std::size_t page) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.at(page).resident;
+}
+
+void PointsPageCache::touch(std::size_t page)
+{
+    lru.splice(lru.begin(), lru, entries[page].lru);
+}
+
+void PointsPageCache::evict()
+{
+    // the most recently used page always stays in memory
+    while (residentPoints > maxPoints && lru.size() > 1) {
+        std::size_t page = lru.back();
+        lru.pop_back();
+        Entry& entry = entries[page];
+        if (entry.offset < 0) {
+            write(page);
+        }
+        residentPoints -= entry.count;
+        entry.data.reset();
+        entry.resident = false;
+    }
+}
+
+void PointsPageCache::write(std::size_t page)
+{
+    if (!swapOut) {
+        swapFile.setFile(Base::FileInfo::getTempFileName("points"));
+        swapOut = std::make_unique<Base::ofstream>(swapFile,
+                                                   std::ios::out | std::ios::binary
+                                                       | std::ios::trunc);
+    }
+
+    // the swap file is only appended to, outdated pages are not reclaimed
+    Entry& entry = entries[page];
+    auto size = static_cast<std::streamsize>(entry.count * sizeof(Base::Vector3f));
+    swapOut->write(reinterpret_cast<const char*>(entry.data->data()), size);  // NOLINT
+    if (!*swapOut) {
+        throw Base::FileException("Failed to write to swap file", swapFile);
+    }
+    entry.offset = swapSize;
+    swapSize += size;
+}
+
+void PointsPageCache::read(std::size_t page)
+{
+    if (swapOut) {
+        swapOut->flush();
+    }
+    if (!swapIn) {
+        swapIn = std::make_unique<Base::ifstream>(swapFile, std::ios::in | std::ios::binary);
+    }
+
+    Entry& entry = entries[page];
+    std::vector<Base::Vector3f> points(entry.count);
+    auto size = static_cast<std::streamsize>(entry.count * sizeof(Base::Vector3f));
+    swapIn->clear();
+    swapIn->seekg(entry.offset);
+    swapIn->read(reinterpret_cast<char*>(points.data()), size);  // NOLINT
+    if (!*swapIn) {
+        throw Base::FileException("Failed to read from swap file", swapFile);
+    }
+
+    entry.data = std::make_shared<const std::vector<Base::Vector3f>>(std::move(points));
+    entry.resident = true;
+    lru.push_front(page);
+    entry.lru = lru.begin();
+    residentPoints += entry.count;
+}
+
+// ----------------------------------------------------------------------------
+
+namespace
+{
+// the sample grid of a node has Resolution^3 cells
+constexpr int Resolution = 128;
+// a leaf with more points is split
+constexpr std::size_t MaxLeafPoints = 65536;
+constexpr int MaxDepth = 20;
+
+int childOf(const Base::BoundBox3f& cube, const Base::Vector3f& pnt)
+{
+    Base::Vector3f center = cube.GetCenter();
+    return (pnt.x >= center.x ? 1 : 0) | (pnt.y >= center.y ? 2 : 0) | (pnt.z >= center.z ? 4 : 0);
+}
+
+uint64_t cellOf(const Base::BoundBox3f& cube, float spacing, const Base::Vector3f& pnt)
+{
+    auto index = [spacing](float value) {
+        return static_cast<uint64_t>(std::clamp(int(value / spacing), 0, Resolution - 1));
+    };
+    return index(pnt.x - cube.MinX) | (index(pnt.y - cube.MinY) << 16)
+        | (index(pnt.z - cube.MinZ) << 32);
+}
+}  // namespace
+
+PointsOctree::PointsOctree(const Base::BoundBox3f& box, std::size_t memoryLimit)
+    : cache(memoryLimit)
+{
+    Base::Vector3f center = box.IsValid() ? box.GetCenter() : Base::Vector3f();
+    float length = box.IsValid() ? std::max({box.LengthX(), box.LengthY(), box.LengthZ()}) : 0.0F;
+    float half = length > 0.0F ? 0.5F * length * 1.001F : 1.0F;
+    Base::BoundBox3f cube(center.x - half,
+                          center.y - half,
+                          center.z - half,
+                          center.x + half,
+                          center.y + half,
+                          center.z + half);
+    createNode(cube, 0);
+}
+
+std::size_t PointsOctree::createNode(const Base::BoundBox3f& cube, int depth)
+{
+    Node node;
+    node.cube = cube;
+    node.depth = depth;
+    node.spacing = cube.LengthX() / float(Resolution);
+    node.page = cache.create();
+    nodes.push_back(node);
+    return nodes.size() - 1;
+}
+
+void PointsOctree::split(std::size_t index)
+{
+    Base::BoundBox3f cube = nodes[index].cube;
+    Base::Vector3f center = cube.GetCenter();
+    int depth = nodes[index].depth + 1;
+    for (int i = 0; i < 8; i++) {
+        Base::BoundBox3f octant(i & 1 ? center.x : cube.MinX,
+                                i & 2 ? center.y : cube.MinY,
+                                i & 4 ? center.z : cube.MinZ,
+                                i & 1 ? cube.MaxX : center.x,
+                                i & 2 ? cube.MaxY : center.y,
+                                i & 4 ? cube.MaxZ : center.z);
+        std::size_t child = createNode(octant, depth);
+        nodes[index].children[i] = static_cast<int>(child);
+    }
+}
+
+void PointsOctree::add(const std::vector<Base::Vector3f>& points)
+{
+    std::vector<Base::Vector3f> batch(points);
+    insert(0, batch);
+    numPoints += points.size();
+}
+
+void PointsOctree::insert(std::size_t index, std::vector<Base::Vector3f>& points)
+{
+    if (points.empty()) {
+        return;
+    }
+
+    for (const auto& it : points) {
+        nodes[index].bounds.Add(it);
+    }
+
+    std::vector<Base::Vector3f> data(*cache.load(nodes[index].page));
+    if (nodes[index].isLeaf()) {
+        data.insert(data.end(), points.begin(), points.end());
+        if (data.size() <= MaxLeafPoints || nodes[index].depth >= MaxDepth) {
+            cache.store(nodes[index].page, std::move(data));
+            return;
+        }
+
+        // turn the leaf into an inner node and distribute all of its points again
+        split(index);
+        points.swap(data);
+        data.clear();
+    }
+
+    // inserting into the children adds nodes, so don't keep a reference
+    Base::BoundBox3f cube = nodes[index].cube;
+    float spacing = nodes[index].spacing;
+    std::array<int, 8> children = nodes[index].children;
+
+    std::unordered_set<uint64_t> occupied;
+    occupied.reserve(data.size() + points.size());
+    for (const auto& it : data) {
+        occupied.insert(cellOf(cube, spacing, it));
+    }
+
+    std::array<std::vector<Base::Vector3f>, 8> groups;
+    for (const auto& it : points) {
+        if (occupied.insert(cellOf(cube, spacing, it)).second) {
+            data.push_back(it);
+        }
+        else {
+            groups[childOf(cube, it)].push_back(it);
+        }
+    }
+
+    cache.store(nodes[index].page, std::move(data));
+    points.clear();
+    points.shrink_to_fit();
+
+    for (int i = 0; i < 8; i++) {
+        insert(children[i], groups[i]);
+    }
+}
+
+std::size_t PointsOctree::countNodes() const
+{
+    return nodes.size();
+}
+
+std::size_t PointsOctree::countPoints() const
+{
+    return numPoints;
+}
+
+const PointsOctree::Node& PointsOctree::getNode(std::size_t index) const
+{
+    return nodes.at(index);
+}
+
+PointsPageCache::Page PointsOctree::getPoints(std::size_t index) const
+{
+    return cache.load(nodes.at(index).page);
+}
+
+std::vector<std::size_t>
+PointsOctree::selectNodes(const Base::Vector3f& eye,
+                          float pixelsPerUnit,
+                          float maxError,
+                          std::size_t budget,
+                          const std::function<bool(const Base::BoundBox3f&)>& isVisible) const
+{
+    auto error = [&](const Node& node) {
+        float distance = Base::Distance(eye, node.bounds.ClosestPoint(eye));
+        if (distance <= 0.0F) {
+            return std::numeric_limits<float>::max();
+        }
+        return node.spacing * pixelsPerUnit / distance;
+    };
+
+    std::vector<std::size_t> selection;
+    std::priority_queue<std::pair<float, std::size_t>> queue;
+    if (nodes[0].bounds.IsValid()) {
+        queue.emplace(error(nodes[0]), 0);
+    }
+
+    std::size_t numSelected = 0;
+    while (!queue.empty()) {
+        auto [err, index] = queue.top();
+        queue.pop();
+
+        const Node& node = nodes[index];
+        if (isVisible && !isVisible(node.bounds)) {
+            continue;
+        }
+
+        std::size_t count = cache.count(node.page);
+        if (numSelected + count > budget) {
+            break;
+        }
+        selection.push_back(index);
+        numSelected += count;
+
+        if (err <= maxError) {
+            continue;
+        }
+        for (int child : node.children) {
+            if (child >= 0 && nodes[child].bounds.IsValid()) {
+                queue.emplace(error(nodes[child]), child);
+            }
+        }
+    }
+
+    return selection;
+}
+
+void PointsOctree::forEachNode(
+    const std::function<void(const Node&, const std::vector<Base::Vector3f>&)>& func) const
+{
+    std::vector<std::size_t> indices;
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        if (cache.count(nodes[i].page) > 0) {
+            indices.push_back(i);
+        }
+    }
+
+    QtConcurrent::blockingMap(indices, [this, &func](std::size_t index) {
+        PointsPageCache::Page page = cache.load(nodes[index].page);
+        func(nodes[index], *page);
+    });
+}
@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL               *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+
+#ifndef POINTS_OCTREE_H
+#define POINTS_OCTREE_H
+
+#include <array>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <Base/BoundBox.h>
+#include <Base/FileInfo.h>
+#include <Base/Stream.h>
+#include <Base/Vector3D.h>
+
+#include <Mod/Points/PointsGlobal.h>
+
+namespace Points
+{
+
+/**
+ * The PointsPageCache class keeps the pages of point data of an octree. If the number of points
+ * in memory exceeds the limit the least recently used pages are written to a temporary swap
+ * file and read back on demand.
+ * A page is handed out as shared pointer so that it stays valid for the caller even if it gets
+ * evicted in the meantime. The class is thread-safe.
+ */
+class PointsExport PointsPageCache
+{
+public:
+    using Page = std::shared_ptr<const std::vector<Base::Vector3f>>;
+
+    explicit PointsPageCache(std::size_t maxPoints);
+    ~PointsPageCache();
+
+    /// Creates a new empty page and returns its index
+    std::size_t create();
+    /// Replaces the points of the page
+    void store(std::size_t page, std::vector<Base::Vector3f>&& points);
+    /// Returns the points of the page and reads them from disk if needed
+    Page load(std::size_t page);
+    /// Returns the number of points of the page
+    std::size_t count(std::size_t page) const;
+    /// Returns the number of points held in memory
+    std::size_t countResident() const;
+    /// Returns true if the page is held in memory
+    bool isResident(std::size_t page) const;
+
+    PointsPageCache(const PointsPageCache&) = delete;
+    PointsPageCache(PointsPageCache&&) = delete;
+    PointsPageCache& operator=(const PointsPageCache&) = delete;
+    PointsPageCache& operator=(PointsPageCache&&) = delete;
+
+private:
+    void touch(std::size_t page);
+    void evict();
+    void write(std::size_t page);
+    void read(std::size_t page);
+
+private:
+    struct Entry
+    {
+        Page data;
+        std::size_t count {0};
+        std::streamoff offset {-1};
+        std::list<std::size_t>::iterator lru;
+        bool resident {false};
+    };
+
+    mutable std::mutex mutex;
+    std::vector<Entry> entries;
+    std::list<std::size_t> lru;
+    std::size_t maxPoints;
+    std::size_t residentPoints {0};
+    Base::FileInfo swapFile;
+    std::unique_ptr<Base::ofstream> swapOut;
+    std::unique_ptr<Base::ifstream> swapIn;
+    std::streamoff swapSize {0};
+};
+
+/**
+ * The PointsOctree class is an out-of-core store for huge point clouds.
+ * Each node keeps a subsample of the points of its subtree with at most one point per cell
+ * of a grid over the node. The remaining points are passed to the children. So, the nodes
+ * near the root form the levels of detail of the point cloud while the leaves hold the rest.
+ * The point data of the nodes is kept in a PointsPageCache that swaps it to disk if it
+ * exceeds the memory limit.
+ */
+class PointsExport PointsOctree
+{
+public:
+    struct Node
+    {
+        /// The cube of the node
+        Base::BoundBox3f cube;
+        /// The bounding box of all points of the subtree
+        Base::BoundBox3f bounds;
+        /// The minimum distance of the sampled points of this node
+        float spacing {0.0F};
+        int depth {0};
+        std::size_t page {0};
+        std::array<int, 8> children {-1, -1, -1, -1, -1, -1, -1, -1};
+
+        bool isLeaf() const
+        {
+            return children[0] < 0;
+        }
+    };
+
+    /*!
+     * \brief PointsOctree
+     * \param box The bounding box of the points to be added. Points outside are stored in the
+     * nodes at the border.
+     * \param memoryLimit The maximum number of points kept in memory.
+     */
+    explicit PointsOctree(const Base::BoundBox3f& box, std::size_t memoryLimit = 50000000);
+
+    /// Adds a batch of points
+    void add(const std::vector<Base::Vector3f>& points);
+    std::size_t countNodes() const;
+    std::size_t countPoints() const;
+    const Node& getNode(std::size_t index) const;
+    /// Returns the points stored in the node
+    PointsPageCache::Page getPoints(std::size_t index) const;
+
+    /*!
+     * \brief Selects the nodes to display for a camera at \a eye.
+     * The screen-space error of a node is its point spacing as seen from the camera where
+     * \a pixelsPerUnit is the projected size of a unit length at distance 1. Starting with the
+     * root the nodes with the largest error are selected until the error of all selected
+     * nodes is below \a maxError or \a budget points are reached. Nodes for which
+     * \a isVisible returns false are skipped together with their subtree.
+     */
+    std::vector<std::size_t>
+    selectNodes(const Base::Vector3f& eye,
+                float pixelsPerUnit,
+                float maxError,
+                std::size_t budget,
+                const std::function<bool(const Base::BoundBox3f&)>& isVisible = {}) const;
+
+    /// Calls \a func for each non-empty node in parallel
+    void forEachNode(
+        const std::function<void(const Node&, const std::vector<Base::Vector3f>&)>& func) const;
+
+private:
+    void insert(std::size_t index, std::vector<Base::Vector3f>& points);
+    void split(std::size_t index);
+    std::size_t createNode(const Base::BoundBox3f& cube, int depth);
+
+private:
+    std::vector<Node> nodes;
+    mutable PointsPageCache cache;
+    std::size_t numPoints {0};
+};
+
+}  // namespace Points
+
+
+#endif  // POINTS_OCTREE_H
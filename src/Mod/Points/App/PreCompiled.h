@@ -36,14 +36,20 @@
 
 // standard
 #include <cstdio>
+#include <cstring>
 
 // STL
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <exception>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <queue>
 #include <set>
 #include <sstream>
+#include <unordered_set>
 #include <vector>
 
 // boost
@@ -22,12 +22,12 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
-#include <QtConcurrentMap>
 #include <algorithm>
 #include <cmath>
 #include <iostream>
 #endif
 
+#include <Base/BulkVector.h>
 #include <Base/Converter.h>
 #include <Base/Matrix.h>
 #include <Base/Persistence.h>
@@ -38,10 +38,6 @@
 #include "Points.h"
 #include "Properties.h"
 
-#ifdef _MSC_VER
-#include <ppl.h>
-#endif
-
 
 using namespace Points;
 using namespace std;
@@ -383,17 +379,7 @@ void PropertyNormalList::transformGeometry(const Base::Matrix4D& mat)
     aboutToSetValue();
 
     // Rotate the normal vectors
-#ifdef _MSC_VER
-    Concurrency::parallel_for_each(_lValueList.begin(),
-                                   _lValueList.end(),
-                                   [rot](Base::Vector3f& value) {
-                                       value = rot * value;
-                                   });
-#else
-    QtConcurrent::blockingMap(_lValueList, [rot](Base::Vector3f& value) {
-        rot.multVec(value, value);
-    });
-#endif
+    Base::BulkVector::transform(rot, _lValueList.data(), _lValueList.size());
 
     hasSetValue();
 }
@@ -520,11 +506,11 @@ void PropertyCurvatureList::transformGeometry(const Base::Matrix4D& mat)
     aboutToSetValue();
 
     // Rotate the principal directions
-    for (int ii = 0; ii < getSize(); ii++) {
-        CurvatureInfo ci = operator[](ii);
-        ci.cMaxCurvDir = rot * ci.cMaxCurvDir;
-        ci.cMinCurvDir = rot * ci.cMinCurvDir;
-        set1Value(ii, ci);
+    if (!_lValueList.empty()) {
+        std::size_t count = _lValueList.size();
+        std::size_t stride = sizeof(CurvatureInfo);
+        Base::BulkVector::transform(rot, &_lValueList.front().cMaxCurvDir, count, stride);
+        Base::BulkVector::transform(rot, &_lValueList.front().cMinCurvDir, count, stride);
     }
 
     hasSetValue();
@@ -124,6 +124,7 @@ public:
         add_keyword_method("filterVoxelGrid",&Module::filterVoxelGrid,
             "filterVoxelGrid(dim)."
         );
+#endif
         add_keyword_method("normalEstimation",&Module::normalEstimation,
             "normalEstimation(Points,[KSearch=0, SearchRadius=0]) -> Normals\n"
             "KSearch is an int and used to search the k-nearest neighbours in\n"
@@ -142,20 +143,17 @@ public:
             "f.ViewObject.Proxy=0\n"
             "f.ViewObject.DisplayMode=1\n"
         );
-#endif
-#if defined(HAVE_PCL_SEGMENTATION)
         add_keyword_method("regionGrowingSegmentation",&Module::regionGrowingSegmentation,
             "regionGrowingSegmentation()."
         );
+#if defined(HAVE_PCL_SEGMENTATION)
         add_keyword_method("featureSegmentation",&Module::featureSegmentation,
             "featureSegmentation()."
         );
 #endif
-#if defined(HAVE_PCL_SAMPLE_CONSENSUS)
         add_keyword_method("sampleConsensus",&Module::sampleConsensus,
             "sampleConsensus()."
         );
-#endif
         initialize("This module is the ReverseEngineering module."); // register with Python
     }
 
@@ -793,7 +791,6 @@ Mesh.show(m)
         return Py::asObject(new Points::PointsPy(points_sample));
     }
 #endif
-#if defined(HAVE_PCL_FILTERS)
     Py::Object normalEstimation(const Py::Tuple& args, const Py::Dict& kwds)
     {
         PyObject *pts;
@@ -808,21 +805,24 @@ Mesh.show(m)
 
         Points::PointKernel* points = static_cast<Points::PointsPy*>(pts)->getPointKernelPtr();
 
-        std::vector<Base::Vector3d> normals;
-        NormalEstimation estimate(*points);
-        estimate.setKSearch(ksearch);
-        estimate.setSearchRadius(searchRadius);
-        estimate.perform(normals);
+        try {
+            std::vector<Base::Vector3d> normals;
+            NormalEstimation estimate(*points);
+            estimate.setKSearch(ksearch);
+            estimate.setSearchRadius(searchRadius);
+            estimate.perform(normals);
+
+            Py::List list;
+            for (std::vector<Base::Vector3d>::iterator it = normals.begin(); it != normals.end(); ++it) {
+                list.append(Py::Vector(*it));
+            }
 
-        Py::List list;
-        for (std::vector<Base::Vector3d>::iterator it = normals.begin(); it != normals.end(); ++it) {
-            list.append(Py::Vector(*it));
+            return list;
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
         }
-
-        return list;
     }
-#endif
-#if defined(HAVE_PCL_SEGMENTATION)
     Py::Object regionGrowingSegmentation(const Py::Tuple& args, const Py::Dict& kwds)
     {
         PyObject *pts;
@@ -839,18 +839,23 @@ Mesh.show(m)
 
         std::list<std::vector<int> > clusters;
         RegionGrowing segm(*points, clusters);
-        if (vec) {
-            Py::Sequence list(vec);
-            std::vector<Base::Vector3f> normals;
-            normals.reserve(list.size());
-            for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
-                Base::Vector3d v = Py::Vector(*it).toVector();
-                normals.push_back(Base::convertTo<Base::Vector3f>(v));
+        try {
+            if (vec) {
+                Py::Sequence list(vec);
+                std::vector<Base::Vector3f> normals;
+                normals.reserve(list.size());
+                for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+                    Base::Vector3d v = Py::Vector(*it).toVector();
+                    normals.push_back(Base::convertTo<Base::Vector3f>(v));
+                }
+                segm.perform(normals);
+            }
+            else {
+                segm.perform(ksearch);
             }
-            segm.perform(normals);
         }
-        else {
-            segm.perform(ksearch);
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
         }
 
         Py::List lists;
@@ -864,6 +869,7 @@ Mesh.show(m)
 
         return lists;
     }
+#if defined(HAVE_PCL_SEGMENTATION)
     Py::Object featureSegmentation(const Py::Tuple& args, const Py::Dict& kwds)
     {
         PyObject *pts;
@@ -892,7 +898,6 @@ Mesh.show(m)
         return lists;
     }
 #endif
-#if defined(HAVE_PCL_SAMPLE_CONSENSUS)
 /*
 import ReverseEngineering as reen
 import Points
@@ -953,13 +958,23 @@ Points.show(np)
             else if (strcmp(sacModelType, "Sphere") == 0)
                 sacModel = SampleConsensus::SACMODEL_SPHERE;
             else if (strcmp(sacModelType, "Cone") == 0)
+#if defined(HAVE_PCL_SAMPLE_CONSENSUS)
                 sacModel = SampleConsensus::SACMODEL_CONE;
+#else
+                throw Py::ValueError("SAC model 'Cone' is only supported with PCL");
+#endif
         }
 
         std::vector<float> parameters;
-        SampleConsensus sample(sacModel, *points, normals);
         std::vector<int> model;
-        double probability = sample.perform(parameters, model);
+        double probability = 0.0;
+        try {
+            SampleConsensus sample(sacModel, *points, normals);
+            probability = sample.perform(parameters, model);
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
 
         Py::Dict dict;
         Py::Tuple tuple(parameters.size());
@@ -974,7 +989,6 @@ Points.show(np)
 
         return dict;
     }
-#endif
 };
 
 PyObject* initModule()
@@ -22,25 +22,27 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
-#include <QFuture>
-#include <QFutureWatcher>
+#include <algorithm>
+#include <functional>
+#include <QThread>
 #include <QtConcurrentMap>
 
 #include <Geom_BSplineSurface.hxx>
 #include <Precision.hxx>
-#include <math_Gauss.hxx>
-#include <math_Householder.hxx>
 #endif
 
+#include <Eigen/IterativeLinearSolvers>
+#include <Eigen/SparseCholesky>
+
+#include <Base/Console.h>
 #include <Base/Sequencer.h>
-#include <Base/Tools.h>
+#include <Base/TimeInfo.h>
 #include <Mod/Mesh/App/Core/Approximation.h>
 
 #include "ApproxSurface.h"
 
 
 using namespace Reen;
-namespace sp = std::placeholders;
 
 // SplineBasisfunction
 
@@ -958,6 +960,186 @@ void BSplineParameterCorrection::SetVKnots(const std::vector<double>& afKnots)
     _clVSpline.SetKnots(_vVKnots, _vVMults, _usVOrder);
 }
 
+namespace
+{
+// Minimum number of points per task
+const int PointsPerTask = 4096;
+
+struct PointRange
+{
+    int begin;
+    int end;
+};
+
+/*
+ * Splits the points into as many ranges as there are threads but gives each range at least
+ * PointsPerTask points.
+ */
+std::vector<PointRange> splitPoints(int lower, int upper)
+{
+    int count = upper - lower + 1;
+    int tasks = std::max(1, std::min(QThread::idealThreadCount(), count / PointsPerTask));
+    int size = (count + tasks - 1) / tasks;
+    std::vector<PointRange> ranges;
+    for (int begin = lower; begin <= upper; begin += size) {
+        ranges.push_back({begin, std::min(begin + size, upper + 1)});
+    }
+    return ranges;
+}
+
+/*
+ * The normal equations (M^T * M) * X = M^T * b of the least-squares problem. Two control points
+ * only interact if their basis functions overlap, i.e. if their indices differ by less than the
+ * order in both directions. So, the row of control point (j,k) only stores the entries of the
+ * control points (j + dj, k + dk) with |dj| < uOrder and |dk| < vOrder.
+ */
+class NormalEquations
+{
+public:
+    NormalEquations(int uCtrlpoints, int vCtrlpoints, int uOrder, int vOrder)
+        : uCtrlpoints(uCtrlpoints)
+        , vCtrlpoints(vCtrlpoints)
+        , uOrder(uOrder)
+        , vOrder(vOrder)
+        , width((2 * uOrder - 1) * (2 * vOrder - 1))
+        , band(std::size_t(uCtrlpoints * vCtrlpoints * width), 0.0)
+        , rhs(std::size_t(uCtrlpoints * vCtrlpoints) * 3, 0.0)
+    {}
+
+    /*
+     * Adds the points of the given range. The basis functions are evaluated only for the
+     * order * order control points whose support contains the parameter of a point.
+     */
+    void addPoints(const PointRange& range,
+                   const TColgp_Array1OfPnt& points,
+                   const TColgp_Array1OfPnt2d& uvParams,
+                   BSplineBasis& uSpline,
+                   BSplineBasis& vSpline,
+                   const TColStd_Array1OfReal& uKnots,
+                   const TColStd_Array1OfReal& vKnots)
+    {
+        TColStd_Array1OfReal uBasis(0, uOrder - 1);
+        TColStd_Array1OfReal vBasis(0, vOrder - 1);
+        std::vector<int> index(std::size_t(uOrder * vOrder));
+        std::vector<double> value(std::size_t(uOrder * vOrder));
+        for (int i = range.begin; i < range.end; i++) {
+            double fU = uvParams(i).X();
+            double fV = uvParams(i).Y();
+            // all basis functions vanish outside of the knot range
+            if (fU < uKnots(uKnots.Lower()) || fU > uKnots(uKnots.Upper())
+                || fV < vKnots(vKnots.Lower()) || fV > vKnots(vKnots.Upper())) {
+                continue;
+            }
+
+            int uFirst = uSpline.FindSpan(fU) - (uOrder - 1);
+            int vFirst = vSpline.FindSpan(fV) - (vOrder - 1);
+            uSpline.AllBasisFunctions(fU, uBasis);
+            vSpline.AllBasisFunctions(fV, vBasis);
+
+            int num = 0;
+            for (int a = 0; a < uOrder; a++) {
+                for (int b = 0; b < vOrder; b++) {
+                    index[num] = (uFirst + a) * vCtrlpoints + vFirst + b;
+                    value[num] = uBasis(a) * vBasis(b);
+                    num++;
+                }
+            }
+
+            const gp_Pnt& pnt = points(i);
+            for (int m = 0; m < num; m++) {
+                double* row = &band[std::size_t(index[m] * width)];
+                for (int n = 0; n < num; n++) {
+                    row[offset(index[m], index[n])] += value[m] * value[n];
+                }
+                double* b = &rhs[std::size_t(index[m]) * 3];
+                b[0] += value[m] * pnt.X();
+                b[1] += value[m] * pnt.Y();
+                b[2] += value[m] * pnt.Z();
+            }
+        }
+    }
+
+    NormalEquations& operator+=(const NormalEquations& other)
+    {
+        std::transform(band.begin(), band.end(), other.band.begin(), band.begin(), std::plus<>());
+        std::transform(rhs.begin(), rhs.end(), other.rhs.begin(), rhs.begin(), std::plus<>());
+        return *this;
+    }
+
+    /*
+     * Returns the system matrix with the weighted smoothing terms added. The smoothing matrix
+     * may be null.
+     */
+    Eigen::SparseMatrix<double> matrix(const math_Matrix* smooth, double fWeight) const
+    {
+        int dim = uCtrlpoints * vCtrlpoints;
+        std::vector<Eigen::Triplet<double>> triplets;
+        triplets.reserve(band.size());
+        for (int row = 0; row < dim; row++) {
+            int j = row / vCtrlpoints;
+            int k = row % vCtrlpoints;
+            for (int dj = 1 - uOrder; dj < uOrder; dj++) {
+                for (int dk = 1 - vOrder; dk < vOrder; dk++) {
+                    if (j + dj < 0 || j + dj >= uCtrlpoints || k + dk < 0
+                        || k + dk >= vCtrlpoints) {
+                        continue;
+                    }
+                    int col = row + dj * vCtrlpoints + dk;
+                    double value = band[std::size_t(row * width + offset(row, col))];
+                    if (value != 0.0) {
+                        triplets.emplace_back(row, col, value);
+                    }
+                }
+            }
+        }
+
+        if (smooth && fWeight != 0.0) {
+            for (int row = 0; row < dim; row++) {
+                for (int col = 0; col < dim; col++) {
+                    double value = (*smooth)(row, col);
+                    if (value != 0.0) {
+                        triplets.emplace_back(row, col, fWeight * value);
+                    }
+                }
+            }
+        }
+
+        Eigen::SparseMatrix<double> mat(dim, dim);
+        mat.setFromTriplets(triplets.begin(), triplets.end());
+        return mat;
+    }
+
+    Eigen::MatrixX3d rightHandSide() const
+    {
+        int dim = uCtrlpoints * vCtrlpoints;
+        Eigen::MatrixX3d b(dim, 3);
+        for (int i = 0; i < dim; i++) {
+            b(i, 0) = rhs[std::size_t(i) * 3];
+            b(i, 1) = rhs[std::size_t(i) * 3 + 1];
+            b(i, 2) = rhs[std::size_t(i) * 3 + 2];
+        }
+        return b;
+    }
+
+private:
+    int offset(int row, int col) const
+    {
+        int dj = col / vCtrlpoints - row / vCtrlpoints;
+        int dk = col % vCtrlpoints - row % vCtrlpoints;
+        return (dj + uOrder - 1) * (2 * vOrder - 1) + dk + vOrder - 1;
+    }
+
+private:
+    int uCtrlpoints;
+    int vCtrlpoints;
+    int uOrder;
+    int vOrder;
+    int width;
+    std::vector<double> band;
+    std::vector<double> rhs;
+};
+}  // namespace
+
 void BSplineParameterCorrection::DoParameterCorrection(int iIter)
 {
     int i = 0;
@@ -966,7 +1148,20 @@ void BSplineParameterCorrection::DoParameterCorrection(int iIter)
 
     Base::SequencerLauncher seq("Calc surface...", iIter * _pvcPoints->Length());
 
+    struct Correction
+    {
+        PointRange range;
+        double maxDiff;
+        double maxScalar;
+    };
+
+    std::vector<Correction> tasks;
+    for (const auto& it : splitPoints(_pvcPoints->Lower(), _pvcPoints->Upper())) {
+        tasks.push_back({it, 0.0, 1.0});
+    }
+
     do {
+        Base::TimeElapsed start;
         fMaxScalar = 1.0;
         fMaxDiff = 0.0;
 
@@ -978,50 +1173,63 @@ void BSplineParameterCorrection::DoParameterCorrection(int iIter)
                                                                              _usUOrder - 1,
                                                                              _usVOrder - 1);
 
-        for (int ii = _pvcPoints->Lower(); ii <= _pvcPoints->Upper(); ii++) {
-            double fDeltaU, fDeltaV, fU, fV;
-            const gp_Pnt& pnt = (*_pvcPoints)(ii);
-            gp_Vec P(pnt.X(), pnt.Y(), pnt.Z());
-            gp_Pnt PntX;
-            gp_Vec Xu, Xv, Xuv, Xuu, Xvv;
-            // Calculate the first two derivatives and point at (u,v)
-            gp_Pnt2d& uvValue = (*_pvcUVParam)(ii);
-            pclBSplineSurf->D2(uvValue.X(), uvValue.Y(), PntX, Xu, Xv, Xuu, Xvv, Xuv);
-            gp_Vec X(PntX.X(), PntX.Y(), PntX.Z());
-            gp_Vec ErrorVec = X - P;
-
-            // Calculate Xu x Xv the normal in X(u,v)
-            gp_Dir clNormal = Xu ^ Xv;
-
-            // Check, if X = P
-            if (!(X.IsEqual(P, 0.001, 0.001))) {
-                ErrorVec.Normalize();
-                if (fabs(clNormal * ErrorVec) < fMaxScalar) {
-                    fMaxScalar = fabs(clNormal * ErrorVec);
+        // Each point only changes its own (u,v) parameters, so the points are corrected in
+        // parallel with a copy of the surface per task
+        QtConcurrent::blockingMap(tasks, [this, &pclBSplineSurf](Correction& task) {
+            Handle(Geom_BSplineSurface) surf =
+                Handle(Geom_BSplineSurface)::DownCast(pclBSplineSurf->Copy());
+            task.maxDiff = 0.0;
+            task.maxScalar = 1.0;
+            for (int ii = task.range.begin; ii < task.range.end; ii++) {
+                double fDeltaU, fDeltaV, fU, fV;
+                const gp_Pnt& pnt = (*_pvcPoints)(ii);
+                gp_Vec P(pnt.X(), pnt.Y(), pnt.Z());
+                gp_Pnt PntX;
+                gp_Vec Xu, Xv, Xuv, Xuu, Xvv;
+                // Calculate the first two derivatives and point at (u,v)
+                gp_Pnt2d& uvValue = (*_pvcUVParam)(ii);
+                surf->D2(uvValue.X(), uvValue.Y(), PntX, Xu, Xv, Xuu, Xvv, Xuv);
+                gp_Vec X(PntX.X(), PntX.Y(), PntX.Z());
+                gp_Vec ErrorVec = X - P;
+
+                // Calculate Xu x Xv the normal in X(u,v)
+                gp_Dir clNormal = Xu ^ Xv;
+
+                // Check, if X = P
+                if (!(X.IsEqual(P, 0.001, 0.001))) {
+                    ErrorVec.Normalize();
+                    if (fabs(clNormal * ErrorVec) < task.maxScalar) {
+                        task.maxScalar = fabs(clNormal * ErrorVec);
+                    }
                 }
-            }
 
-            fDeltaU = ((P - X) * Xu) / ((P - X) * Xuu - Xu * Xu);
-            if (fabs(fDeltaU) < Precision::Confusion()) {
-                fDeltaU = 0.0;
-            }
-            fDeltaV = ((P - X) * Xv) / ((P - X) * Xvv - Xv * Xv);
-            if (fabs(fDeltaV) < Precision::Confusion()) {
-                fDeltaV = 0.0;
-            }
+                fDeltaU = ((P - X) * Xu) / ((P - X) * Xuu - Xu * Xu);
+                if (fabs(fDeltaU) < Precision::Confusion()) {
+                    fDeltaU = 0.0;
+                }
+                fDeltaV = ((P - X) * Xv) / ((P - X) * Xvv - Xv * Xv);
+                if (fabs(fDeltaV) < Precision::Confusion()) {
+                    fDeltaV = 0.0;
+                }
 
-            // Replace old u/v values with new ones
-            fU = uvValue.X() - fDeltaU;
-            fV = uvValue.Y() - fDeltaV;
-            if (fU <= 1.0 && fU >= 0.0 && fV <= 1.0 && fV >= 0.0) {
-                uvValue.SetX(fU);
-                uvValue.SetY(fV);
-                fMaxDiff = std::max<double>(fabs(fDeltaU), fMaxDiff);
-                fMaxDiff = std::max<double>(fabs(fDeltaV), fMaxDiff);
+                // Replace old u/v values with new ones
+                fU = uvValue.X() - fDeltaU;
+                fV = uvValue.Y() - fDeltaV;
+                if (fU <= 1.0 && fU >= 0.0 && fV <= 1.0 && fV >= 0.0) {
+                    uvValue.SetX(fU);
+                    uvValue.SetY(fV);
+                    task.maxDiff = std::max<double>(fabs(fDeltaU), task.maxDiff);
+                    task.maxDiff = std::max<double>(fabs(fDeltaV), task.maxDiff);
+                }
             }
+        });
 
-            seq.next();
+        for (const auto& it : tasks) {
+            fMaxScalar = std::min(fMaxScalar, it.maxScalar);
+            fMaxDiff = std::max(fMaxDiff, it.maxDiff);
         }
+        seq.setProgress(std::size_t(i + 1) * std::size_t(_pvcPoints->Length()));
+        float correction = Base::TimeElapsed::diffTimeF(start);
 
         if (_bSmoothing) {
             fWeight *= 0.5f;
@@ -1031,234 +1239,105 @@ void BSplineParameterCorrection::DoParameterCorrection(int iIter)
             SolveWithoutSmoothing();
         }
 
+        Base::Console().Log("Parameter correction %d: %.3f s correction, %.3f s in total, "
+                            "max. change %g, min. angle %g\n",
+                            i + 1,
+                            correction,
+                            Base::TimeElapsed::diffTimeF(start),
+                            fMaxDiff,
+                            fMaxScalar);
         i++;
     } while (i < iIter && fMaxDiff > Precision::Confusion() && fMaxScalar < 0.99);
 }
 
 bool BSplineParameterCorrection::SolveWithoutSmoothing()
 {
-    unsigned ulSize = _pvcPoints->Length();
-    unsigned ulDim = _usUCtrlpoints * _usVCtrlpoints;
-    math_Matrix M(0, ulSize - 1, 0, ulDim - 1);
-    math_Matrix Xx(0, ulDim - 1, 0, 0);
-    math_Matrix Xy(0, ulDim - 1, 0, 0);
-    math_Matrix Xz(0, ulDim - 1, 0, 0);
-    math_Vector bx(0, ulSize - 1);
-    math_Vector by(0, ulSize - 1);
-    math_Vector bz(0, ulSize - 1);
-
-    // Determining the coefficient matrix of the overdetermined LGS
-    for (unsigned i = 0; i < ulSize; i++) {
-        const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
-        double fU = uvValue.X();
-        double fV = uvValue.Y();
-        unsigned ulIdx = 0;
-
-        // Pre-calculation of the values of the base functions
-        std::vector<double> basisU(_usUCtrlpoints);
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            basisU[j] = _clUSpline.BasisFunction(j, fU);
-        }
-        std::vector<double> basisV(_usVCtrlpoints);
-        for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            basisV[k] = _clVSpline.BasisFunction(k, fV);
-        }
-
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            double valueU = basisU[j];
-            if (valueU == 0.0) {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = 0.0;
-                    ulIdx++;
-                }
-            }
-            else {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = valueU * basisV[k];
-                    ulIdx++;
-                }
-            }
-        }
-    }
-
-    // Determine the right side
-    for (int ii = _pvcPoints->Lower(); ii <= _pvcPoints->Upper(); ii++) {
-        const gp_Pnt& pnt = (*_pvcPoints)(ii);
-        bx(ii) = pnt.X();
-        by(ii) = pnt.Y();
-        bz(ii) = pnt.Z();
-    }
-
-    // Solve the over-determined LGS with Householder-Transformation
-    math_Householder hhX(M, bx);
-    math_Householder hhY(M, by);
-    math_Householder hhZ(M, bz);
-
-    if (!(hhX.IsDone() && hhY.IsDone() && hhZ.IsDone())) {
-        // LGS could not be solved
-        return false;
-    }
-    Xx = hhX.AllValues();
-    Xy = hhY.AllValues();
-    Xz = hhZ.AllValues();
-
-    unsigned ulIdx = 0;
-    for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-        for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            _vCtrlPntsOfSurf(j, k) = gp_Pnt(Xx(ulIdx, 0), Xy(ulIdx, 0), Xz(ulIdx, 0));
-            ulIdx++;
-        }
-    }
-
-    return true;
+    return SolveNormalEquations(nullptr, 0.0);
 }
 
-namespace Reen
-{
-class ScalarProduct
+bool BSplineParameterCorrection::SolveWithSmoothing(double fWeight)
 {
-public:
-    explicit ScalarProduct(const math_Matrix& mat)
-        : mat(mat)
-    {}
-    std::vector<double> multiply(int col) const
-    {
-        math_Vector vec = mat.Col(col);
-        std::vector<double> out(mat.ColNumber());
-        for (int n = mat.LowerCol(); n <= mat.UpperCol(); n++) {
-            out[n] = vec * mat.Col(n);
-        }
-        return out;
-    }
-
-private:
-    const math_Matrix& mat;
-};
-}  // namespace Reen
+    return SolveNormalEquations(&_clSmoothMatrix, fWeight);
+}
 
-bool BSplineParameterCorrection::SolveWithSmoothing(double fWeight)
+bool BSplineParameterCorrection::SolveNormalEquations(const math_Matrix* smooth, double fWeight)
 {
-    unsigned ulSize = _pvcPoints->Length();
-    unsigned ulDim = _usUCtrlpoints * _usVCtrlpoints;
-    math_Matrix M(0, ulSize - 1, 0, ulDim - 1);
-    math_Vector Xx(0, ulDim - 1);
-    math_Vector Xy(0, ulDim - 1);
-    math_Vector Xz(0, ulDim - 1);
-    math_Vector bx(0, ulSize - 1);
-    math_Vector by(0, ulSize - 1);
-    math_Vector bz(0, ulSize - 1);
-    math_Vector Mbx(0, ulDim - 1);
-    math_Vector Mby(0, ulDim - 1);
-    math_Vector Mbz(0, ulDim - 1);
-
-    // Determining the coefficient matrix of the overdetermined LGS
-    for (unsigned i = 0; i < ulSize; i++) {
-        const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
-        double fU = uvValue.X();
-        double fV = uvValue.Y();
+    Base::TimeElapsed start;
+    int uCtrlpoints = static_cast<int>(_usUCtrlpoints);
+    int vCtrlpoints = static_cast<int>(_usVCtrlpoints);
+    int uOrder = static_cast<int>(_usUOrder);
+    int vOrder = static_cast<int>(_usVOrder);
+
+    // Each task sets up the normal equations of its points. The partial systems are summed up
+    // in the order of the tasks.
+    struct Assembly
+    {
+        PointRange range;
+        NormalEquations equations;
+    };
+
+    std::vector<Assembly> tasks;
+    for (const auto& it : splitPoints(_pvcPoints->Lower(), _pvcPoints->Upper())) {
+        tasks.push_back({it, NormalEquations(uCtrlpoints, vCtrlpoints, uOrder, vOrder)});
+    }
+    QtConcurrent::blockingMap(tasks, [this](Assembly& task) {
+        task.equations.addPoints(task.range,
+                                 *_pvcPoints,
+                                 *_pvcUVParam,
+                                 _clUSpline,
+                                 _clVSpline,
+                                 _vUKnots,
+                                 _vVKnots);
+    });
+    for (std::size_t i = 1; i < tasks.size(); i++) {
+        tasks.front().equations += tasks[i].equations;
+    }
+
+    const NormalEquations& equations = tasks.front().equations;
+    Eigen::SparseMatrix<double> mat = equations.matrix(smooth, fWeight);
+    Eigen::MatrixX3d rhs = equations.rightHandSide();
+    float assembly = Base::TimeElapsed::diffTimeF(start);
+
+    // The system is symmetric and positive definite unless there are control points without any
+    // points in the support of their basis functions. In this case the direct solver fails and
+    // the iterative one starts with the current control points.
+    const char* solver = "LDLT";
+    Eigen::MatrixX3d result;
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> ldlt(mat);
+    if (ldlt.info() == Eigen::Success) {
+        result = ldlt.solve(rhs);
+    }
+    if (ldlt.info() != Eigen::Success || !result.allFinite()) {
+        solver = "CG";
+        Eigen::MatrixX3d guess(mat.rows(), 3);
         int ulIdx = 0;
-
-        // Pre-calculation of the values of the basis functions
-        std::vector<double> basisU(_usUCtrlpoints);
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            basisU[j] = _clUSpline.BasisFunction(j, fU);
-        }
-        std::vector<double> basisV(_usVCtrlpoints);
-        for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            basisV[k] = _clVSpline.BasisFunction(k, fV);
-        }
-
         for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            double valueU = basisU[j];
-            if (valueU == 0.0) {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = 0.0;
-                    ulIdx++;
-                }
-            }
-            else {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = valueU * basisV[k];
-                    ulIdx++;
-                }
+            for (unsigned k = 0; k < _usVCtrlpoints; k++) {
+                const gp_Pnt& pole = _vCtrlPntsOfSurf(j, k);
+                guess.row(ulIdx++) << pole.X(), pole.Y(), pole.Z();
             }
         }
-    }
 
-    // The product of its transform and itself results in the quadratic
-    // system matrix (slowly)
-#if 0
-    math_Matrix MTM = M.TMultiply(M);
-#elif 0
-    math_Matrix MTM(0, ulDim - 1, 0, ulDim - 1);
-    for (unsigned m = 0; m < ulDim; m++) {
-        math_Vector Mm = M.Col(m);
-        for (unsigned n = m; n < ulDim; n++) {
-            MTM(m, n) = MTM(n, m) = Mm * M.Col(n);
-        }
-    }
-#else  // multi-threaded
-    std::vector<int> columns(ulDim);
-    std::generate(columns.begin(), columns.end(), Base::iotaGen<int>(0));
-    ScalarProduct scalar(M);
-    // NOLINTBEGIN
-    QFuture<std::vector<double>> future =
-        QtConcurrent::mapped(columns, std::bind(&ScalarProduct::multiply, &scalar, sp::_1));
-    // NOLINTEND
-    QFutureWatcher<std::vector<double>> watcher;
-    watcher.setFuture(future);
-    watcher.waitForFinished();
-
-    math_Matrix MTM(0, ulDim - 1, 0, ulDim - 1);
-    int rowIndex = 0;
-    for (const auto& it : future) {
-        int colIndex = 0;
-        for (std::vector<double>::const_iterator jt = it.begin(); jt != it.end();
-             ++jt, colIndex++) {
-            MTM(rowIndex, colIndex) = *jt;
+        Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower | Eigen::Upper> cg(mat);
+        result = cg.solveWithGuess(rhs, guess);
+        if (cg.info() != Eigen::Success || !result.allFinite()) {
+            // LGS could not be solved
+            return false;
         }
-        rowIndex++;
-    }
-#endif
-
-    // Determine the right side
-    for (int ii = _pvcPoints->Lower(); ii <= _pvcPoints->Upper(); ii++) {
-        const gp_Pnt& pnt = (*_pvcPoints)(ii);
-        bx(ii) = pnt.X();
-        by(ii) = pnt.Y();
-        bz(ii) = pnt.Z();
-    }
-    for (unsigned i = 0; i < ulDim; i++) {
-        math_Vector Mi = M.Col(i);
-        Mbx(i) = Mi * bx;
-        Mby(i) = Mi * by;
-        Mbz(i) = Mi * bz;
-    }
-
-    // Solve the LGS with the LU decomposition
-    math_Gauss mgGaussX(MTM + fWeight * _clSmoothMatrix);
-    math_Gauss mgGaussY(MTM + fWeight * _clSmoothMatrix);
-    math_Gauss mgGaussZ(MTM + fWeight * _clSmoothMatrix);
-
-    mgGaussX.Solve(Mbx, Xx);
-    if (!mgGaussX.IsDone()) {
-        return false;
-    }
-
-    mgGaussY.Solve(Mby, Xy);
-    if (!mgGaussY.IsDone()) {
-        return false;
     }
 
-    mgGaussZ.Solve(Mbz, Xz);
-    if (!mgGaussZ.IsDone()) {
-        return false;
-    }
+    Base::Console().Log("B-spline approximation of %d points with %d control points: "
+                        "%.3f s assembly, %.3f s solving (%s)\n",
+                        _pvcPoints->Length(),
+                        static_cast<int>(mat.rows()),
+                        assembly,
+                        Base::TimeElapsed::diffTimeF(start) - assembly,
+                        solver);
 
-    unsigned ulIdx = 0;
+    int ulIdx = 0;
     for (unsigned j = 0; j < _usUCtrlpoints; j++) {
         for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            _vCtrlPntsOfSurf(j, k) = gp_Pnt(Xx(ulIdx), Xy(ulIdx), Xz(ulIdx));
+            _vCtrlPntsOfSurf(j, k) = gp_Pnt(result(ulIdx, 0), result(ulIdx, 1), result(ulIdx, 2));
             ulIdx++;
         }
     }
@@ -404,15 +404,21 @@ protected:
     void DoParameterCorrection(int iIter) override;
 
     /**
-     * Solve an overdetermined LGS with the help of the Householder-Tansformation
+     * Solve an overdetermined LGS in the least-squares sense
      */
     bool SolveWithoutSmoothing() override;
 
     /**
-     * Solve a regular system of equations by LU decomposition. Depending on the weighting,
-     * smoothing terms are included
+     * Solve a regular system of equations. Depending on the weighting, smoothing terms are
+     * included
      */
     bool SolveWithSmoothing(double fWeight) override;
+    /**
+     * Sets up the normal equations as sparse matrix on several threads and solves them with a
+     * sparse Cholesky decomposition, or iteratively if the system is singular. If \a smooth
+     * is not null the smoothing terms are added with the weight \a fWeight.
+     */
+    bool SolveNormalEquations(const math_Matrix* smooth, double fWeight);
 
 public:
     /**
@@ -41,7 +41,9 @@
 #ifdef _PreComp_
 
 // standard
+#include <deque>
 #include <map>
+#include <random>
 
 // boost
 #include <boost/math/special_functions/fpclassify.hpp>
@@ -22,10 +22,16 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
+#include <cmath>
+#include <deque>
+
 #include <boost/math/special_functions/fpclassify.hpp>
 #endif
 
+#include <Base/Exception.h>
 #include <Mod/Points/App/Points.h>
+#include <Mod/Points/App/PointsKDTree.h>
 
 #include "RegionGrowing.h"
 
@@ -155,4 +161,113 @@ void RegionGrowing::perform(const std::vector<Base::Vector3f>& myNormals)
     }
 }
 
+#else
+
+using namespace Reen;
+
+namespace
+{
+// The same parameters as used for PCL's region growing
+const int NumberOfNeighbours = 30;
+const std::size_t MinClusterSize = 50;
+const std::size_t MaxClusterSize = 1000000;
+const double SmoothnessThreshold = 3.0 / 180.0 * M_PI;
+const float CurvatureThreshold = 1.0F;
+
+bool isValid(const Base::Vector3f& v)
+{
+    return !boost::math::isnan(v.x) && !boost::math::isnan(v.y) && !boost::math::isnan(v.z);
+}
+
+/*
+ * Grows the regions like pcl::RegionGrowing does: starting with the point of lowest curvature
+ * a neighbour is added to the region if the angle between its normal and the normal of the
+ * current seed is below the smoothness threshold. It becomes a seed itself if its curvature is
+ * below the curvature threshold.
+ * The neighbour search is the expensive part and runs in parallel before growing the regions.
+ */
+void growRegions(const Points::PointsKDTree& tree,
+                 const std::vector<Base::Vector3f>& normals,
+                 const std::vector<float>& curvatures,
+                 std::list<std::vector<int>>& clusters)
+{
+    std::vector<std::vector<int>> neighbours;
+    tree.nearestNeighbours(NumberOfNeighbours, neighbours);
+
+    std::vector<int> seeds;
+    seeds.reserve(tree.size());
+    for (std::size_t index = 0; index < tree.size(); index++) {
+        if (isValid(tree.getPoint(index)) && isValid(normals[index])) {
+            seeds.push_back(static_cast<int>(index));
+        }
+    }
+    std::stable_sort(seeds.begin(), seeds.end(), [&curvatures](int lhs, int rhs) {
+        return curvatures[lhs] < curvatures[rhs];
+    });
+
+    const float cosThreshold = static_cast<float>(std::cos(SmoothnessThreshold));
+    std::vector<bool> labeled(tree.size(), false);
+    std::deque<int> queue;
+    for (int seed : seeds) {
+        if (labeled[seed]) {
+            continue;
+        }
+
+        std::vector<int> region;
+        labeled[seed] = true;
+        region.push_back(seed);
+        queue.push_back(seed);
+        while (!queue.empty()) {
+            int current = queue.front();
+            queue.pop_front();
+            const Base::Vector3f& normal = normals[current];
+            for (int it : neighbours[current]) {
+                if (labeled[it] || !isValid(normals[it])) {
+                    continue;
+                }
+                if (std::fabs(normal * normals[it]) < cosThreshold) {
+                    continue;
+                }
+
+                labeled[it] = true;
+                region.push_back(it);
+                if (curvatures[it] < CurvatureThreshold) {
+                    queue.push_back(it);
+                }
+            }
+        }
+
+        if (region.size() >= MinClusterSize && region.size() <= MaxClusterSize) {
+            clusters.push_back(std::move(region));
+        }
+    }
+}
+}  // namespace
+
+RegionGrowing::RegionGrowing(const Points::PointKernel& pts, std::list<std::vector<int>>& clusters)
+    : myPoints(pts)
+    , myClusters(clusters)
+{}
+
+void RegionGrowing::perform(int ksearch)
+{
+    Points::PointsKDTree tree(myPoints);
+    std::vector<Base::Vector3f> normals;
+    std::vector<float> curvatures;
+    tree.estimateNormals(ksearch, 0.0F, normals, &curvatures);
+    growRegions(tree, normals, curvatures, myClusters);
+}
+
+void RegionGrowing::perform(const std::vector<Base::Vector3f>& myNormals)
+{
+    if (myPoints.size() != myNormals.size()) {
+        throw Base::RuntimeError("Number of points doesn't match with number of normals");
+    }
+
+    // Without estimating the normals there is no curvature and each point can be a seed
+    Points::PointsKDTree tree(myPoints.getBasicPoints());
+    std::vector<float> curvatures(myNormals.size(), 0.0F);
+    growRegions(tree, myNormals, curvatures, myClusters);
+}
+
 #endif  // HAVE_PCL_SEGMENTATION
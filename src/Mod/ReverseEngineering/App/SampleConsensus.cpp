@@ -22,7 +22,14 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+
 #include <boost/math/special_functions/fpclassify.hpp>
+#include <QtConcurrentMap>
 #endif
 
 #include <Base/Exception.h>
@@ -140,4 +147,263 @@ double SampleConsensus::perform(std::vector<float>& parameters, std::vector<int>
     return ransac.getProbability();
 }
 
+#else
+
+using namespace Reen;
+
+namespace
+{
+// The same settings as used for PCL's RandomSampleConsensus
+const double DistanceThreshold = 0.01;
+const double Probability = 0.99;
+const int MaxIterations = 1000;
+const int MaxSkip = 10 * MaxIterations;
+// Number of hypotheses that are drawn at once and scored in parallel
+const std::size_t HypothesesPerBatch = 64;
+
+bool isValid(const Base::Vector3d& v)
+{
+    return !boost::math::isnan(v.x) && !boost::math::isnan(v.y) && !boost::math::isnan(v.z);
+}
+
+int sampleSize(SampleConsensus::SacModel sac)
+{
+    switch (sac) {
+        case SampleConsensus::SACMODEL_PLANE:
+            return 3;
+        case SampleConsensus::SACMODEL_SPHERE:
+            return 4;
+        case SampleConsensus::SACMODEL_CYLINDER:
+            return 2;
+        default:
+            throw Base::RuntimeError("Unsupported SAC model");
+    }
+}
+
+struct Hypothesis
+{
+    std::array<int, 4> sample {};
+    std::array<double, 7> coefficients {};
+    std::size_t inliers = 0;
+    bool valid = false;
+};
+
+/*
+ * Computes the model coefficients from a minimal sample in the same form as PCL does:
+ * plane: [normal, d], sphere: [center, radius], cylinder: [point on axis, axis, radius]
+ */
+bool computeModel(SampleConsensus::SacModel sac,
+                  const std::vector<Base::Vector3d>& points,
+                  const std::vector<Base::Vector3d>& normals,
+                  Hypothesis& hyp)
+{
+    const double eps = std::numeric_limits<double>::epsilon();
+    const Base::Vector3d& p0 = points[hyp.sample[0]];
+    const Base::Vector3d& p1 = points[hyp.sample[1]];
+    switch (sac) {
+        case SampleConsensus::SACMODEL_PLANE: {
+            Base::Vector3d normal = (p1 - p0) % (points[hyp.sample[2]] - p0);
+            double len = normal.Length();
+            if (len <= eps) {
+                return false;
+            }
+            normal /= len;
+            hyp.coefficients = {normal.x, normal.y, normal.z, -(normal * p0)};
+            return true;
+        }
+        case SampleConsensus::SACMODEL_SPHERE: {
+            // the center has the same distance to all four points
+            std::array<Base::Vector3d, 3> rows;
+            std::array<double, 3> rhs {};
+            for (std::size_t i = 0; i < 3; i++) {
+                const Base::Vector3d& pi = points[hyp.sample[i + 1]];
+                rows[i] = 2.0 * (pi - p0);
+                rhs[i] = pi.Sqr() - p0.Sqr();
+            }
+            Base::Vector3d c12 = rows[1] % rows[2];
+            Base::Vector3d c20 = rows[2] % rows[0];
+            Base::Vector3d c01 = rows[0] % rows[1];
+            double det = rows[0] * c12;
+            double scale = rows[0].Length() * rows[1].Length() * rows[2].Length();
+            if (std::fabs(det) <= 1e-12 * scale) {
+                return false;
+            }
+            Base::Vector3d center = (rhs[0] * c12 + rhs[1] * c20 + rhs[2] * c01) / det;
+            double radius = Base::Distance(center, p0);
+            hyp.coefficients = {center.x, center.y, center.z, radius};
+            return true;
+        }
+        case SampleConsensus::SACMODEL_CYLINDER: {
+            // the axis is the shortest connection of the two normal lines
+            const Base::Vector3d& n0 = normals[hyp.sample[0]];
+            const Base::Vector3d& n1 = normals[hyp.sample[1]];
+            if (Base::DistanceP2(p0, p1) <= eps) {
+                return false;
+            }
+            Base::Vector3d w = n0 + p0 - p1;
+            double a = n0 * n0;
+            double b = n0 * n1;
+            double c = n1 * n1;
+            double d = n0 * w;
+            double e = n1 * w;
+            double denominator = a * c - b * b;
+            double sc {};
+            double tc {};
+            if (denominator < 1e-8) {
+                sc = 0.0;
+                tc = (b > c ? d / b : e / c);
+            }
+            else {
+                sc = (b * e - c * d) / denominator;
+                tc = (a * e - b * d) / denominator;
+            }
+
+            Base::Vector3d linePnt = p0 + n0 + sc * n0;
+            Base::Vector3d lineDir = p1 + tc * n1 - linePnt;
+            double len = lineDir.Length();
+            if (len <= eps || !isValid(linePnt) || !isValid(lineDir)) {
+                return false;
+            }
+            lineDir /= len;
+            double radius = p0.DistanceToLine(linePnt, lineDir);
+            hyp.coefficients =
+                {linePnt.x, linePnt.y, linePnt.z, lineDir.x, lineDir.y, lineDir.z, radius};
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+double distanceToModel(SampleConsensus::SacModel sac,
+                       const std::array<double, 7>& coeff,
+                       const Base::Vector3d& pnt)
+{
+    switch (sac) {
+        case SampleConsensus::SACMODEL_PLANE:
+            return std::fabs(coeff[0] * pnt.x + coeff[1] * pnt.y + coeff[2] * pnt.z + coeff[3]);
+        case SampleConsensus::SACMODEL_SPHERE:
+            return std::fabs(Base::Distance(pnt, Base::Vector3d(coeff[0], coeff[1], coeff[2]))
+                             - coeff[3]);
+        case SampleConsensus::SACMODEL_CYLINDER:
+            return std::fabs(pnt.DistanceToLine(Base::Vector3d(coeff[0], coeff[1], coeff[2]),
+                                                Base::Vector3d(coeff[3], coeff[4], coeff[5]))
+                             - coeff[6]);
+        default:
+            return std::numeric_limits<double>::max();
+    }
+}
+}  // namespace
+
+SampleConsensus::SampleConsensus(SacModel sac,
+                                 const Points::PointKernel& pts,
+                                 const std::vector<Base::Vector3d>& nor)
+    : mySac(sac)
+    , myPoints(pts)
+    , myNormals(nor)
+{}
+
+double SampleConsensus::perform(std::vector<float>& parameters, std::vector<int>& model)
+{
+    const int size = sampleSize(mySac);
+    const bool useNormals = (mySac == SACMODEL_CYLINDER);
+    if (useNormals && myNormals.size() != myPoints.size()) {
+        throw Base::RuntimeError("Number of points doesn't match with number of normals");
+    }
+
+    std::vector<Base::Vector3d> points;
+    points.reserve(myPoints.size());
+    for (Points::PointKernel::const_iterator it = myPoints.begin(); it != myPoints.end(); ++it) {
+        points.push_back(*it);
+    }
+
+    // only points with valid coordinates (and normals) take part
+    std::vector<int> valid;
+    valid.reserve(points.size());
+    for (std::size_t index = 0; index < points.size(); index++) {
+        if (isValid(points[index]) && (!useNormals || isValid(myNormals[index]))) {
+            valid.push_back(static_cast<int>(index));
+        }
+    }
+    if (valid.size() < static_cast<std::size_t>(size)) {
+        return 0.0;
+    }
+
+    // The hypotheses are drawn sequentially with a fixed seed so that the result doesn't
+    // depend on the number of threads. Only the scoring runs in parallel.
+    std::mt19937 rng(12345);  // NOLINT
+    std::uniform_int_distribution<std::size_t> random(0, valid.size() - 1);
+    auto drawSample = [&](Hypothesis& hyp) {
+        for (int i = 0; i < size; i++) {
+            bool unique = false;
+            while (!unique) {
+                hyp.sample[i] = valid[random(rng)];
+                unique = std::find(hyp.sample.begin(), hyp.sample.begin() + i, hyp.sample[i])
+                    == hyp.sample.begin() + i;
+            }
+        }
+    };
+    auto scoreModel = [&](Hypothesis& hyp) {
+        hyp.valid = computeModel(mySac, points, myNormals, hyp);
+        if (hyp.valid) {
+            for (int index : valid) {
+                if (distanceToModel(mySac, hyp.coefficients, points[index]) < DistanceThreshold) {
+                    hyp.inliers++;
+                }
+            }
+        }
+    };
+
+    Hypothesis best;
+    double maxIterations = std::numeric_limits<double>::max();
+    int iterations = 0;
+    int skipped = 0;
+    std::vector<Hypothesis> batch(HypothesesPerBatch);
+    while (iterations < maxIterations && iterations < MaxIterations && skipped < MaxSkip) {
+        for (auto& it : batch) {
+            it = Hypothesis();
+            drawSample(it);
+        }
+        QtConcurrent::blockingMap(batch, scoreModel);
+
+        // evaluate the hypotheses in the order they were drawn
+        for (const auto& it : batch) {
+            if (iterations >= maxIterations || iterations >= MaxIterations || skipped >= MaxSkip) {
+                break;
+            }
+            if (!it.valid) {
+                skipped++;
+                continue;
+            }
+            if (it.inliers > best.inliers) {
+                best = it;
+                // adapt the number of iterations to the fraction of inliers
+                double w = double(best.inliers) / double(valid.size());
+                double noOutliers = 1.0 - std::pow(w, size);
+                noOutliers = std::max(std::numeric_limits<double>::epsilon(), noOutliers);
+                noOutliers = std::min(1.0 - std::numeric_limits<double>::epsilon(), noOutliers);
+                maxIterations = std::log(1.0 - Probability) / std::log(noOutliers);
+            }
+            iterations++;
+        }
+    }
+
+    if (!best.valid) {
+        return Probability;
+    }
+
+    for (int index : valid) {
+        if (distanceToModel(mySac, best.coefficients, points[index]) < DistanceThreshold) {
+            model.push_back(index);
+        }
+    }
+
+    std::size_t numCoefficients = (mySac == SACMODEL_CYLINDER ? 7 : 4);
+    for (std::size_t i = 0; i < numCoefficients; i++) {
+        parameters.push_back(static_cast<float>(best.coefficients[i]));
+    }
+
+    return Probability;
+}
+
 #endif  // HAVE_PCL_SAMPLE_CONSENSUS
@@ -22,7 +22,9 @@
 
 #include "PreCompiled.h"
 
+#include <Base/Exception.h>
 #include <Mod/Points/App/Points.h>
+#include <Mod/Points/App/PointsKDTree.h>
 
 #include "Segmentation.h"
 
@@ -212,4 +214,29 @@ void NormalEstimation::perform(std::vector<Base::Vector3d>& normals)
     }
 }
 
+#else
+NormalEstimation::NormalEstimation(const Points::PointKernel& pts)
+    : myPoints(pts)
+    , kSearch(0)
+    , searchRadius(0)
+{}
+
+void NormalEstimation::perform(std::vector<Base::Vector3d>& normals)
+{
+    if (kSearch <= 0 && searchRadius <= 0) {
+        throw Base::ValueError("Either the number of neighbours or the search radius must be set");
+    }
+
+    // Like PCL the neighbours are searched on the points with the placement applied and the
+    // normals are oriented towards the origin
+    Points::PointsKDTree tree(myPoints);
+    std::vector<Base::Vector3f> result;
+    tree.estimateNormals(kSearch, static_cast<float>(searchRadius), result);
+
+    normals.reserve(result.size());
+    for (const auto& it : result) {
+        normals.emplace_back(it.x, it.y, it.z);
+    }
+}
+
 #endif  // HAVE_PCL_FILTERS
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <vector>
+#include <Base/BulkVector.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-magic-numbers)
+
+namespace
+{
+// a point with some data behind it
+struct FlaggedPoint: Base::Vector3f
+{
+    unsigned char flag {7};
+    unsigned long prop {42};
+};
+
+class BulkVectorTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std::mt19937 gen(3);
+        std::uniform_real_distribution<float> dist(-1000.0F, 1000.0F);
+        points.resize(1003);
+        for (auto& it : points) {
+            it.Set(dist(gen), dist(gen), dist(gen));
+        }
+
+        mat.rotX(0.3);
+        mat.rotY(-1.1);
+        mat.scale(1.5, 0.7, 2.0);
+        mat.move(Base::Vector3d(12.5, -3.0, 1.0e4));
+    }
+
+    void TearDown() override
+    {
+        Base::BulkVector::setActive(Base::BulkVector::supported());
+    }
+
+    // all instruction sets up to the supported one
+    static std::vector<Base::BulkVector::InstructionSet> instructionSets()
+    {
+        std::vector<Base::BulkVector::InstructionSet> sets;
+        for (int i = 0; i <= int(Base::BulkVector::supported()); i++) {
+            sets.push_back(Base::BulkVector::InstructionSet(i));
+        }
+        return sets;
+    }
+
+    std::vector<Base::Vector3f> points;
+    Base::Matrix4D mat;
+};
+}  // namespace
+
+TEST_F(BulkVectorTest, TestTransform)
+{
+    std::vector<Base::Vector3f> expected = points;
+    for (auto& it : expected) {
+        mat.multVec(it, it);
+    }
+
+    for (auto set : instructionSets()) {
+        Base::BulkVector::setActive(set);
+        EXPECT_EQ(Base::BulkVector::active(), set);
+
+        std::vector<Base::Vector3f> result = points;
+        Base::BulkVector::transform(mat, result.data(), result.size());
+        EXPECT_EQ(result, expected) << Base::BulkVector::name(set);
+    }
+}
+
+TEST_F(BulkVectorTest, TestTransformWithStride)
+{
+    std::vector<FlaggedPoint> flagged(points.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        flagged[i].Set(points[i].x, points[i].y, points[i].z);
+    }
+
+    for (auto set : instructionSets()) {
+        Base::BulkVector::setActive(set);
+
+        std::vector<FlaggedPoint> result = flagged;
+        Base::BulkVector::transform(mat, result.data(), result.size(), sizeof(FlaggedPoint));
+        for (std::size_t i = 0; i < points.size(); i++) {
+            Base::Vector3f pnt = points[i];
+            mat.multVec(pnt, pnt);
+            EXPECT_EQ(static_cast<const Base::Vector3f&>(result[i]), pnt);
+            EXPECT_EQ(result[i].flag, 7);
+            EXPECT_EQ(result[i].prop, 42);
+        }
+    }
+}
+
+TEST_F(BulkVectorTest, TestBoundBox)
+{
+    Base::BoundBox3f expected;
+    Base::BoundBox3d transformed;
+    for (const auto& it : points) {
+        expected.Add(it);
+        transformed.Add(mat * Base::Vector3d(it.x, it.y, it.z));
+    }
+
+    for (auto set : instructionSets()) {
+        Base::BulkVector::setActive(set);
+
+        Base::BoundBox3f box = Base::BulkVector::boundBox(points.data(), points.size());
+        EXPECT_EQ(box.GetMinimum(), expected.GetMinimum());
+        EXPECT_EQ(box.GetMaximum(), expected.GetMaximum());
+
+        Base::BoundBox3d tbox = Base::BulkVector::boundBox(mat, points.data(), points.size());
+        EXPECT_EQ(tbox.GetMinimum(), transformed.GetMinimum());
+        EXPECT_EQ(tbox.GetMaximum(), transformed.GetMaximum());
+    }
+
+    EXPECT_FALSE(Base::BulkVector::boundBox(points.data(), 0).IsValid());
+}
+
+TEST_F(BulkVectorTest, TestBoundBoxWithNaN)
+{
+    // structured point clouds store NaN for empty cells, they are skipped like by BoundBox3::Add()
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    for (std::size_t i = 0; i < points.size(); i += 3) {
+        points[i].Set(nan, nan, nan);
+    }
+    points[1].x = nan;
+
+    Base::BoundBox3f expected;
+    Base::BoundBox3d transformed;
+    for (const auto& it : points) {
+        expected.Add(it);
+        transformed.Add(mat * Base::Vector3d(it.x, it.y, it.z));
+    }
+    ASSERT_TRUE(expected.IsValid());
+
+    for (auto set : instructionSets()) {
+        Base::BulkVector::setActive(set);
+
+        Base::BoundBox3f box = Base::BulkVector::boundBox(points.data(), points.size());
+        EXPECT_EQ(box.GetMinimum(), expected.GetMinimum()) << Base::BulkVector::name(set);
+        EXPECT_EQ(box.GetMaximum(), expected.GetMaximum()) << Base::BulkVector::name(set);
+
+        Base::BoundBox3d tbox = Base::BulkVector::boundBox(mat, points.data(), points.size());
+        EXPECT_EQ(tbox.GetMinimum(), transformed.GetMinimum()) << Base::BulkVector::name(set);
+        EXPECT_EQ(tbox.GetMaximum(), transformed.GetMaximum()) << Base::BulkVector::name(set);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-magic-numbers)
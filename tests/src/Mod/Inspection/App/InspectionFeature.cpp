@@ -0,0 +1,317 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+#include <BRepBuilderAPI_MakeVertex.hxx>
+#include <BRepClass3d_SolidClassifier.hxx>
+#include <BRepExtrema_DistShapeShape.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <BRep_Tool.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Shape.hxx>
+#include <App/Document.h>
+#include <Base/Interpreter.h>
+#include <src/App/InitApplication.h>
+#include <src/Mod/Mesh/App/MeshTestHelpers.h>
+#include <Mod/Inspection/App/InspectionFeature.h>
+#include <Mod/Mesh/App/MeshFeature.h>
+#include <Mod/Points/App/PointsFeature.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+class InspectNominalShapeTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    // The search radius of the nominal
+    static constexpr float radius = 1.0F;
+    // Outside of the search radius the distance to the tessellation is returned
+    static constexpr float tessellationTolerance = 0.05F;
+    static constexpr float exactTolerance = 1.0e-4F;
+
+    /// Returns the signed distance computed without any tessellation
+    static float referenceDistance(const TopoDS_Shape& solid, const Base::Vector3f& point)
+    {
+        // the distance to the solid itself is zero for inner points
+        TopExp_Explorer xp(solid, TopAbs_SHELL);
+        gp_Pnt pnt(point.x, point.y, point.z);
+        BRepExtrema_DistShapeShape distss(xp.Current(), BRepBuilderAPI_MakeVertex(pnt).Vertex());
+        EXPECT_TRUE(distss.IsDone());
+        auto dist = static_cast<float>(distss.Value());
+
+        BRepClass3d_SolidClassifier classifier(solid);
+        classifier.Perform(pnt, 0.001);
+        return classifier.State() == TopAbs_IN ? -dist : dist;
+    }
+
+    static void checkDistances(const TopoDS_Shape& solid, const std::vector<Base::Vector3f>& points)
+    {
+        Inspection::InspectNominalShape nominal(solid, radius);
+        for (const auto& point : points) {
+            float expected = referenceDistance(solid, point);
+            float tolerance = std::fabs(expected) > radius ? tessellationTolerance : exactTolerance;
+            EXPECT_NEAR(nominal.getDistance(point), expected, tolerance)
+                << "at (" << point.x << ", " << point.y << ", " << point.z << ")";
+        }
+    }
+
+    // Offsets to the surface outside and inside of the solid. The small ones are below the
+    // deflection of the tessellation so that the solid must be classified, the medium ones
+    // have a reliable sign and the large ones are outside of the search radius.
+    std::vector<float> offsets {-3.0F, -0.5F, -0.01F, 0.01F, 0.5F, 3.0F};
+};
+
+TEST_F(InspectNominalShapeTest, distanceToBox)
+{
+    // Arrange
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Shape();
+    std::vector<Base::Vector3f> points;
+    for (float offset : offsets) {
+        // in front of and behind all faces
+        points.emplace_back(5.0F, 5.0F, 10.0F + offset);
+        points.emplace_back(5.0F, 5.0F, -offset);
+        points.emplace_back(10.0F + offset, 3.0F, 7.0F);
+        points.emplace_back(-offset, 7.0F, 3.0F);
+        points.emplace_back(4.0F, 10.0F + offset, 6.0F);
+        points.emplace_back(6.0F, -offset, 4.0F);
+    }
+    for (float offset : {0.01F, 0.3F, 2.0F}) {
+        // next to a corner and an edge where the nearest point is on another face than the
+        // nearest facet
+        points.emplace_back(10.0F + offset, 10.0F + offset, 10.0F + offset);
+        points.emplace_back(-offset, 5.0F, -offset);
+    }
+    // inside and nearly equally far from two faces
+    points.emplace_back(0.3F, 0.31F, 5.0F);
+    points.emplace_back(9.7F, 5.0F, 9.69F);
+
+    // Act / Assert
+    checkDistances(box, points);
+}
+
+TEST_F(InspectNominalShapeTest, distanceToCylinder)
+{
+    // Arrange
+    const float cylRadius = 5.0F;
+    const float height = 10.0F;
+    TopoDS_Shape cylinder = BRepPrimAPI_MakeCylinder(cylRadius, height).Shape();
+    std::vector<Base::Vector3f> points;
+    for (float offset : offsets) {
+        // in front of and behind the lateral face at some angles and the planar faces
+        for (float angle : {0.0F, 0.4F, 1.3F, 2.9F, 4.5F}) {
+            float rad = cylRadius + offset;
+            points.emplace_back(rad * std::cos(angle), rad * std::sin(angle), 0.5F * height);
+        }
+        points.emplace_back(2.0F, -1.0F, height + offset);
+        points.emplace_back(-1.0F, 2.0F, -offset);
+    }
+    for (float offset : {0.01F, 0.3F, 2.0F}) {
+        // next to the upper and lower circular edge
+        float rad = cylRadius + offset;
+        points.emplace_back(rad * std::cos(0.7F), rad * std::sin(0.7F), height + offset);
+        points.emplace_back(rad * std::cos(3.3F), rad * std::sin(3.3F), -offset);
+    }
+
+    // Act / Assert
+    checkDistances(cylinder, points);
+}
+
+TEST_F(InspectNominalShapeTest, keepTriangulationOfShape)
+{
+    // Arrange
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Shape();
+
+    // Act
+    Inspection::InspectNominalShape nominal(box, radius);
+
+    // Assert
+    EXPECT_NEAR(nominal.getDistance(Base::Vector3f(5.0F, 5.0F, 10.5F)), 0.5F, exactTolerance);
+    for (TopExp_Explorer xp(box, TopAbs_FACE); xp.More(); xp.Next()) {
+        TopLoc_Location loc;
+        EXPECT_TRUE(BRep_Tool::Triangulation(TopoDS::Face(xp.Current()), loc).IsNull());
+    }
+}
+
+class InspectionFeatureTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+        Base::Interpreter().runString("import Mesh, Points, Inspection");
+    }
+
+    void SetUp() override
+    {
+        document = App::GetApplication().newDocument("Inspection");
+        nominal = document->addObject<Mesh::Feature>("Nominal");
+        nominal->Mesh.setValue(MeshTestHelpers::makeGridMesh(10, 1.0F));
+        actual = document->addObject<Points::Feature>("Actual");
+        actual->Points.setValue(makePoints());
+        inspection = addInspection("Inspection");
+    }
+
+    void TearDown() override
+    {
+        App::GetApplication().closeDocument(document->getName());
+    }
+
+    /// Points above and below the nominal grid, some of them outside of the search radius
+    static Points::PointKernel makePoints()
+    {
+        Points::PointKernel kernel;
+        for (int i = 0; i < 9; i++) {
+            for (int j = 0; j < 9; j++) {
+                double z = 0.15 * double((i + 2 * j) % 11 - 5);
+                kernel.push_back(Base::Vector3d(i + 0.5, j + 0.5, z));
+            }
+        }
+        return kernel;
+    }
+
+    Inspection::Feature* addInspection(const char* name)
+    {
+        auto feature = document->addObject<Inspection::Feature>(name);
+        feature->Actual.setValue(actual);
+        feature->Nominals.setValues({nominal});
+        feature->SearchRadius.setValue(0.5);
+        return feature;
+    }
+
+    /// Runs a new inspection with the settings of the tested one
+    std::vector<float> freshDistances()
+    {
+        auto fresh = addInspection("Fresh");
+        fresh->Nominals.setValues(inspection->Nominals.getValues());
+        fresh->SearchRadius.setValue(inspection->SearchRadius.getValue());
+        EXPECT_EQ(fresh->execute(), nullptr);
+        EXPECT_EQ(fresh->countComputedPoints(), actual->Points.getValue().size());
+        std::vector<float> distances = fresh->Distances.getValues();
+        document->removeObject(fresh->getNameInDocument());
+        return distances;
+    }
+
+    static double getRMS(const std::vector<float>& distances)
+    {
+        double sumsq = 0.0;
+        int count = 0;
+        for (float dist : distances) {
+            if (std::fabs(dist) < FLT_MAX) {
+                sumsq += dist * dist;
+                count++;
+            }
+        }
+        return count > 0 ? std::sqrt(sumsq / count) : 0.0;
+    }
+
+    /// Checks that the cached run gives the same result as a run from scratch
+    void checkAgainstFreshRun()
+    {
+        std::vector<float> distances = inspection->Distances.getValues();
+        std::vector<float> expected = freshDistances();
+        EXPECT_EQ(distances, expected);
+        EXPECT_DOUBLE_EQ(getRMS(distances), getRMS(expected));
+    }
+
+    App::Document* document {};
+    Mesh::Feature* nominal {};
+    Points::Feature* actual {};
+    Inspection::Feature* inspection {};
+};
+
+TEST_F(InspectionFeatureTest, recomputeNewOrMovedPointsOnly)
+{
+    // Arrange
+    ASSERT_EQ(inspection->execute(), nullptr);
+    EXPECT_EQ(inspection->countComputedPoints(), 81);
+    std::vector<float> distances = inspection->Distances.getValues();
+
+    // Act
+    inspection->execute();
+
+    // Assert
+    EXPECT_EQ(inspection->countComputedPoints(), 0);
+    EXPECT_EQ(inspection->Distances.getValues(), distances);
+
+    // Act
+    Points::PointKernel kernel = actual->Points.getValue();
+    kernel.setPoint(0, Base::Vector3d(0.5, 0.5, 0.2));
+    kernel.setPoint(40, Base::Vector3d(4.5, 4.3, -0.3));
+    kernel.setPoint(80, Base::Vector3d(8.5, 8.5, 0.9));
+    kernel.push_back(Base::Vector3d(2.0, 3.0, 0.1));
+    kernel.push_back(Base::Vector3d(7.0, 1.0, -0.4));
+    actual->Points.setValue(kernel);
+    inspection->execute();
+
+    // Assert
+    EXPECT_EQ(inspection->countComputedPoints(), 5);
+    checkAgainstFreshRun();
+}
+
+TEST_F(InspectionFeatureTest, recomputeAllForModifiedNominal)
+{
+    // Arrange
+    inspection->execute();
+
+    // Act
+    nominal->Mesh.setValue(MeshTestHelpers::makeGridMesh(10, 1.0F, [](int i, int j) {
+        return 0.05F * float(i - j);
+    }));
+    inspection->execute();
+
+    // Assert
+    EXPECT_EQ(inspection->countComputedPoints(), 81);
+    checkAgainstFreshRun();
+}
+
+TEST_F(InspectionFeatureTest, recomputeAllForOtherNominal)
+{
+    // Arrange
+    inspection->execute();
+
+    // Act
+    auto other = document->addObject<Mesh::Feature>("Other");
+    other->Mesh.setValue(MeshTestHelpers::makeGridMesh(5, 2.0F));
+    inspection->Nominals.setValues({other});
+    inspection->execute();
+
+    // Assert
+    EXPECT_EQ(inspection->countComputedPoints(), 81);
+    checkAgainstFreshRun();
+}
+
+TEST_F(InspectionFeatureTest, recomputeAllForMovedNominal)
+{
+    // Arrange
+    inspection->execute();
+
+    // Act
+    nominal->Placement.setValue(Base::Placement(Base::Vector3d(0.0, 0.0, 0.1), Base::Rotation()));
+    inspection->execute();
+
+    // Assert
+    EXPECT_EQ(inspection->countComputedPoints(), 81);
+    checkAgainstFreshRun();
+}
+
+TEST_F(InspectionFeatureTest, recomputeAllForChangedSearchRadius)
+{
+    // Arrange
+    inspection->execute();
+
+    // Act
+    inspection->SearchRadius.setValue(0.8);
+    inspection->execute();
+
+    // Assert
+    EXPECT_EQ(inspection->countComputedPoints(), 81);
+    checkAgainstFreshRun();
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <sstream>
+#include <Base/FileInfo.h>
+#include <Base/Stream.h>
+#include <Mod/Mesh/App/Core/IO/FormatBMC.h>
+#include <Mod/Mesh/App/Core/IO/ReaderBMC.h>
+#include <Mod/Mesh/App/Core/IO/WriterBMC.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <src/Mod/Mesh/App/MeshTestHelpers.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class BMCTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // an open grid of 2 * 20 * 20 triangles
+        kernel = MeshTestHelpers::makeGridMesh(20, 1.0F, [](int i, int j) {
+            return 0.1F * float(i * j);
+        });
+    }
+
+    std::string write(unsigned char pointFlags = 0, unsigned char facetFlags = 0) const
+    {
+        std::stringstream str;
+        MeshCore::WriterBMC writer(kernel);
+        writer.SetPointFlags(pointFlags);
+        writer.SetFacetFlags(facetFlags);
+        EXPECT_TRUE(writer.Save(str));
+        return str.str();
+    }
+
+    void compare(const MeshCore::MeshKernel& mesh) const
+    {
+        ASSERT_EQ(mesh.CountPoints(), kernel.CountPoints());
+        ASSERT_EQ(mesh.CountFacets(), kernel.CountFacets());
+        for (std::size_t i = 0; i < kernel.CountPoints(); i++) {
+            EXPECT_EQ(Base::Vector3f(mesh.GetPoints()[i]), Base::Vector3f(kernel.GetPoints()[i]));
+        }
+        for (std::size_t i = 0; i < kernel.CountFacets(); i++) {
+            const MeshCore::MeshFacet& f1 = mesh.GetFacets()[i];
+            const MeshCore::MeshFacet& f2 = kernel.GetFacets()[i];
+            for (int j = 0; j < 3; j++) {
+                EXPECT_EQ(f1._aulPoints[j], f2._aulPoints[j]);
+                EXPECT_EQ(f1._aulNeighbours[j], f2._aulNeighbours[j]);
+            }
+        }
+        EXPECT_EQ(mesh.GetBoundBox().GetCenter(), kernel.GetBoundBox().GetCenter());
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(BMCTest, TestRoundTrip)
+{
+    std::string data = write();
+    EXPECT_EQ(data.size() % 64, 0);
+
+    std::stringstream str(data);
+    MeshCore::MeshKernel mesh;
+    MeshCore::ReaderBMC reader(mesh);
+    ASSERT_TRUE(reader.Load(str));
+    compare(mesh);
+    EXPECT_EQ(mesh.GetFacets()[0]._ucFlag, 0);
+}
+
+TEST_F(BMCTest, TestFlags)
+{
+    for (std::size_t i = 0; i < kernel.CountPoints(); i += 3) {
+        kernel.GetPoints()[i].SetFlag(MeshCore::MeshPoint::MARKED);
+    }
+    for (std::size_t i = 0; i < kernel.CountFacets(); i += 7) {
+        kernel.GetFacets()[i].SetFlag(MeshCore::MeshFacet::SELECTED);
+        kernel.GetFacets()[i].SetFlag(MeshCore::MeshFacet::VISIT);
+    }
+
+    std::string data = write(MeshCore::MeshPoint::MARKED, MeshCore::MeshFacet::SELECTED);
+    MeshCore::MeshKernel mesh;
+    MeshCore::ReaderBMC reader(mesh);
+    ASSERT_TRUE(reader.Load(data.data(), data.size()));
+    compare(mesh);
+
+    // only the requested flags are stored
+    for (std::size_t i = 0; i < kernel.CountPoints(); i++) {
+        EXPECT_EQ(mesh.GetPoints()[i].IsFlag(MeshCore::MeshPoint::MARKED), i % 3 == 0);
+    }
+    for (std::size_t i = 0; i < kernel.CountFacets(); i++) {
+        EXPECT_EQ(mesh.GetFacets()[i].IsFlag(MeshCore::MeshFacet::SELECTED), i % 7 == 0);
+        EXPECT_FALSE(mesh.GetFacets()[i].IsFlag(MeshCore::MeshFacet::VISIT));
+    }
+}
+
+TEST_F(BMCTest, TestCorruptedData)
+{
+    std::string data = write();
+    MeshCore::MeshKernel mesh;
+    MeshCore::ReaderBMC reader(mesh);
+
+    std::string modified = data;
+    modified[data.size() / 2] ^= 0x10;
+    EXPECT_FALSE(reader.Load(modified.data(), modified.size()));
+
+    EXPECT_FALSE(reader.Load(data.data(), data.size() - 1));
+
+    modified = data;
+    modified[0] = 'X';
+    EXPECT_FALSE(reader.Load(modified.data(), modified.size()));
+
+    std::stringstream str(data.substr(0, 100));
+    EXPECT_FALSE(reader.Load(str));
+    EXPECT_EQ(mesh.CountFacets(), 0);
+}
+
+TEST_F(BMCTest, TestOversizedHeader)
+{
+    // a consistent header whose sections are far larger than the stream
+    std::string data = write();
+    MeshCore::BMC::Header header {};
+    std::memcpy(&header, data.data(), sizeof(header));
+    header.countPoints = 0xfffffff0;
+    header.countFacets = 0xfffffff0;
+    header.dataSize = MeshCore::BMC::Layout(header).end - sizeof(header);
+    std::memcpy(data.data(), &header, sizeof(header));
+
+    MeshCore::MeshKernel mesh;
+    MeshCore::ReaderBMC reader(mesh);
+    std::stringstream str(data);
+    EXPECT_FALSE(reader.Load(str));
+    EXPECT_FALSE(reader.Load(data.data(), data.size()));
+    EXPECT_EQ(mesh.CountFacets(), 0);
+}
+
+TEST_F(BMCTest, TestLoadFile)
+{
+    Base::FileInfo fi(Base::FileInfo::getTempFileName() + ".bmc");
+    {
+        Base::ofstream str(fi, std::ios::out | std::ios::binary);
+        std::string data = write();
+        str.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+
+    MeshCore::MeshKernel mesh;
+    MeshCore::ReaderBMC reader(mesh);
+    EXPECT_TRUE(reader.Load(fi.filePath()));
+    compare(mesh);
+    fi.deleteFile();
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,235 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <Mod/Mesh/App/Core/BVH.h>
+#include <Mod/Mesh/App/Core/Iterator.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <src/Mod/Mesh/App/MeshTestHelpers.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class BVHTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a wavy height field of 2 * 30 * 30 triangles
+        kernel = MeshTestHelpers::makeGridMesh(30, 0.2F, [](int i, int j) {
+            return 0.5F * std::sin(float(i) * 0.2F) * std::cos(float(j) * 0.2F);
+        });
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(BVHTest, TestBuild)
+{
+    MeshCore::MeshFacetBVH bvh(kernel);
+    EXPECT_FALSE(bvh.IsEmpty());
+    EXPECT_EQ(bvh.CountFacets(), kernel.CountFacets());
+    EXPECT_GT(bvh.CountNodes(), 1);
+
+    Base::BoundBox3f box1 = bvh.GetBoundBox();
+    Base::BoundBox3f box2 = kernel.GetBoundBox();
+    EXPECT_FLOAT_EQ(box1.MinX, box2.MinX);
+    EXPECT_FLOAT_EQ(box1.MaxY, box2.MaxY);
+    EXPECT_FLOAT_EQ(box1.MaxZ, box2.MaxZ);
+
+    bvh.Clear();
+    EXPECT_TRUE(bvh.IsEmpty());
+}
+
+TEST_F(BVHTest, TestNearestFacetOnRay)
+{
+    MeshCore::MeshFacetBVH bvh(kernel);
+    MeshCore::MeshFacetIterator it(kernel);
+    Base::Vector3f dir(0.1F, 0.05F, -1.0F);
+    for (float x = 0.3F; x < 5.5F; x += 0.7F) {
+        for (float y = 0.4F; y < 5.5F; y += 0.9F) {
+            Base::Vector3f pnt(x, y, 2.0F);
+
+            // brute force
+            MeshCore::FacetIndex index = MeshCore::FACET_INDEX_MAX;
+            float minDist = FLOAT_MAX;
+            for (it.Init(); it.More(); it.Next()) {
+                Base::Vector3f res;
+                if (it->Foraminate(pnt, dir, res)) {
+                    float dist = Base::Distance(pnt, res);
+                    if (dist < minDist) {
+                        minDist = dist;
+                        index = it.Position();
+                    }
+                }
+            }
+
+            Base::Vector3f res;
+            MeshCore::FacetIndex facet {};
+            ASSERT_TRUE(bvh.NearestFacetOnRay(pnt, dir, res, facet));
+            EXPECT_EQ(facet, index);
+            EXPECT_NEAR(Base::Distance(pnt, res), minDist, 1e-4F);
+
+            // the ray points away from the mesh
+            EXPECT_FALSE(bvh.NearestFacetOnRay(pnt, -dir, res, facet));
+        }
+    }
+}
+
+TEST_F(BVHTest, TestNearestFacetOnAxisRay)
+{
+    // rays parallel to an axis that run through the vertices and so lie in the faces
+    // of the node boxes
+    MeshCore::MeshFacetBVH bvh(kernel);
+    Base::Vector3f dir(0.0F, 0.0F, -1.0F);
+    for (const auto& it : kernel.GetPoints()) {
+        // hitting the border of the mesh depends on rounding
+        if (it.x < 0.1F || it.y < 0.1F || it.x > 5.9F || it.y > 5.9F) {
+            continue;
+        }
+        Base::Vector3f pnt(it.x, it.y, 2.0F);
+        Base::Vector3f res;
+        MeshCore::FacetIndex facet {};
+        ASSERT_TRUE(bvh.NearestFacetOnRay(pnt, dir, res, facet));
+        EXPECT_NEAR(res.z, it.z, 1e-5F);
+    }
+}
+
+TEST_F(BVHTest, TestNearestFacetToPoint)
+{
+    MeshCore::MeshFacetBVH bvh(kernel);
+    MeshCore::MeshFacetIterator it(kernel);
+    std::vector<Base::Vector3f> points;
+    for (float x = -0.5F; x < 6.5F; x += 0.8F) {
+        for (float z = -1.0F; z < 1.0F; z += 0.6F) {
+            points.emplace_back(x, 0.5F * x, z);
+        }
+    }
+
+    std::vector<MeshCore::FacetIndex> facets;
+    std::vector<Base::Vector3f> results;
+    bvh.NearestFacetsToPoints(points, facets, results);
+    ASSERT_EQ(facets.size(), points.size());
+
+    for (std::size_t i = 0; i < points.size(); i++) {
+        float minDist = FLOAT_MAX;
+        for (it.Init(); it.More(); it.Next()) {
+            minDist = std::min(minDist, it->DistanceToPoint(points[i]));
+        }
+
+        Base::Vector3f res;
+        MeshCore::FacetIndex facet {};
+        ASSERT_TRUE(bvh.NearestFacetToPoint(points[i], res, facet));
+        EXPECT_NEAR(Base::Distance(points[i], res), minDist, 1e-4F);
+        EXPECT_EQ(facets[i], facet);
+
+        // nothing within a too small distance
+        if (minDist > 0.01F) {
+            EXPECT_FALSE(bvh.NearestFacetToPoint(points[i], res, facet, 0.5F * minDist));
+        }
+    }
+}
+
+TEST_F(BVHTest, TestAttachTransformed)
+{
+    Base::Matrix4D mat;
+    mat.rotZ(0.3);
+    mat.move(Base::Vector3f(1.0F, -2.0F, 0.5F));
+
+    Base::Vector3f first = kernel.GetPoint(0);
+    MeshCore::MeshKernel copy(kernel);
+    copy.Transform(mat);
+    MeshCore::MeshFacetBVH bvh1(copy);
+    MeshCore::MeshFacetBVH bvh2;
+    bvh2.Attach(kernel, mat);
+    EXPECT_EQ(bvh1.CountNodes(), bvh2.CountNodes());
+    EXPECT_EQ(kernel.GetPoint(0), first);
+
+    for (float x = -0.5F; x < 6.5F; x += 0.8F) {
+        Base::Vector3f pnt(x, 0.5F * x, 0.2F);
+        Base::Vector3f res1;
+        Base::Vector3f res2;
+        MeshCore::FacetIndex facet1 {};
+        MeshCore::FacetIndex facet2 {};
+        ASSERT_TRUE(bvh1.NearestFacetToPoint(pnt, res1, facet1));
+        ASSERT_TRUE(bvh2.NearestFacetToPoint(pnt, res2, facet2));
+        EXPECT_EQ(facet1, facet2);
+        EXPECT_EQ(res1, res2);
+    }
+}
+
+TEST_F(BVHTest, TestInside)
+{
+    MeshCore::MeshFacetBVH bvh(kernel);
+    Base::BoundBox3f box(1.0F, 1.5F, -1.0F, 2.3F, 3.1F, 0.1F);
+
+    std::vector<MeshCore::FacetIndex> expected;
+    MeshCore::MeshFacetIterator it(kernel);
+    for (it.Init(); it.More(); it.Next()) {
+        if (it->GetBoundBox() && box) {
+            expected.push_back(it.Position());
+        }
+    }
+
+    std::vector<MeshCore::FacetIndex> facets;
+    bvh.Inside(box, facets);
+    std::sort(facets.begin(), facets.end());
+    EXPECT_EQ(facets, expected);
+
+    // accepting all nodes returns every facet once
+    bvh.Inside(
+        [](const Base::BoundBox3f&) {
+            return true;
+        },
+        facets);
+    EXPECT_EQ(facets.size(), kernel.CountFacets());
+}
+
+TEST(BVHDepthTest, TestDepthWithOutliers)
+{
+    // a dense patch and facets far away at growing distances, which makes the heuristic split
+    // off a single facet per level
+    const std::uint32_t num = 100;
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    for (std::uint32_t i = 0; i <= num; i++) {
+        for (std::uint32_t j = 0; j <= num; j++) {
+            points.push_back(MeshCore::MeshPoint(Base::Vector3f(float(i), float(j), 0.0F)));
+        }
+    }
+    for (std::uint32_t i = 0; i < num; i++) {
+        for (std::uint32_t j = 0; j < num; j++) {
+            MeshCore::PointIndex p0 = i * (num + 1) + j;
+            MeshCore::PointIndex p1 = p0 + num + 1;
+            facets.push_back(MeshCore::MeshFacet(p0, p1, p1 + 1));
+            facets.push_back(MeshCore::MeshFacet(p0, p1 + 1, p0 + 1));
+        }
+    }
+    for (int k = 1; k <= 28; k++) {
+        float x = 1000.0F * std::pow(17.0F, float(k));
+        auto index = static_cast<MeshCore::PointIndex>(points.size());
+        points.push_back(MeshCore::MeshPoint(Base::Vector3f(x, 0.0F, 0.0F)));
+        points.push_back(MeshCore::MeshPoint(Base::Vector3f(x, 1.0F, 0.0F)));
+        points.push_back(MeshCore::MeshPoint(Base::Vector3f(x, 0.0F, 1.0F)));
+        facets.push_back(MeshCore::MeshFacet(index, index + 1, index + 2));
+    }
+
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets);
+    MeshCore::MeshFacetBVH bvh(kernel);
+
+    // the traversal stacks hold 64 entries
+    EXPECT_LT(bvh.GetDepth(), 64);
+
+    Base::Vector3f res;
+    MeshCore::FacetIndex facet {};
+    ASSERT_TRUE(bvh.NearestFacetOnRay(Base::Vector3f(50.5F, 20.2F, 1.0F),
+                                      Base::Vector3f(0.0F, 0.0F, -1.0F),
+                                      res,
+                                      facet));
+    EXPECT_FLOAT_EQ(res.z, 0.0F);
+    ASSERT_TRUE(bvh.NearestFacetToPoint(Base::Vector3f(50.5F, 20.2F, 1.0F), res, facet));
+    EXPECT_FLOAT_EQ(res.z, 0.0F);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <array>
+#include <Mod/Mesh/App/Core/Boolean.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/SetOperations.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class BooleanTest: public ::testing::Test
+{
+protected:
+    static MeshCore::MeshKernel makeBox(const Base::Vector3f& min, const Base::Vector3f& max)
+    {
+        std::array<Base::Vector3f, 8> pts {Base::Vector3f(min.x, min.y, min.z),
+                                           Base::Vector3f(max.x, min.y, min.z),
+                                           Base::Vector3f(max.x, max.y, min.z),
+                                           Base::Vector3f(min.x, max.y, min.z),
+                                           Base::Vector3f(min.x, min.y, max.z),
+                                           Base::Vector3f(max.x, min.y, max.z),
+                                           Base::Vector3f(max.x, max.y, max.z),
+                                           Base::Vector3f(min.x, max.y, max.z)};
+        // the corners of each side in counterclockwise order seen from outside
+        std::array<std::array<int, 4>, 6> sides {{{0, 3, 2, 1},
+                                                  {4, 5, 6, 7},
+                                                  {0, 1, 5, 4},
+                                                  {1, 2, 6, 5},
+                                                  {2, 3, 7, 6},
+                                                  {3, 0, 4, 7}}};
+        std::vector<MeshCore::MeshGeomFacet> facets;
+        for (const auto& s : sides) {
+            facets.emplace_back(pts[s[0]], pts[s[1]], pts[s[2]]);
+            facets.emplace_back(pts[s[0]], pts[s[2]], pts[s[3]]);
+        }
+
+        MeshCore::MeshKernel kernel;
+        kernel = facets;
+        return kernel;
+    }
+
+    static bool isSolid(const MeshCore::MeshKernel& kernel)
+    {
+        MeshCore::MeshEvalSolid solid(kernel);
+        MeshCore::MeshEvalTopology topology(kernel);
+        return solid.Evaluate() && topology.Evaluate();
+    }
+};
+
+TEST_F(BooleanTest, TestOverlappingBoxes)
+{
+    MeshCore::MeshKernel box1 = makeBox(Base::Vector3f(0, 0, 0), Base::Vector3f(1, 1, 1));
+    MeshCore::MeshKernel box2 =
+        makeBox(Base::Vector3f(0.3F, 0.4F, 0.2F), Base::Vector3f(1.3F, 1.4F, 1.2F));
+    const float overlap = 0.7F * 0.6F * 0.8F;
+
+    MeshCore::MeshKernel result;
+    MeshCore::MeshBoolean unite(box1, box2, MeshCore::MeshBoolean::Union);
+    ASSERT_TRUE(unite.Perform(result));
+    EXPECT_GT(unite.CountIntersections(), 0);
+    EXPECT_TRUE(isSolid(result));
+    EXPECT_NEAR(result.GetVolume(), 2.0F - overlap, 1e-4F);
+
+    MeshCore::MeshBoolean intersect(box1, box2, MeshCore::MeshBoolean::Intersect);
+    ASSERT_TRUE(intersect.Perform(result));
+    EXPECT_TRUE(isSolid(result));
+    EXPECT_NEAR(result.GetVolume(), overlap, 1e-4F);
+
+    MeshCore::MeshBoolean subtract(box1, box2, MeshCore::MeshBoolean::Difference);
+    ASSERT_TRUE(subtract.Perform(result));
+    EXPECT_TRUE(isSolid(result));
+    EXPECT_NEAR(result.GetVolume(), 1.0F - overlap, 1e-4F);
+}
+
+TEST_F(BooleanTest, TestCoplanarBoxes)
+{
+    // the boxes share the planes of four sides
+    MeshCore::MeshKernel box1 = makeBox(Base::Vector3f(0, 0, 0), Base::Vector3f(1, 1, 1));
+    MeshCore::MeshKernel box2 = makeBox(Base::Vector3f(0.5F, 0, 0), Base::Vector3f(1.5F, 1, 1));
+
+    MeshCore::MeshKernel result;
+    MeshCore::MeshBoolean unite(box1, box2, MeshCore::MeshBoolean::Union);
+    ASSERT_TRUE(unite.Perform(result));
+    EXPECT_NEAR(result.GetVolume(), 1.5F, 1e-4F);
+
+    MeshCore::MeshBoolean subtract(box1, box2, MeshCore::MeshBoolean::Difference);
+    ASSERT_TRUE(subtract.Perform(result));
+    EXPECT_NEAR(result.GetVolume(), 0.5F, 1e-4F);
+}
+
+TEST_F(BooleanTest, TestIdenticalBoxes)
+{
+    // every facet coincides with a facet of the other mesh
+    MeshCore::MeshKernel box = makeBox(Base::Vector3f(0, 0, 0), Base::Vector3f(1, 1, 1));
+
+    MeshCore::MeshKernel result;
+    MeshCore::MeshBoolean unite(box, box, MeshCore::MeshBoolean::Union);
+    ASSERT_TRUE(unite.Perform(result));
+    EXPECT_TRUE(isSolid(result));
+    EXPECT_NEAR(result.GetVolume(), 1.0F, 1e-4F);
+}
+
+TEST_F(BooleanTest, TestNestedBoxes)
+{
+    MeshCore::MeshKernel box1 = makeBox(Base::Vector3f(0, 0, 0), Base::Vector3f(2, 2, 2));
+    MeshCore::MeshKernel box2 = makeBox(Base::Vector3f(0.5F, 0.5F, 0.5F), Base::Vector3f(1, 1, 1));
+
+    MeshCore::MeshKernel result;
+    MeshCore::MeshBoolean subtract(box1, box2, MeshCore::MeshBoolean::Difference);
+    ASSERT_TRUE(subtract.Perform(result));
+    EXPECT_EQ(subtract.CountIntersections(), 0);
+    EXPECT_EQ(result.CountFacets(), 24);
+    EXPECT_NEAR(result.GetVolume(), 8.0F - 0.125F, 1e-4F);
+
+    MeshCore::MeshBoolean intersect(box1, box2, MeshCore::MeshBoolean::Intersect);
+    ASSERT_TRUE(intersect.Perform(result));
+    EXPECT_NEAR(result.GetVolume(), 0.125F, 1e-4F);
+}
+
+TEST_F(BooleanTest, TestSetOperations)
+{
+    MeshCore::MeshKernel box1 = makeBox(Base::Vector3f(0, 0, 0), Base::Vector3f(1, 1, 1));
+    MeshCore::MeshKernel box2 =
+        makeBox(Base::Vector3f(0.3F, 0.4F, 0.2F), Base::Vector3f(1.3F, 1.4F, 1.2F));
+
+    MeshCore::MeshKernel result;
+    MeshCore::SetOperations unite(box1, box2, result, MeshCore::SetOperations::Union);
+    unite.Do();
+    EXPECT_TRUE(isSolid(result));
+    EXPECT_NEAR(result.GetVolume(), 2.0F - 0.7F * 0.6F * 0.8F, 1e-4F);
+
+    // the part of the first box outside the second box is open
+    MeshCore::SetOperations outer(box1, box2, result, MeshCore::SetOperations::Outer);
+    outer.Do();
+    EXPECT_GT(result.CountFacets(), 0);
+    EXPECT_FALSE(isSolid(result));
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <limits>
+#include <Base/Matrix.h>
+#include <Mod/Mesh/App/Core/CompactKernel.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class CompactKernelTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Base::Vector3f p0(0.F, 0.F, 0.F);
+        Base::Vector3f p1(1.F, 0.F, 0.F);
+        Base::Vector3f p2(0.F, 1.F, 0.F);
+        Base::Vector3f p3(0.F, 0.F, 1.F);
+        std::vector<MeshCore::MeshGeomFacet> facets;
+        facets.emplace_back(p0, p2, p1);
+        facets.emplace_back(p0, p1, p3);
+        facets.emplace_back(p1, p2, p3);
+        facets.emplace_back(p2, p0, p3);
+        kernel = facets;
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST(MeshBitset, TestLazyAllocation)
+{
+    MeshCore::MeshBitset bits(100);
+    EXPECT_FALSE(bits.IsAllocated());
+    EXPECT_FALSE(bits.Test(70));
+    EXPECT_EQ(bits.Count(), 0);
+
+    bits.Set(70);
+    EXPECT_TRUE(bits.IsAllocated());
+    EXPECT_TRUE(bits.Test(70));
+    EXPECT_FALSE(bits.Test(69));
+
+    bits.SetAll();
+    EXPECT_EQ(bits.Count(), 100);
+    bits.Release();
+    EXPECT_FALSE(bits.IsAllocated());
+}
+
+TEST_F(CompactKernelTest, TestAssign)
+{
+    MeshCore::MeshCompactKernel compact(kernel);
+    EXPECT_EQ(compact.CountPoints(), kernel.CountPoints());
+    EXPECT_EQ(compact.CountFacets(), kernel.CountFacets());
+    EXPECT_LT(compact.GetMemSize(), kernel.GetMemSize());
+
+    for (MeshCore::FacetIndex i = 0; i < kernel.CountFacets(); i++) {
+        const MeshCore::MeshFacet& face = kernel.GetFacets()[i];
+        const auto* pts = compact.GetFacetPoints(i);
+        const auto* nbs = compact.GetFacetNeighbours(i);
+        for (int j = 0; j < 3; j++) {
+            EXPECT_EQ(pts[j], face._aulPoints[j]);
+            EXPECT_EQ(nbs[j], face._aulNeighbours[j]);
+        }
+    }
+
+    // no flags are set so nothing has been allocated
+    EXPECT_FALSE(compact.FacetFlags(MeshCore::MeshFacet::VISIT).IsAllocated());
+    EXPECT_FALSE(compact.PointFlags(MeshCore::MeshPoint::MARKED).IsAllocated());
+}
+
+TEST_F(CompactKernelTest, TestRoundTrip)
+{
+    kernel.GetFacets()[2].SetFlag(MeshCore::MeshFacet::SELECTED);
+    kernel.GetFacets()[3]._ulProp = 5;
+    kernel.GetPoints()[1].SetFlag(MeshCore::MeshPoint::MARKED);
+
+    MeshCore::MeshCompactKernel compact(kernel);
+    EXPECT_TRUE(compact.FacetFlags(MeshCore::MeshFacet::SELECTED).IsAllocated());
+    EXPECT_FALSE(compact.FacetFlags(MeshCore::MeshFacet::VISIT).IsAllocated());
+    EXPECT_TRUE(compact.PointFlags(MeshCore::MeshPoint::MARKED).Test(1));
+
+    Base::Matrix4D mat;
+    mat.move(Base::Vector3f(1.F, 2.F, 3.F));
+    compact.Transform(mat);
+
+    MeshCore::MeshKernel copy;
+    compact.CopyTo(copy);
+    EXPECT_EQ(copy.CountFacets(), 4);
+    EXPECT_TRUE(copy.GetFacets()[2].IsFlag(MeshCore::MeshFacet::SELECTED));
+    EXPECT_FALSE(copy.GetFacets()[1].IsFlag(MeshCore::MeshFacet::SELECTED));
+    EXPECT_EQ(copy.GetFacets()[3]._ulProp, 5);
+    EXPECT_TRUE(copy.GetPoints()[1].IsFlag(MeshCore::MeshPoint::MARKED));
+    EXPECT_EQ(copy.GetFacets()[0]._aulNeighbours[0], kernel.GetFacets()[0]._aulNeighbours[0]);
+
+    Base::BoundBox3f box = copy.GetBoundBox();
+    EXPECT_FLOAT_EQ(box.MinX, 1.F);
+    EXPECT_FLOAT_EQ(box.MaxZ, 4.F);
+}
+
+TEST_F(CompactKernelTest, TestKeepFullProperties)
+{
+    // Arrange
+    const unsigned long prop = std::numeric_limits<unsigned long>::max() - 1;
+    kernel.GetPoints()[2]._ulProp = prop;
+    kernel.GetFacets()[1]._ulProp = prop;
+
+    // Act
+    MeshCore::MeshCompactKernel compact(kernel);
+    MeshCore::MeshKernel copy;
+    compact.CopyTo(copy);
+
+    // Assert
+    EXPECT_EQ(compact.PointProperties()[2], prop);
+    EXPECT_EQ(copy.GetPoints()[2]._ulProp, prop);
+    EXPECT_EQ(copy.GetFacets()[1]._ulProp, prop);
+    EXPECT_EQ(copy.GetFacets()[0]._ulProp, 0);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
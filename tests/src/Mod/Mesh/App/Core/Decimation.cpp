@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <Mod/Mesh/App/Core/Decimation.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <src/Mod/Mesh/App/MeshTestHelpers.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class DecimationTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a wavy height field of 2 * 100 * 100 triangles
+        kernel = MeshTestHelpers::makeGridMesh(100, 0.1F, [](int i, int j) {
+            return 0.5F * std::sin(float(i) * 0.1F) * std::cos(float(j) * 0.1F);
+        });
+    }
+
+    void checkResult(const MeshCore::MeshKernel& mesh, unsigned long targetSize) const
+    {
+        EXPECT_LE(mesh.CountFacets(), targetSize);
+        EXPECT_GT(mesh.CountFacets(), targetSize / 2);
+
+        MeshCore::MeshEvalTopology topology(mesh);
+        EXPECT_TRUE(topology.Evaluate());
+        MeshCore::MeshEvalOrientation orientation(mesh);
+        EXPECT_TRUE(orientation.Evaluate());
+
+        // the boundary is kept
+        Base::BoundBox3f box1 = mesh.GetBoundBox();
+        Base::BoundBox3f box2 = kernel.GetBoundBox();
+        EXPECT_FLOAT_EQ(box1.MinX, box2.MinX);
+        EXPECT_FLOAT_EQ(box1.MaxX, box2.MaxX);
+        EXPECT_FLOAT_EQ(box1.MinY, box2.MinY);
+        EXPECT_FLOAT_EQ(box1.MaxY, box2.MaxY);
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(DecimationTest, TestTargetSize)
+{
+    MeshCore::MeshKernel mesh = kernel;
+    MeshCore::MeshSimplify simplify(mesh);
+    simplify.setThreadCount(1);
+    simplify.simplify(2000);
+    checkResult(mesh, 2000);
+}
+
+TEST_F(DecimationTest, TestPartitions)
+{
+    MeshCore::MeshKernel mesh = kernel;
+    MeshCore::MeshSimplify simplify(mesh);
+    simplify.setThreadCount(4);
+    simplify.simplify(2000);
+    checkResult(mesh, 2000);
+}
+
+TEST_F(DecimationTest, TestReduction)
+{
+    MeshCore::MeshKernel mesh = kernel;
+    MeshCore::MeshSimplify simplify(mesh);
+    simplify.setThreadCount(4);
+    simplify.simplify(1000.0F, 0.75F);
+    checkResult(mesh, 5000);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <Base/Exception.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class EvaluationTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // three facets sharing the edge (0, 1) and one facet attached to the edge (1, 2)
+        MeshCore::MeshPointArray points;
+        points.push_back(MeshCore::MeshPoint(Base::Vector3f(0.F, 0.F, 0.F)));
+        points.push_back(MeshCore::MeshPoint(Base::Vector3f(1.F, 0.F, 0.F)));
+        points.push_back(MeshCore::MeshPoint(Base::Vector3f(0.F, 1.F, 0.F)));
+        points.push_back(MeshCore::MeshPoint(Base::Vector3f(0.F, -1.F, 0.F)));
+        points.push_back(MeshCore::MeshPoint(Base::Vector3f(0.F, 0.F, 1.F)));
+        points.push_back(MeshCore::MeshPoint(Base::Vector3f(1.F, 1.F, 0.F)));
+        MeshCore::MeshFacetArray facets;
+        facets.push_back(MeshCore::MeshFacet(0, 1, 2));
+        facets.push_back(MeshCore::MeshFacet(1, 0, 3));
+        facets.push_back(MeshCore::MeshFacet(1, 0, 4));
+        facets.push_back(MeshCore::MeshFacet(2, 1, 5));
+        kernel.Adopt(points, facets, true);
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(EvaluationTest, TestTopology)
+{
+    MeshCore::MeshEvalTopology eval(kernel);
+    EXPECT_FALSE(eval.Evaluate());
+    EXPECT_EQ(eval.CountManifolds(), 1);
+
+    std::vector<MeshCore::FacetIndex> facets;
+    eval.GetFacetManifolds(facets);
+    EXPECT_EQ(facets, std::vector<MeshCore::FacetIndex>({0, 1, 2}));
+}
+
+TEST_F(EvaluationTest, TestNeighbourhood)
+{
+    MeshCore::MeshEvalNeighbourhood eval(kernel);
+    EXPECT_TRUE(eval.Evaluate());
+    EXPECT_TRUE(eval.GetIndices().empty());
+}
+
+TEST_F(EvaluationTest, TestPipeline)
+{
+    MeshCore::MeshEvaluationPipeline pipeline;
+    pipeline.AddStage("Topology", [this]() {
+        MeshCore::MeshEvalTopology eval(kernel);
+        return eval.Evaluate();
+    });
+    pipeline.AddStage("Neighbourhood", [this]() {
+        MeshCore::MeshEvalNeighbourhood eval(kernel);
+        return eval.Evaluate();
+    });
+    pipeline.AddStage(
+        "Orientation",
+        [this]() {
+            MeshCore::MeshEvalOrientation eval(kernel);
+            return eval.GetIndices().empty();
+        },
+        true);
+
+    EXPECT_FALSE(pipeline.Run());
+    const auto& stages = pipeline.GetStages();
+    ASSERT_EQ(stages.size(), 3);
+    EXPECT_FALSE(stages[0].result);
+    EXPECT_TRUE(stages[1].result);
+    for (const auto& stage : stages) {
+        EXPECT_GE(stage.seconds, 0.0F);
+    }
+    EXPECT_GE(pipeline.GetElapsedTime(), 0.0F);
+    EXPECT_NE(pipeline.Report().find("Topology: failed"), std::string::npos);
+}
+
+TEST_F(EvaluationTest, TestPipelineException)
+{
+    bool done = false;
+    MeshCore::MeshEvaluationPipeline pipeline;
+    pipeline.AddStage("Error", []() -> bool {
+        throw Base::RuntimeError("stage failed");
+    });
+    pipeline.AddStage("Other", [&done]() {
+        done = true;
+        return true;
+    });
+
+    EXPECT_THROW(pipeline.Run(), Base::RuntimeError);
+    EXPECT_TRUE(done);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,200 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <Mod/Mesh/App/Core/Approximation.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/Segmentation.h>
+#include <src/Mod/Mesh/App/MeshTestHelpers.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class SegmentationTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a plane of 2 * 40 * 40 triangles with a crease along x = 2
+        kernel = MeshTestHelpers::makeGridMesh(40, 0.1F);
+
+        for (const auto& it : kernel.GetPoints()) {
+            MeshCore::CurvatureInfo ci {};
+            ci.fMaxCurvature = std::fabs(it.x - 2.0F) < 0.05F ? 1.0F : 0.0F;
+            ci.fMinCurvature = 0.0F;
+            curvature.push_back(ci);
+        }
+    }
+
+    MeshCore::MeshKernel kernel;
+    std::vector<MeshCore::CurvatureInfo> curvature;
+};
+
+namespace
+{
+// the same test as MeshCurvaturePlanarSegment but grown facet by facet
+class GrowingPlanarSegment: public MeshCore::MeshCurvaturePlanarSegment
+{
+public:
+    using MeshCore::MeshCurvaturePlanarSegment::MeshCurvaturePlanarSegment;
+    bool IsGrowing() const override
+    {
+        return true;
+    }
+};
+}  // namespace
+
+TEST_F(SegmentationTest, TestCurvatureSegments)
+{
+    auto planar = std::make_shared<MeshCore::MeshCurvaturePlanarSegment>(curvature, 10, 0.1F);
+    std::vector<MeshCore::MeshSurfaceSegmentPtr> segm {planar};
+    MeshCore::MeshSegmentAlgorithm finder(kernel);
+    finder.FindSegments(segm);
+
+    // both sides of the crease
+    const std::vector<MeshCore::MeshSegment>& result = planar->GetSegments();
+    ASSERT_EQ(result.size(), 2);
+    EXPECT_EQ(result[0].size(), 2 * 19 * 40);
+    EXPECT_GE(result[1].size(), 2 * 19 * 40);
+    for (const auto& it : result) {
+        float minX = FLT_MAX;
+        float maxX = -FLT_MAX;
+        for (MeshCore::FacetIndex index : it) {
+            Base::Vector3f center = kernel.GetFacet(index).GetGravityPoint();
+            minX = std::min(minX, center.x);
+            maxX = std::max(maxX, center.x);
+        }
+        EXPECT_FALSE(minX < 1.9F && maxX > 2.1F);
+    }
+}
+
+TEST_F(SegmentationTest, TestCurvatureSegmentsLikeGrowing)
+{
+    auto planar = std::make_shared<MeshCore::MeshCurvaturePlanarSegment>(curvature, 10, 0.1F);
+    auto growing = std::make_shared<GrowingPlanarSegment>(curvature, 10, 0.1F);
+    MeshCore::MeshSegmentAlgorithm finder(kernel);
+
+    std::vector<MeshCore::MeshSurfaceSegmentPtr> segm1 {planar};
+    finder.FindSegments(segm1);
+    std::vector<MeshCore::MeshSurfaceSegmentPtr> segm2 {growing};
+    finder.FindSegments(segm2);
+
+    EXPECT_EQ(planar->GetSegments(), growing->GetSegments());
+}
+
+TEST_F(SegmentationTest, TestManyCurvatureSegmentsLikeGrowing)
+{
+    // Arrange
+
+    // a pattern of curved points that splits the grid into many regions of all sizes, some of
+    // them touching several seeds
+    kernel = MeshTestHelpers::makeGridMesh(120, 0.1F);
+    curvature.clear();
+    for (const auto& it : kernel.GetPoints()) {
+        auto i = int(std::lround(it.x * 10.0F));
+        auto j = int(std::lround(it.y * 10.0F));
+        MeshCore::CurvatureInfo ci {};
+        ci.fMaxCurvature = (i * 7 + j * 13) % 11 == 0 || i % 17 == 0 ? 1.0F : 0.0F;
+        ci.fMinCurvature = (i * 3 + j) % 23 == 0 ? 0.5F : 0.0F;
+        curvature.push_back(ci);
+    }
+    // the second segment type only gets the facets left by the first one
+    auto planar1 = std::make_shared<MeshCore::MeshCurvaturePlanarSegment>(curvature, 2, 0.1F);
+    auto planar2 = std::make_shared<MeshCore::MeshCurvaturePlanarSegment>(curvature, 2, 0.6F);
+    auto growing1 = std::make_shared<GrowingPlanarSegment>(curvature, 2, 0.1F);
+    auto growing2 = std::make_shared<GrowingPlanarSegment>(curvature, 2, 0.6F);
+    std::vector<MeshCore::MeshSurfaceSegmentPtr> segm1 {planar1, planar2};
+    std::vector<MeshCore::MeshSurfaceSegmentPtr> segm2 {growing1, growing2};
+    MeshCore::MeshSegmentAlgorithm finder(kernel);
+
+    // Act
+    finder.FindSegments(segm1);
+    finder.FindSegments(segm2);
+
+    // Assert
+    EXPECT_GT(planar1->GetSegments().size(), 100);
+    EXPECT_FALSE(planar2->GetSegments().empty());
+    EXPECT_EQ(planar1->GetSegments(), growing1->GetSegments());
+    EXPECT_EQ(planar2->GetSegments(), growing2->GetSegments());
+}
+
+TEST_F(SegmentationTest, TestPlaneSegments)
+{
+    auto plane = std::make_shared<MeshCore::MeshDistanceGenericSurfaceFitSegment>(
+        new MeshCore::PlaneSurfaceFit,
+        kernel,
+        10,
+        0.01F);
+    std::vector<MeshCore::MeshSurfaceSegmentPtr> segm {plane};
+    MeshCore::MeshSegmentAlgorithm finder(kernel);
+    finder.FindSegments(segm);
+
+    const std::vector<MeshCore::MeshSegment>& result = plane->GetSegments();
+    ASSERT_EQ(result.size(), 1);
+    EXPECT_EQ(result[0].size(), kernel.CountFacets());
+}
+
+TEST_F(SegmentationTest, TestPlaneFitAddPoints)
+{
+    // fitting again after adding points must give the same plane as fitting all points at once
+    MeshCore::PlaneFit incremental;
+    MeshCore::PlaneFit complete;
+    for (const auto& it : kernel.GetPoints()) {
+        Base::Vector3f pnt(it.x, it.y, 0.1F * it.x + 0.2F * it.y);
+        incremental.AddPoint(pnt);
+        complete.AddPoint(pnt);
+        if (incremental.CountPoints() % 100 == 3) {
+            incremental.Fit();
+        }
+    }
+
+    EXPECT_FLOAT_EQ(incremental.Fit(), complete.Fit());
+    EXPECT_EQ(incremental.GetBase(), complete.GetBase());
+    EXPECT_EQ(incremental.GetNormal(), complete.GetNormal());
+
+    incremental.Clear();
+    incremental.AddPoint(Base::Vector3f(0, 0, 1));
+    incremental.AddPoint(Base::Vector3f(1, 0, 1));
+    incremental.AddPoint(Base::Vector3f(0, 1, 1));
+    incremental.AddPoint(Base::Vector3f(1, 1, 1));
+    EXPECT_LT(incremental.Fit(), FLOAT_MAX);
+    EXPECT_FLOAT_EQ(std::fabs(incremental.GetNormal().z), 1.0F);
+    EXPECT_FLOAT_EQ(incremental.GetBase().z, 1.0F);
+}
+
+TEST_F(SegmentationTest, TestCylinderFitManyPoints)
+{
+    // enough points to set up the normal equations on several threads
+    MeshCore::CylinderFit fit;
+    for (int i = 0; i < 100; i++) {
+        for (int j = 0; j < 60; j++) {
+            float phi = float(j) * 2.0F * float(M_PI) / 60.0F;
+            fit.AddPoint(Base::Vector3f(2.0F * std::cos(phi), 2.0F * std::sin(phi), 0.1F * i));
+        }
+    }
+
+    EXPECT_LT(fit.Fit(), FLOAT_MAX);
+    EXPECT_NEAR(fit.GetRadius(), 2.0F, 1e-4F);
+    EXPECT_NEAR(std::fabs(fit.GetAxis().z), 1.0F, 1e-4F);
+}
+
+TEST_F(SegmentationTest, TestSphereFitManyPoints)
+{
+    MeshCore::SphereFit fit;
+    for (int i = 1; i < 60; i++) {
+        for (int j = 0; j < 60; j++) {
+            float theta = float(i) * float(M_PI) / 60.0F;
+            float phi = float(j) * 2.0F * float(M_PI) / 60.0F;
+            fit.AddPoint(Base::Vector3f(1.0F + 3.0F * std::sin(theta) * std::cos(phi),
+                                        3.0F * std::sin(theta) * std::sin(phi),
+                                        3.0F * std::cos(theta)));
+        }
+    }
+
+    EXPECT_LT(fit.Fit(), FLOAT_MAX);
+    EXPECT_NEAR(fit.GetRadius(), 3.0F, 1e-4F);
+    EXPECT_NEAR(fit.GetCenter().x, 1.0F, 1e-4F);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
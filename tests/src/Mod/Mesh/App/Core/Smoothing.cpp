@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/Smoothing.h>
+#include <src/Mod/Mesh/App/MeshTestHelpers.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class SmoothingTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a noisy plane of 2 * 40 * 40 triangles
+        kernel = MeshTestHelpers::makeGridMesh(40, 0.1F, [](int i, int j) {
+            return 0.05F * float((i * 7 + j * 13) % 5 - 2);
+        });
+    }
+
+    float roughness(const MeshCore::MeshKernel& mesh) const
+    {
+        float sum = 0.0F;
+        for (const auto& pnt : mesh.GetPoints()) {
+            sum += std::fabs(pnt.z);
+        }
+        return sum;
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(SmoothingTest, TestAdjacency)
+{
+    MeshCore::MeshPointAdjacency adj(kernel);
+    MeshCore::MeshRefPointToPoints vv(kernel);
+    MeshCore::MeshRefPointToFacets vf(kernel);
+    ASSERT_EQ(adj.CountPoints(), kernel.CountPoints());
+    EXPECT_EQ(adj.CountFacets(), kernel.CountFacets());
+
+    for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i++) {
+        auto points = adj.NeighbourPoints(i);
+        auto facets = adj.NeighbourFacets(i);
+        EXPECT_EQ(std::set<MeshCore::PointIndex>(points.begin(), points.end()), vv[i]);
+        EXPECT_EQ(std::set<MeshCore::FacetIndex>(facets.begin(), facets.end()), vf[i]);
+        EXPECT_EQ(adj.IsBorder(i), vv[i].size() != vf[i].size());
+    }
+}
+
+TEST_F(SmoothingTest, TestLaplace)
+{
+    MeshCore::MeshKernel mesh = kernel;
+    MeshCore::LaplaceSmoothing smooth(mesh);
+    smooth.Smooth(1);
+
+    // all points are moved towards the centre of their old neighbours
+    MeshCore::MeshRefPointToPoints vv(kernel);
+    MeshCore::MeshRefPointToFacets vf(kernel);
+    const MeshCore::MeshPointArray& points = kernel.GetPoints();
+    for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i++) {
+        Base::Vector3f expected = points[i];
+        if (vv[i].size() == vf[i].size()) {
+            Base::Vector3f center;
+            for (auto nb : vv[i]) {
+                center += points[nb];
+            }
+            center /= float(vv[i].size());
+            expected += (center - points[i]) * float(smooth.GetLambda());
+        }
+        EXPECT_NEAR(Base::Distance(mesh.GetPoint(i), expected), 0.0F, 1e-5F);
+    }
+
+    smooth.Smooth(10);
+    EXPECT_LT(roughness(mesh), 0.5F * roughness(kernel));
+}
+
+TEST_F(SmoothingTest, TestSmoothPoints)
+{
+    MeshCore::MeshKernel mesh = kernel;
+    std::vector<MeshCore::PointIndex> indices {50, 100, 150, 200};
+    MeshCore::TaubinSmoothing smooth(mesh);
+    smooth.SmoothPoints(4, indices);
+
+    for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i++) {
+        bool moved = std::find(indices.begin(), indices.end(), i) != indices.end();
+        if (!moved) {
+            EXPECT_EQ(mesh.GetPoint(i), kernel.GetPoint(i));
+        }
+    }
+
+    // an empty list doesn't change anything
+    MeshCore::MeshKernel copy = mesh;
+    smooth.SmoothPoints(4, {});
+    for (MeshCore::PointIndex i = 0; i < mesh.CountPoints(); i++) {
+        EXPECT_EQ(mesh.GetPoint(i), copy.GetPoint(i));
+    }
+}
+
+TEST_F(SmoothingTest, TestFilters)
+{
+    MeshCore::MeshKernel mesh1 = kernel;
+    MeshCore::PlaneFitSmoothing planeFit(mesh1);
+    planeFit.Smooth(5);
+    EXPECT_LT(roughness(mesh1), roughness(kernel));
+
+    MeshCore::MeshKernel mesh2 = kernel;
+    MeshCore::MedianFilterSmoothing median(mesh2);
+    median.Smooth(5);
+    EXPECT_LT(roughness(mesh2), roughness(kernel));
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
+#include <sstream>
 #include <Base/FileInfo.h>
 #include <Mod/Mesh/App/Core/IO/Reader3MF.h>
+#include <Mod/Mesh/App/Core/MeshIO.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
 #include <xercesc/util/PlatformUtils.hpp>
 #include <zipios++/fcoll.h>
 
@@ -37,4 +40,83 @@ TEST_F(ImporterTest, Test3MF)
     EXPECT_EQ(mesh2.CountEdges(), 1950);
     EXPECT_EQ(mesh2.CountFacets(), 1300);
 }
+
+TEST_F(ImporterTest, TestBinarySTL)
+{
+    Base::Vector3f p0(0.F, 0.F, 0.F);
+    Base::Vector3f p1(1.F, 0.F, 0.F);
+    Base::Vector3f p2(1.F, 1.F, 0.F);
+    Base::Vector3f p3(0.F, 1.F, -0.F);
+    MeshCore::MeshPointArray points;
+    points.push_back(MeshCore::MeshPoint(p0));
+    points.push_back(MeshCore::MeshPoint(p1));
+    points.push_back(MeshCore::MeshPoint(p2));
+    points.push_back(MeshCore::MeshPoint(p3));
+    MeshCore::MeshFacetArray facets;
+    facets.push_back(MeshCore::MeshFacet(0, 1, 2));
+    facets.push_back(MeshCore::MeshFacet(0, 2, 3));
+
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+
+    std::stringstream str;
+    MeshCore::MeshOutput output(kernel);
+    EXPECT_TRUE(output.SaveBinarySTL(str));
+
+    MeshCore::MeshKernel mesh;
+    MeshCore::MeshInput input(mesh);
+    EXPECT_TRUE(input.LoadBinarySTL(str));
+
+    // duplicated points are merged and keep the order of their first occurrence
+    EXPECT_EQ(mesh.CountPoints(), 4);
+    EXPECT_EQ(mesh.CountFacets(), 2);
+    EXPECT_EQ(mesh.CountEdges(), 5);
+    for (MeshCore::PointIndex i = 0; i < 4; i++) {
+        EXPECT_EQ(mesh.GetPoint(i), kernel.GetPoint(i));
+    }
+    EXPECT_EQ(mesh.GetFacets()[1]._aulPoints[2], 3);
+}
+
+TEST_F(ImporterTest, TestBinaryPLY)
+{
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    MeshCore::Material mat;
+    mat.binding = MeshCore::MeshIO::PER_VERTEX;
+    const int num = 300;
+    for (int i = 0; i <= num; i++) {
+        points.push_back(MeshCore::MeshPoint(Base::Vector3f(float(i), 0.F, 0.F)));
+        points.push_back(MeshCore::MeshPoint(Base::Vector3f(float(i), 1.F, 0.5F)));
+        mat.diffuseColor.emplace_back(0.F, 1.F, 0.F);
+        mat.diffuseColor.emplace_back(0.F, 0.F, 1.F);
+        if (i > 0) {
+            auto j = MeshCore::PointIndex(2 * i);
+            facets.push_back(MeshCore::MeshFacet(j - 2, j, j + 1));
+            facets.push_back(MeshCore::MeshFacet(j - 2, j + 1, j - 1));
+        }
+    }
+
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+
+    std::stringstream str;
+    MeshCore::MeshOutput output(kernel, &mat);
+    EXPECT_TRUE(output.SaveBinaryPLY(str));
+
+    MeshCore::MeshKernel mesh;
+    MeshCore::Material color;
+    MeshCore::MeshInput input(mesh, &color);
+    EXPECT_TRUE(input.LoadPLY(str));
+
+    EXPECT_EQ(mesh.CountPoints(), kernel.CountPoints());
+    EXPECT_EQ(mesh.CountFacets(), kernel.CountFacets());
+    for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i++) {
+        EXPECT_EQ(mesh.GetPoint(i), kernel.GetPoint(i));
+    }
+
+    EXPECT_EQ(color.binding, MeshCore::MeshIO::PER_VERTEX);
+    ASSERT_EQ(color.diffuseColor.size(), mat.diffuseColor.size());
+    EXPECT_EQ(color.diffuseColor[1], mat.diffuseColor[1]);
+    EXPECT_EQ(color.diffuseColor[2], mat.diffuseColor[2]);
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 #include <Mod/Mesh/App/Mesh.h>
+#include <Mod/Mesh/App/Core/Algorithm.h>
 #include <Mod/Mesh/App/Core/Grid.h>
+#include <src/Mod/Mesh/App/MeshTestHelpers.h>
+#include <cstdint>
+#include <sstream>
 
 // NOLINTBEGIN(cppcoreguidelines-*,readability-*)
 TEST(MeshTest, TestDefault)
@@ -95,4 +99,191 @@ TEST(MeshTest, TestGrid2OfAlmostPlanarMesh)
     EXPECT_EQ(countY, 1);
     EXPECT_EQ(countZ, 1);
 }
+
+namespace
+{
+MeshCore::MeshKernel makeTube(int segments, int rings)
+{
+    std::vector<MeshCore::MeshGeomFacet> facets;
+    auto point = [segments, rings](int i, int j) {
+        const float pi = 3.14159265F;
+        float angle = 2.0F * pi * float(i % segments) / float(segments);
+        return Base::Vector3f(std::cos(angle), std::sin(angle), float(j) / float(rings));
+    };
+    for (int j = 0; j < rings; j++) {
+        for (int i = 0; i < segments; i++) {
+            facets.emplace_back(point(i, j), point(i + 1, j), point(i + 1, j + 1));
+            facets.emplace_back(point(i, j), point(i + 1, j + 1), point(i, j + 1));
+        }
+    }
+
+    MeshCore::MeshKernel kernel;
+    kernel = facets;
+    return kernel;
+}
+}  // namespace
+
+TEST(MeshTest, TestSlicerMatchesGrid)
+{
+    MeshCore::MeshKernel kernel = makeTube(36, 20);
+    Base::Vector3f normal(0.0F, 0.3F, 1.0F);
+    std::vector<Base::Vector3f> bases;
+    for (int i = 0; i < 10; i++) {
+        bases.emplace_back(0.0F, 0.0F, 0.05F + 0.1F * float(i));
+    }
+
+    MeshCore::MeshSlicer slicer(kernel, normal);
+    std::vector<MeshCore::MeshSlicer::TPolylines> sections = slicer.CutWithPlanes(bases);
+    ASSERT_EQ(sections.size(), bases.size());
+
+    MeshCore::MeshFacetGrid grid(kernel);
+    MeshCore::MeshAlgorithm algo(kernel);
+    for (std::size_t i = 0; i < bases.size(); i++) {
+        MeshCore::MeshSlicer::TPolylines polylines;
+        algo.CutWithPlane(bases[i], normal, grid, polylines);
+        ASSERT_EQ(sections[i].size(), polylines.size());
+        auto it = polylines.begin();
+        for (const auto& polyline : sections[i]) {
+            EXPECT_EQ(polyline, *it++);
+        }
+    }
+}
+
+TEST(MeshTest, TestSlicerOutsideMesh)
+{
+    MeshCore::MeshKernel kernel = makeTube(8, 2);
+    MeshCore::MeshSlicer slicer(kernel, Base::Vector3f(0.0F, 0.0F, 1.0F));
+
+    MeshCore::MeshSlicer::TPolylines polylines;
+    slicer.CutWithPlane(Base::Vector3f(0.0F, 0.0F, 2.0F), polylines);
+    EXPECT_TRUE(polylines.empty());
+
+    std::vector<MeshCore::FacetIndex> facets;
+    slicer.GetFacetsFromPlane(Base::Vector3f(0.0F, 0.0F, 0.25F), facets);
+    EXPECT_EQ(facets.size(), 16);
+    EXPECT_TRUE(std::is_sorted(facets.begin(), facets.end()));
+}
+
+TEST(MeshTest, TestGridElementsSorted)
+{
+    MeshCore::MeshKernel kernel = makeTube(36, 20);
+    MeshCore::MeshFacetGrid grid(kernel, 5);
+    EXPECT_TRUE(grid.Verify());
+
+    unsigned long countX {};
+    unsigned long countY {};
+    unsigned long countZ {};
+    grid.GetCtGrids(countX, countY, countZ);
+
+    std::set<MeshCore::ElementIndex> facets;
+    for (unsigned long i = 0; i < countX; i++) {
+        for (unsigned long j = 0; j < countY; j++) {
+            for (unsigned long k = 0; k < countZ; k++) {
+                MeshCore::MeshGrid::ElementRange range = grid.GetGridElements(i, j, k);
+                EXPECT_EQ(range.size(), grid.GetCtElements(i, j, k));
+                EXPECT_TRUE(std::is_sorted(range.begin(), range.end()));
+                facets.insert(range.begin(), range.end());
+            }
+        }
+    }
+    EXPECT_EQ(facets.size(), kernel.CountFacets());
+}
+
+TEST(MeshTest, TestGridBatchQueries)
+{
+    MeshCore::MeshKernel kernel = makeTube(36, 20);
+    MeshCore::MeshFacetGrid grid(kernel);
+
+    std::vector<Base::Vector3f> points;
+    std::vector<Base::BoundBox3f> boxes;
+    for (int i = 0; i < 50; i++) {
+        float angle = 0.3F * float(i);
+        Base::Vector3f pnt(1.2F * std::cos(angle), 0.8F * std::sin(angle), 0.02F * float(i));
+        points.push_back(pnt);
+        boxes.emplace_back(pnt.x - 0.1F, pnt.y - 0.1F, pnt.z - 0.1F,
+                           pnt.x + 0.1F, pnt.y + 0.1F, pnt.z + 0.1F);
+    }
+
+    std::vector<MeshCore::ElementIndex> nearest = grid.SearchNearestFromPoints(points);
+    std::vector<MeshCore::ElementIndex> nearestArea = grid.SearchNearestFromPoints(points, 0.5F);
+    std::vector<std::vector<MeshCore::ElementIndex>> inside;
+    grid.Inside(boxes, inside);
+    ASSERT_EQ(nearest.size(), points.size());
+    ASSERT_EQ(inside.size(), boxes.size());
+
+    for (std::size_t i = 0; i < points.size(); i++) {
+        EXPECT_EQ(nearest[i], grid.SearchNearestFromPoint(points[i]));
+        EXPECT_EQ(nearestArea[i], grid.SearchNearestFromPoint(points[i], 0.5F));
+        std::vector<MeshCore::ElementIndex> elements;
+        grid.Inside(boxes[i], elements);
+        EXPECT_EQ(inside[i], elements);
+    }
+}
+
+namespace
+{
+void expectSameMesh(const MeshCore::MeshKernel& kernel1, const MeshCore::MeshKernel& kernel2)
+{
+    ASSERT_EQ(kernel1.CountPoints(), kernel2.CountPoints());
+    ASSERT_EQ(kernel1.CountFacets(), kernel2.CountFacets());
+    for (MeshCore::PointIndex i = 0; i < kernel1.CountPoints(); i++) {
+        EXPECT_EQ(kernel1.GetPoint(i), kernel2.GetPoint(i));
+    }
+    for (MeshCore::FacetIndex i = 0; i < kernel1.CountFacets(); i++) {
+        const MeshCore::MeshFacet& face1 = kernel1.GetFacets()[i];
+        const MeshCore::MeshFacet& face2 = kernel2.GetFacets()[i];
+        for (int j = 0; j < 3; j++) {
+            EXPECT_EQ(face1._aulPoints[j], face2._aulPoints[j]);
+            EXPECT_EQ(face1._aulNeighbours[j], face2._aulNeighbours[j]);
+        }
+    }
+}
+}  // namespace
+
+TEST(MeshTest, TestLoadLegacyBMS)
+{
+    // Arrange
+
+    // The oldest BMS format has no magic number but starts with the number of points and
+    // facets followed by the raw point and facet arrays and the bounding box
+    MeshCore::MeshKernel kernel = MeshTestHelpers::makeGridMesh(3, 1.0F);
+    auto numPoints = static_cast<uint32_t>(kernel.CountPoints());
+    auto numFacets = static_cast<uint32_t>(kernel.CountFacets());
+    Base::BoundBox3f box = kernel.GetBoundBox();
+    std::stringstream str;
+    str.write(reinterpret_cast<const char*>(&numPoints), sizeof(numPoints));
+    str.write(reinterpret_cast<const char*>(&numFacets), sizeof(numFacets));
+    str.write(reinterpret_cast<const char*>(kernel.GetPoints().data()),
+              numPoints * sizeof(MeshCore::MeshPoint));
+    str.write(reinterpret_cast<const char*>(kernel.GetFacets().data()),
+              numFacets * sizeof(MeshCore::MeshFacet));
+    str.write(reinterpret_cast<const char*>(&box), sizeof(box));
+    Mesh::MeshObject mesh;
+
+    // Act
+    mesh.load(str);
+
+    // Assert
+    expectSameMesh(mesh.getKernel(), kernel);
+}
+
+TEST(MeshTest, TestSaveAndLoad)
+{
+    // Arrange
+    Mesh::MeshObject mesh(MeshTestHelpers::makeGridMesh(3, 1.0F));
+    std::stringstream bms;
+    std::stringstream bmc;
+    Mesh::MeshObject fromBMS;
+    Mesh::MeshObject fromBMC;
+
+    // Act
+    mesh.save(bms);
+    mesh.saveCompact(bmc);
+    fromBMS.load(bms);
+    fromBMC.load(bmc);
+
+    // Assert
+    expectSameMesh(fromBMS.getKernel(), mesh.getKernel());
+    expectSameMesh(fromBMC.getKernel(), mesh.getKernel());
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef MESH_TEST_HELPERS_H
+#define MESH_TEST_HELPERS_H
+
+#include <functional>
+#include <vector>
+#include <Mod/Mesh/App/Core/Elements.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+namespace MeshTestHelpers
+{
+
+/**
+ * Creates an open grid of 2 * num * num triangles in the xy plane whose points are \a size
+ * apart. The z coordinate of the grid point (i, j) is given by \a height or is 0 otherwise.
+ */
+inline MeshCore::MeshKernel
+makeGridMesh(int num, float size, const std::function<float(int, int)>& height = {})
+{
+    auto point = [&](int i, int j) {
+        return Base::Vector3f(float(i) * size, float(j) * size, height ? height(i, j) : 0.0F);
+    };
+
+    std::vector<MeshCore::MeshGeomFacet> facets;
+    facets.reserve(std::size_t(2 * num * num));
+    for (int i = 0; i < num; i++) {
+        for (int j = 0; j < num; j++) {
+            Base::Vector3f p0 = point(i, j);
+            Base::Vector3f p1 = point(i + 1, j);
+            Base::Vector3f p2 = point(i + 1, j + 1);
+            Base::Vector3f p3 = point(i, j + 1);
+            facets.emplace_back(p0, p1, p2);
+            facets.emplace_back(p0, p2, p3);
+        }
+    }
+
+    MeshCore::MeshKernel kernel;
+    kernel = facets;
+    return kernel;
+}
+
+}  // namespace MeshTestHelpers
+
+#endif  // MESH_TEST_HELPERS_H
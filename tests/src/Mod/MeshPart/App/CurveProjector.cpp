@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <BRepBuilderAPI_MakeEdge.hxx>
+#include <TopoDS_Edge.hxx>
+#include <gp_Pnt.hxx>
+#include <Base/Matrix.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/MeshPart/App/CurveProjector.h>
+#include <src/Mod/Mesh/App/MeshTestHelpers.h>
+
+// NOLINTBEGIN
+class MeshProjectionTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a plane of 2 * 20 * 20 triangles at z = 0
+        kernel = MeshTestHelpers::makeGridMesh(20, 0.25F);
+    }
+
+    static TopoDS_Edge makeLine(double x1, double y1, double x2, double y2)
+    {
+        return BRepBuilderAPI_MakeEdge(gp_Pnt(x1, y1, 5.0), gp_Pnt(x2, y2, 5.0)).Edge();
+    }
+
+    static void checkPolyLine(const MeshPart::MeshProjection::PolyLine& polyline,
+                              float minX,
+                              float maxX,
+                              float z)
+    {
+        ASSERT_FALSE(polyline.points.empty());
+        for (const auto& it : polyline.points) {
+            EXPECT_NEAR(it.z, z, 1e-5F);
+            EXPECT_GE(it.x, minX - 1e-4F);
+            EXPECT_LE(it.x, maxX + 1e-4F);
+        }
+    }
+
+    MeshCore::MeshKernel kernel;
+    Base::Vector3f dir {0.0F, 0.0F, -1.0F};
+};
+
+TEST_F(MeshProjectionTest, testProjectEdgesInOrder)
+{
+    std::vector<TopoDS_Edge> edges;
+    for (int i = 0; i < 100; i++) {
+        double x = 0.5 + 0.04 * i;
+        edges.push_back(makeLine(x, 0.5, x, 4.5));
+    }
+
+    MeshPart::MeshProjection proj(kernel);
+    std::vector<MeshPart::MeshProjection::PolyLine> polylines;
+    proj.projectParallelToMesh(edges, dir, polylines);
+    ASSERT_EQ(polylines.size(), edges.size());
+    for (std::size_t i = 0; i < polylines.size(); i++) {
+        float x = 0.5F + 0.04F * float(i);
+        checkPolyLine(polylines[i], x, x, 0.0F);
+    }
+}
+
+TEST_F(MeshProjectionTest, testProjectPolyLines)
+{
+    std::vector<MeshPart::MeshProjection::PolyLine> polylinesIn(2);
+    polylinesIn[0].points = {Base::Vector3f(0.5F, 0.5F, 5.0F), Base::Vector3f(1.5F, 2.5F, 5.0F)};
+    polylinesIn[1].points = {Base::Vector3f(3.0F, 0.5F, 5.0F), Base::Vector3f(4.0F, 4.5F, 5.0F)};
+
+    MeshPart::MeshProjection proj(kernel);
+    std::vector<MeshPart::MeshProjection::PolyLine> polylines;
+    proj.projectParallelToMesh(polylinesIn, dir, polylines);
+    ASSERT_EQ(polylines.size(), 2);
+    checkPolyLine(polylines[0], 0.5F, 1.5F, 0.0F);
+    checkPolyLine(polylines[1], 3.0F, 4.0F, 0.0F);
+}
+
+TEST_F(MeshProjectionTest, testModifiedMeshWithoutCache)
+{
+    std::vector<TopoDS_Edge> edges {makeLine(0.5, 0.5, 4.5, 2.5)};
+
+    kernel.SetPoint(0, 0.0F, 0.0F, 1.0F);
+    kernel.RecalcBoundBox();
+
+    MeshPart::MeshProjection proj(kernel);
+    EXPECT_FALSE(proj.isCacheEnabled());
+
+    std::vector<MeshPart::MeshProjection::PolyLine> polylines;
+    proj.projectParallelToMesh(edges, dir, polylines);
+    ASSERT_EQ(polylines.size(), 1);
+    checkPolyLine(polylines[0], 0.5F, 4.5F, 0.0F);
+
+    // lift the inner points, which keeps the number of elements and the bounding box
+    for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i++) {
+        Base::Vector3f pnt = kernel.GetPoint(i);
+        if (pnt.x > 0.4F && pnt.x < 4.6F && pnt.y > 0.4F && pnt.y < 4.6F) {
+            kernel.SetPoint(i, pnt.x, pnt.y, 1.0F);
+        }
+    }
+    kernel.RecalcBoundBox();
+
+    polylines.clear();
+    proj.projectParallelToMesh(edges, dir, polylines);
+    ASSERT_EQ(polylines.size(), 1);
+    checkPolyLine(polylines[0], 0.5F, 4.5F, 1.0F);
+}
+
+TEST_F(MeshProjectionTest, testCacheIsResetOnClear)
+{
+    std::vector<TopoDS_Edge> edges {makeLine(0.5, 0.5, 4.5, 2.5)};
+
+    MeshPart::MeshProjection proj(kernel);
+    proj.setCacheEnabled(true);
+    EXPECT_TRUE(proj.isCacheEnabled());
+
+    std::vector<MeshPart::MeshProjection::PolyLine> polylines;
+    proj.projectParallelToMesh(edges, dir, polylines);
+    proj.projectParallelToMesh(edges, dir, polylines);
+    ASSERT_EQ(polylines.size(), 2);
+    EXPECT_EQ(polylines[0].points, polylines[1].points);
+    checkPolyLine(polylines[0], 0.5F, 4.5F, 0.0F);
+
+    // the cached polyline is dropped after modifying the mesh
+    Base::Matrix4D mat;
+    mat.move(Base::Vector3f(0.0F, 0.0F, 1.0F));
+    kernel.Transform(mat);
+    proj.clearCache();
+
+    polylines.clear();
+    proj.projectParallelToMesh(edges, dir, polylines);
+    ASSERT_EQ(polylines.size(), 1);
+    checkPolyLine(polylines[0], 0.5F, 4.5F, 1.0F);
+}
+// NOLINTEND
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <TopLoc_Location.hxx>
+#include <gp_Ax1.hxx>
+#include <gp_Trsf.hxx>
+#include <Mod/Mesh/App/Mesh.h>
+#include <Mod/MeshPart/App/Mesher.h>
+
+// NOLINTBEGIN
+class BatchMesherTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        box = BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Shape();
+        cylinder = BRepPrimAPI_MakeCylinder(5.0, 10.0).Shape();
+    }
+
+    static MeshPart::Mesher settings(const TopoDS_Shape& shape)
+    {
+        MeshPart::Mesher mesher(shape);
+        mesher.setMethod(MeshPart::Mesher::Standard);
+        mesher.setDeflection(0.1);
+        return mesher;
+    }
+
+    TopoDS_Shape box;
+    TopoDS_Shape cylinder;
+};
+
+TEST_F(BatchMesherTest, testMeshIdenticalShapesOnce)
+{
+    gp_Trsf move;
+    move.SetTranslation(gp_Vec(20.0, 0.0, 0.0));
+    gp_Trsf rotate;
+    rotate.SetRotation(gp_Ax1(gp_Pnt(0.0, 0.0, 0.0), gp_Dir(0.0, 0.0, 1.0)), M_PI / 2.0);
+
+    MeshPart::BatchMesher mesher(settings(TopoDS_Shape()));
+    mesher.addShape(box);
+    mesher.addShape(box.Moved(TopLoc_Location(move)));
+    mesher.addShape(cylinder.Moved(TopLoc_Location(move)));
+    mesher.addShape(box.Moved(TopLoc_Location(rotate)));
+    EXPECT_EQ(mesher.countShapes(), 4);
+    EXPECT_EQ(mesher.countUniqueShapes(), 2);
+
+    std::unique_ptr<Mesh::MeshObject> mesh(mesher.createMesh());
+    std::unique_ptr<Mesh::MeshObject> single(settings(box).createMesh());
+    std::unique_ptr<Mesh::MeshObject> round(settings(cylinder).createMesh());
+    EXPECT_EQ(mesh->countFacets(), 3 * single->countFacets() + round->countFacets());
+    EXPECT_NEAR(mesh->getVolume(), 3 * single->getVolume() + round->getVolume(), 1e-2);
+
+    Base::BoundBox3d bbox = mesh->getBoundBox();
+    EXPECT_NEAR(bbox.MinX, -10.0, 1e-5);
+    EXPECT_NEAR(bbox.MaxX, 30.0, 1e-5);
+}
+
+TEST_F(BatchMesherTest, testMeshesInOrder)
+{
+    gp_Trsf move;
+    move.SetTranslation(gp_Vec(0.0, 0.0, 20.0));
+
+    MeshPart::BatchMesher mesher(settings(TopoDS_Shape()));
+    mesher.addShape(cylinder);
+    mesher.addShape(box.Moved(TopLoc_Location(move)));
+
+    std::vector<Base::BoundBox3f> boxes;
+    mesher.createMeshes([&boxes](const MeshCore::MeshKernel& kernel) {
+        boxes.push_back(kernel.GetBoundBox());
+    });
+    ASSERT_EQ(boxes.size(), 2);
+    EXPECT_NEAR(boxes[0].MaxZ, 10.0F, 1e-5F);
+    EXPECT_NEAR(boxes[1].MinZ, 20.0F, 1e-5F);
+}
+// NOLINTEND
@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <Mod/Part/App/ShapeChecker.h>
+
+#include <BRep_Builder.hxx>
+#include <BRepBuilderAPI_MakeEdge.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <TopoDS_Compound.hxx>
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+namespace
+{
+TopoDS_Compound makeBoxes(int count)
+{
+    BRep_Builder builder;
+    TopoDS_Compound compound;
+    builder.MakeCompound(compound);
+    for (int i = 0; i < count; ++i) {
+        builder.Add(compound, BRepPrimAPI_MakeBox(gp_Pnt(2.0 * i, 0, 0), 1, 1, 1).Shape());
+    }
+    return compound;
+}
+}  // namespace
+
+TEST(ShapeChecker, checkSolidsInParallel)
+{
+    // Arrange
+    TopoDS_Compound compound = makeBoxes(8);
+    BRep_Builder builder;
+    builder.Add(compound, BRepBuilderAPI_MakeEdge(gp_Pnt(0, 5, 0), gp_Pnt(1, 5, 0)).Edge());
+    Part::ShapeChecker checker(compound);
+    checker.setThreadCount(4);
+
+    // Act
+    int reported = 0;
+    bool done = checker.perform([&reported](const Part::ShapeChecker::Result& result) {
+        EXPECT_TRUE(result.checked);
+        ++reported;
+        return true;
+    });
+
+    // Assert
+    EXPECT_TRUE(done);
+    EXPECT_TRUE(checker.isValid());
+    const auto& results = checker.getResults();
+    ASSERT_EQ(results.size(), 9U);
+    EXPECT_EQ(reported, 9);
+    EXPECT_EQ(results.front().name, "Solid1");
+    EXPECT_EQ(results.back().name, "Edge97");
+}
+
+TEST(ShapeChecker, nothingToSplit)
+{
+    // Arrange
+    Part::ShapeChecker checker(BRepPrimAPI_MakeBox(1, 1, 1).Shape(), TopAbs_SOLID);
+
+    // Act
+    bool done = checker.perform();
+
+    // Assert
+    EXPECT_TRUE(done);
+    EXPECT_TRUE(checker.isValid());
+    ASSERT_EQ(checker.getResults().size(), 1U);
+    EXPECT_EQ(checker.getResults().front().name, "Solid1");
+}
+
+TEST(ShapeChecker, abortFromCallback)
+{
+    // Arrange
+    Part::ShapeChecker checker(makeBoxes(50), TopAbs_FACE);
+    checker.setThreadCount(1);
+
+    // Act
+    bool done = checker.perform([](const Part::ShapeChecker::Result&) {
+        return false;
+    });
+
+    // Assert
+    EXPECT_FALSE(done);
+    EXPECT_TRUE(checker.isAborted());
+    EXPECT_FALSE(checker.isValid());
+}
+
+TEST(ShapeChecker, abortBeforePerform)
+{
+    // Arrange
+    Part::ShapeChecker checker(makeBoxes(4));
+    checker.abort();
+
+    // Act
+    bool done = checker.perform();
+
+    // Assert
+    EXPECT_FALSE(done);
+    EXPECT_FALSE(checker.isValid());
+
+    // Act
+    checker.reset();
+    done = checker.perform();
+
+    // Assert
+    EXPECT_TRUE(done);
+    EXPECT_TRUE(checker.isValid());
+}
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
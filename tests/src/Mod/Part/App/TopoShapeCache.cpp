@@ -11,7 +11,10 @@
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <BRepAlgoAPI_Fuse.hxx>
 #include <BRepPrimAPI_MakeBox.hxx>
+#include <BRep_Builder.hxx>
+#include <TopoDS_Compound.hxx>
 #include <TopoDS_Edge.hxx>
+#include <TopoDS_Wire.hxx>
 
 // NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
 
@@ -281,4 +284,112 @@ TEST_F(TopoShapeCacheTest, FindAncestor)
     EXPECT_FALSE(ancestorResultCompound.IsNull());
 }
 
+TEST_F(TopoShapeCacheTest, ShapeMapsSharedByPartners)
+{
+    // Arrange
+    const auto [shape, ancestors] = CreateFusedCubes();
+    gp_Trsf transform;
+    transform.SetTranslation(gp_Vec(0.0, 0.0, 5.0));
+    auto movedShape = shape.Moved(TopLoc_Location(transform));
+
+    // Act
+    Part::TopoShapeCache cache1(shape);
+    int countOfFaces = cache1.countShape(TopAbs_FACE);
+    Part::TopoShapeCache cache2(movedShape);
+    Part::TopoShapeCache cache3(shape.Reversed());
+
+    // Assert
+    EXPECT_EQ(cache1.getShapeMaps(), cache2.getShapeMaps());
+    EXPECT_NE(cache1.getShapeMaps(), cache3.getShapeMaps());
+    EXPECT_EQ(countOfFaces, cache2.countShape(TopAbs_FACE));
+    auto face = cache2.findShape(movedShape, TopAbs_FACE, 1);
+    EXPECT_EQ(1, cache2.findShape(movedShape, face));
+    EXPECT_FALSE(cache2.findAncestor(movedShape, face, TopAbs_SOLID).IsNull());
+}
+
+TEST_F(TopoShapeCacheTest, ShapeMapsReleased)
+{
+    // Arrange
+    auto shape = std::get<0>(CreateShapeWithSubshapes());
+    std::weak_ptr<Part::TopoShapeCache::ShapeMaps> maps;
+
+    // Act
+    {
+        Part::TopoShapeCache cache(shape);
+        maps = cache.getShapeMaps();
+    }
+    Part::TopoShapeCache cache(shape);
+
+    // Assert
+    EXPECT_TRUE(maps.expired());
+    EXPECT_EQ(2, cache.countShape(TopAbs_EDGE));
+}
+
+TEST_F(TopoShapeCacheTest, ShapeMapsRebuiltForChildReplacedInPlace)
+{
+    // Arrange
+    BRep_Builder builder;
+    TopoDS_Compound compound;
+    builder.MakeCompound(compound);
+    auto edge1 = BRepBuilderAPI_MakeEdge(gp_Pnt(0.0, 0.0, 0.0), gp_Pnt(1.0, 0.0, 0.0)).Edge();
+    auto edge2 = BRepBuilderAPI_MakeEdge(gp_Pnt(0.0, 1.0, 0.0), gp_Pnt(1.0, 1.0, 0.0)).Edge();
+    auto edge3 = BRepBuilderAPI_MakeEdge(gp_Pnt(0.0, 2.0, 0.0), gp_Pnt(1.0, 2.0, 0.0)).Edge();
+    builder.Add(compound, edge1);
+    builder.Add(compound, edge2);
+    Part::TopoShapeCache cache1(compound);
+    EXPECT_EQ(2, cache1.findShape(compound, edge2));
+
+    // Act
+    builder.Remove(compound, edge2);
+    builder.Add(compound, edge3);
+    Part::TopoShapeCache cache2(compound);
+
+    // Assert
+    EXPECT_NE(cache1.getShapeMaps(), cache2.getShapeMaps());
+    EXPECT_EQ(0, cache2.findShape(compound, edge2));
+    EXPECT_EQ(2, cache2.findShape(compound, edge3));
+}
+
+TEST_F(TopoShapeCacheTest, ShapeMapsNotCreatedBeforeFirstUse)
+{
+    // Arrange
+    auto shape = std::get<0>(CreateShapeWithSubshapes());
+
+    // Act
+    Part::TopoShapeCache cache(shape);
+
+    // Assert
+    EXPECT_FALSE(cache.shapeMaps);
+    EXPECT_EQ(2, cache.countShape(TopAbs_EDGE));
+    EXPECT_TRUE(cache.shapeMaps);
+}
+
+TEST_F(TopoShapeCacheTest, ShapeMapsRebuiltForSubShapeEditedInPlace)
+{
+    // Arrange
+    BRep_Builder builder;
+    TopoDS_Compound compound;
+    builder.MakeCompound(compound);
+    TopoDS_Wire wire;
+    builder.MakeWire(wire);
+    auto edge1 = BRepBuilderAPI_MakeEdge(gp_Pnt(0.0, 0.0, 0.0), gp_Pnt(1.0, 0.0, 0.0)).Edge();
+    auto edge2 = BRepBuilderAPI_MakeEdge(gp_Pnt(1.0, 0.0, 0.0), gp_Pnt(1.0, 1.0, 0.0)).Edge();
+    builder.Add(wire, edge1);
+    builder.Add(compound, wire);
+    Part::TopoShapeCache cache1(compound);
+    EXPECT_EQ(1, cache1.countShape(TopAbs_EDGE));
+
+    // Act
+    // The wire is shared with the compound, the compound's own children stay the same
+    wire.Free(true);
+    builder.Add(wire, edge2);
+    Part::TopoShapeCache cache2(compound);
+
+    // Assert
+    EXPECT_NE(cache1.getShapeMaps(), cache2.getShapeMaps());
+    EXPECT_EQ(2, cache2.countShape(TopAbs_EDGE));
+    EXPECT_EQ(2, cache2.findShape(compound, edge2));
+    EXPECT_FALSE(cache2.findAncestor(compound, edge2, TopAbs_WIRE).IsNull());
+}
+
 // NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
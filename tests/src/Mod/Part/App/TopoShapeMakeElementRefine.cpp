@@ -6,6 +6,12 @@
 
 #include "PartTestHelpers.h"
 
+#include <BRepAlgoAPI_Fuse.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+
+#include <Mod/Part/App/modelRefine.h>
+
 class FeaturePartMakeElementRefineTest: public ::testing::Test,
                                         public PartTestHelpers::PartTestHelperClass
 {
@@ -53,3 +59,53 @@ TEST_F(FeaturePartMakeElementRefineTest, makeElementRefineBoxes)
     // TODO: Refine doesn't work on compounds, so we're going to need a binary operation or the
     // like, and those don't exist yet.  Once they do, this test can be expanded
 }
+
+TEST_F(FeaturePartMakeElementRefineTest, refineModelManyBoxes)
+{
+    // Arrange
+    const int count = 20;
+    TopoDS_Shape fused = BRepPrimAPI_MakeBox(1.0, 1.0, 1.0).Shape();
+    for (int i = 1; i < count; ++i) {
+        gp_Pnt origin(i, 0.0, 0.0);
+        fused = BRepAlgoAPI_Fuse(fused, BRepPrimAPI_MakeBox(origin, 1.0, 1.0, 1.0).Shape()).Shape();
+    }
+    TopTools_IndexedMapOfShape faces;
+    TopExp::MapShapes(fused, TopAbs_FACE, faces);
+    // Act
+    Part::BRepBuilderAPI_RefineModel refine(fused);
+    TopTools_IndexedMapOfShape refinedFaces;
+    TopExp::MapShapes(refine.Shape(), TopAbs_FACE, refinedFaces);
+    // Assert
+    EXPECT_EQ(faces.Extent(), 4 * count + 2);
+    EXPECT_EQ(refinedFaces.Extent(), 6);
+    EXPECT_NEAR(PartTestHelpers::getVolume(refine.Shape()), count, 1e-6);
+}
+
+TEST_F(FeaturePartMakeElementRefineTest, adjacencySplitterReentrant)
+{
+    // Arrange
+    TopoDS_Shape fused = BRepAlgoAPI_Fuse(BRepPrimAPI_MakeBox(1.0, 1.0, 1.0).Shape(),
+                                          BRepPrimAPI_MakeBox(gp_Pnt(1.0, 0.0, 0.0), 1.0, 1.0, 1.0).Shape())
+                             .Shape();
+    TopExp_Explorer xp(fused, TopAbs_SHELL);
+    ASSERT_TRUE(xp.More());
+    const TopoDS_Shell& shell = TopoDS::Shell(xp.Current());
+    ModelRefine::FaceVectorType faces;
+    for (TopExp_Explorer it(shell, TopAbs_FACE); it.More(); it.Next()) {
+        faces.push_back(TopoDS::Face(it.Current()));
+    }
+    ModelRefine::FaceAdjacencySplitter splitter(shell);
+    // Act
+    splitter.split(faces);
+    std::vector<ModelRefine::FaceVectorType> groups;
+    splitter.split(faces, groups);
+    // Assert
+    ASSERT_EQ(groups.size(), splitter.getGroupCount());
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+        const auto& group = splitter.getGroup(i);
+        ASSERT_EQ(groups[i].size(), group.size());
+        for (std::size_t j = 0; j < group.size(); ++j) {
+            EXPECT_TRUE(groups[i][j].IsSame(group[j]));
+        }
+    }
+}
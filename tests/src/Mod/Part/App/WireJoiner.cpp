@@ -28,18 +28,27 @@ protected:
         App::GetApplication().newDocument(_docName.c_str(), "testUser");
         _hasher = Base::Reference<App::StringHasher>(new App::StringHasher);
         ASSERT_EQ(_hasher.getRefCount(), 1);
+        _parallel = getParameters()->GetBool("Parallel", true);
     }
 
     void TearDown() override
     {
+        getParameters()->SetBool("Parallel", _parallel);
         App::GetApplication().closeDocument(_docName.c_str());
     }
 
+    static Base::Reference<ParameterGrp> getParameters()
+    {
+        return App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/WireJoiner");
+    }
+
 
 private:
     std::string _docName;
     Data::ElementIDRefs _sid;
     App::StringHasherRef _hasher;
+    bool _parallel {true};
 };
 
 TEST_F(WireJoinerTest, addShape)
@@ -929,4 +938,43 @@ TEST_F(WireJoinerTest, IsDeleted)
     EXPECT_TRUE(wjIsDeleted.IsDeleted(edge5));
 }
 
+TEST_F(WireJoinerTest, splitEdgesGrid)
+{
+    // Arrange
+
+    // A grid of lines, each one crossing all the lines of the other direction. This exercises
+    // the box tree and the concurrent intersection checks.
+    const int count = 8;
+    std::vector<TopoDS_Shape> edges;
+    for (int i = 0; i < count; ++i) {
+        edges.push_back(
+            BRepBuilderAPI_MakeEdge(gp_Pnt(-1.0, i, 0.0), gp_Pnt(count, i, 0.0)).Edge());
+        edges.push_back(
+            BRepBuilderAPI_MakeEdge(gp_Pnt(i, -1.0, 0.0), gp_Pnt(i, count, 0.0)).Edge());
+    }
+    auto wjSerial {WireJoiner()};
+    auto wjParallel {WireJoiner()};
+    auto wireSerial {TopoShape(1)};
+    auto wireParallel {TopoShape(2)};
+
+    // Act
+
+    getParameters()->SetBool("Parallel", false);
+    wjSerial.addShape(edges);
+    wjSerial.getResultWires(wireSerial);
+
+    getParameters()->SetBool("Parallel", true);
+    wjParallel.addShape(edges);
+    wjParallel.getResultWires(wireParallel);
+
+    // Assert
+
+    // Every cell of the grid is a closed wire
+    EXPECT_EQ(wireSerial.getSubTopoShapes(TopAbs_WIRE).size(), (count - 1) * (count - 1));
+    EXPECT_EQ(wireParallel.getSubTopoShapes(TopAbs_WIRE).size(),
+              wireSerial.getSubTopoShapes(TopAbs_WIRE).size());
+    EXPECT_EQ(wireParallel.getSubTopoShapes(TopAbs_EDGE).size(),
+              wireSerial.getSubTopoShapes(TopAbs_EDGE).size());
+}
+
 // NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <Base/FileInfo.h>
+#include <Base/Stream.h>
 #include <Mod/Points/App/Points.h>
 #include <Mod/Points/App/PointsAlgos.h>
 
@@ -238,4 +239,93 @@ TEST_F(PointsTest, TestPCDStructured)
     EXPECT_EQ(reader.getWidth(), 4);
     EXPECT_EQ(reader.getHeight(), 2);
 }
+
+TEST_F(PointsTest, TestPLYManyPoints)
+{
+    // enough points to parse the file on several threads
+    std::vector<Base::Vector3f> points;
+    for (int i = 0; i < 200000; i++) {
+        points.emplace_back(0.125F * float(i), -0.5F * float(i % 100), 1.0e-3F * float(i % 7));
+    }
+    Points::PointKernel kernel;
+    kernel.setBasicPoints(points);
+
+    std::string name = getFileName();
+    Points::PlyWriter writer(kernel);
+    writer.write(name);
+
+    Points::PlyReader reader;
+    reader.read(name);
+
+    const std::vector<Base::Vector3f>& result = reader.getPoints().getBasicPoints();
+    ASSERT_EQ(result.size(), points.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        EXPECT_NEAR(Base::Distance(result[i], points[i]), 0.0F, 1.0e-6F * points[i].Length());
+    }
+}
+
+TEST_F(PointsTest, TestASCIIPLYLineAcrossBlocks)
+{
+    // the body of an ASCII file is read in blocks of 16 MiB, a line must span the first border
+    const std::size_t blockSize = 1 << 24;
+    std::vector<Base::Vector3f> points;
+    std::string body;
+    while (body.size() <= blockSize + 1000) {
+        int i = int(points.size());
+        points.emplace_back(float(i % 1000) + 0.25F,
+                            float(i / 1000) + 0.5F,
+                            -float(i % 7) - 0.125F);
+        body += std::to_string(i % 1000) + ".25 " + std::to_string(i / 1000) + ".5 -"
+            + std::to_string(i % 7) + ".125\n";
+    }
+    ASSERT_NE(body[blockSize - 1], '\n');
+    ASSERT_NE(body[blockSize], '\n');
+
+    std::string name = getFileName();
+    {
+        Base::FileInfo fi(name);
+        Base::ofstream str(fi, std::ios::out | std::ios::binary);
+        str << "ply\nformat ascii 1.0\nelement vertex " << points.size() << "\n"
+            << "property float x\nproperty float y\nproperty float z\nend_header\n"
+            << body;
+    }
+
+    Points::PlyReader reader;
+    reader.read(name);
+
+    const std::vector<Base::Vector3f>& result = reader.getPoints().getBasicPoints();
+    ASSERT_EQ(result.size(), points.size());
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < points.size(); i++) {
+        if (result[i] != points[i]) {
+            mismatches++;
+        }
+    }
+    EXPECT_EQ(mismatches, 0);
+}
+
+TEST_F(PointsTest, TestBinaryPLY)
+{
+    std::string name = getFileName();
+    {
+        Base::ofstream out(Base::FileInfo(name), std::ios::out | std::ios::binary);
+        out << "ply\n"
+            << "format binary_big_endian 1.0\n"
+            << "element vertex 8\n"
+            << "property float x\n"
+            << "property double y\n"
+            << "property uchar z\n"
+            << "end_header\n";
+        Base::OutputStream str(out);
+        str.setByteOrder(Base::Stream::BigEndian);
+        for (const auto& it : getKernel().getBasicPoints()) {
+            str << it.x << static_cast<double>(it.y) << static_cast<uint8_t>(it.z);
+        }
+    }
+
+    Points::PlyReader reader;
+    reader.read(name);
+
+    EXPECT_EQ(reader.getPoints().getBasicPoints(), getKernel().getBasicPoints());
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <Mod/Points/App/PointsKDTree.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class PointsKDTreeTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a wavy height field of 60 * 60 points with one invalid point
+        for (int i = 0; i < 60; i++) {
+            for (int j = 0; j < 60; j++) {
+                float x = 0.1F * i;
+                float y = 0.1F * j;
+                points.emplace_back(x, y, 0.3F * std::sin(x) * std::cos(y) + 2.0F);
+            }
+        }
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        points[100] = Base::Vector3f(nan, nan, nan);
+    }
+
+    std::vector<int> bruteForce(const Base::Vector3f& pnt, std::size_t k) const
+    {
+        std::vector<std::pair<float, int>> dist;
+        for (std::size_t i = 0; i < points.size(); i++) {
+            if (!std::isnan(points[i].x)) {
+                dist.emplace_back(Base::DistanceP2(points[i], pnt), int(i));
+            }
+        }
+        std::sort(dist.begin(), dist.end());
+        std::vector<int> indices;
+        for (std::size_t i = 0; i < std::min(k, dist.size()); i++) {
+            indices.push_back(dist[i].second);
+        }
+        return indices;
+    }
+
+    std::vector<Base::Vector3f> points;
+};
+
+TEST_F(PointsKDTreeTest, TestNearestNeighbours)
+{
+    Points::PointsKDTree tree(points);
+    EXPECT_EQ(tree.size(), points.size());
+    EXPECT_EQ(tree.countIndexed(), points.size() - 1);
+
+    std::vector<int> indices;
+    for (float x = -0.5F; x < 6.5F; x += 0.37F) {
+        Base::Vector3f pnt(x, 0.8F * x, 2.1F);
+        tree.nearestNeighbours(pnt, 10, indices);
+        std::vector<int> expected = bruteForce(pnt, 10);
+        ASSERT_EQ(indices.size(), expected.size());
+        for (std::size_t i = 0; i < indices.size(); i++) {
+            EXPECT_FLOAT_EQ(Base::DistanceP2(points[indices[i]], pnt),
+                            Base::DistanceP2(points[expected[i]], pnt));
+        }
+    }
+
+    // batched search for all points includes the point itself
+    std::vector<std::vector<int>> neighbours;
+    tree.nearestNeighbours(5, neighbours);
+    ASSERT_EQ(neighbours.size(), points.size());
+    EXPECT_TRUE(neighbours[100].empty());
+    EXPECT_EQ(neighbours[0].size(), 5);
+    EXPECT_EQ(neighbours[0].front(), 0);
+}
+
+TEST_F(PointsKDTreeTest, TestRadiusNeighbours)
+{
+    Points::PointsKDTree tree(points);
+    std::vector<std::vector<int>> neighbours;
+    tree.radiusNeighbours(0.25F, neighbours);
+    ASSERT_EQ(neighbours.size(), points.size());
+
+    for (std::size_t i = 0; i < points.size(); i += 97) {
+        if (std::isnan(points[i].x)) {
+            continue;
+        }
+        std::size_t count = 0;
+        for (const auto& it : points) {
+            if (Base::Distance(it, points[i]) <= 0.25F) {
+                count++;
+            }
+        }
+        EXPECT_EQ(neighbours[i].size(), count);
+        for (int index : neighbours[i]) {
+            EXPECT_LE(Base::Distance(points[index], points[i]), 0.25F);
+        }
+    }
+}
+
+TEST_F(PointsKDTreeTest, TestEstimateNormals)
+{
+    // a plane z = 2 gives normals towards the origin and no curvature
+    std::vector<Base::Vector3f> plane;
+    for (int i = 0; i < 40; i++) {
+        for (int j = 0; j < 40; j++) {
+            plane.emplace_back(0.1F * i, 0.1F * j, 2.0F);
+        }
+    }
+
+    Points::PointsKDTree tree(plane);
+    std::vector<Base::Vector3f> normals;
+    std::vector<float> curvatures;
+    tree.estimateNormals(8, 0.0F, normals, &curvatures);
+    ASSERT_EQ(normals.size(), plane.size());
+    for (std::size_t i = 0; i < normals.size(); i++) {
+        EXPECT_NEAR(normals[i].z, -1.0F, 1e-5F);
+        EXPECT_NEAR(curvatures[i], 0.0F, 1e-5F);
+    }
+
+    // the same with a search radius
+    tree.estimateNormals(0, 0.15F, normals);
+    for (const auto& it : normals) {
+        EXPECT_NEAR(it.z, -1.0F, 1e-5F);
+    }
+}
+
+TEST_F(PointsKDTreeTest, TestEstimateNormalsOfSphere)
+{
+    std::vector<Base::Vector3f> sphere;
+    for (int i = 1; i < 60; i++) {
+        for (int j = 0; j < 60; j++) {
+            float theta = float(i) * float(M_PI) / 60.0F;
+            float phi = float(j) * 2.0F * float(M_PI) / 60.0F;
+            sphere.emplace_back(std::sin(theta) * std::cos(phi),
+                                std::sin(theta) * std::sin(phi),
+                                std::cos(theta));
+        }
+    }
+
+    Points::PointsKDTree tree(sphere);
+    std::vector<Base::Vector3f> normals;
+    tree.estimateNormals(10, 0.0F, normals);
+    for (std::size_t i = 0; i < sphere.size(); i++) {
+        // pointing inwards to the origin
+        EXPECT_LT(normals[i] * sphere[i], -0.99F);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
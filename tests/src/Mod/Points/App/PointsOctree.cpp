@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <Mod/Points/App/PointsOctree.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+TEST(PointsPageCache, TestSwapLeastRecentlyUsed)
+{
+    // Arrange
+    Points::PointsPageCache cache(5);
+    std::size_t page1 = cache.create();
+    std::size_t page2 = cache.create();
+    std::vector<Base::Vector3f> points1 {Base::Vector3f(1.F, 2.F, 3.F),
+                                         Base::Vector3f(4.F, 5.F, 6.F),
+                                         Base::Vector3f(7.F, 8.F, 9.F)};
+    std::vector<Base::Vector3f> points2 {Base::Vector3f(0.F, 1.F, 0.F),
+                                         Base::Vector3f(0.F, 0.F, 1.F),
+                                         Base::Vector3f(1.F, 0.F, 0.F)};
+
+    // Act
+    cache.store(page1, std::vector<Base::Vector3f>(points1));
+    cache.store(page2, std::vector<Base::Vector3f>(points2));
+
+    // Assert
+    EXPECT_FALSE(cache.isResident(page1));
+    EXPECT_TRUE(cache.isResident(page2));
+    EXPECT_EQ(cache.countResident(), 3);
+    EXPECT_EQ(cache.count(page1), 3);
+
+    // Act
+    auto page = cache.load(page1);
+
+    // Assert
+    EXPECT_EQ(*page, points1);
+    EXPECT_TRUE(cache.isResident(page1));
+    EXPECT_FALSE(cache.isResident(page2));
+    EXPECT_EQ(*cache.load(page2), points2);
+}
+
+class PointsOctreeTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a regular grid of 200 * 200 * 5 points, denser than the sample grid of the root
+        for (int i = 0; i < 200; i++) {
+            for (int j = 0; j < 200; j++) {
+                for (int k = 0; k < 5; k++) {
+                    points.emplace_back(0.05F * i, 0.05F * j, 0.05F * k);
+                }
+            }
+        }
+        for (const auto& it : points) {
+            box.Add(it);
+        }
+    }
+
+    std::vector<Base::Vector3f> points;
+    Base::BoundBox3f box;
+};
+
+TEST_F(PointsOctreeTest, TestAllPointsStored)
+{
+    Points::PointsOctree tree(box);
+    tree.add(points);
+
+    EXPECT_EQ(tree.countPoints(), points.size());
+    EXPECT_GT(tree.countNodes(), 1);
+
+    std::vector<Base::Vector3f> result;
+    for (std::size_t i = 0; i < tree.countNodes(); i++) {
+        auto page = tree.getPoints(i);
+        result.insert(result.end(), page->begin(), page->end());
+        for (const auto& it : *page) {
+            EXPECT_TRUE(tree.getNode(i).bounds.IsInBox(it));
+        }
+    }
+
+    auto less = [](const Base::Vector3f& a, const Base::Vector3f& b) {
+        return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z);
+    };
+    std::sort(result.begin(), result.end(), less);
+    std::sort(points.begin(), points.end(), less);
+    EXPECT_EQ(result, points);
+}
+
+TEST_F(PointsOctreeTest, TestSwapToDisk)
+{
+    Points::PointsOctree reference(box);
+    Points::PointsOctree tree(box, 50000);
+    for (std::size_t i = 0; i < points.size(); i += 10000) {
+        std::vector<Base::Vector3f> batch(points.begin() + i, points.begin() + i + 10000);
+        reference.add(batch);
+        tree.add(batch);
+    }
+
+    ASSERT_EQ(tree.countNodes(), reference.countNodes());
+    for (std::size_t i = 0; i < tree.countNodes(); i++) {
+        EXPECT_EQ(*tree.getPoints(i), *reference.getPoints(i));
+    }
+}
+
+TEST_F(PointsOctreeTest, TestSelectNodes)
+{
+    Points::PointsOctree tree(box);
+    tree.add(points);
+
+    // far away the root node is fine enough
+    Base::Vector3f eye(5.0F, 5.0F, 1000.0F);
+    std::vector<std::size_t> far = tree.selectNodes(eye, 1000.0F, 1.0F, points.size());
+    ASSERT_EQ(far.size(), 1);
+    EXPECT_EQ(far[0], 0);
+
+    // close to the cloud more nodes are needed but the budget is kept
+    eye.Set(5.0F, 5.0F, 3.0F);
+    std::size_t budget = points.size() / 2;
+    std::vector<std::size_t> near = tree.selectNodes(eye, 1000.0F, 1.0F, budget);
+    EXPECT_GT(near.size(), 1);
+    std::size_t count = 0;
+    for (std::size_t index : near) {
+        count += tree.getPoints(index)->size();
+    }
+    EXPECT_LE(count, budget);
+
+    // invisible nodes are skipped
+    auto isVisible = [](const Base::BoundBox3f&) {
+        return false;
+    };
+    EXPECT_TRUE(tree.selectNodes(eye, 1000.0F, 1.0F, budget, isVisible).empty());
+}
+
+TEST_F(PointsOctreeTest, TestForEachNode)
+{
+    Points::PointsOctree tree(box, 50000);
+    tree.add(points);
+
+    std::atomic<std::size_t> count {0};
+    tree.forEachNode(
+        [&count](const Points::PointsOctree::Node&, const std::vector<Base::Vector3f>& pts) {
+            count += pts.size();
+        });
+    EXPECT_EQ(count, points.size());
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,237 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <Geom_BSplineSurface.hxx>
+#include <TColStd_Array1OfInteger.hxx>
+#include <TColStd_Array1OfReal.hxx>
+#include <TColgp_Array1OfPnt.hxx>
+#include <TColgp_Array2OfPnt.hxx>
+#include <math_Gauss.hxx>
+#include <math_Householder.hxx>
+#include <math_Matrix.hxx>
+#include <math_Vector.hxx>
+#include <src/App/InitApplication.h>
+#include <Mod/ReverseEngineering/App/ApproxSurface.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+namespace
+{
+
+/**
+ * Gives access to the fitted control points and solves the least-squares problem as it was done
+ * before the sparse normal equations: with the dense matrix of all points and control points.
+ */
+class DenseParameterCorrection: public Reen::BSplineParameterCorrection
+{
+public:
+    using BSplineParameterCorrection::BSplineParameterCorrection;
+
+    const TColgp_Array2OfPnt& getPoles() const
+    {
+        return _vCtrlPntsOfSurf;
+    }
+
+    /// Solves the system of the last fit, the surface is not modified
+    TColgp_Array2OfPnt solveDense()
+    {
+        int numPoints = _pvcPoints->Length();
+        int dim = static_cast<int>(_usUCtrlpoints * _usVCtrlpoints);
+        math_Matrix M(0, numPoints - 1, 0, dim - 1, 0.0);
+        math_Vector bx(0, numPoints - 1);
+        math_Vector by(0, numPoints - 1);
+        math_Vector bz(0, numPoints - 1);
+        for (int i = 0; i < numPoints; i++) {
+            const gp_Pnt2d& uv = (*_pvcUVParam)(i);
+            int idx = 0;
+            for (unsigned j = 0; j < _usUCtrlpoints; j++) {
+                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
+                    M(i, idx++) = _clUSpline.BasisFunction(static_cast<int>(j), uv.X())
+                        * _clVSpline.BasisFunction(static_cast<int>(k), uv.Y());
+                }
+            }
+            const gp_Pnt& pnt = (*_pvcPoints)(_pvcPoints->Lower() + i);
+            bx(i) = pnt.X();
+            by(i) = pnt.Y();
+            bz(i) = pnt.Z();
+        }
+
+        math_Matrix X(0, dim - 1, 0, 2);
+        if (_bSmoothing) {
+            math_Matrix MTM = M.TMultiply(M) + _fSmoothInfluence * _clSmoothMatrix;
+            math_Gauss gauss(MTM);
+            EXPECT_TRUE(gauss.IsDone());
+            math_Matrix MT = M.Transposed();
+            math_Vector sol(0, dim - 1);
+            gauss.Solve(MT * bx, sol);
+            X.SetCol(0, sol);
+            gauss.Solve(MT * by, sol);
+            X.SetCol(1, sol);
+            gauss.Solve(MT * bz, sol);
+            X.SetCol(2, sol);
+        }
+        else {
+            math_Householder hhX(M, bx);
+            math_Householder hhY(M, by);
+            math_Householder hhZ(M, bz);
+            EXPECT_TRUE(hhX.IsDone() && hhY.IsDone() && hhZ.IsDone());
+            math_Vector sol(0, dim - 1);
+            hhX.Value(sol, 1);
+            X.SetCol(0, sol);
+            hhY.Value(sol, 1);
+            X.SetCol(1, sol);
+            hhZ.Value(sol, 1);
+            X.SetCol(2, sol);
+        }
+
+        TColgp_Array2OfPnt poles(0, _usUCtrlpoints - 1, 0, _usVCtrlpoints - 1);
+        int idx = 0;
+        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
+            for (unsigned k = 0; k < _usVCtrlpoints; k++) {
+                poles(j, k) = gp_Pnt(X(idx, 0), X(idx, 1), X(idx, 2));
+                idx++;
+            }
+        }
+        return poles;
+    }
+};
+
+}  // namespace
+
+class ApproxSurfaceTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    void SetUp() override
+    {
+        // A bicubic patch with the knots of the fit. The x and y coordinates of the poles are at
+        // the Greville abscissae so that x and y are linear in u and v.
+        const double greville[numPoles] = {0.0, 1.0 / 9.0, 1.0 / 3.0, 2.0 / 3.0, 8.0 / 9.0, 1.0};
+        TColgp_Array2OfPnt poles(1, numPoles, 1, numPoles);
+        for (int j = 0; j < numPoles; j++) {
+            for (int k = 0; k < numPoles; k++) {
+                poles(j + 1, k + 1) = gp_Pnt(size * greville[j],
+                                             size * greville[k],
+                                             std::sin(0.9 * j) * std::cos(0.7 * k));
+            }
+        }
+
+        TColStd_Array1OfReal knots(1, 4);
+        TColStd_Array1OfInteger mults(1, 4);
+        for (int i = 0; i < 4; i++) {
+            knots(i + 1) = i / 3.0;
+            mults(i + 1) = 1;
+        }
+        mults(1) = 4;
+        mults(4) = 4;
+        patch = new Geom_BSplineSurface(poles, knots, knots, mults, mults, 3, 3);
+    }
+
+    /// Samples the patch on a regular grid of \a count x \a count points and moves the points by
+    /// \a noise along z
+    TColgp_Array1OfPnt samplePatch(double noise, int count = numSamples) const
+    {
+        TColgp_Array1OfPnt points(0, count * count - 1);
+        int idx = 0;
+        for (int i = 0; i < count; i++) {
+            for (int j = 0; j < count; j++) {
+                double u = double(i) / (count - 1);
+                double v = double(j) / (count - 1);
+                gp_Pnt pnt = patch->Value(u, v);
+                pnt.SetZ(pnt.Z() + noise * std::sin(12.9898 * i + 78.233 * j));
+                points(idx++) = pnt;
+            }
+        }
+        return points;
+    }
+
+    static void fit(DenseParameterCorrection& approx, const TColgp_Array1OfPnt& points)
+    {
+        // map the points to (u,v) by their x and y coordinates without any parameter correction
+        approx.SetUV(Base::Vector3d(1.0, 0.0, 0.0), Base::Vector3d(0.0, 1.0, 0.0));
+        Handle(Geom_BSplineSurface) surf = approx.CreateSurface(points, 0, false, 1.0);
+        ASSERT_FALSE(surf.IsNull());
+    }
+
+    static void comparePoles(const TColgp_Array2OfPnt& poles1,
+                             const TColgp_Array2OfPnt& poles2,
+                             double tolerance)
+    {
+        ASSERT_EQ(poles1.ColLength(), poles2.ColLength());
+        ASSERT_EQ(poles1.RowLength(), poles2.RowLength());
+        for (int j = 0; j < poles1.ColLength(); j++) {
+            for (int k = 0; k < poles1.RowLength(); k++) {
+                const gp_Pnt& pnt1 = poles1(poles1.LowerRow() + j, poles1.LowerCol() + k);
+                const gp_Pnt& pnt2 = poles2(poles2.LowerRow() + j, poles2.LowerCol() + k);
+                EXPECT_NEAR(pnt1.X(), pnt2.X(), tolerance) << "pole " << j << ", " << k;
+                EXPECT_NEAR(pnt1.Y(), pnt2.Y(), tolerance) << "pole " << j << ", " << k;
+                EXPECT_NEAR(pnt1.Z(), pnt2.Z(), tolerance) << "pole " << j << ", " << k;
+            }
+        }
+    }
+
+    static constexpr int numPoles = 6;
+    static constexpr int numSamples = 40;
+    static constexpr double size = 10.0;
+    Handle(Geom_BSplineSurface) patch;
+};
+
+TEST_F(ApproxSurfaceTest, recoverBicubicPatch)
+{
+    // Arrange
+    DenseParameterCorrection approx(4, 4, numPoles, numPoles);
+
+    // Act
+    fit(approx, samplePatch(0.0));
+
+    // Assert
+    TColgp_Array2OfPnt poles(1, numPoles, 1, numPoles);
+    patch->Poles(poles);
+    comparePoles(approx.getPoles(), poles, 1.0e-8);
+}
+
+TEST_F(ApproxSurfaceTest, matchDenseSolution)
+{
+    // Arrange
+    DenseParameterCorrection approx(4, 4, numPoles, numPoles);
+
+    // Act
+    fit(approx, samplePatch(0.05));
+
+    // Assert
+    comparePoles(approx.getPoles(), approx.solveDense(), 1.0e-8);
+}
+
+TEST_F(ApproxSurfaceTest, matchDenseSolutionWithSmoothing)
+{
+    // Arrange
+    DenseParameterCorrection approx(4, 4, numPoles, numPoles);
+    approx.EnableSmoothing(true, 0.5);
+
+    // Act
+    fit(approx, samplePatch(0.05));
+
+    // Assert
+    comparePoles(approx.getPoles(), approx.solveDense(), 1.0e-8);
+}
+
+TEST_F(ApproxSurfaceTest, matchDenseSolutionWithSeveralTasks)
+{
+    // Arrange
+    // more than twice the minimum number of points per task so that the normal equations are
+    // assembled from several ranges if there is more than one thread
+    const int count = 100;
+    ASSERT_GT(count * count, 2 * 4096);
+    DenseParameterCorrection approx(4, 4, numPoles, numPoles);
+
+    // Act
+    fit(approx, samplePatch(0.05, count));
+
+    // Assert
+    comparePoles(approx.getPoles(), approx.solveDense(), 1.0e-8);
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)
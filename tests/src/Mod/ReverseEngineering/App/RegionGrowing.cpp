@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <vector>
+#include <Mod/Points/App/Points.h>
+#include <Mod/ReverseEngineering/App/RegionGrowing.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+class RegionGrowingTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // The horizontal plane z=0 and the vertical plane x=0 crossing along the y axis. The
+        // grids are shifted by half a step so that no point lies on both planes.
+        for (int i = 0; i < numSteps; i++) {
+            for (int j = 0; j < numSteps; j++) {
+                points.push_back(Base::Vector3d(coord(i), coord(j), 0.0));
+                normals.emplace_back(0.0F, 0.0F, 1.0F);
+            }
+        }
+        for (int i = 0; i < numSteps; i++) {
+            for (int j = 0; j < numSteps; j++) {
+                points.push_back(Base::Vector3d(0.0, coord(j), coord(i)));
+                normals.emplace_back(1.0F, 0.0F, 0.0F);
+            }
+        }
+    }
+
+    static double coord(int step)
+    {
+        return 0.1 * (step - numSteps / 2) + 0.05;
+    }
+
+    /// Returns 0 or 1 for the plane the point was sampled on
+    static int plane(int index)
+    {
+        return index < numSteps * numSteps ? 0 : 1;
+    }
+
+    static constexpr int numSteps = 40;
+    Points::PointKernel points;
+    std::vector<Base::Vector3f> normals;
+};
+
+TEST_F(RegionGrowingTest, separatePlanesWithGivenNormals)
+{
+    // Arrange
+    std::list<std::vector<int>> clusters;
+    Reen::RegionGrowing growing(points, clusters);
+
+    // Act
+    growing.perform(normals);
+
+    // Assert
+    ASSERT_EQ(clusters.size(), 2);
+    std::vector<int> sizes(2, 0);
+    for (const auto& cluster : clusters) {
+        int first = plane(cluster.front());
+        for (int index : cluster) {
+            EXPECT_EQ(plane(index), first);
+        }
+        sizes[first] += static_cast<int>(cluster.size());
+    }
+    EXPECT_EQ(sizes[0], numSteps * numSteps);
+    EXPECT_EQ(sizes[1], numSteps * numSteps);
+}
+
+TEST_F(RegionGrowingTest, separatePlanesWithEstimatedNormals)
+{
+    // Arrange
+    std::list<std::vector<int>> clusters;
+    Reen::RegionGrowing growing(points, clusters);
+
+    // Act
+    growing.perform(10);
+
+    // Assert
+    // The normals next to the intersection are tilted, these points may be left out or form
+    // small clusters, but none of the clusters may take points of both planes
+    ASSERT_GE(clusters.size(), 2);
+    std::vector<int> largest(2, 0);
+    for (const auto& cluster : clusters) {
+        int first = plane(cluster.front());
+        for (int index : cluster) {
+            EXPECT_EQ(plane(index), first);
+        }
+        largest[first] = std::max(largest[first], static_cast<int>(cluster.size()));
+    }
+    EXPECT_GT(largest[0], 0.8 * numSteps * numSteps);
+    EXPECT_GT(largest[1], 0.8 * numSteps * numSteps);
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <Mod/Points/App/Points.h>
+#include <Mod/ReverseEngineering/App/SampleConsensus.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+class SampleConsensusTest: public ::testing::Test
+{
+protected:
+    /// Moves the point by a random amount below the distance threshold of the fit along \a dir
+    Base::Vector3d addNoise(const Base::Vector3d& pnt, const Base::Vector3d& dir)
+    {
+        return pnt + dir * noise(rng);
+    }
+
+    /// Adds points spread over the box [-size, size]^3 that don't belong to the model
+    void addOutliers(int count, double size)
+    {
+        std::uniform_real_distribution<double> coord(-size, size);
+        for (int i = 0; i < count; i++) {
+            points.push_back(Base::Vector3d(coord(rng), coord(rng), coord(rng)));
+            normals.emplace_back(0.0, 0.0, 1.0);
+        }
+    }
+
+    /// Runs the fit and checks that nearly all samples of the model are found as inliers
+    std::vector<float> fit(Reen::SampleConsensus::SacModel sac, int numSamples)
+    {
+        Reen::SampleConsensus consensus(sac, points, normals);
+        std::vector<float> parameters;
+        std::vector<int> model;
+        consensus.perform(parameters, model);
+
+        // the samples of the model are the first points
+        auto found = std::count_if(model.begin(), model.end(), [numSamples](int index) {
+            return index < numSamples;
+        });
+        EXPECT_GT(found, 0.95 * numSamples);
+        EXPECT_LT(model.size() - found, 0.1 * (points.size() - numSamples));
+        return parameters;
+    }
+
+    Points::PointKernel points;
+    std::vector<Base::Vector3d> normals;
+    std::mt19937 rng {42};
+    std::uniform_real_distribution<double> noise {-0.003, 0.003};
+};
+
+TEST_F(SampleConsensusTest, recoverPlane)
+{
+    // Arrange
+    Base::Vector3d normal(1.0, -2.0, 2.0);
+    normal.Normalize();
+    Base::Vector3d dirU = Base::Vector3d(2.0, 1.0, 0.0).Normalize();
+    Base::Vector3d dirV = normal % dirU;
+    Base::Vector3d origin(1.0, 2.0, 3.0);
+    const int numSamples = 400;
+    for (int i = 0; i < 20; i++) {
+        for (int j = 0; j < 20; j++) {
+            Base::Vector3d pnt = origin + dirU * (0.1 * i) + dirV * (0.1 * j);
+            points.push_back(addNoise(pnt, normal));
+            normals.push_back(normal);
+        }
+    }
+    addOutliers(100, 5.0);
+
+    // Act
+    std::vector<float> parameters = fit(Reen::SampleConsensus::SACMODEL_PLANE, numSamples);
+
+    // Assert
+    ASSERT_EQ(parameters.size(), 4);
+    Base::Vector3d fitNormal(parameters[0], parameters[1], parameters[2]);
+    EXPECT_NEAR(std::fabs(fitNormal * normal), 1.0, 1.0e-3);
+    double sign = fitNormal * normal > 0.0 ? 1.0 : -1.0;
+    EXPECT_NEAR(parameters[3], -sign * (normal * origin), 0.01);
+}
+
+TEST_F(SampleConsensusTest, recoverSphere)
+{
+    // Arrange
+    Base::Vector3d center(1.0, -2.0, 0.5);
+    const double radius = 2.0;
+    const int numSamples = 600;
+    for (int i = 0; i < 20; i++) {
+        double theta = M_PI * (i + 0.5) / 20.0;
+        for (int j = 0; j < 30; j++) {
+            double phi = 2.0 * M_PI * j / 30.0;
+            Base::Vector3d dir(std::sin(theta) * std::cos(phi),
+                               std::sin(theta) * std::sin(phi),
+                               std::cos(theta));
+            points.push_back(addNoise(center + dir * radius, dir));
+            normals.push_back(dir);
+        }
+    }
+    addOutliers(100, 4.0);
+
+    // Act
+    std::vector<float> parameters = fit(Reen::SampleConsensus::SACMODEL_SPHERE, numSamples);
+
+    // Assert
+    ASSERT_EQ(parameters.size(), 4);
+    EXPECT_NEAR(parameters[0], center.x, 0.01);
+    EXPECT_NEAR(parameters[1], center.y, 0.01);
+    EXPECT_NEAR(parameters[2], center.z, 0.01);
+    EXPECT_NEAR(parameters[3], radius, 0.01);
+}
+
+TEST_F(SampleConsensusTest, recoverCylinder)
+{
+    // Arrange
+    Base::Vector3d base(0.5, -1.0, 0.0);
+    Base::Vector3d axis = Base::Vector3d(1.0, 1.0, 4.0).Normalize();
+    Base::Vector3d dirU = Base::Vector3d(1.0, -1.0, 0.0).Normalize();
+    Base::Vector3d dirV = axis % dirU;
+    const double radius = 1.5;
+    const int numSamples = 600;
+    for (int i = 0; i < 20; i++) {
+        for (int j = 0; j < 30; j++) {
+            double phi = 2.0 * M_PI * j / 30.0;
+            Base::Vector3d dir = dirU * std::cos(phi) + dirV * std::sin(phi);
+            points.push_back(addNoise(base + axis * (0.2 * i) + dir * radius, dir));
+            normals.push_back(dir);
+        }
+    }
+    addOutliers(100, 4.0);
+
+    // Act
+    std::vector<float> parameters = fit(Reen::SampleConsensus::SACMODEL_CYLINDER, numSamples);
+
+    // Assert
+    ASSERT_EQ(parameters.size(), 7);
+    Base::Vector3d fitBase(parameters[0], parameters[1], parameters[2]);
+    Base::Vector3d fitAxis(parameters[3], parameters[4], parameters[5]);
+    EXPECT_NEAR(std::fabs(fitAxis * axis), 1.0, 1.0e-3);
+    EXPECT_NEAR(fitBase.DistanceToLine(base, axis), 0.0, 0.01);
+    EXPECT_NEAR(parameters[6], radius, 0.01);
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)
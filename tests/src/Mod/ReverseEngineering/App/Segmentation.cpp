@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include <Mod/Points/App/Points.h>
+#include <Mod/ReverseEngineering/App/Segmentation.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+class NormalEstimationTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // Evenly spread points on a sphere around the origin, the normals are oriented towards
+        // the origin
+        const double goldenAngle = M_PI * (3.0 - std::sqrt(5.0));
+        for (int i = 0; i < numPoints; i++) {
+            double z = 1.0 - (2.0 * i + 1.0) / numPoints;
+            double rad = std::sqrt(1.0 - z * z);
+            double phi = goldenAngle * i;
+            points.push_back(
+                Base::Vector3d(rad * std::cos(phi), rad * std::sin(phi), z) * radius);
+        }
+    }
+
+    void checkRadialNormals(const std::vector<Base::Vector3d>& normals) const
+    {
+        ASSERT_EQ(normals.size(), points.size());
+        for (std::size_t index = 0; index < normals.size(); index++) {
+            Base::Vector3d dir = points.getPoint(static_cast<int>(index));
+            dir.Normalize();
+            EXPECT_NEAR(normals[index].Length(), 1.0, 1.0e-5) << "at point " << index;
+            EXPECT_LT(normals[index] * dir, -0.995) << "at point " << index;
+        }
+    }
+
+    static constexpr int numPoints = 3000;
+    static constexpr double radius = 5.0;
+    Points::PointKernel points;
+};
+
+TEST_F(NormalEstimationTest, radialNormalsOfNearestNeighbours)
+{
+    // Arrange
+    Reen::NormalEstimation estimation(points);
+    estimation.setKSearch(12);
+    std::vector<Base::Vector3d> normals;
+
+    // Act
+    estimation.perform(normals);
+
+    // Assert
+    checkRadialNormals(normals);
+}
+
+TEST_F(NormalEstimationTest, radialNormalsWithinRadius)
+{
+    // Arrange
+    Reen::NormalEstimation estimation(points);
+    estimation.setSearchRadius(0.8);
+    std::vector<Base::Vector3d> normals;
+
+    // Act
+    estimation.perform(normals);
+
+    // Assert
+    checkRadialNormals(normals);
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)